@@ -0,0 +1,37 @@
+/**
+ * @file bench.h
+ * @date 18.10.2026
+ *
+ * Helpers shared by the benchmark programs.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <time.h>
+#include <cstdlib>
+
+namespace bench
+{
+
+/**
+ * Monotonic wall-clock time in seconds
+ */
+inline double now()
+{
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/**
+ * Get the @p i 'th command line argument as a number, or @p def if not given
+ */
+inline unsigned long arg(int argc, char** argv, int i, unsigned long def)
+{
+	return (argc > i) ? std::strtoul(argv[i], 0, 10) : def;
+}
+
+}
+
+#endif /* BENCH_H_ */
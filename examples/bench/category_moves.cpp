@@ -0,0 +1,82 @@
+/**
+ * @file category_moves.cpp
+ * @date 18.10.2026
+ *
+ * Cost of node state changes and node insertions as a function of the number
+ * of node states C, with states ordered in a single array (the default) and
+ * with indexed states (Graph::setIndexedStates).
+ *
+ * Usage: category-moves [nodes] [operations]
+ */
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+/// time per operation in ns for state changes, insertions and random picks
+void run(node_state_size_t C, bool indexed, node_size_t n, unsigned long k)
+{
+	boost::mt19937 rng(42);
+	boost::random::uniform_int_distribution<node_state_t> state(0, C - 1);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+
+	Graph g(C, 1);
+	g.setIndexedStates(indexed);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(state(rng));
+
+	double t0 = bench::now();
+	for (unsigned long i = 0; i < k; ++i)
+		g.setNodeState(pick(rng), state(rng));
+	const double moves = bench::now() - t0;
+
+	node_size_t found = 0;
+	t0 = bench::now();
+	for (unsigned long i = 0; i < k; ++i)
+		found += g.numberOfNodes(state(rng));
+	const double counts = bench::now() - t0;
+
+	t0 = bench::now();
+	for (unsigned long i = 0; i < k; ++i)
+	{
+		const node_id_t v = g.addNode(state(rng));
+		g.removeNode(v);
+	}
+	const double inserts = bench::now() - t0;
+
+	cout << setw(8) << C << setw(10) << (indexed ? "indexed" : "ordered")
+			<< fixed << setprecision(1) << setw(12) << 1e9 * moves / k
+			<< setw(12) << 1e9 * inserts / k << setw(12) << 1e9 * counts / k
+			<< "\n";
+	if (found == 0)
+		cout << "# no nodes found\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 100000);
+	const unsigned long k = bench::arg(argc, argv, 2, 200000);
+
+	cout << "# " << n << " nodes, " << k << " operations; time per operation in ns\n";
+	cout << setw(8) << "C" << setw(10) << "mode" << setw(12) << "setState"
+			<< setw(12) << "add+remove" << setw(12) << "count" << "\n";
+	const node_state_size_t C[] =
+	{ 2, 10, 100, 1000, 10000 };
+	for (unsigned int i = 0; i < sizeof(C) / sizeof(C[0]); ++i)
+	{
+		run(C[i], false, n, k);
+		run(C[i], true, n, k);
+	}
+	return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file graph_clone.cpp
+ * @date 18.10.2026
+ *
+ * Cost of setting up an ensemble member from a stored initial condition:
+ * rebuilding the graph edge by edge compared to Graph::clone.
+ *
+ * Usage: graph-clone [nodes] [mean degree] [copies]
+ */
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+/// copy @p g by adding its nodes and edges one by one
+std::auto_ptr<Graph> rebuild(const Graph& g)
+{
+	std::auto_ptr<Graph> c(new Graph(g.numberOfNodeStates(), g.numberOfEdgeStates()));
+	c->reserve(g.numberOfNodes(), g.numberOfEdges());
+	for (Graph::ConstNodeIterator it = g.nodes().first; it != g.nodes().second; ++it)
+		c->addNode(g.nodeState(it.id()));
+	for (Graph::ConstEdgeIterator it = g.edges().first; it != g.edges().second; ++it)
+		c->setEdgeState(c->addEdge(it->source()->id(), it->target()->id(),
+				it->isDirected()), g.edgeState(it.id()));
+	return c;
+}
+
+void report(const char* name, double build, double destroy,
+		unsigned long k, edge_size_t m)
+{
+	cout << setw(10) << name << fixed << setprecision(2) << setw(12) << 1e3
+			* build / k << setw(12) << 1e3 * destroy / k << setw(12)
+			<< setprecision(1) << 1e9 * build / k / m << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 100000);
+	const edge_size_t m = n * bench::arg(argc, argv, 2, 10) / 2;
+	const unsigned long k = bench::arg(argc, argv, 3, 20);
+
+	Graph g(2, 3);
+	boost::mt19937 rng(42);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	boost::random::uniform_int_distribution<node_state_t> state(0, 1);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(state(rng));
+	while (g.numberOfEdges() < m)
+	{
+		const node_id_t s = pick(rng), t = pick(rng);
+		if (s != t)
+			g.addEdge(s, t, false);
+	}
+
+	cout << "# " << n << " nodes, " << m << " edges, " << k << " copies\n";
+	cout << setw(10) << "method" << setw(12) << "ms/copy" << setw(12)
+			<< "ms/destroy" << setw(12) << "ns/edge" << "\n";
+	edge_size_t check = 0;
+	double build = 0, destroy = 0;
+	for (unsigned long i = 0; i < k; ++i)
+	{
+		const double t0 = bench::now();
+		std::auto_ptr<Graph> c = rebuild(g);
+		const double t1 = bench::now();
+		check += c->numberOfEdges();
+		c.reset();
+		build += t1 - t0;
+		destroy += bench::now() - t1;
+	}
+	report("rebuild", build, destroy, k, m);
+
+	build = destroy = 0;
+	for (unsigned long i = 0; i < k; ++i)
+	{
+		const double t0 = bench::now();
+		std::auto_ptr<Graph> c = g.clone();
+		const double t1 = bench::now();
+		check += c->numberOfEdges();
+		c.reset();
+		build += t1 - t0;
+		destroy += bench::now() - t1;
+	}
+	report("clone", build, destroy, k, m);
+
+	if (check != 2 * k * m)
+		cout << "# copies differ from the original\n";
+	return 0;
+}
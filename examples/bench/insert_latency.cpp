@@ -0,0 +1,92 @@
+/**
+ * @file insert_latency.cpp
+ * @date 18.10.2026
+ *
+ * Worst-case latency of single node and edge insertions while a graph grows,
+ * with default repository growth, with memory reserved up front
+ * (Graph::reserve), and with segmented storage (Graph::setSegmentBits).
+ *
+ * Usage: insert-latency [nodes] [mean degree]
+ */
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+enum Mode
+{
+	DEFAULT, RESERVED, SEGMENTED
+};
+
+struct Latency
+{
+	Latency() :
+		total(0), worst(0)
+	{
+	}
+	void add(double t)
+	{
+		total += t;
+		worst = max(worst, t);
+	}
+	double total;
+	double worst;
+};
+
+void run(const string& name, Mode mode, node_size_t n, edge_size_t m)
+{
+	Graph g(1, 1);
+	if (mode == RESERVED)
+		g.reserve(n, m);
+	else if (mode == SEGMENTED)
+		g.setSegmentBits(12);
+
+	Latency nodes, edges;
+	for (node_size_t i = 0; i < n; ++i)
+	{
+		const double t = bench::now();
+		g.addNode();
+		nodes.add(bench::now() - t);
+	}
+	boost::mt19937 rng(42);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	for (edge_size_t i = 0; i < m; ++i)
+	{
+		const node_id_t s = pick(rng), t = pick(rng);
+		const double t0 = bench::now();
+		g.addEdge(s, t, false);
+		edges.add(bench::now() - t0);
+	}
+
+	cout << setw(10) << name << fixed << setprecision(3) << setw(12)
+			<< 1e3 * nodes.total << setw(12) << 1e3 * nodes.worst << setw(12)
+			<< 1e3 * edges.total << setw(12) << 1e3 * edges.worst << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 2000000);
+	const edge_size_t m = n * bench::arg(argc, argv, 2, 4) / 2;
+
+	cout << "# " << n << " nodes, " << m << " edges; times in ms\n";
+	cout << setw(10) << "mode" << setw(12) << "nodes" << setw(12)
+			<< "worst node" << setw(12) << "edges" << setw(12) << "worst edge"
+			<< "\n";
+	run("default", DEFAULT, n, m);
+	run("reserved", RESERVED, n, m);
+	run("segmented", SEGMENTED, n, m);
+	return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file journal.cpp
+ * @date 18.10.2026
+ *
+ * Recording and replaying an adaptive SIS simulation with
+ * io::JournalListener and io::JournalReplayer: the cost of recording, the
+ * journal size compared to binary snapshots written with io::BinWriter, and
+ * the speed of replaying the trajectory and of seeking in it compared to
+ * running the simulation.
+ *
+ * Usage: journal [number of nodes] [mean degree] [events]
+ */
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <largenet2/io/BinWriter.h>
+#include <largenet2/io/JournalListener.h>
+#include <largenet2/io/JournalReplayer.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <memory>
+#include <cmath>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	double Uniform01()
+	{
+		return boost::random::uniform_real_distribution<double>(0, 1)(engine_);
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// SIS edge states: SS, SI, II
+struct SISEdges
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return s + t;
+	}
+};
+
+const edge_state_t SI = 1;
+
+void build(Graph& g, const node_size_t n, const edge_size_t m)
+{
+	Rng rng(1);
+	g.reserve(n, m);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(i % 10 == 0 ? 1 : 0);
+	while (g.numberOfEdges() < m)
+	{
+		const node_id_t s = rng.IntFromTo<node_id_t>(0, n - 1), t = rng.IntFromTo<
+				node_id_t>(0, n - 1);
+		if (s != t)
+			g.addEdge(s, t, false);
+	}
+}
+
+/// adaptive SIS model: infection and rewiring along SI edges, recovery
+double simulate(Graph& g, const unsigned long events,
+		io::JournalListener* journal)
+{
+	const double p = 0.01, r = 0.002, w = 0.01;
+	Rng rng(2);
+	double t = 0;
+	for (unsigned long i = 0; i < events; ++i)
+	{
+		const double si = g.numberOfEdges(SI), inf = g.numberOfNodes(1);
+		const double total = (p + w) * si + r * inf;
+		if (total == 0)
+			break;
+		t -= std::log(1 - rng.Uniform01()) / total;
+		if (journal)
+			journal->setTime(t);
+		const double x = rng.Uniform01() * total;
+		if (x < r * inf)
+			g.setNodeState(g.randomNode(1, rng)->id(), 0);
+		else
+		{
+			const Edge* e = g.randomEdge(SI, rng);
+			const node_id_t s = (g.nodeState(e->source()->id()) == 0) ? e->source()->id()
+					: e->target()->id();
+			if (x < r * inf + p * si)
+				g.setNodeState(s, 1);
+			else
+				g.moveEdgeEndpoint(e->id(), e->opposite(*g.node(s))->id(),
+						g.randomNode(0, rng)->id());
+		}
+	}
+	return t;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 100000);
+	const unsigned long k = bench::arg(argc, argv, 2, 10);
+	const unsigned long events = bench::arg(argc, argv, 3, 2000000);
+
+	double tsim[2], tend = 0;
+	unsigned long changes = 0;
+	std::stringstream journalData;
+	std::string snapshot;
+	for (int i = 0; i < 2; ++i)
+	{
+		Graph g(2, 3);
+		StateConsistencyListener<SISEdges> scl(std::auto_ptr<SISEdges>(
+				new SISEdges));
+		g.addGraphListener(&scl);
+		build(g, n, k * n / 2);
+		std::auto_ptr<io::JournalListener> journal;
+		if (i == 1)
+		{
+			journal.reset(new io::JournalListener(g, journalData));
+			g.addGraphListener(journal.get());
+		}
+		const double t0 = bench::now();
+		tend = simulate(g, events, journal.get());
+		if (i == 1)
+		{
+			journal->flush();
+			changes = journal->numberOfChanges();
+			g.removeGraphListener(journal.get());
+		}
+		tsim[i] = bench::now() - t0;
+		if (i == 0)
+		{
+			std::ostringstream bin;
+			io::BinWriter().write(g, bin);
+			snapshot = bin.str();
+		}
+	}
+
+	Graph h(2, 3);
+	double t0 = bench::now();
+	io::JournalReplayer replay(journalData, h);
+	while (replay.step())
+		;
+	const double treplay = bench::now() - t0;
+	const int seeks = 20;
+	Rng rng(3);
+	t0 = bench::now();
+	for (int i = 0; i < seeks; ++i)
+		replay.seek(rng.Uniform01() * tend);
+	const double tseek = (bench::now() - t0) / seeks;
+
+	const double bytes = journalData.str().size();
+	cout << "# " << n << " nodes of mean degree " << k << ", " << events
+			<< " events, " << changes << " recorded changes\n";
+	cout << fixed << setprecision(1);
+	cout << "simulation              " << setw(10) << 1e9 * tsim[0] / events
+			<< " ns/event\n";
+	cout << "simulation with journal " << setw(10) << 1e9 * tsim[1] / events
+			<< " ns/event\n";
+	cout << "replay                  " << setw(10) << 1e9 * treplay / events
+			<< " ns/event\n";
+	cout << "seek                    " << setw(10) << 1e3 * tseek << " ms\n";
+	cout << "journal                 " << setw(10) << bytes / events
+			<< " bytes/event, " << bytes / (1 << 20) << " MiB\n";
+	cout << "BinWriter snapshot      " << setw(10) << snapshot.size() / double(
+			1 << 20) << " MiB\n";
+	return 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file listener_dispatch.cpp
+ * @date 18.10.2026
+ *
+ * Cost of Graph::setNodeState with edge states kept consistent by a
+ * StateConsistencyListener registered at runtime, compared to a
+ * StaticStateConsistencyListener bound to a BasicGraph.
+ *
+ * Usage: listener-dispatch [nodes] [mean degree] [state changes]
+ */
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+/// SIS-like link states: SS, SI, II
+struct LinkState
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return s + t;
+	}
+};
+
+template<class G>
+void build(G& g, node_size_t n, edge_size_t m)
+{
+	boost::mt19937 rng(42);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode();
+	while (g.numberOfEdges() < m)
+	{
+		const node_id_t s = pick(rng), t = pick(rng);
+		if (s != t)
+			g.addEdge(s, t, false);
+	}
+}
+
+template<class G>
+void run(const string& name, G& g, node_size_t n, unsigned long k)
+{
+	boost::mt19937 rng(7);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < k; ++i)
+	{
+		const node_id_t v = pick(rng);
+		g.setNodeState(v, 1 - g.nodeState(v));
+	}
+	const double t = bench::now() - t0;
+	cout << setw(10) << name << fixed << setprecision(1) << setw(12)
+			<< 1e9 * t / k << setw(12) << g.numberOfEdges(1) << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 100000);
+	const edge_size_t m = n * bench::arg(argc, argv, 2, 10) / 2;
+	const unsigned long k = bench::arg(argc, argv, 3, 5000000);
+
+	cout << "# " << n << " nodes, " << m << " edges, " << k
+			<< " state changes; time per change in ns\n";
+	cout << setw(10) << "listener" << setw(12) << "ns" << setw(12)
+			<< "SI links" << "\n";
+	{
+		Graph g(2, 3);
+		StateConsistencyListener<LinkState> l(
+				auto_ptr<LinkState>(new LinkState));
+		g.addGraphListener(&l);
+		build(g, n, m);
+		run("runtime", g, n, k);
+	}
+	{
+		BasicGraph<CompactNode> g(2, 3);
+		StateConsistencyListener<LinkState> l(
+				auto_ptr<LinkState>(new LinkState));
+		g.addGraphListener(&l);
+		build(g, n, m);
+		run("typed", g, n, k);
+	}
+	{
+		BasicGraph<CompactNode, Edge, GraphElementFactory<CompactNode>,
+				StaticStateConsistencyListener<LinkState> > g(2, 3);
+		build(g, n, m);
+		run("static", g, n, k);
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file memory_usage.cpp
+ * @date 18.10.2026
+ *
+ * Memory footprint of random graphs for each node type, as reported by
+ * Graph::memoryUsage(): bytes per node object, bytes per edge including the
+ * adjacency entries of both end nodes, and bookkeeping bytes per element,
+ * for growing graph sizes.
+ *
+ * Usage: memory-usage [smallest number of nodes] [largest number of nodes] [mean degree]
+ */
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+void build(Graph& g, const node_size_t n, const edge_size_t m)
+{
+	boost::mt19937 rng(1);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	g.reserve(n, m);
+	g.addNodes(n);
+	for (edge_size_t i = 0; i < m; ++i)
+		g.addEdge(pick(rng), pick(rng), false);
+}
+
+void run(const char* name, std::auto_ptr<ElementFactory> f, const node_size_t n,
+		const unsigned long k)
+{
+	Graph g(1, 1);
+	g.setElementFactory(f);
+	build(g, n, k * n / 2);
+	const double t0 = bench::now();
+	const MemoryUsage m = g.memoryUsage();
+	const double t = bench::now() - t0;
+	const double N = g.numberOfNodes(), M = g.numberOfEdges();
+	cout << setw(10) << name << setw(10) << n << fixed << setprecision(1)
+			<< setw(10) << m.nodes / N << setw(10) << (m.edges + m.adjacency)
+			/ M << setw(10) << m.repositories / (N + M) << setw(10)
+			<< m.total() / (1024.0 * 1024.0) << setw(10) << 100.0 * m.unused
+			/ m.total() << setw(10) << 1e3 * t << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t first = bench::arg(argc, argv, 1, 100000);
+	const node_size_t last = bench::arg(argc, argv, 2, 1000000);
+	const unsigned long k = bench::arg(argc, argv, 3, 10);
+
+	cout << "# random graphs of mean degree " << k << "\n";
+	cout << setw(10) << "node" << setw(10) << "nodes" << setw(10) << "B/node"
+			<< setw(10) << "B/edge" << setw(10) << "B/elem" << setw(10) << "MB"
+			<< setw(10) << "unused %" << setw(10) << "ms" << "\n";
+	for (node_size_t n = first; n <= last; n *= 10)
+	{
+		run("single", std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory), n, k);
+		run("multi", std::auto_ptr<ElementFactory>(new MultiEdgeElementFactory), n, k);
+		run("compact", std::auto_ptr<ElementFactory>(
+				new GraphElementFactory<CompactNode> ), n, k);
+		run("indexed", std::auto_ptr<ElementFactory>(new IndexedElementFactory), n, k);
+		run("pooled", std::auto_ptr<ElementFactory>(
+				new PooledElementFactory<CompactNode> ), n, k);
+	}
+	return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file random_neighbor.cpp
+ * @date 18.10.2026
+ *
+ * Cost of selecting a random out-edge of a node, as in voter model updates,
+ * on a star-like graph whose hubs dominate the selection cost: advancing an
+ * edge iterator compared to Node::randomOutEdge, for set-based and
+ * contiguous node storage.
+ *
+ * Usage: random-neighbor [hubs] [hub degree] [selections]
+ */
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+void build(Graph& g, const node_size_t hubs, const degree_t k)
+{
+	g.addNodes(hubs + k);
+	for (node_id_t h = 0; h < hubs; ++h)
+		for (node_id_t i = 0; i < k; ++i)
+			g.addEdge(h, hubs + i, true);
+}
+
+/// select by advancing over the out-edges, as random_from does
+double advance(const Graph& g, const node_size_t hubs, const unsigned long n,
+		edge_id_t& check)
+{
+	Rng rng(1);
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		const Node* h = g.node(rng.IntFromTo<node_id_t>(0, hubs - 1));
+		Node::edge_iterator it = h->outEdges().first;
+		std::advance(it, rng.IntFromTo<degree_t>(0, h->outDegree() - 1));
+		check += (*it)->id();
+	}
+	return bench::now() - t0;
+}
+
+double direct(const Graph& g, const node_size_t hubs, const unsigned long n,
+		edge_id_t& check)
+{
+	Rng rng(1);
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		const Node* h = g.node(rng.IntFromTo<node_id_t>(0, hubs - 1));
+		check += h->randomOutEdge(rng)->id();
+	}
+	return bench::now() - t0;
+}
+
+void run(const char* name, Graph& g, const node_size_t hubs,
+		const degree_t k, const unsigned long n)
+{
+	build(g, hubs, k);
+	edge_id_t a = 0, b = 0;
+	const double ta = advance(g, hubs, n, a), tb = direct(g, hubs, n, b);
+	cout << setw(10) << name << fixed << setprecision(1) << setw(14) << 1e9
+			* ta / n << setw(14) << 1e9 * tb / n << "\n";
+	if (a != b)
+		cout << "# selections differ\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t hubs = bench::arg(argc, argv, 1, 10);
+	const degree_t k = bench::arg(argc, argv, 2, 10000);
+	const unsigned long n = bench::arg(argc, argv, 3, 200000);
+
+	cout << "# " << hubs << " hubs of out-degree " << k << ", " << n
+			<< " selections\n";
+	cout << setw(10) << "node" << setw(14) << "advance ns" << setw(14)
+			<< "random ns" << "\n";
+	Graph single(1, 1);
+	run("single", single, hubs, k, n);
+	Graph compact(1, 1);
+	compact.setElementFactory(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ));
+	run("compact", compact, hubs, k, n);
+	Graph indexed(1, 1);
+	indexed.setElementFactory(std::auto_ptr<ElementFactory>(
+			new IndexedElementFactory));
+	run("indexed", indexed, hubs, k, n);
+	return 0;
+}
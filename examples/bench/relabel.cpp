@@ -0,0 +1,185 @@
+/**
+ * @file relabel.cpp
+ * @date 18.10.2026
+ *
+ * Effect of Graph::relabel() with the orderings of largenet::orderings on
+ * traversal speed: counting triangles, computing neighbor degree
+ * correlations, and sweeps of a discrete-time SIS model on a random
+ * geometric graph whose node IDs, and thus memory layout, carry no
+ * information about the node positions.
+ *
+ * Usage: relabel [number of nodes] [mean degree] [SIS sweeps]
+ */
+
+#include <largenet2.h>
+#include <largenet2/base/orderings.h>
+#include <largenet2/measures/measures.h>
+#include <largenet2/measures/counts.h>
+#include <boost/foreach.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	double Uniform01()
+	{
+		return boost::random::uniform_real_distribution<double>(0, 1)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// random geometric graph in the unit square, nodes in random order
+void build(Graph& g, const node_size_t n, const double k)
+{
+	Rng rng(1);
+	const double r = std::sqrt(k / (M_PI * n));
+	const size_t cells = std::max<size_t>(1, static_cast<size_t> (1 / r));
+	std::vector<double> x(n), y(n);
+	std::vector<std::vector<node_id_t> > grid(cells * cells);
+	g.reserve(n, static_cast<edge_size_t> (k * n / 2 * 1.1));
+	for (node_size_t i = 0; i < n; ++i)
+	{
+		x[i] = rng.Uniform01();
+		y[i] = rng.Uniform01();
+		g.addNode(rng.Uniform01() < 0.1 ? 1 : 0);
+		grid[std::min<size_t>(x[i] * cells, cells - 1) * cells + std::min<
+				size_t>(y[i] * cells, cells - 1)].push_back(i);
+	}
+	for (size_t cx = 0; cx < cells; ++cx)
+		for (size_t cy = 0; cy < cells; ++cy)
+		{
+			const std::vector<node_id_t>& a = grid[cx * cells + cy];
+			for (size_t dx = 0; dx < 2; ++dx)
+				for (int dy = -1; dy < 2; ++dy)
+				{
+					if ((cx + dx >= cells) || (cy + dy >= cells) || (dx == 0
+							&& dy < 0))
+						continue;
+					const std::vector<node_id_t>& b = grid[(cx + dx) * cells
+							+ cy + dy];
+					for (size_t i = 0; i < a.size(); ++i)
+						for (size_t j = (&a == &b) ? i + 1 : 0; j < b.size(); ++j)
+						{
+							const double ddx = x[a[i]] - x[b[j]], ddy = y[a[i]]
+									- y[b[j]];
+							if (ddx * ddx + ddy * ddy < r * r)
+								g.addEdge(a[i], b[j], false);
+						}
+				}
+		}
+}
+
+/// mean ID difference of adjacent nodes
+double spread(const Graph& g)
+{
+	double d = 0;
+	for (Graph::ConstEdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+		d += std::fabs(static_cast<double> (e->source()->id())
+				- static_cast<double> (e->target()->id()));
+	return d / g.numberOfEdges();
+}
+
+/// discrete-time SIS model: infection along edges, then recovery
+void sweep(Graph& g, Rng& rng, std::vector<node_id_t>& infect)
+{
+	const double p = 0.05, r = 0.2;
+	infect.clear();
+	for (Graph::NodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+	{
+		if (g.nodeState(n.id()) == 0)
+			continue;
+		BOOST_FOREACH(const Node& nb, n->undirectedNeighbors())
+		{
+			if ((g.nodeState(nb.id()) == 0) && (rng.Uniform01() < p))
+				infect.push_back(nb.id());
+		}
+		if (rng.Uniform01() < r)
+			g.setNodeState(n.id(), 0);
+	}
+	for (size_t i = 0; i < infect.size(); ++i)
+		g.setNodeState(infect[i], 1);
+}
+
+typedef std::vector<node_id_t> (*Ordering)(const Graph&);
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 500000);
+	const unsigned long k = bench::arg(argc, argv, 2, 10);
+	const unsigned long sweeps = bench::arg(argc, argv, 3, 20);
+
+	Graph original(2, 1);
+	original.setElementFactory(std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<> ));
+	build(original, n, k);
+
+	const char* names[] = { "none", "breadth-first", "reverse Cuthill-McKee",
+			"degree", "communities" };
+	const Ordering orders[] = { 0, orderings::breadthFirst,
+			orderings::reverseCuthillMcKee, orderings::degreeDescending,
+			orderings::communities };
+	double tclone = bench::now();
+	original.clone();
+	tclone = bench::now() - tclone;
+	cout << "# random geometric graph, " << original.numberOfNodes()
+			<< " nodes, " << original.numberOfEdges() << " edges, " << sweeps
+			<< " SIS sweeps; clone() takes " << setprecision(1) << fixed << 1e3
+			* tclone << " ms\n";
+	cout << setw(22) << "ordering" << setw(12) << "relabel/ms" << setw(12)
+			<< "ID spread" << setw(14) << "triangles/ms" << setw(16)
+			<< "correlation/ms" << setw(16) << "SIS ns/node\n";
+	cout << fixed;
+	for (size_t i = 0; i < sizeof(orders) / sizeof(orders[0]); ++i)
+	{
+		std::auto_ptr<Graph> g = original.clone();
+		double t0 = bench::now();
+		if (orders[i])
+			g->relabel(orders[i](*g));
+		const double trelabel = bench::now() - t0;
+
+		t0 = bench::now();
+		const size_t triangles = measures::triangles(*g);
+		const double ttri = bench::now() - t0;
+		t0 = bench::now();
+		const measures::NeighborDegreeCorrelations c =
+				measures::neighborDegreeCorrelations(*g);
+		const double tcorr = bench::now() - t0;
+
+		Rng rng(2);
+		std::vector<node_id_t> infect;
+		t0 = bench::now();
+		for (unsigned long s = 0; s < sweeps; ++s)
+			sweep(*g, rng, infect);
+		const double tsis = bench::now() - t0;
+
+		cout << setw(22) << names[i] << setprecision(1) << setw(12) << 1e3
+				* trelabel << setw(12) << setprecision(0) << spread(*g)
+				<< setprecision(1) << setw(14) << 1e3 * ttri << setw(16) << 1e3
+				* tcorr << setw(15) << 1e9 * tsis / (sweeps * n) << "\n";
+		// keep the results alive
+		if (triangles == 0 && c.r_oo > 2)
+			cout << "";
+	}
+	return 0;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file rewire.cpp
+ * @date 18.10.2026
+ *
+ * Cost of rewiring edges as in adaptive network models, with a
+ * StateConsistencyListener and a NeighborStateCounter registered: removing
+ * the edge and adding a new one compared to moving one of its ends with
+ * Graph::moveEdgeEndpoint, for each node type. The time to select the edge
+ * and its new end is reported separately and not included in the rewiring
+ * times.
+ *
+ * Usage: rewire [number of nodes] [mean degree] [rewiring steps]
+ */
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <largenet2/NeighborStateCounter.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// SIS edge states: SS, SI, II
+struct SISEdges
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return s + t;
+	}
+};
+
+void build(Graph& g, const node_size_t n, const edge_size_t m)
+{
+	Rng rng(1);
+	g.reserve(n, m);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(i % 2);
+	while (g.numberOfEdges() < m)
+		g.addEdge(rng.IntFromTo<node_id_t>(0, n - 1), rng.IntFromTo<node_id_t>(
+				0, n - 1), false);
+}
+
+/// rewire by removing the edge and adding a new one
+double removeAdd(Graph& g, const unsigned long steps)
+{
+	Rng rng(2);
+	const node_id_t last = g.numberOfNodes() - 1;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < steps; ++i)
+	{
+		const Edge* e = g.randomEdge(rng);
+		const node_id_t s = e->source()->id(), n = rng.IntFromTo<node_id_t>(0, last);
+		if (!g.isEdge(s, n))
+		{
+			g.removeEdge(e->id());
+			g.addEdge(s, n, false);
+		}
+	}
+	return bench::now() - t0;
+}
+
+/// only select the edge and the new end, as in the rewiring loops
+double select(Graph& g, const unsigned long steps)
+{
+	Rng rng(2);
+	const node_id_t last = g.numberOfNodes() - 1;
+	node_id_t sum = 0;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < steps; ++i)
+	{
+		const Edge* e = g.randomEdge(rng);
+		sum += e->target()->id() + rng.IntFromTo<node_id_t>(0, last);
+	}
+	const double t = bench::now() - t0;
+	if (sum == 0)
+		cerr << "";
+	return t;
+}
+
+/// rewire in place
+double moveEnd(Graph& g, const unsigned long steps)
+{
+	Rng rng(2);
+	const node_id_t last = g.numberOfNodes() - 1;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < steps; ++i)
+	{
+		const Edge* e = g.randomEdge(rng);
+		g.moveEdgeEndpoint(e->id(), e->target()->id(), rng.IntFromTo<node_id_t>(
+				0, last));
+	}
+	return bench::now() - t0;
+}
+
+void run(const char* name, std::auto_ptr<ElementFactory> f1,
+		std::auto_ptr<ElementFactory> f2, const node_size_t n,
+		const unsigned long k, const unsigned long steps)
+{
+	double t[2], sel = 0;
+	for (int i = 0; i < 2; ++i)
+	{
+		Graph g(2, 3);
+		g.setElementFactory(i == 0 ? f1 : f2);
+		build(g, n, k * n / 2);
+		StateConsistencyListener<SISEdges> scl(std::auto_ptr<SISEdges>(
+				new SISEdges));
+		NeighborStateCounter c(g);
+		g.addGraphListener(&scl);
+		g.addGraphListener(&c);
+		if (i == 0)
+			sel = select(g, steps);
+		t[i] = (i == 0) ? removeAdd(g, steps) : moveEnd(g, steps);
+	}
+	cout << setw(10) << name << fixed << setprecision(1) << setw(12) << 1e9
+			* sel / steps << setw(12) << 1e9 * (t[0] - sel) / steps << setw(12)
+			<< 1e9 * (t[1] - sel) / steps << setw(10) << (t[0] - sel) / (t[1]
+			- sel) << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 100000);
+	const unsigned long k = bench::arg(argc, argv, 2, 10);
+	const unsigned long steps = bench::arg(argc, argv, 3, 2000000);
+
+	cout << "# " << n << " nodes of mean degree " << k << ", " << steps
+			<< " rewiring steps, times in ns per step\n";
+	cout << setw(10) << "node" << setw(12) << "select" << setw(12)
+			<< "remove+add" << setw(12) << "move" << setw(10) << "speedup"
+			<< "\n";
+	run("single", std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory),
+			std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory), n, k,
+			steps);
+	run("compact", std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ), std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ), n, k, steps);
+	run("indexed", std::auto_ptr<ElementFactory>(new IndexedElementFactory),
+			std::auto_ptr<ElementFactory>(new IndexedElementFactory), n, k, steps);
+	run("pooled", std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<CompactNode> ), std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<CompactNode> ), n, k, steps);
+	return 0;
+}
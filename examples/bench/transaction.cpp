@@ -0,0 +1,195 @@
+/**
+ * @file transaction.cpp
+ * @date 18.10.2026
+ *
+ * Cost of degree-preserving edge swaps of which most are rejected, as in
+ * Monte Carlo samplers of network ensembles, with a StateConsistencyListener
+ * and a NeighborStateCounter registered: undoing rejected swaps by hand
+ * through removeEdge and addEdge compared to Graph::rollback, for each node
+ * type.
+ *
+ * Usage: transaction [number of nodes] [mean degree] [proposals] [acceptance %]
+ */
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <largenet2/NeighborStateCounter.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// SIS edge states: SS, SI, II
+struct SISEdges
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return s + t;
+	}
+};
+
+void build(Graph& g, const node_size_t n, const edge_size_t m)
+{
+	Rng rng(1);
+	g.reserve(n, m);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(i % 2);
+	while (g.numberOfEdges() < m)
+	{
+		const node_id_t s = rng.IntFromTo<node_id_t>(0, n - 1), t = rng.IntFromTo<
+				node_id_t>(0, n - 1);
+		if (s != t)
+			g.addEdge(s, t, false);
+	}
+}
+
+/// propose swapping the targets of two random edges, false if the swap
+/// would create a loop or a parallel edge
+bool propose(Graph& g, Rng& rng, node_id_t& a, node_id_t& b, node_id_t& c,
+		node_id_t& d, edge_id_t& e1, edge_id_t& e2)
+{
+	const Edge* x = g.randomEdge(rng);
+	const Edge* y = g.randomEdge(rng);
+	a = x->source()->id();
+	b = x->target()->id();
+	c = y->source()->id();
+	d = y->target()->id();
+	e1 = x->id();
+	e2 = y->id();
+	return (a != d) && (c != b) && (x != y) && !g.isEdge(a, d) && !g.isEdge(c, b);
+}
+
+/// undo rejected swaps by hand
+double manual(Graph& g, const unsigned long steps, const unsigned int acceptance,
+		unsigned long& accepted)
+{
+	Rng rng(2);
+	accepted = 0;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < steps; ++i)
+	{
+		node_id_t a, b, c, d;
+		edge_id_t e1, e2;
+		if (!propose(g, rng, a, b, c, d, e1, e2))
+			continue;
+		g.removeEdge(e1);
+		g.removeEdge(e2);
+		const edge_id_t f1 = g.addEdge(a, d, false), f2 = g.addEdge(c, b, false);
+		if (rng.IntFromTo<unsigned int>(0, 99) < acceptance)
+			++accepted;
+		else
+		{
+			g.removeEdge(f1);
+			g.removeEdge(f2);
+			g.addEdge(a, b, false);
+			g.addEdge(c, d, false);
+		}
+	}
+	return bench::now() - t0;
+}
+
+/// undo rejected swaps by rolling back a transaction
+double transaction(Graph& g, const unsigned long steps,
+		const unsigned int acceptance, unsigned long& accepted)
+{
+	Rng rng(2);
+	accepted = 0;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < steps; ++i)
+	{
+		node_id_t a, b, c, d;
+		edge_id_t e1, e2;
+		if (!propose(g, rng, a, b, c, d, e1, e2))
+			continue;
+		g.beginTransaction();
+		g.removeEdge(e1);
+		g.removeEdge(e2);
+		g.addEdge(a, d, false);
+		g.addEdge(c, b, false);
+		if (rng.IntFromTo<unsigned int>(0, 99) < acceptance)
+		{
+			g.commit();
+			++accepted;
+		}
+		else
+			g.rollback();
+	}
+	return bench::now() - t0;
+}
+
+void run(const char* name, std::auto_ptr<ElementFactory> f1,
+		std::auto_ptr<ElementFactory> f2, const node_size_t n,
+		const unsigned long k, const unsigned long steps,
+		const unsigned int acceptance)
+{
+	double t[2];
+	unsigned long acc[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		Graph g(2, 3);
+		g.setElementFactory(i == 0 ? f1 : f2);
+		build(g, n, k * n / 2);
+		StateConsistencyListener<SISEdges> scl(std::auto_ptr<SISEdges>(
+				new SISEdges));
+		NeighborStateCounter c(g);
+		g.addGraphListener(&scl);
+		g.addGraphListener(&c);
+		t[i] = (i == 0) ? manual(g, steps, acceptance, acc[i]) : transaction(g,
+				steps, acceptance, acc[i]);
+	}
+	cout << setw(10) << name << fixed << setprecision(1) << setw(10) << 100.0
+			* acc[1] / steps << setw(12) << 1e9 * t[0] / steps << setw(12) << 1e9
+			* t[1] / steps << setw(10) << t[0] / t[1] << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 100000);
+	const unsigned long k = bench::arg(argc, argv, 2, 10);
+	const unsigned long steps = bench::arg(argc, argv, 3, 2000000);
+	const unsigned int acceptance = bench::arg(argc, argv, 4, 5);
+
+	cout << "# " << n << " nodes of mean degree " << k << ", " << steps
+			<< " proposals, times in ns per proposal\n";
+	cout << setw(10) << "node" << setw(10) << "accept %" << setw(12) << "manual"
+			<< setw(12) << "rollback" << setw(10) << "speedup" << "\n";
+	run("single", std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory),
+			std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory), n, k,
+			steps, acceptance);
+	run("compact", std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ), std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ), n, k, steps, acceptance);
+	run("indexed", std::auto_ptr<ElementFactory>(new IndexedElementFactory),
+			std::auto_ptr<ElementFactory>(new IndexedElementFactory), n, k, steps,
+			acceptance);
+	run("pooled", std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<CompactNode> ), std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<CompactNode> ), n, k, steps, acceptance);
+	return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file try_add_edge.cpp
+ * @date 18.10.2026
+ *
+ * Cost of adding edges between random node pairs of a dense graph, where
+ * most pairs are connected already, as in rewiring loops: rejecting
+ * duplicates by catching the exception thrown when the edge is registered
+ * with its nodes, compared to Graph::tryAddEdge, and looking up edges through
+ * the throwing Node::undirectedEdgeTo compared to Graph::findEdge, for each
+ * node type.
+ *
+ * Usage: try-add-edge [number of nodes] [mean degree] [attempts]
+ */
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include "bench.h"
+
+using namespace std;
+using namespace largenet;
+
+namespace
+{
+
+void build(Graph& g, const node_size_t n, const edge_size_t m)
+{
+	boost::mt19937 rng(1);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	g.addNodes(n);
+	while (g.numberOfEdges() < m)
+	{
+		const node_id_t s = pick(rng), t = pick(rng);
+		if (s != t)
+			g.addEdge(s, t, false);
+	}
+}
+
+/// reject duplicates by catching the exception of a checked registration
+double throwing(Graph& g, const unsigned long n, unsigned long& dup)
+{
+	boost::mt19937 rng(2);
+	boost::random::uniform_int_distribution<node_id_t> pick(0,
+			g.numberOfNodes() - 1);
+	dup = 0;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		const node_id_t s = pick(rng), t = pick(rng);
+		try
+		{
+			delete Edge::create(g.numberOfEdges(), *g.node(s), *g.node(t), false);
+		} catch (SingletonException&)
+		{
+			++dup;
+		}
+	}
+	return bench::now() - t0;
+}
+
+/// reject duplicates by looking for them first
+double nonThrowing(Graph& g, const unsigned long n, unsigned long& dup)
+{
+	boost::mt19937 rng(2);
+	boost::random::uniform_int_distribution<node_id_t> pick(0,
+			g.numberOfNodes() - 1);
+	dup = 0;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		const std::pair<edge_id_t, bool> e = g.tryAddEdge(pick(rng), pick(rng),
+				false);
+		if (e.second)
+			g.removeEdge(e.first);
+		else
+			++dup;
+	}
+	return bench::now() - t0;
+}
+
+double throwingLookup(const Graph& g, const unsigned long n, unsigned long& found)
+{
+	boost::mt19937 rng(3);
+	boost::random::uniform_int_distribution<node_id_t> pick(0,
+			g.numberOfNodes() - 1);
+	found = 0;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		const node_id_t s = pick(rng), t = pick(rng);
+		try
+		{
+			g.node(s)->undirectedEdgeTo(g.node(t));
+			++found;
+		} catch (NotAdjacentException&)
+		{
+		}
+	}
+	return bench::now() - t0;
+}
+
+double findLookup(const Graph& g, const unsigned long n, unsigned long& found)
+{
+	boost::mt19937 rng(3);
+	boost::random::uniform_int_distribution<node_id_t> pick(0,
+			g.numberOfNodes() - 1);
+	found = 0;
+	const double t0 = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		if (g.findEdge(pick(rng), pick(rng), false) != 0)
+			++found;
+	}
+	return bench::now() - t0;
+}
+
+void run(const char* name, std::auto_ptr<ElementFactory> f, const node_size_t n,
+		const unsigned long k, const unsigned long attempts)
+{
+	Graph g(1, 1);
+	g.setElementFactory(f);
+	build(g, n, k * n / 2);
+	unsigned long d1 = 0, d2 = 0, f1 = 0, f2 = 0;
+	const double t1 = throwing(g, attempts, d1);
+	const double t2 = nonThrowing(g, attempts, d2);
+	const double t3 = throwingLookup(g, attempts, f1);
+	const double t4 = findLookup(g, attempts, f2);
+	if ((d1 != d2) || (f1 != f2))
+		cerr << "results differ for " << name << "\n";
+	cout << setw(10) << name << fixed << setprecision(1) << setw(10) << 100.0
+			* d2 / attempts << setw(12) << 1e9 * t1 / attempts << setw(12) << 1e9
+			* t2 / attempts << setw(12) << 1e9 * t3 / attempts << setw(12) << 1e9
+			* t4 / attempts << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	const node_size_t n = bench::arg(argc, argv, 1, 200);
+	const unsigned long k = bench::arg(argc, argv, 2, 150);
+	const unsigned long attempts = bench::arg(argc, argv, 3, 1000000);
+
+	cout << "# " << n << " nodes of mean degree " << k << ", " << attempts
+			<< " attempts, times in ns per attempt\n";
+	cout << setw(10) << "node" << setw(10) << "dup %" << setw(12) << "catch"
+			<< setw(12) << "tryAddEdge" << setw(12) << "edgeTo" << setw(12)
+			<< "findEdge" << "\n";
+	run("single", std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory), n,
+			k, attempts);
+	run("compact", std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ), n, k, attempts);
+	run("indexed", std::auto_ptr<ElementFactory>(new IndexedElementFactory), n,
+			k, attempts);
+	return 0;
+}
@@ -35,6 +35,11 @@ U& random_from(V& container, RandomGen& rnd)
  * @param end iterator pointing to (past the) end of range
  * @param rnd random number generator
  * @return random iterator within range or @p end if empty range
+ *
+ * This takes constant time for random access iterators, such as the
+ * per-state node and edge iterators of a Graph and those of its denseNodes()
+ * and denseEdges(). The iterators of nodes() and edges() are bidirectional,
+ * for which this takes time linear in the length of the range.
  */
 template<class _Iter, class RandomGen>
 _Iter random_from(_Iter begin, _Iter end, RandomGen& rnd)
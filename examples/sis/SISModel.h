@@ -163,11 +163,11 @@ private:
 		largenet::Graph::EdgeStateIterator e = myrng::util::random_from(
 				net_.edges(SI), rng_);
 
+		const largenet::edge_id_t eid = e.id();
 		largenet::Node* n =
 				(net_.nodeState(e->source()->id()) == S) ?
 						e->source() : e->target();
-		net_.removeEdge(e->id());
-		largenet::edge_size_t old_edges = net_.numberOfEdges();
+		const largenet::node_id_t infected = e->opposite(*n)->id();
 		unsigned int tries = 0;
 		const unsigned int max_tries = net_.numberOfNodes(S);
 		largenet::Graph::NodeStateIterator n2 = myrng::util::random_from(
@@ -181,17 +181,14 @@ private:
 				continue;
 			}
 
-			net_.addEdge(n->id(), n2.id(), false);	// undirected edge
-
-			if (net_.numberOfEdges() == old_edges) // could not add edge (already in graph)
-			{
-				n2 = myrng::util::random_from(net_.nodes(S), rng_);
-				++tries;
-				continue;
-			}
-			else
-				break;
+			// move the infected end, fails if the edge is already in graph
+			if (net_.moveEdgeEndpoint(eid, infected, n2.id()))
+				return;
+			n2 = myrng::util::random_from(net_.nodes(S), rng_);
+			++tries;
 		}
+		// no susceptible node to connect to, so the edge is cut
+		net_.removeEdge(eid);
 	}
 
 private:
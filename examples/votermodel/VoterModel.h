@@ -7,7 +7,6 @@
 #ifndef VOTERMODEL_H_
 #define VOTERMODEL_H_
 
-#include "../lib/util.h"
 #include <largenet2.h>
 
 /**
@@ -117,15 +116,12 @@ public:
 		// nodes, this throws an exception.
 		largenet::Node* n1 = net_.randomNode(rng);
 
-		// Get a random out-going edge of the node. For convenience,
-		// we use the helper function random_from() defined in util.h,
-		// which returns a Node::edge_iterator object.
-		largenet::Node::edge_iterator ei = myrng::util::random_from(n1->outEdges(), rng);
-		if (ei == n1->outEdges().second)
-			return tau; // do nothing if the node has no neighbors
+		// do nothing if the node has no neighbors
+		if (n1->outDegree() == 0)
+			return tau;
 
-		// Get the actual edge
-		largenet::Edge* e = *ei;
+		// Get a random out-going edge of the node
+		largenet::Edge* e = n1->randomOutEdge(rng);
 
 		// Do nothing if the nodes share the same state
 		if (net_.nodeState(e->source()->id())
@@ -159,8 +155,6 @@ private:
 		if (net_.numberOfNodes(s) == 1)
 			return;
 
-		largenet::edge_size_t old_edges = net_.numberOfEdges();
-
 		// try only so often to rewire a link
 		largenet::node_size_t tries = 0;
 		const largenet::node_size_t max_tries = net_.numberOfNodes(s);
@@ -175,18 +169,10 @@ private:
 				continue;
 			}
 
-			net_.addEdge(e->source()->id(), n->id(), true);
-
-			if (net_.numberOfEdges() == old_edges) // could not add edge (already in graph)
-			{
-				++tries;
-				continue;
-			}
-			else
-			{
-				net_.removeEdge(e->id());
+			// keeps the edge ID, fails if the edge is already in graph
+			if (net_.moveEdgeEndpoint(e->id(), e->target()->id(), n->id()))
 				return;
-			}
+			++tries;
 		}
 	}
 
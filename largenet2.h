@@ -20,6 +20,9 @@
 #include <largenet2/base/exceptions.h>
 #include <largenet2/base/factories.h>
 #include <largenet2/base/Graph.h>
+#include <largenet2/base/BasicGraph.h>
 #include <largenet2/base/GraphListener.h>
+#include <largenet2/base/properties.h>
+#include <largenet2/base/parallel.h>
 
 #endif /* LARGENET2_H_ */
@@ -0,0 +1,115 @@
+#include "NeighborStateCounter.h"
+#include <largenet2/base/Graph.h>
+#include <algorithm>
+#include <limits>
+
+namespace largenet
+{
+
+NeighborStateCounter::NeighborStateCounter(const Graph& g) :
+	states_(0)
+{
+	reset(g);
+}
+
+void NeighborStateCounter::reset(const Graph& g)
+{
+	states_ = g.numberOfNodeStates();
+	counts_.clear();
+	for (Graph::ConstNodeIterator it = g.nodes().first; it != g.nodes().second; ++it)
+		clearNode(it.id());
+	for (Graph::ConstEdgeIterator it = g.edges().first; it != g.edges().second; ++it)
+		count(g, *it, 1);
+}
+
+void NeighborStateCounter::clearNode(const node_id_t n)
+{
+	const size_t first = index(n, OUT, 0), last = index(n + 1, OUT, 0);
+	if (counts_.size() < last)
+		counts_.resize(std::max(last, 2 * counts_.size()), 0);
+	std::fill(counts_.begin() + first, counts_.begin() + last, 0);
+}
+
+void NeighborStateCounter::count(const Graph& g, const Edge& e, const int delta)
+{
+	const node_id_t s = e.source()->id(), t = e.target()->id();
+	const node_state_t ss = g.nodeState(s), ts = g.nodeState(t);
+	if (e.isDirected())
+	{
+		at(s, OUT, ts) += delta;
+		at(t, IN, ss) += delta;
+	}
+	else
+	{
+		at(s, UNDIRECTED, ts) += delta;
+		if (!e.isLoop())
+			at(t, UNDIRECTED, ss) += delta;
+	}
+}
+
+void NeighborStateCounter::afterNodeAddEvent(Graph& g, Node& n)
+{
+	clearNode(n.id());
+}
+
+void NeighborStateCounter::afterEdgeAddEvent(Graph& g, Edge& e)
+{
+	count(g, e, 1);
+}
+
+void NeighborStateCounter::beforeEdgeRemoveEvent(Graph& g, Edge& e)
+{
+	count(g, e, -1);
+}
+
+void NeighborStateCounter::beforeGraphClearEvent(Graph& g)
+{
+	counts_.clear();
+}
+
+void NeighborStateCounter::afterGraphCompactEvent(Graph& g,
+		const std::vector<node_id_t>& nodeIds,
+		const std::vector<edge_id_t>& edgeIds)
+{
+	// the new IDs may be in any order (@see Graph::relabel)
+	const size_t row = DIRECTIONS * states_;
+	std::vector<degree_t> counts(index(g.numberOfNodes(), OUT, 0), 0);
+	for (node_id_t i = 0; i < nodeIds.size(); ++i)
+	{
+		if (nodeIds[i] == std::numeric_limits<node_id_t>::max())
+			continue;
+		std::copy(counts_.begin() + index(i, OUT, 0), counts_.begin()
+				+ index(i, OUT, 0) + row, counts.begin() + index(nodeIds[i],
+				OUT, 0));
+	}
+	counts_.swap(counts);
+}
+
+void NeighborStateCounter::afterNodeStateChangeEvent(Graph& g, Node& n,
+		const node_state_t oldState, const node_state_t newState)
+{
+	Node::edge_iterator_range out = n.outEdges();
+	for (Node::edge_iterator it = out.first; it != out.second; ++it)
+	{
+		const node_id_t t = (*it)->target()->id();
+		--at(t, IN, oldState);
+		++at(t, IN, newState);
+	}
+	Node::edge_iterator_range in = n.inEdges();
+	for (Node::edge_iterator it = in.first; it != in.second; ++it)
+	{
+		const node_id_t s = (*it)->source()->id();
+		--at(s, OUT, oldState);
+		++at(s, OUT, newState);
+	}
+	Node::edge_iterator_range un = n.undirectedEdges();
+	for (Node::edge_iterator it = un.first; it != un.second; ++it)
+	{
+		const node_id_t m = ((*it)->source() == &n) ? (*it)->target()->id()
+				: (*it)->source()->id();
+		--at(m, UNDIRECTED, oldState);
+		++at(m, UNDIRECTED, newState);
+	}
+}
+
+}
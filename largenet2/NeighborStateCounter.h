@@ -0,0 +1,125 @@
+/**
+ * @file NeighborStateCounter.h
+ * @date 18.10.2026
+ */
+
+#ifndef NEIGHBORSTATECOUNTER_H_
+#define NEIGHBORSTATECOUNTER_H_
+
+#include <largenet2/base/types.h>
+#include <largenet2/base/GraphListener.h>
+#include <vector>
+#include <cassert>
+
+namespace largenet
+{
+
+class Graph;
+
+/**
+ * Count the neighbors of each node by node state.
+ *
+ * This graph listener keeps, for every node, the number of its out-, in-,
+ * and undirected neighbors in each node state. Changing the state of a node
+ * updates the counts of its neighbors in O(degree) steps, adding or removing
+ * an edge updates them in constant time, and all queries take constant time.
+ * This is useful for models whose rates depend on the states of a node's
+ * neighbors, such as threshold or majority rule models.
+ *
+ * Neighbors are counted per edge, i.e. a neighbor connected by two edges
+ * counts twice. An undirected loop counts once.
+ *
+ * The counter takes the initial counts from the graph it is constructed
+ * with and must then be registered with that graph
+ * (@see Graph::addGraphListener).
+ */
+class NeighborStateCounter: public GraphListener
+{
+public:
+	/**
+	 * Count neighbor states in @p g.
+	 */
+	explicit NeighborStateCounter(const Graph& g);
+
+	/**
+	 * Count neighbor states in @p g again, from scratch.
+	 */
+	void reset(const Graph& g);
+
+	size_t memoryUsage() const
+	{
+		return counts_.capacity() * sizeof(degree_t);
+	}
+
+	/**
+	 * Number of nodes in state @p s that node @p n has an edge to
+	 */
+	degree_t outNeighbors(node_id_t n, node_state_t s) const
+	{
+		return at(n, OUT, s);
+	}
+	/**
+	 * Number of nodes in state @p s that have an edge to node @p n
+	 */
+	degree_t inNeighbors(node_id_t n, node_state_t s) const
+	{
+		return at(n, IN, s);
+	}
+	/**
+	 * Number of nodes in state @p s that node @p n shares an undirected edge with
+	 */
+	degree_t undirectedNeighbors(node_id_t n, node_state_t s) const
+	{
+		return at(n, UNDIRECTED, s);
+	}
+	/**
+	 * Number of neighbors of node @p n in state @p s, for all edge directions
+	 */
+	degree_t neighbors(node_id_t n, node_state_t s) const
+	{
+		return at(n, OUT, s) + at(n, IN, s) + at(n, UNDIRECTED, s);
+	}
+
+private:
+	enum Direction
+	{
+		OUT, IN, UNDIRECTED, DIRECTIONS
+	};
+
+	degree_t at(node_id_t n, Direction d, node_state_t s) const
+	{
+		assert(s < states_);
+		assert(index(n, d, s) < counts_.size());
+		return counts_[index(n, d, s)];
+	}
+	degree_t& at(node_id_t n, Direction d, node_state_t s)
+	{
+		assert(s < states_);
+		assert(index(n, d, s) < counts_.size());
+		return counts_[index(n, d, s)];
+	}
+	size_t index(node_id_t n, Direction d, node_state_t s) const
+	{
+		return (static_cast<size_t> (n) * DIRECTIONS + d) * states_ + s;
+	}
+	/// make room for the counts of node @p n and set them to zero
+	void clearNode(node_id_t n);
+	/// add @p delta to the counts of both end nodes of @p e
+	void count(const Graph& g, const Edge& e, int delta);
+
+	void afterNodeAddEvent(Graph& g, Node& n);
+	void afterEdgeAddEvent(Graph& g, Edge& e);
+	void beforeEdgeRemoveEvent(Graph& g, Edge& e);
+	void beforeGraphClearEvent(Graph& g);
+	void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds);
+	void afterNodeStateChangeEvent(Graph& g, Node& n, node_state_t oldState,
+			node_state_t newState);
+
+	node_state_size_t states_;
+	std::vector<degree_t> counts_; ///< counts by node, direction, and state
+};
+
+}
+
+#endif /* NEIGHBORSTATECOUNTER_H_ */
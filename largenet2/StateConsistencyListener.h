@@ -9,7 +9,10 @@
 
 #include <largenet2.h>
 #include <largenet2/base/GraphListener.h>
+#include <largenet2/base/StaticGraphListener.h>
+#include <largenet2/base/node_traits.h>
 #include <memory>
+#include <vector>
 
 namespace largenet {
 
@@ -20,6 +23,12 @@ namespace largenet {
  * edges whenever a node changes its state. The edge states are
  * computed using a user-supplied edge state calculator.
  *
+ * On a node state change, the new edge states are computed from the node's
+ * new state and the states of its neighbors in a single pass over its edges,
+ * and applied with one call to Graph::setEdgeStates(), so that other
+ * listeners receive one afterEdgeStatesChange notification per node state
+ * change instead of one notification per edge.
+ *
  * @tparam EdgeStateCalculator Functor computing an appropriate
  * 		   edge state from given source and target node states.
  */
@@ -48,30 +57,153 @@ public:
 	 * @return edge state calculator
 	 */
 	EdgeStateCalculator& edgeStateCalculator() const { return *lsc_; }
+	size_t memoryUsage() const
+	{
+		return edges_.capacity() * sizeof(largenet::edge_id_t)
+				+ states_.capacity() * sizeof(largenet::edge_state_t);
+	}
 private:
 	virtual void afterEdgeAddEvent(largenet::Graph& g, largenet::Edge& e)
 	{
 		g.setEdgeState(e.id(), (*lsc_)(g.nodeState(e.source()->id()),
 				g.nodeState(e.target()->id())));
 	}
+	virtual void afterEdgeRewireEvent(largenet::Graph& g, largenet::Edge& e,
+			largenet::Node& oldSource, largenet::Node& oldTarget)
+	{
+		// only this edge's end nodes have changed
+		afterEdgeAddEvent(g, e);
+	}
+	virtual void afterEdgesAddEvent(largenet::Graph& g,
+			const std::vector<largenet::edge_id_t>& edges)
+	{
+		std::vector<largenet::edge_state_t> states;
+		states.swap(states_);
+		states.clear();
+		for (std::vector<largenet::edge_id_t>::const_iterator it = edges.begin(); it
+				!= edges.end(); ++it)
+		{
+			const largenet::Edge* e = g.edge(*it);
+			states.push_back((*lsc_)(g.nodeState(e->source()->id()),
+					g.nodeState(e->target()->id())));
+		}
+		g.setEdgeStates(edges, states);
+		states_.swap(states);
+	}
 	virtual void afterNodeStateChangeEvent(largenet::Graph& g,
 			largenet::Node& n, largenet::node_state_t oldState,
 			largenet::node_state_t newState)
 	{
-		largenet::Node::edge_iterator_range out = n.outEdges();
+		// take the buffers out of the members, as listeners notified by
+		// setEdgeStates() may change further node states and re-enter here
+		std::vector<largenet::edge_id_t> edges;
+		std::vector<largenet::edge_state_t> states;
+		edges.swap(edges_);
+		states.swap(states_);
+		edges.clear();
+		states.clear();
+		const largenet::Node::edge_iterator_range out = n.outEdges();
 		for (largenet::Node::edge_iterator it = out.first; it != out.second; ++it)
-			g.setEdgeState((*it)->id(), (*lsc_)(g.nodeState((*it)->source()->id()),
-					g.nodeState((*it)->target()->id())));
-		largenet::Node::edge_iterator_range in = n.inEdges();
+		{
+			edges.push_back((*it)->id());
+			states.push_back((*lsc_)(newState, g.nodeState(
+					(*it)->target()->id())));
+		}
+		const largenet::Node::edge_iterator_range in = n.inEdges();
 		for (largenet::Node::edge_iterator it = in.first; it != in.second; ++it)
-			g.setEdgeState((*it)->id(), (*lsc_)(g.nodeState((*it)->source()->id()),
-					g.nodeState((*it)->target()->id())));
-		largenet::Node::edge_iterator_range un = n.undirectedEdges();
+		{
+			edges.push_back((*it)->id());
+			states.push_back((*lsc_)(g.nodeState((*it)->source()->id()),
+					newState));
+		}
+		const largenet::Node::edge_iterator_range un = n.undirectedEdges();
 		for (largenet::Node::edge_iterator it = un.first; it != un.second; ++it)
-			g.setEdgeState((*it)->id(), (*lsc_)(g.nodeState((*it)->source()->id()),
-					g.nodeState((*it)->target()->id())));
+		{
+			edges.push_back((*it)->id());
+			if ((*it)->source() == &n)
+				states.push_back((*lsc_)(newState, g.nodeState(
+						(*it)->target()->id())));
+			else
+				states.push_back((*lsc_)(g.nodeState((*it)->source()->id()),
+						newState));
+		}
+		g.setEdgeStates(edges, states);
+		edges_.swap(edges);
+		states_.swap(states);
 	}
 	std::auto_ptr<EdgeStateCalculator> lsc_;
+	/// buffers for the edges to update and their new states, reused across
+	/// calls and taken out of here while in use
+	std::vector<largenet::edge_id_t> edges_;
+	std::vector<largenet::edge_state_t> states_;
+};
+
+/**
+ * Ensure edge states that are consistent with node states.
+ *
+ * Static listener version of StateConsistencyListener, to be bound to a
+ * BasicGraph (@see StaticGraphListener). Adjacent edges are iterated
+ * through node_traits, so for a BasicGraph the whole update is statically
+ * dispatched.
+ *
+ * @tparam EdgeStateCalculator Functor computing an appropriate
+ * 		   edge state from given source and target node states.
+ */
+template<class EdgeStateCalculator>
+class StaticStateConsistencyListener: public largenet::StaticGraphListener
+{
+public:
+	StaticStateConsistencyListener(const EdgeStateCalculator& lsc =
+			EdgeStateCalculator()) :
+		lsc_(lsc)
+	{
+	}
+	/**
+	 * Get the edge state calculator object used by the listener
+	 * @return edge state calculator
+	 */
+	EdgeStateCalculator& edgeStateCalculator() { return lsc_; }
+	const EdgeStateCalculator& edgeStateCalculator() const { return lsc_; }
+
+	template<class G, class E> void afterEdgeAdd(G& g, E& e)
+	{
+		update(g, e);
+	}
+	template<class G, class E, class N> void afterEdgeRewire(G& g, E& e,
+			N& oldSource, N& oldTarget)
+	{
+		update(g, e);
+	}
+	template<class G, class N> void afterNodeStateChange(G& g, N& n,
+			largenet::node_state_t oldState, largenet::node_state_t newState)
+	{
+		typedef largenet::node_traits<N> traits;
+		const largenet::Node::edge_iterator_range out = traits::outEdges(n);
+		for (largenet::Node::edge_iterator it = out.first; it != out.second; ++it)
+			g.setEdgeState((*it)->id(), lsc_(newState, g.nodeState(
+					(*it)->target()->id())));
+		const largenet::Node::edge_iterator_range in = traits::inEdges(n);
+		for (largenet::Node::edge_iterator it = in.first; it != in.second; ++it)
+			g.setEdgeState((*it)->id(), lsc_(g.nodeState((*it)->source()->id()),
+					newState));
+		const largenet::Node::edge_iterator_range un = traits::undirectedEdges(n);
+		for (largenet::Node::edge_iterator it = un.first; it != un.second; ++it)
+		{
+			if ((*it)->source() == &n)
+				g.setEdgeState((*it)->id(), lsc_(newState, g.nodeState(
+						(*it)->target()->id())));
+			else
+				g.setEdgeState((*it)->id(), lsc_(g.nodeState(
+						(*it)->source()->id()), newState));
+		}
+	}
+private:
+	template<class G, class E> void update(G& g, const E& e)
+	{
+		g.setEdgeState(e.id(), lsc_(g.nodeState(e.source()->id()),
+				g.nodeState(e.target()->id())));
+	}
+	EdgeStateCalculator lsc_;
 };
 }
 #endif /* STATECONSISTENCYLISTENER_H_ */
@@ -0,0 +1,217 @@
+#include "WeightedSampler.h"
+#include <largenet2/base/Graph.h>
+
+namespace largenet
+{
+
+NodeSampler::NodeSampler(const Graph& g, const Weight w, const double offset) :
+	kind_(w), offset_(offset)
+{
+	if (offset < 0)
+		throw(std::invalid_argument("Node weights must not be negative."));
+	reset(g);
+}
+
+void NodeSampler::reset(const Graph& g)
+{
+	index_.reset(g.numberOfNodeStates());
+	removing_.clear();
+	removed_.clear();
+	for (Graph::ConstNodeIterator it = g.nodes().first; it != g.nodes().second; ++it)
+	{
+		if (it.id() >= removing_.size())
+			removing_.resize(it.id() + 1, false);
+		index_.add(it.id(), g.nodeState(it.id()), degreeWeight(*it, 0, 0, 0));
+	}
+}
+
+void NodeSampler::setWeight(const node_id_t n, const double w)
+{
+	if (kind_ != CUSTOM)
+		throw(std::invalid_argument("Cannot set node weights that follow degrees."));
+	if (w < 0)
+		throw(std::invalid_argument("Node weights must not be negative."));
+	index_.set(n, w);
+}
+
+double NodeSampler::degreeWeight(const Node& n, const degree_t inDelta,
+		const degree_t outDelta, const degree_t unDelta) const
+{
+	switch (kind_)
+	{
+	case DEGREE:
+		return offset_ + (n.degree() - inDelta - outDelta - unDelta);
+	case IN_DEGREE:
+		return offset_ + (n.inDegree() - inDelta);
+	case OUT_DEGREE:
+		return offset_ + (n.outDegree() - outDelta);
+	default:
+		return offset_;
+	}
+}
+
+void NodeSampler::update(const Node& n, const degree_t inDelta,
+		const degree_t outDelta, const degree_t unDelta)
+{
+	if ((kind_ == CUSTOM) || removing_[n.id()])
+		return;
+	index_.set(n.id(), degreeWeight(n, inDelta, outDelta, unDelta));
+}
+
+void NodeSampler::afterNodeAddEvent(Graph& g, Node& n)
+{
+	if (n.id() >= removing_.size())
+		removing_.resize(std::max<size_t>(n.id() + 1, 2 * removing_.size()),
+				false);
+	removing_[n.id()] = false;
+	index_.add(n.id(), g.nodeState(n.id()), degreeWeight(n, 0, 0, 0));
+}
+
+void NodeSampler::afterEdgeAddEvent(Graph& g, Edge& e)
+{
+	update(*e.source(), 0, 0, 0);
+	if (!e.isLoop())
+		update(*e.target(), 0, 0, 0);
+}
+
+void NodeSampler::beforeNodeRemoveEvent(Graph& g, Node& n)
+{
+	// its edges are removed next, which must not change its weight again
+	removing_[n.id()] = true;
+	// keep a custom weight in case the removal is rolled back
+	if ((kind_ == CUSTOM) && g.inTransaction())
+		removed_.push_back(std::make_pair(n.id(), index_.weight(n.id())));
+	index_.remove(n.id());
+}
+
+void NodeSampler::afterNodeRestoreEvent(Graph& g, Node& n)
+{
+	afterNodeAddEvent(g, n);
+	// nodes are restored in reverse order of their removal
+	if (!removed_.empty() && (removed_.back().first == n.id()))
+	{
+		index_.set(n.id(), removed_.back().second);
+		removed_.pop_back();
+	}
+}
+
+void NodeSampler::afterTransactionCommitEvent(Graph& g)
+{
+	removed_.clear();
+}
+
+void NodeSampler::beforeEdgeRemoveEvent(Graph& g, Edge& e)
+{
+	// the edge is still registered with its nodes
+	if (e.isDirected())
+	{
+		if (e.isLoop())
+			update(*e.source(), 1, 1, 0);
+		else
+		{
+			update(*e.source(), 0, 1, 0);
+			update(*e.target(), 1, 0, 0);
+		}
+	}
+	else
+	{
+		update(*e.source(), 0, 0, 1);
+		if (!e.isLoop())
+			update(*e.target(), 0, 0, 1);
+	}
+}
+
+void NodeSampler::beforeGraphClearEvent(Graph& g)
+{
+	index_.clear();
+	removing_.clear();
+	removed_.clear();
+}
+
+void NodeSampler::afterGraphCompactEvent(Graph& g,
+		const std::vector<node_id_t>& nodeIds,
+		const std::vector<edge_id_t>& edgeIds)
+{
+	index_.compact(nodeIds);
+	removing_.assign(g.numberOfNodes(), false);
+}
+
+void NodeSampler::afterNodeStateChangeEvent(Graph& g, Node& n,
+		const node_state_t oldState, const node_state_t newState)
+{
+	index_.move(n.id(), newState);
+}
+
+EdgeSampler::EdgeSampler(const Graph& g, const double def) :
+	default_(def)
+{
+	if (def < 0)
+		throw(std::invalid_argument("Edge weights must not be negative."));
+	reset(g);
+}
+
+void EdgeSampler::reset(const Graph& g)
+{
+	index_.reset(g.numberOfEdgeStates());
+	removed_.clear();
+	for (Graph::ConstEdgeIterator it = g.edges().first; it != g.edges().second; ++it)
+		index_.add(it.id(), g.edgeState(it.id()), default_);
+}
+
+void EdgeSampler::setWeight(const edge_id_t e, const double w)
+{
+	if (w < 0)
+		throw(std::invalid_argument("Edge weights must not be negative."));
+	index_.set(e, w);
+}
+
+void EdgeSampler::afterEdgeAddEvent(Graph& g, Edge& e)
+{
+	index_.add(e.id(), g.edgeState(e.id()), default_);
+}
+
+void EdgeSampler::beforeEdgeRemoveEvent(Graph& g, Edge& e)
+{
+	// keep the weight in case the removal is rolled back
+	if (g.inTransaction())
+		removed_.push_back(std::make_pair(e.id(), index_.weight(e.id())));
+	index_.remove(e.id());
+}
+
+void EdgeSampler::afterEdgeRestoreEvent(Graph& g, Edge& e)
+{
+	double w = default_;
+	// edges are restored in reverse order of their removal
+	if (!removed_.empty() && (removed_.back().first == e.id()))
+	{
+		w = removed_.back().second;
+		removed_.pop_back();
+	}
+	index_.add(e.id(), g.edgeState(e.id()), w);
+}
+
+void EdgeSampler::afterTransactionCommitEvent(Graph& g)
+{
+	removed_.clear();
+}
+
+void EdgeSampler::beforeGraphClearEvent(Graph& g)
+{
+	index_.clear();
+	removed_.clear();
+}
+
+void EdgeSampler::afterGraphCompactEvent(Graph& g,
+		const std::vector<node_id_t>& nodeIds,
+		const std::vector<edge_id_t>& edgeIds)
+{
+	index_.compact(edgeIds);
+}
+
+void EdgeSampler::afterEdgeStateChangeEvent(Graph& g, Edge& e,
+		const edge_state_t oldState, const edge_state_t newState)
+{
+	index_.move(e.id(), newState);
+}
+
+}
@@ -0,0 +1,397 @@
+/**
+ * @file WeightedSampler.h
+ * @date 18.10.2026
+ */
+
+#ifndef WEIGHTEDSAMPLER_H_
+#define WEIGHTEDSAMPLER_H_
+
+#include <largenet2/base/types.h>
+#include <largenet2/base/GraphListener.h>
+#include <largenet2/util/SumTree.h>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <cassert>
+
+namespace largenet
+{
+
+class Graph;
+
+/// @cond IGNORE
+namespace detail
+{
+/**
+ * Weights of elements by ID, with one sum tree per element state
+ */
+template<class Id, class State>
+class WeightIndex
+{
+public:
+	void reset(const size_t states)
+	{
+		trees_.assign(states, SumTree());
+		states_.clear();
+	}
+	size_t numberOfStates() const
+	{
+		return trees_.size();
+	}
+	/// add element @p i in state @p s with weight @p w
+	void add(const Id i, const State s, const double w)
+	{
+		assert(s < trees_.size());
+		if (i >= states_.size())
+			states_.resize(std::max<size_t>(i + 1, 2 * states_.size()), 0);
+		states_[i] = s;
+		trees_[s].set(i, w);
+	}
+	void remove(const Id i)
+	{
+		assert(i < states_.size());
+		trees_[states_[i]].set(i, 0);
+	}
+	void set(const Id i, const double w)
+	{
+		assert(i < states_.size());
+		trees_[states_[i]].set(i, w);
+	}
+	double weight(const Id i) const
+	{
+		assert(i < states_.size());
+		return trees_[states_[i]][i];
+	}
+	/// move the weight of element @p i to the tree of state @p s
+	void move(const Id i, const State s)
+	{
+		assert(s < trees_.size());
+		const double w = weight(i);
+		trees_[states_[i]].set(i, 0);
+		states_[i] = s;
+		trees_[s].set(i, w);
+	}
+	double total() const
+	{
+		double t = 0;
+		for (size_t s = 0; s < trees_.size(); ++s)
+			t += trees_[s].total();
+		return t;
+	}
+	double total(const State s) const
+	{
+		assert(s < trees_.size());
+		return trees_[s].total();
+	}
+	void clear()
+	{
+		for (size_t s = 0; s < trees_.size(); ++s)
+			trees_[s].clear();
+		states_.clear();
+	}
+	size_t memoryUsage() const
+	{
+		size_t m = trees_.capacity() * sizeof(SumTree) + states_.capacity()
+				* sizeof(State);
+		for (size_t s = 0; s < trees_.size(); ++s)
+			m += trees_[s].memoryUsage();
+		return m;
+	}
+	/// move weights to new IDs, which are never larger than the old ones
+	void compact(const std::vector<Id>& newIds)
+	{
+		std::vector<std::vector<double> > w(trees_.size());
+		// the new IDs may be in any order (@see Graph::relabel)
+		const std::vector<State> states(states_);
+		for (size_t i = 0; i < newIds.size(); ++i)
+		{
+			if (newIds[i] == std::numeric_limits<Id>::max())
+				continue;
+			const State s = states[i];
+			if (w[s].size() <= newIds[i])
+				w[s].resize(newIds[i] + 1, 0);
+			w[s][newIds[i]] = trees_[s][i];
+			states_[newIds[i]] = s;
+		}
+		for (size_t s = 0; s < trees_.size(); ++s)
+			trees_[s].assign(w[s]);
+	}
+	template<class RandomNumGen> Id draw(RandomNumGen& rnd) const
+	{
+		for (int tries = 0; tries < 16; ++tries)
+		{
+			double u = rnd.Uniform01() * total();
+			for (size_t s = 0; s < trees_.size(); ++s)
+			{
+				if (u < trees_[s].total())
+				{
+					const size_t i = trees_[s].find(u);
+					if ((i < trees_[s].size()) && (trees_[s][i] > 0))
+						return i;
+					break;
+				}
+				u -= trees_[s].total();
+			}
+			if (!(total() > 0))
+				break;
+			// only rounding errors lead here, so draw again
+		}
+		throw(std::invalid_argument("Cannot draw from zero total weight."));
+	}
+	template<class RandomNumGen> Id draw(const State s, RandomNumGen& rnd) const
+	{
+		assert(s < trees_.size());
+		const SumTree& t = trees_[s];
+		for (int tries = 0; (tries < 16) && (t.total() > 0); ++tries)
+		{
+			const size_t i = t.find(rnd.Uniform01() * t.total());
+			if ((i < t.size()) && (t[i] > 0))
+				return i;
+		}
+		throw(std::invalid_argument("Cannot draw from zero total weight."));
+	}
+
+private:
+	std::vector<SumTree> trees_;
+	std::vector<State> states_; ///< state of each element, by ID
+};
+}
+/// @endcond
+
+/**
+ * Draw nodes with probability proportional to a weight.
+ *
+ * Graph::randomNode() selects nodes uniformly. This graph listener keeps node
+ * weights in one sum tree per node state (@see SumTree), so that a node can
+ * be drawn with probability proportional to its weight, among all nodes or
+ * among the nodes in a given state, in O(log N) steps. This is what
+ * preferential attachment growth or weighted voter models need.
+ *
+ * The weight of a node is either its degree, in-degree, or out-degree plus a
+ * constant @c offset, and follows the node's edges, or it is a custom weight
+ * set by the user, which is @c offset for new nodes and the previous weight
+ * for nodes restored by Graph::rollback(). Adding or removing an
+ * edge, changing a node's state, or setting a weight takes O(log N) steps.
+ * Memory usage is two doubles per node ID and node state.
+ *
+ * The sampler takes the initial weights from the graph it is constructed
+ * with and must then be registered with that graph
+ * (@see Graph::addGraphListener).
+ */
+class NodeSampler: public GraphListener
+{
+public:
+	/// Node weights
+	enum Weight
+	{
+		DEGREE, ///< total degree plus offset
+		IN_DEGREE, ///< in-degree plus offset
+		OUT_DEGREE, ///< out-degree plus offset
+		CUSTOM ///< set by setWeight(), offset for new nodes
+	};
+	/**
+	 * Sample nodes of @p g with weights @p w.
+	 * @param g graph
+	 * @param w kind of node weights
+	 * @param offset weight added to the degree, or weight of new nodes for
+	 * custom weights
+	 */
+	explicit NodeSampler(const Graph& g, Weight w = DEGREE, double offset = 0);
+
+	/**
+	 * Compute the weights of all nodes in @p g again, from scratch.
+	 * Custom weights are reset to the offset.
+	 */
+	void reset(const Graph& g);
+
+	size_t memoryUsage() const
+	{
+		return index_.memoryUsage() + removing_.capacity() / 8
+				+ removed_.capacity() * sizeof(removed_[0]);
+	}
+
+	/**
+	 * Set weight of node @p n to @p w
+	 * @throw std::invalid_argument if weights follow degrees or @p w is negative
+	 */
+	void setWeight(node_id_t n, double w);
+	/**
+	 * Weight of node @p n
+	 */
+	double weight(node_id_t n) const
+	{
+		return index_.weight(n);
+	}
+	/**
+	 * Sum of the weights of all nodes
+	 */
+	double totalWeight() const
+	{
+		return index_.total();
+	}
+	/**
+	 * Sum of the weights of all nodes in state @p s
+	 */
+	double totalWeight(node_state_t s) const
+	{
+		return index_.total(s);
+	}
+	/**
+	 * Draw a node with probability proportional to its weight
+	 *
+	 * @p rnd must provide a Uniform01() method returning a random number in
+	 * [0, 1).
+	 * @return ID of the drawn node
+	 * @throw std::invalid_argument if all weights are zero
+	 */
+	template<class RandomNumGen> node_id_t draw(RandomNumGen& rnd) const
+	{
+		return index_.draw(rnd);
+	}
+	/**
+	 * Draw a node in state @p s with probability proportional to its weight
+	 *
+	 * @see draw(RandomNumGen&)
+	 * @throw std::invalid_argument if all weights in state @p s are zero
+	 */
+	template<class RandomNumGen> node_id_t draw(node_state_t s,
+			RandomNumGen& rnd) const
+	{
+		return index_.draw(s, rnd);
+	}
+
+private:
+	/// weight of node @p n if it had the given numbers of edges fewer
+	double degreeWeight(const Node& n, degree_t inDelta, degree_t outDelta,
+			degree_t unDelta) const;
+	void update(const Node& n, degree_t inDelta, degree_t outDelta,
+			degree_t unDelta);
+
+	void afterNodeAddEvent(Graph& g, Node& n);
+	void afterEdgeAddEvent(Graph& g, Edge& e);
+	void beforeNodeRemoveEvent(Graph& g, Node& n);
+	void beforeEdgeRemoveEvent(Graph& g, Edge& e);
+	void afterNodeRestoreEvent(Graph& g, Node& n);
+	void afterTransactionCommitEvent(Graph& g);
+	void beforeGraphClearEvent(Graph& g);
+	void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds);
+	void afterNodeStateChangeEvent(Graph& g, Node& n, node_state_t oldState,
+			node_state_t newState);
+
+	Weight kind_;
+	double offset_;
+	detail::WeightIndex<node_id_t, node_state_t> index_;
+	std::vector<bool> removing_; ///< nodes whose edges are being removed with them
+	/// custom weights of nodes removed during a transaction, by ID
+	std::vector<std::pair<node_id_t, double> > removed_;
+};
+
+/**
+ * Draw edges with probability proportional to a weight.
+ *
+ * The edge counterpart of NodeSampler, for user-supplied edge weights such as
+ * link strengths. New edges get a default weight, edges restored by
+ * Graph::rollback() get their previous weight back, and edges can be drawn
+ * among all edges or among the edges in a given state in O(log M) steps.
+ * Memory usage is two doubles per edge ID and edge state.
+ *
+ * The sampler takes the edges from the graph it is constructed with and must
+ * then be registered with that graph (@see Graph::addGraphListener).
+ */
+class EdgeSampler: public GraphListener
+{
+public:
+	/**
+	 * Sample edges of @p g, all with weight @p def.
+	 */
+	explicit EdgeSampler(const Graph& g, double def = 1);
+
+	/**
+	 * Take the edges of @p g again, from scratch, all with the default weight.
+	 */
+	void reset(const Graph& g);
+
+	size_t memoryUsage() const
+	{
+		return index_.memoryUsage() + removed_.capacity() * sizeof(removed_[0]);
+	}
+
+	/**
+	 * Set weight of edge @p e to @p w
+	 * @throw std::invalid_argument if @p w is negative
+	 */
+	void setWeight(edge_id_t e, double w);
+	/**
+	 * Weight of edge @p e
+	 */
+	double weight(edge_id_t e) const
+	{
+		return index_.weight(e);
+	}
+	/**
+	 * Sum of the weights of all edges
+	 */
+	double totalWeight() const
+	{
+		return index_.total();
+	}
+	/**
+	 * Sum of the weights of all edges in state @p s
+	 */
+	double totalWeight(edge_state_t s) const
+	{
+		return index_.total(s);
+	}
+	/**
+	 * Draw an edge with probability proportional to its weight
+	 *
+	 * @see NodeSampler::draw
+	 * @return ID of the drawn edge
+	 * @throw std::invalid_argument if all weights are zero
+	 */
+	template<class RandomNumGen> edge_id_t draw(RandomNumGen& rnd) const
+	{
+		return index_.draw(rnd);
+	}
+	/**
+	 * Draw an edge in state @p s with probability proportional to its weight
+	 *
+	 * @see NodeSampler::draw
+	 * @throw std::invalid_argument if all weights in state @p s are zero
+	 */
+	template<class RandomNumGen> edge_id_t draw(edge_state_t s,
+			RandomNumGen& rnd) const
+	{
+		return index_.draw(s, rnd);
+	}
+
+private:
+	void afterEdgeAddEvent(Graph& g, Edge& e);
+	void beforeEdgeRemoveEvent(Graph& g, Edge& e);
+	void afterEdgeRestoreEvent(Graph& g, Edge& e);
+	void afterTransactionCommitEvent(Graph& g);
+	// rewired edges keep their weights
+	void beforeEdgeRewireEvent(Graph& g, Edge& e, Node& newSource, Node& newTarget)
+	{
+	}
+	void afterEdgeRewireEvent(Graph& g, Edge& e, Node& oldSource, Node& oldTarget)
+	{
+	}
+	void beforeGraphClearEvent(Graph& g);
+	void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds);
+	void afterEdgeStateChangeEvent(Graph& g, Edge& e, edge_state_t oldState,
+			edge_state_t newState);
+
+	double default_;
+	detail::WeightIndex<edge_id_t, edge_state_t> index_;
+	/// weights of edges removed during a transaction, by ID
+	std::vector<std::pair<edge_id_t, double> > removed_;
+};
+
+}
+
+#endif /* WEIGHTEDSAMPLER_H_ */
@@ -0,0 +1,187 @@
+/**
+ * @file AdjacencyArray.h
+ * @date 17.10.2026
+ */
+
+#ifndef ADJACENCYARRAY_H_
+#define ADJACENCYARRAY_H_
+
+#include <largenet2/base/types.h>
+#include <boost/noncopyable.hpp>
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+namespace largenet
+{
+
+class Edge;
+
+/**
+ * Contiguous storage for the edges attached to a node.
+ *
+ * Outgoing, incoming, and undirected edges are kept in a single array, packed
+ * by segment in this order (much like the categories in a repo::CPtrRepository).
+ * The first few edges are stored inline in the object itself, such that
+ * low-degree nodes do not need any heap allocation at all.
+ *
+ * Inserting an edge takes constant time, as at most one element per segment
+ * needs to be moved. Removing an edge moves as few elements, but has to find
+ * the edge first, which is linear in the size of its segment (the edges do
+ * not record their positions). The order of edges within a segment is not
+ * preserved.
+ */
+class AdjacencyArray: public boost::noncopyable
+{
+public:
+	/// Edge segments
+	enum Segment
+	{
+		OUT = 0, IN = 1, UNDIRECTED = 2
+	};
+	enum
+	{
+		inline_capacity = 4 ///< Number of edges stored without heap allocation
+	};
+
+	typedef Edge* const* const_iterator;
+
+	AdjacencyArray() :
+		data_(inline_), capacity_(inline_capacity)
+	{
+		end_[OUT] = end_[IN] = end_[UNDIRECTED] = 0;
+	}
+	~AdjacencyArray()
+	{
+		if (data_ != inline_)
+			delete[] data_;
+	}
+	/**
+	 * Number of edges in segment @p s
+	 */
+	degree_t size(Segment s) const
+	{
+		return end_[s] - start(s);
+	}
+	/**
+	 * Total number of edges stored
+	 */
+	degree_t size() const
+	{
+		return end_[UNDIRECTED];
+	}
+	/**
+	 * Number of edges that can be stored without reallocation
+	 */
+	degree_t capacity() const
+	{
+		return capacity_;
+	}
+	/**
+	 * Heap memory held by the array, in bytes, which is zero as long as the
+	 * edges fit into the inline storage
+	 */
+	size_t heapMemory() const
+	{
+		return (data_ == inline_) ? 0 : capacity_ * sizeof(Edge*);
+	}
+	const_iterator begin(Segment s) const
+	{
+		return data_ + start(s);
+	}
+	const_iterator end(Segment s) const
+	{
+		return data_ + end_[s];
+	}
+	/**
+	 * Check whether segment @p s contains @p e
+	 */
+	bool contains(const Edge* e, Segment s) const
+	{
+		return find(e, s) != end(s);
+	}
+	/**
+	 * Find @p e in segment @p s
+	 * @return pointer to the position of @p e, or end(@p s) if not found
+	 */
+	const_iterator find(const Edge* e, Segment s) const
+	{
+		return std::find(begin(s), end(s), e);
+	}
+	/**
+	 * Append @p e to segment @p s
+	 */
+	void insert(Edge* e, Segment s)
+	{
+		if (size() == capacity_)
+			grow();
+		// shift the following segments by one, moving their first element
+		// to their end
+		degree_t pos = end_[UNDIRECTED];
+		for (int k = UNDIRECTED; k > s; --k)
+		{
+			const degree_t first = end_[k - 1];
+			data_[pos] = data_[first];
+			pos = first;
+		}
+		data_[pos] = e;
+		for (int k = s; k <= UNDIRECTED; ++k)
+			++end_[k];
+	}
+	/**
+	 * Remove @p e from segment @p s
+	 *
+	 * Takes time linear in size(@p s) for finding @p e.
+	 * @return true if @p e was found and removed
+	 */
+	bool erase(const Edge* e, Segment s)
+	{
+		const_iterator it = find(e, s);
+		if (it == end(s))
+			return false;
+		erase(static_cast<degree_t>(it - data_), s);
+		return true;
+	}
+
+private:
+	degree_t start(Segment s) const
+	{
+		return (s == OUT) ? 0 : end_[s - 1];
+	}
+	void erase(degree_t pos, Segment s)
+	{
+		assert(pos >= start(s));
+		assert(pos < end_[s]);
+		// fill the hole with the last element of each segment in turn
+		degree_t hole = pos;
+		for (int k = s; k <= UNDIRECTED; ++k)
+		{
+			const degree_t last = end_[k] - 1;
+			data_[hole] = data_[last];
+			hole = last;
+			--end_[k];
+		}
+	}
+	void grow()
+	{
+		if (capacity_ > std::numeric_limits<degree_t>::max() / 2)
+			throw(std::overflow_error("Node degree exceeds range of degree_t."));
+		const degree_t cap = 2 * capacity_;
+		Edge** data = new Edge*[cap];
+		std::copy(data_, data_ + size(), data);
+		if (data_ != inline_)
+			delete[] data_;
+		data_ = data;
+		capacity_ = cap;
+	}
+
+	Edge** data_;
+	degree_t end_[3];
+	degree_t capacity_;
+	Edge* inline_[inline_capacity];
+};
+
+}
+
+#endif /* ADJACENCYARRAY_H_ */
@@ -0,0 +1,538 @@
+/**
+ * @file BasicGraph.h
+ * @date 18.10.2026
+ */
+
+#ifndef BASICGRAPH_H_
+#define BASICGRAPH_H_
+
+#include <largenet2/base/Graph.h>
+#include <largenet2/base/factories.h>
+#include <largenet2/base/node_traits.h>
+#include <largenet2/base/GraphListener.h>
+#include <largenet2/base/StaticGraphListener.h>
+#include <boost/iterator/iterator_adaptor.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <memory>
+#include <cassert>
+
+namespace largenet
+{
+
+namespace iterators
+{
+
+/**
+ * Iterator adaptor turning an iterator over Node or Edge references into an
+ * iterator over references to the concrete element type @p Value.
+ *
+ * The repository iterator interface (id(), category()) is preserved.
+ */
+template<class BaseIterator, class Value>
+class DowncastIterator: public boost::iterator_adaptor<
+		DowncastIterator<BaseIterator, Value>, BaseIterator, Value>
+{
+private:
+	typedef boost::iterator_adaptor<DowncastIterator<BaseIterator, Value>,
+			BaseIterator, Value> super_t;
+
+public:
+	DowncastIterator() :
+		super_t()
+	{
+	}
+	explicit DowncastIterator(const BaseIterator& it) :
+		super_t(it)
+	{
+	}
+	template<class OtherIterator, class OtherValue>
+	DowncastIterator(const DowncastIterator<OtherIterator, OtherValue>& it,
+			typename boost::enable_if_convertible<OtherValue*, Value*>::type* = 0) :
+		super_t(it.base())
+	{
+	}
+	repo::id_t id() const
+	{
+		return this->base().id();
+	}
+	repo::category_t category() const
+	{
+		return this->base().category();
+	}
+
+private:
+	friend class boost::iterator_core_access;
+	typename super_t::reference dereference() const
+	{
+		return static_cast<Value&> (*this->base());
+	}
+};
+
+}
+
+/**
+ * Graph with statically known node and edge types
+ *
+ * A BasicGraph creates all its elements through a factory of type @p Factory,
+ * which must produce elements of exactly the types @p NodeType and
+ * @p EdgeType. Its accessors and iterators therefore return the concrete
+ * types, and calls to their members can be resolved at compile time and
+ * inlined instead of going through the virtual Node interface (@see
+ * node_traits). Graph algorithms templated on the graph type, such as those
+ * in measures and generators, pick up this fast path automatically.
+ *
+ * A BasicGraph is a Graph, so it can still be passed to all code expecting
+ * a Graph, which then uses the virtual interface.
+ *
+ * In addition to the graph listeners registered at runtime, a BasicGraph
+ * notifies the static listener @p Listener (@see StaticGraphListener). Its
+ * event handlers are called directly from the inline members setNodeState(),
+ * setEdgeState(), addNode(), addEdge(), and removeEdge(), without walking the
+ * listener list or going through virtual calls. Changes made through the
+ * Graph interface reach the static listener through a single virtual call.
+ *
+ * @tparam NodeType type of node elements
+ * @tparam EdgeType type of edge elements
+ * @tparam Factory element factory creating @p NodeType and @p EdgeType elements
+ * @tparam Listener static listener notified of all graph events
+ */
+template<class NodeType, class EdgeType = Edge,
+		class Factory = GraphElementFactory<NodeType, EdgeType>,
+		class Listener = StaticGraphListener>
+class BasicGraph: public Graph
+{
+public:
+	typedef NodeType node_type;
+	typedef EdgeType edge_type;
+	typedef Factory factory_type;
+	typedef Listener listener_type;
+
+	/// iterator for all nodes
+	typedef iterators::DowncastIterator<Graph::NodeIterator, NodeType> NodeIterator;
+	/// iterator for all nodes in given state
+	typedef iterators::DowncastIterator<Graph::NodeStateIterator, NodeType> NodeStateIterator;
+	/// iterator for all edges
+	typedef iterators::DowncastIterator<Graph::EdgeIterator, EdgeType> EdgeIterator;
+	/// iterator for all edges in given state
+	typedef iterators::DowncastIterator<Graph::EdgeStateIterator, EdgeType> EdgeStateIterator;
+	/// const node iterator
+	typedef iterators::DowncastIterator<Graph::ConstNodeIterator, const NodeType> ConstNodeIterator;
+	/// const node iterator for all nodes in given state
+	typedef iterators::DowncastIterator<Graph::ConstNodeStateIterator, const NodeType> ConstNodeStateIterator;
+	/// const edge iterator
+	typedef iterators::DowncastIterator<Graph::ConstEdgeIterator, const EdgeType> ConstEdgeIterator;
+	/// const edge iterator for all edges in given state
+	typedef iterators::DowncastIterator<Graph::ConstEdgeStateIterator, const EdgeType> ConstEdgeStateIterator;
+	/// iterator for all nodes in storage order
+	typedef iterators::DowncastIterator<Graph::DenseNodeIterator, NodeType> DenseNodeIterator;
+	/// iterator for all edges in storage order
+	typedef iterators::DowncastIterator<Graph::DenseEdgeIterator, EdgeType> DenseEdgeIterator;
+	/// const iterator for all nodes in storage order
+	typedef iterators::DowncastIterator<Graph::ConstDenseNodeIterator, const NodeType> ConstDenseNodeIterator;
+	/// const iterator for all edges in storage order
+	typedef iterators::DowncastIterator<Graph::ConstDenseEdgeIterator, const EdgeType> ConstDenseEdgeIterator;
+
+	/// node iterator range
+	typedef std::pair<NodeIterator, NodeIterator> NodeIteratorRange;
+	/// node state iterator range
+	typedef std::pair<NodeStateIterator, NodeStateIterator> NodeStateIteratorRange;
+	/// edge iterator range
+	typedef std::pair<EdgeIterator, EdgeIterator> EdgeIteratorRange;
+	/// edge state iterator range
+	typedef std::pair<EdgeStateIterator, EdgeStateIterator> EdgeStateIteratorRange;
+	/// const node iterator range
+	typedef std::pair<ConstNodeIterator, ConstNodeIterator> ConstNodeIteratorRange;
+	/// const node state iterator range
+	typedef std::pair<ConstNodeStateIterator, ConstNodeStateIterator> ConstNodeStateIteratorRange;
+	/// const edge iterator range
+	typedef std::pair<ConstEdgeIterator, ConstEdgeIterator> ConstEdgeIteratorRange;
+	/// const edge state iterator range
+	typedef std::pair<ConstEdgeStateIterator, ConstEdgeStateIterator> ConstEdgeStateIteratorRange;
+	/// dense node iterator range
+	typedef std::pair<DenseNodeIterator, DenseNodeIterator> DenseNodeIteratorRange;
+	/// dense edge iterator range
+	typedef std::pair<DenseEdgeIterator, DenseEdgeIterator> DenseEdgeIteratorRange;
+	/// const dense node iterator range
+	typedef std::pair<ConstDenseNodeIterator, ConstDenseNodeIterator> ConstDenseNodeIteratorRange;
+	/// const dense edge iterator range
+	typedef std::pair<ConstDenseEdgeIterator, ConstDenseEdgeIterator> ConstDenseEdgeIteratorRange;
+
+	/**
+	 * Create a graph with @p nodeStates possible node states and @p edgeStates
+	 * possible edge states.
+	 * @throw std::overflow_error if there are more states than node_state_t
+	 * or edge_state_t can represent
+	 */
+	BasicGraph(node_state_size_t nodeStates, edge_state_size_t edgeStates,
+			const Listener& listener = Listener()) :
+		Graph(nodeStates, edgeStates), listener_(listener)
+	{
+		Graph::setElementFactory(std::auto_ptr<ElementFactory>(new Factory));
+		lockElementFactory();
+		if (!boost::is_same<Listener, StaticGraphListener>::value)
+			bindListener(&forwarder_);
+	}
+
+	/**
+	 * Create a copy of this graph, including a copy of its static listener
+	 * @see Graph::clone
+	 */
+	std::auto_ptr<BasicGraph> clone() const
+	{
+		std::auto_ptr<BasicGraph> g(new BasicGraph(numberOfNodeStates(),
+				numberOfEdgeStates(), listener_));
+		g->copyElements(*this);
+		return g;
+	}
+	/**
+	 * Exchange contents and static listeners with @p g in constant time
+	 * @see Graph::swap
+	 */
+	void swap(BasicGraph& g)
+	{
+		// the static listeners move first, so that they are rebuilt for
+		// the elements they end up with
+		std::swap(listener_, g.listener_);
+		Graph::swap(g);
+	}
+
+	/**
+	 * Get the static listener
+	 */
+	Listener& listener()
+	{
+		return listener_;
+	}
+	const Listener& listener() const
+	{
+		return listener_;
+	}
+
+	/**
+	 * @name Modification
+	 * These notify the static listener directly.
+	 * @see Graph::addNode, Graph::addEdge, Graph::tryAddEdge, Graph::removeEdge,
+	 * Graph::rewireEdge, Graph::moveEdgeEndpoint,
+	 * Graph::setNodeState, Graph::setEdgeState
+	 */
+	///@{
+	node_id_t addNode()
+	{
+		return addNode(0);
+	}
+	node_id_t addNode(node_state_t s)
+	{
+		node_id_t n;
+		{
+			Unbound u(*this);
+			n = Graph::addNode(s);
+		}
+		listener_.afterNodeAdd(*this, *node(n));
+		return n;
+	}
+	edge_id_t addEdge(node_id_t source, node_id_t target, bool directed)
+	{
+		return tryAddEdge(source, target, directed).first;
+	}
+	std::pair<edge_id_t, bool> tryAddEdge(node_id_t source, node_id_t target,
+			bool directed)
+	{
+		std::pair<edge_id_t, bool> e;
+		{
+			Unbound u(*this);
+			e = Graph::tryAddEdge(source, target, directed);
+		}
+		if (e.second)
+			listener_.afterEdgeAdd(*this, *edge(e.first));
+		return e;
+	}
+	void removeEdge(edge_id_t e)
+	{
+		listener_.beforeEdgeRemove(*this, *edge(e));
+		Unbound u(*this);
+		Graph::removeEdge(e);
+	}
+	bool rewireEdge(edge_id_t e, node_id_t newSource, node_id_t newTarget)
+	{
+		if (!canRewireEdge(e, newSource, newTarget))
+			return false;
+		EdgeType& ed = *edge(e);
+		NodeType& oldSource = static_cast<NodeType&> (*ed.source());
+		NodeType& oldTarget = static_cast<NodeType&> (*ed.target());
+		listener_.beforeEdgeRewire(*this, ed, *node(newSource), *node(newTarget));
+		{
+			Unbound u(*this);
+			Graph::rewireEdgeUnchecked(e, newSource, newTarget);
+		}
+		listener_.afterEdgeRewire(*this, ed, oldSource, oldTarget);
+		return true;
+	}
+	bool moveEdgeEndpoint(edge_id_t e, node_id_t oldEnd, node_id_t newEnd)
+	{
+		const std::pair<node_id_t, node_id_t> ends = movedEnds(e, oldEnd, newEnd);
+		return rewireEdge(e, ends.first, ends.second);
+	}
+	void setNodeState(node_id_t n, node_state_t s)
+	{
+		const node_state_t old = nodeState(n);
+		if (s == old)
+			return;
+		changeNodeState(n, old, s);
+		listener_.afterNodeStateChange(*this, *node(n), old, s);
+	}
+	void setEdgeState(edge_id_t e, edge_state_t s)
+	{
+		const edge_state_t old = edgeState(e);
+		if (s == old)
+			return;
+		changeEdgeState(e, old, s);
+		listener_.afterEdgeStateChange(*this, *edge(e), old, s);
+	}
+	///@}
+
+	/**
+	 * Get node with ID @p n
+	 * @throw std::invalid_argument if node @p n does not exist
+	 */
+	NodeType* node(node_id_t n)
+	{
+		return static_cast<NodeType*> (Graph::node(n));
+	}
+	const NodeType* node(node_id_t n) const
+	{
+		return static_cast<const NodeType*> (Graph::node(n));
+	}
+	/**
+	 * Get edge with ID @p e
+	 * @throw std::invalid_argument if edge @p e does not exist
+	 */
+	EdgeType* edge(edge_id_t e)
+	{
+		return static_cast<EdgeType*> (Graph::edge(e));
+	}
+	const EdgeType* edge(edge_id_t e) const
+	{
+		return static_cast<const EdgeType*> (Graph::edge(e));
+	}
+
+	/**
+	 * @name Random elements
+	 * @see Graph::randomNode, Graph::randomEdge
+	 */
+	///@{
+	template<class RandomNumGen> NodeType* randomNode(RandomNumGen& rnd)
+	{
+		return static_cast<NodeType*> (Graph::randomNode(rnd));
+	}
+	template<class RandomNumGen> const NodeType* randomNode(RandomNumGen& rnd) const
+	{
+		return static_cast<const NodeType*> (Graph::randomNode(rnd));
+	}
+	template<class RandomNumGen> NodeType* randomNode(node_state_t s,
+			RandomNumGen& rnd)
+	{
+		return static_cast<NodeType*> (Graph::randomNode(s, rnd));
+	}
+	template<class RandomNumGen> const NodeType* randomNode(node_state_t s,
+			RandomNumGen& rnd) const
+	{
+		return static_cast<const NodeType*> (Graph::randomNode(s, rnd));
+	}
+	template<class RandomNumGen> EdgeType* randomEdge(RandomNumGen& rnd)
+	{
+		return static_cast<EdgeType*> (Graph::randomEdge(rnd));
+	}
+	template<class RandomNumGen> const EdgeType* randomEdge(RandomNumGen& rnd) const
+	{
+		return static_cast<const EdgeType*> (Graph::randomEdge(rnd));
+	}
+	template<class RandomNumGen> EdgeType* randomEdge(edge_state_t s,
+			RandomNumGen& rnd)
+	{
+		return static_cast<EdgeType*> (Graph::randomEdge(s, rnd));
+	}
+	template<class RandomNumGen> const EdgeType* randomEdge(edge_state_t s,
+			RandomNumGen& rnd) const
+	{
+		return static_cast<const EdgeType*> (Graph::randomEdge(s, rnd));
+	}
+	///@}
+
+	/**
+	 * @name Iteration
+	 * @see Graph::nodes, Graph::edges, Graph::denseNodes, Graph::denseEdges
+	 */
+	///@{
+	NodeIteratorRange nodes()
+	{
+		return convert<NodeIteratorRange> (Graph::nodes());
+	}
+	ConstNodeIteratorRange nodes() const
+	{
+		return convert<ConstNodeIteratorRange> (Graph::nodes());
+	}
+	NodeStateIteratorRange nodes(node_state_t s)
+	{
+		return convert<NodeStateIteratorRange> (Graph::nodes(s));
+	}
+	ConstNodeStateIteratorRange nodes(node_state_t s) const
+	{
+		return convert<ConstNodeStateIteratorRange> (Graph::nodes(s));
+	}
+	EdgeIteratorRange edges()
+	{
+		return convert<EdgeIteratorRange> (Graph::edges());
+	}
+	ConstEdgeIteratorRange edges() const
+	{
+		return convert<ConstEdgeIteratorRange> (Graph::edges());
+	}
+	EdgeStateIteratorRange edges(edge_state_t s)
+	{
+		return convert<EdgeStateIteratorRange> (Graph::edges(s));
+	}
+	ConstEdgeStateIteratorRange edges(edge_state_t s) const
+	{
+		return convert<ConstEdgeStateIteratorRange> (Graph::edges(s));
+	}
+	DenseNodeIteratorRange denseNodes()
+	{
+		return convert<DenseNodeIteratorRange> (Graph::denseNodes());
+	}
+	ConstDenseNodeIteratorRange denseNodes() const
+	{
+		return convert<ConstDenseNodeIteratorRange> (Graph::denseNodes());
+	}
+	DenseEdgeIteratorRange denseEdges()
+	{
+		return convert<DenseEdgeIteratorRange> (Graph::denseEdges());
+	}
+	ConstDenseEdgeIteratorRange denseEdges() const
+	{
+		return convert<ConstDenseEdgeIteratorRange> (Graph::denseEdges());
+	}
+	///@}
+
+	/**
+	 * Check whether there exists a directed or undirected edge from @p source
+	 * to @p target
+	 */
+	bool isEdge(node_id_t source, node_id_t target) const
+	{
+		const NodeType* s = node(source);
+		const NodeType* t = node(target);
+		return node_traits<NodeType>::hasEdgeTo(*s, t)
+				|| node_traits<NodeType>::hasUndirectedEdgeTo(*s, t);
+	}
+	/**
+	 * Check whether two nodes are connected by an edge
+	 */
+	bool adjacent(node_id_t n1, node_id_t n2) const
+	{
+		return node_traits<NodeType>::isAdjacentTo(*node(n1), node(n2));
+	}
+
+private:
+	/// The element factory determines the element types and cannot be
+	/// replaced, which Graph::setElementFactory() enforces, too.
+	using Graph::setElementFactory;
+
+	/// Forwards events caused through the Graph interface to the static listener.
+	class Forwarder: public GraphListener
+	{
+		static BasicGraph& cast(Graph& g)
+		{
+			return static_cast<BasicGraph&> (g);
+		}
+		void afterNodeAddEvent(Graph& g, Node& n)
+		{
+			cast(g).listener().afterNodeAdd(cast(g), static_cast<NodeType&> (n));
+		}
+		void afterEdgeAddEvent(Graph& g, Edge& e)
+		{
+			cast(g).listener().afterEdgeAdd(cast(g), static_cast<EdgeType&> (e));
+		}
+		void beforeNodeRemoveEvent(Graph& g, Node& n)
+		{
+			cast(g).listener().beforeNodeRemove(cast(g), static_cast<NodeType&> (n));
+		}
+		void beforeEdgeRemoveEvent(Graph& g, Edge& e)
+		{
+			cast(g).listener().beforeEdgeRemove(cast(g), static_cast<EdgeType&> (e));
+		}
+		void beforeEdgeRewireEvent(Graph& g, Edge& e, Node& newSource,
+				Node& newTarget)
+		{
+			cast(g).listener().beforeEdgeRewire(cast(g), static_cast<EdgeType&> (e),
+					static_cast<NodeType&> (newSource),
+					static_cast<NodeType&> (newTarget));
+		}
+		void afterEdgeRewireEvent(Graph& g, Edge& e, Node& oldSource,
+				Node& oldTarget)
+		{
+			cast(g).listener().afterEdgeRewire(cast(g), static_cast<EdgeType&> (e),
+					static_cast<NodeType&> (oldSource),
+					static_cast<NodeType&> (oldTarget));
+		}
+		void beforeGraphClearEvent(Graph& g)
+		{
+			cast(g).listener().beforeGraphClear(cast(g));
+		}
+		void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+				const std::vector<edge_id_t>& edgeIds)
+		{
+			cast(g).listener().afterGraphCompact(cast(g), nodeIds, edgeIds);
+		}
+		void afterNodeStateChangeEvent(Graph& g, Node& n, node_state_t oldState,
+				node_state_t newState)
+		{
+			cast(g).listener().afterNodeStateChange(cast(g),
+					static_cast<NodeType&> (n), oldState, newState);
+		}
+		void afterEdgeStateChangeEvent(Graph& g, Edge& e, edge_state_t oldState,
+				edge_state_t newState)
+		{
+			cast(g).listener().afterEdgeStateChange(cast(g),
+					static_cast<EdgeType&> (e), oldState, newState);
+		}
+	};
+
+	/// Unbinds the forwarder while the Graph implementation notifies its listeners.
+	class Unbound
+	{
+	public:
+		explicit Unbound(BasicGraph& g) :
+			g_(g), bound_(g.bindListener(0))
+		{
+		}
+		~Unbound()
+		{
+			g_.bindListener(bound_);
+		}
+	private:
+		BasicGraph& g_;
+		GraphListener* bound_;
+	};
+
+	template<class Range, class BaseRange>
+	static Range convert(const BaseRange& r)
+	{
+		typedef typename Range::first_type iterator;
+		return Range(iterator(r.first), iterator(r.second));
+	}
+
+	Listener listener_;
+	Forwarder forwarder_;
+};
+
+template<class NodeType, class EdgeType, class Factory, class Listener>
+inline void swap(BasicGraph<NodeType, EdgeType, Factory, Listener>& a,
+		BasicGraph<NodeType, EdgeType, Factory, Listener>& b)
+{
+	a.swap(b);
+}
+
+}
+
+#endif /* BASICGRAPH_H_ */
@@ -0,0 +1,153 @@
+/**
+ * @file CSRGraph.cpp
+ * @date 17.10.2026
+ */
+
+#include <largenet2/base/CSRGraph.h>
+#include <largenet2/base/Graph.h>
+#include <boost/foreach.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace largenet
+{
+
+namespace
+{
+const node_size_t no_index = static_cast<node_size_t>(-1);
+}
+
+CSRGraph::CSRGraph(const Graph& g)
+{
+	const node_size_t N = g.numberOfNodes();
+	const edge_size_t M = g.numberOfEdges();
+
+	// dense node indices
+	std::vector<const Node*> nodes;
+	nodes.reserve(N);
+	nodeIds_.reserve(N);
+	nodeStates_.reserve(N);
+	node_id_t maxId = 0;
+	BOOST_FOREACH(const Node& n, g.nodes())
+	{
+		nodes.push_back(&n);
+		nodeIds_.push_back(n.id());
+		nodeStates_.push_back(g.nodeState(n.id()));
+		maxId = std::max(maxId, n.id());
+	}
+	index_.assign(N > 0 ? maxId + 1 : 0, no_index);
+	for (node_size_t i = 0; i < N; ++i)
+		index_[nodeIds_[i]] = i;
+
+	// dense edge indices and per-node edge counts
+	for (int d = OUT; d <= UNDIRECTED; ++d)
+		offsets_[d].assign(N + 1, 0);
+	edgeIds_.reserve(M);
+	edgeStates_.reserve(M);
+	sources_.reserve(M);
+	targets_.reserve(M);
+	directed_.reserve(M);
+	edge_id_t maxEdgeId = 0;
+	BOOST_FOREACH(const Edge& e, g.edges())
+	{
+		const node_size_t s = index_[e.source()->id()], t =
+				index_[e.target()->id()];
+		edgeIds_.push_back(e.id());
+		edgeStates_.push_back(g.edgeState(e.id()));
+		sources_.push_back(s);
+		targets_.push_back(t);
+		directed_.push_back(e.isDirected());
+		maxEdgeId = std::max(maxEdgeId, e.id());
+		if (e.isDirected())
+		{
+			++offsets_[OUT][s + 1];
+			++offsets_[IN][t + 1];
+		}
+		else
+		{
+			++offsets_[UNDIRECTED][s + 1];
+			if (s != t)
+				++offsets_[UNDIRECTED][t + 1];
+		}
+	}
+	std::vector<edge_size_t> edgeIndex(M > 0 ? maxEdgeId + 1 : 0, 0);
+	for (edge_size_t j = 0; j < M; ++j)
+		edgeIndex[edgeIds_[j]] = j;
+
+	std::vector<edge_size_t> pos[3];
+	for (int d = OUT; d <= UNDIRECTED; ++d)
+	{
+		for (node_size_t i = 0; i < N; ++i)
+			offsets_[d][i + 1] += offsets_[d][i];
+		neighbors_[d].resize(offsets_[d][N]);
+		edges_[d].resize(offsets_[d][N]);
+		pos[d].assign(offsets_[d].begin(), offsets_[d].end() - 1);
+	}
+
+	// Fill each node's adjacency from the point of view of its neighbors.
+	// As we visit neighbors in index order, all lists end up sorted.
+	for (node_size_t i = 0; i < N; ++i)
+	{
+		const Node* n = nodes[i];
+		BOOST_FOREACH(const Edge* e, n->inEdges())
+		{
+			const node_size_t s = index_[e->source()->id()];
+			neighbors_[OUT][pos[OUT][s]] = i;
+			edges_[OUT][pos[OUT][s]++] = edgeIndex[e->id()];
+		}
+		BOOST_FOREACH(const Edge* e, n->outEdges())
+		{
+			const node_size_t t = index_[e->target()->id()];
+			neighbors_[IN][pos[IN][t]] = i;
+			edges_[IN][pos[IN][t]++] = edgeIndex[e->id()];
+		}
+		BOOST_FOREACH(const Edge* e, n->undirectedEdges())
+		{
+			const node_size_t o = index_[e->opposite(*n)->id()];
+			neighbors_[UNDIRECTED][pos[UNDIRECTED][o]] = i;
+			edges_[UNDIRECTED][pos[UNDIRECTED][o]++] = edgeIndex[e->id()];
+		}
+	}
+
+	// mutual degrees: incoming edges from nodes that are also out-neighbors
+	mutual_.assign(N, 0);
+	for (node_size_t i = 0; i < N; ++i)
+	{
+		index_range out = outNeighbors(i), in = inNeighbors(i);
+		for (; in.first != in.second; ++in.first)
+		{
+			while ((out.first != out.second) && (*out.first < *in.first))
+				++out.first;
+			if (out.first == out.second)
+				break;
+			if (*out.first == *in.first)
+				++mutual_[i];
+		}
+	}
+}
+
+node_size_t CSRGraph::nodeIndex(const node_id_t id) const
+{
+	if ((id >= index_.size()) || (index_[id] == no_index))
+		throw(std::invalid_argument("Invalid node ID."));
+	return index_[id];
+}
+
+bool CSRGraph::contains(const node_size_t i, const Direction d,
+		const node_size_t j) const
+{
+	const index_range r = neighbors(i, d);
+	return std::binary_search(r.first, r.second, j);
+}
+
+bool CSRGraph::isEdge(const node_size_t i, const node_size_t j) const
+{
+	return contains(i, OUT, j) || contains(i, UNDIRECTED, j);
+}
+
+bool CSRGraph::adjacent(const node_size_t i, const node_size_t j) const
+{
+	return isEdge(i, j) || contains(i, IN, j);
+}
+
+}
@@ -0,0 +1,218 @@
+/**
+ * @file CSRGraph.h
+ * @date 17.10.2026
+ */
+
+#ifndef CSRGRAPH_H_
+#define CSRGRAPH_H_
+
+#include <largenet2/base/types.h>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace largenet
+{
+
+class Graph;
+
+/**
+ * Immutable snapshot of a Graph in compressed sparse row (CSR) format.
+ *
+ * Nodes and edges are renumbered densely, i.e. node indices run from 0 to
+ * numberOfNodes()-1 and edge indices from 0 to numberOfEdges()-1, in the
+ * order in which Graph::nodes() and Graph::edges() enumerate them. The
+ * original IDs are available via nodeId() and edgeId().
+ *
+ * For each node, the outgoing, incoming, and undirected neighbors are stored
+ * in contiguous arrays, sorted by neighbor index, together with the indices
+ * of the corresponding edges. Analyses that only read the network (such as
+ * the overloads of the functions in largenet::measures taking a CSRGraph)
+ * thus traverse a few flat arrays instead of chasing pointers through the
+ * Graph's node and edge objects.
+ *
+ * A snapshot does not change when the Graph it was taken from is modified.
+ */
+class CSRGraph
+{
+public:
+	/// Adjacency direction
+	enum Direction
+	{
+		OUT = 0, IN = 1, UNDIRECTED = 2
+	};
+	/// Iterator over neighbor indices
+	typedef std::vector<node_size_t>::const_iterator index_iterator;
+	/// Range of neighbor indices
+	typedef std::pair<index_iterator, index_iterator> index_range;
+	/// Iterator over edge indices
+	typedef std::vector<edge_size_t>::const_iterator edge_index_iterator;
+	/// Range of edge indices
+	typedef std::pair<edge_index_iterator, edge_index_iterator>
+			edge_index_range;
+
+	/**
+	 * Take a snapshot of @p g
+	 *
+	 * Runs in O(N + M) time, where N and M are the numbers of nodes and
+	 * edges of @p g.
+	 */
+	explicit CSRGraph(const Graph& g);
+
+	node_size_t numberOfNodes() const
+	{
+		return nodeIds_.size();
+	}
+	edge_size_t numberOfEdges() const
+	{
+		return edgeIds_.size();
+	}
+	/**
+	 * ID of node @p i in the original graph
+	 */
+	node_id_t nodeId(node_size_t i) const
+	{
+		assert(i < numberOfNodes());
+		return nodeIds_[i];
+	}
+	/**
+	 * Index of the node with ID @p id in the original graph
+	 * @throw std::invalid_argument if the graph had no node with ID @p id
+	 */
+	node_size_t nodeIndex(node_id_t id) const;
+	node_state_t nodeState(node_size_t i) const
+	{
+		assert(i < numberOfNodes());
+		return nodeStates_[i];
+	}
+	/**
+	 * ID of edge @p j in the original graph
+	 */
+	edge_id_t edgeId(edge_size_t j) const
+	{
+		assert(j < numberOfEdges());
+		return edgeIds_[j];
+	}
+	edge_state_t edgeState(edge_size_t j) const
+	{
+		assert(j < numberOfEdges());
+		return edgeStates_[j];
+	}
+	/**
+	 * Index of the source node of edge @p j
+	 */
+	node_size_t source(edge_size_t j) const
+	{
+		assert(j < numberOfEdges());
+		return sources_[j];
+	}
+	/**
+	 * Index of the target node of edge @p j
+	 */
+	node_size_t target(edge_size_t j) const
+	{
+		assert(j < numberOfEdges());
+		return targets_[j];
+	}
+	bool isDirected(edge_size_t j) const
+	{
+		assert(j < numberOfEdges());
+		return directed_[j] != 0;
+	}
+
+	degree_t degree(node_size_t i, Direction d) const
+	{
+		assert(i < numberOfNodes());
+		return offsets_[d][i + 1] - offsets_[d][i];
+	}
+	degree_t outDegree(node_size_t i) const
+	{
+		return degree(i, OUT);
+	}
+	degree_t inDegree(node_size_t i) const
+	{
+		return degree(i, IN);
+	}
+	degree_t undirectedDegree(node_size_t i) const
+	{
+		return degree(i, UNDIRECTED);
+	}
+	/**
+	 * Total number of incoming, outgoing, and undirected edges of node @p i
+	 */
+	degree_t degree(node_size_t i) const
+	{
+		return outDegree(i) + inDegree(i) + undirectedDegree(i);
+	}
+	/**
+	 * Number of nodes that node @p i has both an outgoing and an incoming
+	 * edge to
+	 */
+	degree_t mutualDegree(node_size_t i) const
+	{
+		assert(i < numberOfNodes());
+		return mutual_[i];
+	}
+	/**
+	 * Neighbors of node @p i in direction @p d, sorted by index
+	 */
+	index_range neighbors(node_size_t i, Direction d) const
+	{
+		assert(i < numberOfNodes());
+		return std::make_pair(neighbors_[d].begin() + offsets_[d][i],
+				neighbors_[d].begin() + offsets_[d][i + 1]);
+	}
+	index_range outNeighbors(node_size_t i) const
+	{
+		return neighbors(i, OUT);
+	}
+	index_range inNeighbors(node_size_t i) const
+	{
+		return neighbors(i, IN);
+	}
+	index_range undirectedNeighbors(node_size_t i) const
+	{
+		return neighbors(i, UNDIRECTED);
+	}
+	/**
+	 * Edges of node @p i in direction @p d, in the same order as
+	 * neighbors(@p i, @p d)
+	 */
+	edge_index_range edges(node_size_t i, Direction d) const
+	{
+		assert(i < numberOfNodes());
+		return std::make_pair(edges_[d].begin() + offsets_[d][i],
+				edges_[d].begin() + offsets_[d][i + 1]);
+	}
+	/**
+	 * Check whether there is a directed edge from @p i to @p j, or an
+	 * undirected edge between them
+	 *
+	 * Runs in O(log k), where k is the degree of @p i.
+	 */
+	bool isEdge(node_size_t i, node_size_t j) const;
+	/**
+	 * Check whether nodes @p i and @p j are connected by an edge
+	 */
+	bool adjacent(node_size_t i, node_size_t j) const;
+
+private:
+	bool contains(node_size_t i, Direction d, node_size_t j) const;
+
+	std::vector<node_id_t> nodeIds_;
+	std::vector<node_state_t> nodeStates_;
+	std::vector<node_size_t> index_; ///< node index by ID
+	std::vector<degree_t> mutual_;
+	std::vector<edge_size_t> offsets_[3];
+	std::vector<node_size_t> neighbors_[3];
+	std::vector<edge_size_t> edges_[3];
+	std::vector<edge_id_t> edgeIds_;
+	std::vector<edge_state_t> edgeStates_;
+	std::vector<node_size_t> sources_;
+	std::vector<node_size_t> targets_;
+	std::vector<char> directed_;
+};
+
+}
+
+#endif /* CSRGRAPH_H_ */
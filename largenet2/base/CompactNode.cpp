@@ -0,0 +1,154 @@
+/**
+ * @file CompactNode.cpp
+ * @date 17.10.2026
+ */
+
+#include <largenet2/base/CompactNode.h>
+#include <largenet2/base/Edge.h>
+#include <largenet2/base/exceptions.h>
+
+namespace largenet
+{
+
+degree_t CompactNode::mutualDegree() const
+{
+	degree_t mdeg = 0;
+	for (AdjacencyArray::const_iterator it = edges_.begin(AdjacencyArray::IN);
+			it != edges_.end(AdjacencyArray::IN); ++it)
+	{
+		if (hasEdgeTo((*it)->source())) // at most one mutual edge pair per neighbor
+			++mdeg;
+	}
+	return mdeg;
+}
+
+bool CompactNode::hasEdgeTo(const Node* n) const
+{
+	return findEdgeTo(n) != 0;
+}
+
+bool CompactNode::hasEdgeFrom(const Node* n) const
+{
+	return findEdgeFrom(n) != 0;
+}
+
+bool CompactNode::hasUndirectedEdgeTo(const Node* n) const
+{
+	return findUndirectedEdgeTo(n) != 0;
+}
+
+Edge* CompactNode::edgeTo(const Node* n) const
+{
+	Edge* e = findEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge to given node."));
+	return e;
+}
+
+Edge* CompactNode::edgeFrom(const Node* n) const
+{
+	Edge* e = findEdgeFrom(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge from given node."));
+	return e;
+}
+
+Edge* CompactNode::undirectedEdgeTo(const Node* n) const
+{
+	Edge* e = findUndirectedEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no undirected edge to given node."));
+	return e;
+}
+
+Edge* CompactNode::findEdgeTo(const Node* n) const
+{
+	for (AdjacencyArray::const_iterator it = edges_.begin(AdjacencyArray::OUT);
+			it != edges_.end(AdjacencyArray::OUT); ++it)
+	{
+		if ((*it)->to(*n))
+			return *it;
+	}
+	return 0;
+}
+
+Edge* CompactNode::findEdgeFrom(const Node* n) const
+{
+	for (AdjacencyArray::const_iterator it = edges_.begin(AdjacencyArray::IN);
+			it != edges_.end(AdjacencyArray::IN); ++it)
+	{
+		if ((*it)->from(*n))
+			return *it;
+	}
+	return 0;
+}
+
+Edge* CompactNode::findUndirectedEdgeTo(const Node* n) const
+{
+	for (AdjacencyArray::const_iterator it =
+			edges_.begin(AdjacencyArray::UNDIRECTED);
+			it != edges_.end(AdjacencyArray::UNDIRECTED); ++it)
+	{
+		if ((*it)->opposite(*this) == n)
+			return *it;
+	}
+	return 0;
+}
+
+void CompactNode::registerEdge(const Edge* e)
+{
+	insertEdge(e, true);
+}
+
+void CompactNode::registerEdgeUnchecked(const Edge* e)
+{
+	insertEdge(e, false);
+}
+
+void CompactNode::insertEdge(const Edge* e, const bool checked)
+{
+	// only loops are registered twice with the same node
+	if (e->isLoop() && hasEdge(e))
+		return;
+
+	if ((e->source() != this) && (e->target() != this)) // neither target nor source point to this node
+		throw(NotAdjacentException(
+				"Cannot register edge that does not connect to this node."));
+
+	Edge* edge = const_cast<Edge*>(e); // here be dragons
+	if (!e->isDirected())
+	{
+		if (checked && hasUndirectedEdgeTo(e->opposite(*this)))
+			throw SingletonException("Edge already exists.");
+		edges_.insert(edge, AdjacencyArray::UNDIRECTED);
+		return;
+	}
+
+	if (e->source() == this)
+	{
+		if (checked && hasEdgeTo(e->target()))
+			throw SingletonException("Edge already exists.");
+		edges_.insert(edge, AdjacencyArray::OUT);
+	}
+	if (e->target() == this)
+	{
+		if (checked && !e->isLoop() && hasEdgeFrom(e->source()))
+			throw SingletonException("Edge already exists.");
+		edges_.insert(edge, AdjacencyArray::IN);
+	}
+}
+
+void CompactNode::unregisterEdge(const Edge* e)
+{
+	if (!e->isDirected())
+	{
+		edges_.erase(e, AdjacencyArray::UNDIRECTED);
+		return;
+	}
+	if (e->source() == this)
+		edges_.erase(e, AdjacencyArray::OUT);
+	if (e->target() == this)
+		edges_.erase(e, AdjacencyArray::IN);
+}
+
+}
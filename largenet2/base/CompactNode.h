@@ -0,0 +1,175 @@
+/**
+ * @file CompactNode.h
+ * @date 17.10.2026
+ */
+
+#ifndef COMPACTNODE_H_
+#define COMPACTNODE_H_
+
+#include <largenet2/base/Node.h>
+#include <largenet2/base/AdjacencyArray.h>
+
+namespace largenet
+{
+
+/**
+ * Does not allow for parallel edges, and stores its edges contiguously.
+ *
+ * A CompactNode behaves like a SingleNode, but keeps its adjacent edges in an
+ * AdjacencyArray instead of three std::set containers. This saves the
+ * per-edge tree node allocation and makes traversing the neighbors of a node
+ * a linear scan over contiguous memory. Low-degree nodes keep their edges
+ * inline and do not allocate at all.
+ *
+ * Adding an edge takes constant time. Removing an edge, finding an edge, and
+ * finding a neighbor are linear in the respective degree, as the edge is
+ * searched for first; the removal itself then takes constant time.
+ * Random edges and neighbors (@see Node::randomOutEdge()) are selected in
+ * constant time.
+ */
+class CompactNode: public Node
+{
+public:
+	/**
+	 * Create a new node with ID @p id
+	 */
+	CompactNode(node_id_t id) :
+		Node(id)
+	{
+	}
+	virtual ~CompactNode()
+	{
+	}
+	degree_t outDegree() const
+	{
+		return edges_.size(AdjacencyArray::OUT);
+	}
+	degree_t inDegree() const
+	{
+		return edges_.size(AdjacencyArray::IN);
+	}
+	degree_t mutualDegree() const;
+	degree_t undirectedDegree() const
+	{
+		return edges_.size(AdjacencyArray::UNDIRECTED);
+	}
+	degree_t degree() const
+	{
+		return edges_.size();
+	}
+	bool hasInEdge(const Edge* e) const
+	{
+		return edges_.contains(e, AdjacencyArray::IN);
+	}
+	bool hasOutEdge(const Edge* e) const
+	{
+		return edges_.contains(e, AdjacencyArray::OUT);
+	}
+	bool hasUndirectedEdge(const Edge* e) const
+	{
+		return edges_.contains(e, AdjacencyArray::UNDIRECTED);
+	}
+	bool hasEdgeTo(const Node* n) const;
+	bool hasEdgeFrom(const Node* n) const;
+	bool hasUndirectedEdgeTo(const Node* n) const;
+	Edge* edgeTo(const Node* n) const;
+	Edge* edgeFrom(const Node* n) const;
+	Edge* undirectedEdgeTo(const Node* n) const;
+	Edge* findEdgeTo(const Node* n) const;
+	Edge* findEdgeFrom(const Node* n) const;
+	Edge* findUndirectedEdgeTo(const Node* n) const;
+	edge_iterator_range outEdges() const
+	{
+		return edges(AdjacencyArray::OUT);
+	}
+	edge_iterator_range inEdges() const
+	{
+		return edges(AdjacencyArray::IN);
+	}
+	edge_iterator_range undirectedEdges() const
+	{
+		return edges(AdjacencyArray::UNDIRECTED);
+	}
+	Edge* outEdgeAt(const degree_t i) const
+	{
+		assert(i < outDegree());
+		return edges_.begin(AdjacencyArray::OUT)[i];
+	}
+	Edge* inEdgeAt(const degree_t i) const
+	{
+		assert(i < inDegree());
+		return edges_.begin(AdjacencyArray::IN)[i];
+	}
+	Edge* undirectedEdgeAt(const degree_t i) const
+	{
+		assert(i < undirectedDegree());
+		return edges_.begin(AdjacencyArray::UNDIRECTED)[i];
+	}
+	OutNeighborIteratorRange outNeighbors()
+	{
+		edge_iterator_range r = outEdges();
+		return OutNeighborIteratorRange(OutNeighborIterator(r.first, id()),
+				OutNeighborIterator(r.second, id()));
+	}
+	ConstOutNeighborIteratorRange outNeighbors() const
+	{
+		edge_iterator_range r = outEdges();
+		return ConstOutNeighborIteratorRange(ConstOutNeighborIterator(r.first,
+				id()), ConstOutNeighborIterator(r.second, id()));
+	}
+	InNeighborIteratorRange inNeighbors()
+	{
+		edge_iterator_range r = inEdges();
+		return InNeighborIteratorRange(InNeighborIterator(r.first, id()),
+				InNeighborIterator(r.second, id()));
+	}
+	ConstInNeighborIteratorRange inNeighbors() const
+	{
+		edge_iterator_range r = inEdges();
+		return ConstInNeighborIteratorRange(ConstInNeighborIterator(r.first,
+				id()), ConstInNeighborIterator(r.second, id()));
+	}
+	ConstUndirectedNeighborIteratorRange undirectedNeighbors() const
+	{
+		edge_iterator_range r = undirectedEdges();
+		return ConstUndirectedNeighborIteratorRange(
+				ConstUndirectedNeighborIterator(r.first, id()),
+				ConstUndirectedNeighborIterator(r.second, id()));
+	}
+	UndirectedNeighborIteratorRange undirectedNeighbors()
+	{
+		edge_iterator_range r = undirectedEdges();
+		return UndirectedNeighborIteratorRange(UndirectedNeighborIterator(
+				r.first, id()), UndirectedNeighborIterator(r.second, id()));
+	}
+	size_t memoryUsage(size_t& adjacency, size_t& unused) const
+	{
+		adjacency = edges_.heapMemory();
+		unused = (adjacency > 0) ? (edges_.capacity() - edges_.size())
+				* sizeof(Edge*) : 0;
+		return sizeof(CompactNode);
+	}
+
+protected:
+	void registerEdge(const Edge* e);
+	void registerEdgeUnchecked(const Edge* e);
+	void unregisterEdge(const Edge* e);
+
+private:
+	/**
+	 * Store @p e in the adjacency array, optionally rejecting parallel edges
+	 * @throw SingletonException if @p checked and @p e is a parallel edge
+	 */
+	void insertEdge(const Edge* e, bool checked);
+	edge_iterator_range edges(AdjacencyArray::Segment s) const
+	{
+		return edge_iterator_range(edge_iterator(edges_.begin(s)),
+				edge_iterator(edges_.end(s)));
+	}
+
+	AdjacencyArray edges_;
+};
+
+}
+
+#endif /* COMPACTNODE_H_ */
@@ -28,6 +28,14 @@ void Edge::connect()
 	target_->registerEdge(this);
 }
 
+void Edge::connectUnchecked()
+{
+	if ((source_ == 0) || (target_ == 0))
+		return;
+	source_->registerEdgeUnchecked(this);
+	target_->registerEdgeUnchecked(this);
+}
+
 void Edge::disconnect()
 {
 	if (source_ != 0)
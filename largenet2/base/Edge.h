@@ -10,6 +10,7 @@
 #include <largenet2/base/types.h>
 #include <largenet2/base/exceptions.h>
 #include <boost/noncopyable.hpp>
+#include <new>
 
 namespace largenet
 {
@@ -52,6 +53,38 @@ public:
 	 * @return
 	 */
 	static Edge* create(edge_id_t id, Node& source, Node& target, bool directed);
+	/**
+	 * Edge factory method using preallocated memory.
+	 *
+	 * Creates a new edge in the memory pointed to by @p place, which must be
+	 * suitably aligned and at least sizeof(Edge) bytes large. If the edge
+	 * cannot be connected, it is destroyed again and the exception is
+	 * rethrown; @p place is then left to the caller.
+	 * @param place memory to construct the edge in
+	 * @param id Edge ID
+	 * @param source source node
+	 * @param target target node
+	 * @param directed create directed edge?
+	 * @return
+	 */
+	static Edge* create(void* place, edge_id_t id, Node& source, Node& target, bool directed);
+	/**
+	 * Edge factory method for edges known not to be parallel to an existing
+	 * edge.
+	 *
+	 * Like create(), but lets the nodes skip their search for parallel edges.
+	 * The caller must guarantee that no edge between @p source and @p target
+	 * with the same directionality exists yet.
+	 * @see Node::registerEdgeUnchecked
+	 */
+	static Edge* createUnchecked(edge_id_t id, Node& source, Node& target, bool directed);
+	/**
+	 * Edge factory method for edges known not to be parallel to an existing
+	 * edge, using preallocated memory.
+	 * @see create(void*, edge_id_t, Node&, Node&, bool)
+	 * @see createUnchecked(edge_id_t, Node&, Node&, bool)
+	 */
+	static Edge* createUnchecked(void* place, edge_id_t id, Node& source, Node& target, bool directed);
 	/**
 	 * Destructor
 	 *
@@ -131,18 +164,54 @@ public:
 		else
 			return (source_ == &to) || (target_ == &to);
 	}
+	/**
+	 * Memory used by this edge object, in bytes
+	 */
+	virtual size_t memoryUsage() const { return sizeof(Edge); }
 
 protected:
 	/**
 	 * Connect and register with source and target nodes.
 	 */
 	void connect();
+	/**
+	 * Connect and register with source and target nodes, skipping the
+	 * nodes' search for parallel edges.
+	 */
+	void connectUnchecked();
 	/**
 	 * Disconnect and unregister from source and target nodes.
 	 */
 	void disconnect();
 
 private:
+	friend class Graph; // renumbers edges in Graph::compact(), rewires and clears them
+	/**
+	 * Set edge ID
+	 */
+	void setId(edge_id_t id) { id_ = id; }
+	/**
+	 * Connect this edge to other nodes, keeping its ID and directionality.
+	 * The caller must guarantee that it does not become parallel to an
+	 * existing edge (@see connectUnchecked).
+	 */
+	void relink(Node& source, Node& target)
+	{
+		disconnect();
+		source_ = &source;
+		target_ = &target;
+		connectUnchecked();
+	}
+	/**
+	 * Forget the end nodes without unregistering from them, when they are
+	 * destroyed along with this edge.
+	 */
+	void detach()
+	{
+		source_ = 0;
+		target_ = 0;
+	}
+
 	edge_id_t id_;
 	Node* source_;
 	Node* target_;
@@ -163,6 +232,48 @@ inline Edge* Edge::create(const edge_id_t id, Node& source, Node& target, bool d
 	return e;
 }
 
+inline Edge* Edge::create(void* place, const edge_id_t id, Node& source, Node& target, bool directed)
+{
+	Edge* e = new (place) Edge(id, source, target, directed);
+	try
+	{
+		e->connect();
+	} catch (largenet::SingletonException&)
+	{
+		e->~Edge();
+		throw ;
+	}
+	return e;
+}
+
+inline Edge* Edge::createUnchecked(const edge_id_t id, Node& source, Node& target, bool directed)
+{
+	Edge* e = new Edge(id, source, target, directed);
+	try
+	{
+		e->connectUnchecked();
+	} catch (...)
+	{
+		delete e;
+		throw ;
+	}
+	return e;
+}
+
+inline Edge* Edge::createUnchecked(void* place, const edge_id_t id, Node& source, Node& target, bool directed)
+{
+	Edge* e = new (place) Edge(id, source, target, directed);
+	try
+	{
+		e->connectUnchecked();
+	} catch (...)
+	{
+		e->~Edge();
+		throw ;
+	}
+	return e;
+}
+
 inline bool Edge::operator ==(const Edge& e) const
 {
 	bool val = (source_ == e.source_) && (target_ == e.target_);
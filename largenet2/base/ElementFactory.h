@@ -8,13 +8,12 @@
 #define ELEMENTFACTORY_H_
 
 #include <largenet2/base/types.h>
+#include <largenet2/base/Node.h>
+#include <largenet2/base/Edge.h>
 
 namespace largenet
 {
 
-class Node;
-class Edge;
-
 /**
  * Basic graph element factory used to create nodes and edges as required.
  */
@@ -48,9 +47,124 @@ public:
 	{
 		return doCreateEdge(id, source, target, directed);
 	}
+	/**
+	 * Create a new edge with ID @p id connecting @p source and @p target,
+	 * which are known not to be connected by an edge of the same
+	 * directionality yet.
+	 *
+	 * Factories may skip the search for parallel edges in this case.
+	 * @see Edge::createUnchecked
+	 */
+	Edge* createEdgeUnchecked(edge_id_t id, Node& source, Node& target, bool directed)
+	{
+		return doCreateEdgeUnchecked(id, source, target, directed);
+	}
+	/**
+	 * Destroy node @p n, which must have been created by this factory
+	 * @param n pointer to node
+	 */
+	void destroy(Node* n)
+	{
+		doDestroyNode(n);
+	}
+	/**
+	 * Destroy edge @p e, which must have been created by this factory
+	 * @param e pointer to edge
+	 */
+	void destroy(Edge* e)
+	{
+		doDestroyEdge(e);
+	}
+	/**
+	 * Notify the factory that all elements it created have been destroyed.
+	 *
+	 * Factories that manage their own memory may use this to recycle it
+	 * in bulk.
+	 */
+	void reset()
+	{
+		doReset();
+	}
+	/**
+	 * Create a new factory of the same type, e.g. for a copy of a graph
+	 * (@see Graph::clone).
+	 *
+	 * The new factory shares no state with this one.
+	 * @return pointer to the new factory, or 0 if this factory cannot be
+	 * duplicated
+	 */
+	ElementFactory* clone() const
+	{
+		return doClone();
+	}
+	/**
+	 * Memory the factory holds for creating elements, e.g. in a memory pool,
+	 * in bytes.
+	 * @return memory holding the elements created by this factory and room
+	 * for more, or 0 if elements are allocated individually on the heap
+	 */
+	size_t memoryUsage() const
+	{
+		return doMemoryUsage();
+	}
 private:
 	virtual Node* doCreateNode(node_id_t id) = 0;
 	virtual Edge* doCreateEdge(edge_id_t id, Node& source, Node& target, bool directed) = 0;
+	virtual Edge* doCreateEdgeUnchecked(edge_id_t id, Node& source, Node& target, bool directed)
+	{
+		return doCreateEdge(id, source, target, directed);
+	}
+	virtual void doDestroyNode(Node* n)
+	{
+		delete n;
+	}
+	virtual void doDestroyEdge(Edge* e)
+	{
+		delete e;
+	}
+	virtual void doReset()
+	{
+	}
+	virtual size_t doMemoryUsage() const
+	{
+		return 0;
+	}
+	virtual ElementFactory* doClone() const
+	{
+		return 0;
+	}
+};
+
+/**
+ * Clone allocator for repo::CPtrRepository that hands elements back to the
+ * ElementFactory that created them.
+ *
+ * Without a factory, elements are deleted (like boost::heap_clone_allocator).
+ */
+class ElementFactoryCloneAllocator
+{
+public:
+	ElementFactoryCloneAllocator() :
+		elf_(0)
+	{
+	}
+	explicit ElementFactoryCloneAllocator(ElementFactory* elf) :
+		elf_(elf)
+	{
+	}
+	template<class U>
+	void deallocate_clone(const U* r)
+	{
+		U* p = const_cast<U*>(r); // here be dragons
+		if (p == 0)
+			return;
+		if (elf_ != 0)
+			elf_->destroy(p);
+		else
+			delete p;
+	}
+private:
+	ElementFactory* elf_;
 };
 
 }
@@ -0,0 +1,108 @@
+/**
+ * @file ElementPool.cpp
+ * @date 17.10.2026
+ */
+
+#include <largenet2/base/ElementPool.h>
+#include <cassert>
+#include <new>
+
+namespace largenet
+{
+
+ElementPool::ElementPool() :
+	inUse_(0)
+{
+}
+
+ElementPool::~ElementPool()
+{
+	release();
+}
+
+void* ElementPool::allocate(const std::size_t size)
+{
+	SizeClass& c = sizeClass(size);
+	void* p = c.free;
+	if (p != 0)
+		c.free = *static_cast<void**>(p);
+	else
+	{
+		if (c.next == c.end)
+			nextSlab(c);
+		p = c.next;
+		c.next += c.slotSize;
+	}
+	++inUse_;
+	return p;
+}
+
+void ElementPool::deallocate(void* p, const std::size_t size)
+{
+	if (p == 0)
+		return;
+	assert(inUse_ > 0);
+	SizeClass& c = sizeClass(size);
+	*static_cast<void**>(p) = c.free;
+	c.free = p;
+	--inUse_;
+}
+
+void ElementPool::reset()
+{
+	for (std::vector<SizeClass>::iterator c = classes_.begin(); c
+			!= classes_.end(); ++c)
+	{
+		c->used = 0;
+		c->free = 0;
+		c->next = c->end = 0;
+	}
+	inUse_ = 0;
+}
+
+void ElementPool::release()
+{
+	for (std::vector<SizeClass>::iterator c = classes_.begin(); c
+			!= classes_.end(); ++c)
+	{
+		for (std::vector<char*>::iterator s = c->slabs.begin(); s
+				!= c->slabs.end(); ++s)
+			::operator delete(*s);
+	}
+	classes_.clear();
+	inUse_ = 0;
+}
+
+std::size_t ElementPool::capacity() const
+{
+	std::size_t bytes = 0;
+	for (std::vector<SizeClass>::const_iterator c = classes_.begin(); c
+			!= classes_.end(); ++c)
+		bytes += c->slabs.size() * c->slotSize * slab_slots;
+	return bytes;
+}
+
+ElementPool::SizeClass& ElementPool::sizeClass(const std::size_t size)
+{
+	// slots must be able to hold the free list link
+	const std::size_t i = (size > 0) ? (size - 1) / alignment : 0;
+	if (i >= classes_.size())
+	{
+		classes_.resize(i + 1);
+		for (std::size_t k = 0; k < classes_.size(); ++k)
+			classes_[k].slotSize = (k + 1) * alignment;
+	}
+	return classes_[i];
+}
+
+void ElementPool::nextSlab(SizeClass& c)
+{
+	const std::size_t bytes = c.slotSize * slab_slots;
+	if (c.used == c.slabs.size())
+		c.slabs.push_back(static_cast<char*> (::operator new(bytes)));
+	c.next = c.slabs[c.used];
+	c.end = c.next + bytes;
+	++c.used;
+}
+
+}
@@ -0,0 +1,105 @@
+/**
+ * @file ElementPool.h
+ * @date 17.10.2026
+ */
+
+#ifndef ELEMENTPOOL_H_
+#define ELEMENTPOOL_H_
+
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace largenet
+{
+
+/**
+ * Slab allocator for graph elements.
+ *
+ * Memory is handed out in slots of a few size classes (multiples of
+ * @ref alignment bytes), which are carved out of larger slabs. Freed slots are
+ * kept on a free list per size class and reused last-in first-out, so that
+ * a node or edge created right after another one was removed occupies the
+ * memory that is most likely still in cache.
+ *
+ * reset() makes all slots available again at once without returning the
+ * slabs to the heap, so that a pool that has been used once does not need to
+ * allocate any more memory for graphs of the same size. release() returns
+ * all slabs to the heap.
+ *
+ * The pool does not know about the objects it stores: callers are
+ * responsible for constructing and destroying them, and must pass the same
+ * size to deallocate() that they passed to allocate().
+ */
+class ElementPool: public boost::noncopyable
+{
+public:
+	enum
+	{
+		alignment = 16, ///< Slot sizes are multiples of this
+		slab_slots = 256 ///< Number of slots per slab
+	};
+
+	ElementPool();
+	~ElementPool();
+	/**
+	 * Allocate memory for an object of @p size bytes
+	 * @param size object size in bytes
+	 * @return pointer to uninitialized memory
+	 */
+	void* allocate(std::size_t size);
+	/**
+	 * Return memory obtained from allocate() to the pool
+	 * @param p pointer returned by allocate()
+	 * @param size object size passed to allocate()
+	 */
+	void deallocate(void* p, std::size_t size);
+	/**
+	 * Make all memory available again, keeping the slabs.
+	 *
+	 * Any objects still living in the pool must have been destroyed before.
+	 */
+	void reset();
+	/**
+	 * Return all slabs to the heap.
+	 *
+	 * Any objects still living in the pool must have been destroyed before.
+	 */
+	void release();
+	/**
+	 * Number of slots currently handed out
+	 */
+	std::size_t size() const
+	{
+		return inUse_;
+	}
+	/**
+	 * Number of bytes held in slabs
+	 */
+	std::size_t capacity() const;
+
+private:
+	struct SizeClass
+	{
+		SizeClass() :
+			slotSize(0), used(0), free(0), next(0), end(0)
+		{
+		}
+		std::size_t slotSize;
+		std::vector<char*> slabs;
+		std::size_t used; ///< number of slabs that slots have been carved from
+		void* free; ///< head of the free list
+		char* next; ///< next unused slot in the current slab
+		char* end; ///< end of the current slab
+	};
+
+	SizeClass& sizeClass(std::size_t size);
+	void nextSlab(SizeClass& c);
+
+	std::vector<SizeClass> classes_;
+	std::size_t inUse_;
+};
+
+}
+
+#endif /* ELEMENTPOOL_H_ */
@@ -3,25 +3,248 @@
 #include <largenet2/base/Edge.h>
 #include <largenet2/base/factories.h>
 #include <largenet2/base/GraphListener.h>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
 
 namespace largenet
 {
 
-Graph::Graph(const node_state_t nodeStates, const edge_state_t edgeStates) :
+namespace
+{
+template<typename state_t>
+unsigned int checkStates(const unsigned int n)
+{
+	// states 0, ..., n-1 must be representable
+	if ((n > 0) && (n - 1 > std::numeric_limits<state_t>::max()))
+		throw(std::overflow_error("Number of states exceeds range of state type."));
+	return n;
+}
+}
+
+Graph::Graph(const node_state_size_t nodeStates, const edge_state_size_t edgeStates) :
 	elf_(std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory)),
-			nodes_(nodeStates), edges_(edgeStates)
+			elfLocked_(false), nodes_(checkStates<node_state_t>(nodeStates)),
+			edges_(checkStates<edge_state_t>(edgeStates)), bound_(0)
 {
+	nodes_.setCloneAllocator(ElementFactoryCloneAllocator(elf_.get()));
+	edges_.setCloneAllocator(ElementFactoryCloneAllocator(elf_.get()));
 }
 
 Graph::~Graph()
 {
 }
 
+namespace
+{
+/// creates nodes for Graph::copyElements
+class NodeCloner
+{
+public:
+	explicit NodeCloner(ElementFactory& elf) :
+		elf_(elf)
+	{
+	}
+	Node* operator()(const Node& n) const
+	{
+		return elf_.createNode(n.id());
+	}
+private:
+	ElementFactory& elf_;
+};
+
+/// creates edges between the copied nodes for Graph::copyElements
+template<class NodeContainer>
+class EdgeCloner
+{
+public:
+	EdgeCloner(ElementFactory& elf, NodeContainer& nodes) :
+		elf_(elf), nodes_(nodes)
+	{
+	}
+	Edge* operator()(const Edge& e) const
+	{
+		// the original edges cannot be parallel to each other unless the
+		// node type allows it
+		return elf_.createEdgeUnchecked(e.id(), nodes_[e.source()->id()],
+				nodes_[e.target()->id()], e.isDirected());
+	}
+private:
+	ElementFactory& elf_;
+	NodeContainer& nodes_;
+};
+}
+
+std::auto_ptr<Graph> Graph::clone() const
+{
+	std::auto_ptr<ElementFactory> elf(elf_->clone());
+	if (elf.get() == 0)
+		throw(std::logic_error("Cannot duplicate element factory."));
+	std::auto_ptr<Graph> g(new Graph(numberOfNodeStates(), numberOfEdgeStates()));
+	g->setElementFactory(elf);
+	g->copyElements(*this);
+	return g;
+}
+
+void Graph::copyElements(const Graph& g)
+{
+	assert((numberOfNodes() == 0) && (numberOfEdges() == 0));
+	assert(numberOfNodeStates() == g.numberOfNodeStates());
+	assert(numberOfEdgeStates() == g.numberOfEdgeStates());
+	nodes_.assign(g.nodes_, NodeCloner(*elf_));
+	edges_.assign(g.edges_, EdgeCloner<NodeContainer> (*elf_, nodes_));
+}
+
+void Graph::swap(Graph& g)
+{
+	if ((elfLocked_ || g.elfLocked_) && (typeid(*elf_) != typeid(*g.elf_)))
+		throw(std::logic_error("Cannot swap graphs with different locked element factories."));
+	beforeGraphClear();
+	g.beforeGraphClear();
+	swapElements(g);
+	afterGraphReload();
+	g.afterGraphReload();
+}
+
+void Graph::swapElements(Graph& g)
+{
+	ElementFactory* elf = elf_.release();
+	elf_.reset(g.elf_.release());
+	g.elf_.reset(elf);
+	nodes_.swap(g.nodes_);
+	edges_.swap(g.edges_);
+	undo_.swap(g.undo_);
+	transactions_.swap(g.transactions_);
+}
+
 void Graph::clear()
 {
+	if (inTransaction())
+		throw(std::logic_error("Cannot clear graph during a transaction."));
 	beforeGraphClear();
+	// all nodes go as well, so edges need not unregister from them one by one
+	for (DenseEdgeIterator it = edges_.denseItems().first; it
+			!= edges_.denseItems().second; ++it)
+		it->detach();
 	edges_.clear();
 	nodes_.clear();
+	elf_->reset();
+}
+
+MemoryUsage Graph::memoryUsage() const
+{
+	MemoryUsage m;
+	for (ConstDenseNodeIterator it = nodes_.denseItems().first; it
+			!= nodes_.denseItems().second; ++it)
+	{
+		size_t adjacency = 0, unused = 0;
+		m.nodes += it->memoryUsage(adjacency, unused);
+		m.adjacency += adjacency;
+		m.unused += unused;
+	}
+	for (ConstDenseEdgeIterator it = edges_.denseItems().first; it
+			!= edges_.denseItems().second; ++it)
+		m.edges += it->memoryUsage();
+	m.repositories = nodes_.memoryUsage() + edges_.memoryUsage()
+			+ undo_.capacity() * sizeof(detail::UndoRecord)
+			+ transactions_.capacity() * sizeof(size_t)
+			+ changedEdges_.capacity() * sizeof(edge_id_t)
+			+ oldEdgeStates_.capacity() * sizeof(edge_state_t);
+	m.unused += nodes_.unusedMemory() + edges_.unusedMemory();
+	// pooled elements live in the pool, so only its remainder is extra
+	const size_t pool = elf_->memoryUsage();
+	if (pool > m.nodes + m.edges)
+	{
+		m.pool = pool - m.nodes - m.edges;
+		m.unused += m.pool;
+	}
+	for (ListenerContainer::const_iterator it = listeners_.begin(); it
+			!= listeners_.end(); ++it)
+		m.listeners += (*it)->memoryUsage();
+	if (bound_ != 0)
+		m.listeners += bound_->memoryUsage();
+	return m;
+}
+
+void Graph::compact()
+{
+	if (inTransaction())
+		throw(std::logic_error("Cannot compact graph during a transaction."));
+	std::vector<node_id_t> nodeIds;
+	std::vector<edge_id_t> edgeIds;
+	nodes_.compact(nodeIds);
+	edges_.compact(edgeIds);
+	for (DenseNodeIterator it = nodes_.denseItems().first; it
+			!= nodes_.denseItems().second; ++it)
+		it->setId(it.id());
+	for (DenseEdgeIterator it = edges_.denseItems().first; it
+			!= edges_.denseItems().second; ++it)
+		it->setId(it.id());
+	afterGraphCompact(nodeIds, edgeIds);
+}
+
+std::vector<node_id_t> Graph::relabel(const std::vector<node_id_t>& order)
+{
+	if (inTransaction())
+		throw(std::logic_error("Cannot relabel graph during a transaction."));
+	if (order.size() != numberOfNodes())
+		throw(std::invalid_argument("Node order must list every node once."));
+	const node_id_t none = std::numeric_limits<node_id_t>::max();
+	std::vector<node_id_t> nodeIds(numberOfNodes() > 0 ? nodes_.maxID() + 1 : 0,
+			none);
+	for (node_size_t i = 0; i < order.size(); ++i)
+	{
+		if (!nodes_.valid(order[i]) || (nodeIds[order[i]] != none))
+			throw(std::invalid_argument("Node order must list every node once."));
+		nodeIds[order[i]] = i;
+	}
+	std::auto_ptr<ElementFactory> elf(elf_->clone());
+	if (elf.get() == 0)
+		throw(std::logic_error("Cannot duplicate element factory."));
+
+	// build the relabeled graph, then exchange it with this one
+	Graph g(numberOfNodeStates(), numberOfEdgeStates());
+	g.setElementFactory(elf);
+	g.setSegmentBits(nodes_.segmentBits());
+	g.setIndexedStates(nodes_.indexedCategories());
+	g.reserve(numberOfNodes(), numberOfEdges());
+	for (node_size_t i = 0; i < order.size(); ++i)
+	{
+		assert(g.nodes_.nextInsertId() == i);
+		g.nodes_.insert(g.elf_->createNode(i), nodeState(order[i]));
+	}
+	std::vector<edge_id_t> edgeIds(numberOfEdges() > 0 ? edges_.maxID() + 1
+			: 0, std::numeric_limits<edge_id_t>::max());
+	edge_id_t next = 0;
+	for (node_size_t i = 0; i < order.size(); ++i)
+	{
+		// incoming directed edges are taken with their source
+		const Node& n = nodes_[order[i]];
+		const Node::edge_iterator_range r[] = { n.outEdges(),
+				n.undirectedEdges() };
+		for (size_t k = 0; k < 2; ++k)
+		{
+			for (Node::edge_iterator it = r[k].first; it != r[k].second; ++it)
+			{
+				const Edge& e = **it;
+				if (edgeIds[e.id()] != std::numeric_limits<edge_id_t>::max())
+					continue;
+				edgeIds[e.id()] = next;
+				assert(g.edges_.nextInsertId() == next);
+				g.edges_.insert(g.elf_->createEdgeUnchecked(next,
+						g.nodes_[nodeIds[e.source()->id()]],
+						g.nodes_[nodeIds[e.target()->id()]], e.isDirected()),
+						edgeState(e.id()));
+				++next;
+			}
+		}
+	}
+	assert(next == numberOfEdges());
+	swapElements(g);
+	// the old elements go with g, which need not notify its nodes
+	g.clear();
+	afterGraphCompact(nodeIds, edgeIds);
+	return nodeIds;
 }
 
 void Graph::setNodeState(const node_id_t n, const node_state_t s)
@@ -29,8 +252,9 @@ void Graph::setNodeState(const node_id_t n, const node_state_t s)
 	const node_state_t old = nodeState(n);
 	if (s == old)
 		return;
-	nodes_.setCategory(n, s);
-	afterNodeStateChange(n, old, s);
+	changeNodeState(n, old, s);
+	if (bound_)
+		bound_->afterNodeStateChange(*this, *node(n), old, s);
 }
 
 void Graph::setEdgeState(const edge_id_t e, const edge_state_t s)
@@ -38,8 +262,49 @@ void Graph::setEdgeState(const edge_id_t e, const edge_state_t s)
 	const edge_state_t old = edgeState(e);
 	if (s == old)
 		return;
-	edges_.setCategory(e, s);
-	afterEdgeStateChange(e, old, s);
+	changeEdgeState(e, old, s);
+	if (bound_)
+		bound_->afterEdgeStateChange(*this, *edge(e), old, s);
+}
+
+void Graph::setEdgeStates(const std::vector<edge_id_t>& edges,
+		const std::vector<edge_state_t>& states)
+{
+	assert(edges.size() == states.size());
+	if (!hasListeners())
+	{
+		for (size_t i = 0; i < edges.size(); ++i)
+		{
+			const edge_state_t old = edgeState(edges[i]);
+			if (old == states[i])
+				continue;
+			logUndo(detail::UndoRecord(detail::UndoRecord::EDGE_STATE, edges[i], old));
+			edges_.setCategory(edges[i], states[i]);
+		}
+		return;
+	}
+	// take the buffers out of the members, as listeners may change edge
+	// states again and re-enter here
+	std::vector<edge_id_t> changed;
+	std::vector<edge_state_t> oldStates;
+	changed.swap(changedEdges_);
+	oldStates.swap(oldEdgeStates_);
+	changed.clear();
+	oldStates.clear();
+	for (size_t i = 0; i < edges.size(); ++i)
+	{
+		const edge_state_t old = edgeState(edges[i]);
+		if (old == states[i])
+			continue;
+		logUndo(detail::UndoRecord(detail::UndoRecord::EDGE_STATE, edges[i], old));
+		edges_.setCategory(edges[i], states[i]);
+		changed.push_back(edges[i]);
+		oldStates.push_back(old);
+	}
+	if (!changed.empty())
+		afterEdgeStatesChange(changed, oldStates);
+	changedEdges_.swap(changed);
+	oldEdgeStates_.swap(oldStates);
 }
 
 node_id_t Graph::addNode()
@@ -56,41 +321,79 @@ node_id_t Graph::addNode(const node_state_t s)
 #endif
 			nodes_.insert(elf_->createNode(id), s);
 	assert(nid == id);
+	logUndo(detail::UndoRecord(detail::UndoRecord::NODE_ADD, id));
 	afterNodeAdd(id);
 	return id;
 }
 
 edge_id_t Graph::addEdge(const node_id_t source, const node_id_t target, bool directed)
 {
-	edge_id_t id = edges_.nextInsertId();
-	Edge* e = 0;
-	try
+	return tryAddEdge(source, target, directed).first;
+}
+
+std::pair<edge_id_t, bool> Graph::tryAddEdge(const node_id_t source,
+		const node_id_t target, const bool directed)
+{
+	if (!node(source)->allowsParallelEdges())
 	{
-		e = elf_->createEdge(id, *node(source), *node(target), directed);
-		edges_.insert(e);
-		afterEdgeAdd(id);
-	} catch (SingletonException&)
+		const Edge* e = findEdge(source, target, directed);
+		if (e != 0)
+			return std::make_pair(e->id(), false);
+	}
+	const edge_id_t id = insertEdge(source, target, directed, false)->id();
+	afterEdgeAdd(id);
+	return std::make_pair(id, true);
+}
+
+void Graph::addNodes(const node_size_t n, const node_state_t s)
+{
+	assert(s < nodes_.numberOfCategories());
+	nodes_.reserve(nodes_.size() + n);
+	std::vector<node_id_t> added;
+	if (hasListeners())
+		added.reserve(n);
+	for (node_size_t i = 0; i < n; ++i)
 	{
-		// edge exists and we do not allow multiple edges
-		if (directed)
-			id = node(source)->edgeTo(node(target))->id();
-		else
-			id = node(source)->edgeToAdjacentNode(node(target))->id();
+		const node_id_t id = nodes_.insert(elf_->createNode(nodes_.nextInsertId()), s);
+		logUndo(detail::UndoRecord(detail::UndoRecord::NODE_ADD, id));
+		if (hasListeners())
+			added.push_back(id);
 	}
-	return id;
+	if (!added.empty())
+		afterNodesAdd(added);
+}
+
+Edge* Graph::insertEdge(const node_id_t source, const node_id_t target,
+		const bool directed, const bool checked)
+{
+	// look for parallel edges here rather than letting the nodes throw,
+	// which is much cheaper when many edges exist already
+	if (checked && !node(source)->allowsParallelEdges() && (findEdge(source,
+			target, directed) != 0))
+		return 0;
+	Edge* e = elf_->createEdgeUnchecked(edges_.nextInsertId(), *node(source),
+			*node(target), directed);
+	edges_.insert(e);
+	logUndo(detail::UndoRecord(detail::UndoRecord::EDGE_ADD, e->id()));
+	return e;
 }
 
 void Graph::removeNode(const node_id_t n)
 {
 	assert(nodes_.valid(n));
 	beforeNodeRemove(n);
-	// remove adjacent edges
-	Node::edge_iterator_range iters = node(n)->outEdges();
-	for (Node::edge_iterator it = iters.first; it != iters.second; ++it)
-		removeEdge((*it)->id());
-	iters = node(n)->inEdges();
-	for (Node::edge_iterator it = iters.first; it != iters.second; ++it)
-		removeEdge((*it)->id());
+	// remove adjacent edges; removing an edge modifies the node's edge
+	// containers, so we always remove the first remaining one
+	Node* nd = node(n);
+	while (nd->outDegree() > 0)
+		removeEdge((*nd->outEdges().first)->id());
+	while (nd->inDegree() > 0)
+		removeEdge((*nd->inEdges().first)->id());
+	while (nd->undirectedDegree() > 0)
+		removeEdge((*nd->undirectedEdges().first)->id());
+	if (inTransaction())
+		logUndo(detail::UndoRecord(detail::UndoRecord::NODE_REMOVE, n,
+				nodeState(n)));
 	nodes_.erase(n);
 }
 
@@ -98,9 +401,138 @@ void Graph::removeEdge(const edge_id_t e)
 {
 	assert(edges_.valid(e));
 	beforeEdgeRemove(e);
+	if (inTransaction())
+	{
+		const Edge* ed = edge(e);
+		logUndo(detail::UndoRecord(detail::UndoRecord::EDGE_REMOVE, e,
+				edgeState(e), ed->source()->id(), ed->target()->id(),
+				ed->isDirected()));
+	}
 	edges_.erase(e);
 }
 
+bool Graph::rewireEdge(const edge_id_t e, const node_id_t newSource,
+		const node_id_t newTarget)
+{
+	if (!canRewireEdge(e, newSource, newTarget))
+		return false;
+	rewireEdgeUnchecked(e, newSource, newTarget);
+	return true;
+}
+
+bool Graph::moveEdgeEndpoint(const edge_id_t e, const node_id_t oldEnd,
+		const node_id_t newEnd)
+{
+	const std::pair<node_id_t, node_id_t> ends = movedEnds(e, oldEnd, newEnd);
+	return rewireEdge(e, ends.first, ends.second);
+}
+
+bool Graph::canRewireEdge(const edge_id_t e, const node_id_t newSource,
+		const node_id_t newTarget) const
+{
+	assert(edges_.valid(e));
+	if (node(newSource)->allowsParallelEdges())
+		return true;
+	const Edge* p = findEdge(newSource, newTarget, edge(e)->isDirected());
+	return (p == 0) || (p == edge(e));
+}
+
+void Graph::rewireEdgeUnchecked(const edge_id_t e, const node_id_t newSource,
+		const node_id_t newTarget)
+{
+	Edge* ed = edge(e);
+	const node_id_t oldSource = ed->source()->id(), oldTarget =
+			ed->target()->id();
+	beforeEdgeRewire(e, newSource, newTarget);
+	logUndo(detail::UndoRecord(detail::UndoRecord::EDGE_REWIRE, e, 0,
+			oldSource, oldTarget));
+	ed->relink(*node(newSource), *node(newTarget));
+	afterEdgeRewire(e, oldSource, oldTarget);
+}
+
+std::pair<node_id_t, node_id_t> Graph::movedEnds(const edge_id_t e,
+		const node_id_t oldEnd, const node_id_t newEnd) const
+{
+	const Edge* ed = edge(e);
+	if (ed->target()->id() == oldEnd)
+		return std::make_pair(ed->source()->id(), newEnd);
+	if (ed->source()->id() == oldEnd)
+		return std::make_pair(newEnd, ed->target()->id());
+	throw(std::invalid_argument("Node is not an end of the edge."));
+}
+
+void Graph::beginTransaction()
+{
+	transactions_.push_back(undo_.size());
+}
+
+void Graph::commit()
+{
+	if (!inTransaction())
+		throw(std::logic_error("No transaction to commit."));
+	transactions_.pop_back();
+	if (!inTransaction())
+	{
+		undo_.clear();
+		afterTransactionCommit();
+	}
+}
+
+void Graph::rollback()
+{
+	if (!inTransaction())
+		throw(std::logic_error("No transaction to roll back."));
+	const size_t start = transactions_.back();
+	transactions_.pop_back();
+	// the undo steps, and changes that listeners make in response to them,
+	// must not be recorded themselves
+	std::vector<size_t> open;
+	open.swap(transactions_);
+	for (size_t i = undo_.size(); i > start; --i)
+		undo(undo_[i - 1]);
+	open.swap(transactions_);
+	undo_.erase(undo_.begin() + start, undo_.end());
+}
+
+void Graph::undo(const detail::UndoRecord& r)
+{
+	// IDs of removed elements are reused last in, first out, so undoing in
+	// reverse order restores the previous IDs; this is checked also in
+	// release builds, as an element whose ID differs from its slot would
+	// corrupt the graph unnoticed
+	switch (r.kind)
+	{
+	case detail::UndoRecord::NODE_ADD:
+		removeNode(r.id);
+		break;
+	case detail::UndoRecord::NODE_REMOVE:
+		if (nodes_.nextInsertId() != r.id)
+			throw(std::logic_error("Cannot restore ID of removed node."));
+		nodes_.insert(elf_->createNode(r.id), r.state);
+		afterNodeRestore(r.id);
+		break;
+	case detail::UndoRecord::EDGE_ADD:
+		removeEdge(r.id);
+		break;
+	case detail::UndoRecord::EDGE_REMOVE:
+		if (edges_.nextInsertId() != r.id)
+			throw(std::logic_error("Cannot restore ID of removed edge."));
+		edges_.insert(elf_->createEdgeUnchecked(r.id, *node(r.source),
+				*node(r.target), r.directed), r.state);
+		afterEdgeRestore(r.id);
+		break;
+	case detail::UndoRecord::NODE_STATE:
+		setNodeState(r.id, r.state);
+		break;
+	case detail::UndoRecord::EDGE_STATE:
+		setEdgeState(r.id, r.state);
+		break;
+	case detail::UndoRecord::EDGE_REWIRE:
+		rewireEdgeUnchecked(r.id, r.source, r.target);
+		break;
+	}
+}
+
 Graph::NodeIteratorRange Graph::nodes()
 {
 	return std::make_pair(NodeIterator(nodes_.begin()), NodeIterator(
@@ -153,7 +585,26 @@ bool Graph::isEdge(const node_id_t source, const node_id_t target) const
 {
 	assert(nodes_.valid(source));
 	assert(nodes_.valid(target));
-	return node(source)->hasEdgeTo(node(target)) || node(source)->hasUndirectedEdgeTo(node(target));
+	return (node(source)->findEdgeTo(node(target)) != 0)
+			|| (node(source)->findUndirectedEdgeTo(node(target)) != 0);
+}
+
+Edge* Graph::findEdge(const node_id_t source, const node_id_t target,
+		const bool directed)
+{
+	assert(nodes_.valid(source));
+	assert(nodes_.valid(target));
+	return directed ? node(source)->findEdgeTo(node(target))
+			: node(source)->findUndirectedEdgeTo(node(target));
+}
+
+const Edge* Graph::findEdge(const node_id_t source, const node_id_t target,
+		const bool directed) const
+{
+	assert(nodes_.valid(source));
+	assert(nodes_.valid(target));
+	return directed ? node(source)->findEdgeTo(node(target))
+			: node(source)->findUndirectedEdgeTo(node(target));
 }
 
 bool Graph::adjacent(const node_id_t n1, const node_id_t n2) const
@@ -169,6 +620,8 @@ void Graph::afterNodeAdd(const node_id_t n)
 	for (ListenerContainer::iterator i = listeners_.begin(); i
 			!= listeners_.end(); ++i)
 		(*i)->afterNodeAdd(*this, *node(n));
+	if (bound_)
+		bound_->afterNodeAdd(*this, *node(n));
 }
 
 void Graph::afterEdgeAdd(const edge_id_t e)
@@ -177,10 +630,32 @@ void Graph::afterEdgeAdd(const edge_id_t e)
 	for (ListenerContainer::iterator i = listeners_.begin(); i
 			!= listeners_.end(); ++i)
 		(*i)->afterEdgeAdd(*this, *edge(e));
+	if (bound_)
+		bound_->afterEdgeAdd(*this, *edge(e));
+}
+
+void Graph::afterNodesAdd(const std::vector<node_id_t>& nodes)
+{
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterNodesAdd(*this, nodes);
+	if (bound_)
+		bound_->afterNodesAdd(*this, nodes);
+}
+
+void Graph::afterEdgesAdd(const std::vector<edge_id_t>& edges)
+{
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterEdgesAdd(*this, edges);
+	if (bound_)
+		bound_->afterEdgesAdd(*this, edges);
 }
 
 void Graph::beforeNodeRemove(const node_id_t n)
 {
+	if (bound_)
+		bound_->beforeNodeRemove(*this, *node(n));
 	for (ListenerContainer::iterator i = listeners_.begin(); i
 			!= listeners_.end(); ++i)
 		(*i)->beforeNodeRemove(*this, *node(n));
@@ -188,18 +663,101 @@ void Graph::beforeNodeRemove(const node_id_t n)
 
 void Graph::beforeEdgeRemove(const edge_id_t e)
 {
+	if (bound_)
+		bound_->beforeEdgeRemove(*this, *edge(e));
 	for (ListenerContainer::iterator i = listeners_.begin(); i
 			!= listeners_.end(); ++i)
 		(*i)->beforeEdgeRemove(*this, *edge(e));
 }
 
+void Graph::beforeEdgeRewire(const edge_id_t e, const node_id_t newSource,
+		const node_id_t newTarget)
+{
+	if (bound_)
+		bound_->beforeEdgeRewire(*this, *edge(e), *node(newSource),
+				*node(newTarget));
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->beforeEdgeRewire(*this, *edge(e), *node(newSource),
+				*node(newTarget));
+}
+
+void Graph::afterEdgeRewire(const edge_id_t e, const node_id_t oldSource,
+		const node_id_t oldTarget)
+{
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterEdgeRewire(*this, *edge(e), *node(oldSource),
+				*node(oldTarget));
+	if (bound_)
+		bound_->afterEdgeRewire(*this, *edge(e), *node(oldSource),
+				*node(oldTarget));
+}
+
+void Graph::afterNodeRestore(const node_id_t n)
+{
+	assert(nodes_.valid(n));
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterNodeRestore(*this, *node(n));
+	if (bound_)
+		bound_->afterNodeRestore(*this, *node(n));
+}
+
+void Graph::afterEdgeRestore(const edge_id_t e)
+{
+	assert(edges_.valid(e));
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterEdgeRestore(*this, *edge(e));
+	if (bound_)
+		bound_->afterEdgeRestore(*this, *edge(e));
+}
+
+void Graph::afterTransactionCommit()
+{
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterTransactionCommit(*this);
+	if (bound_)
+		bound_->afterTransactionCommit(*this);
+}
+
 void Graph::beforeGraphClear()
 {
+	if (bound_)
+		bound_->beforeGraphClear(*this);
 	for (ListenerContainer::iterator i = listeners_.begin(); i
 			!= listeners_.end(); ++i)
 		(*i)->beforeGraphClear(*this);
 }
 
+void Graph::afterGraphReload()
+{
+	if (!hasListeners())
+		return;
+	std::vector<node_id_t> nodes;
+	nodes.reserve(numberOfNodes());
+	for (NodeIterator it = this->nodes().first; it != this->nodes().second; ++it)
+		nodes.push_back(it.id());
+	afterNodesAdd(nodes);
+	std::vector<edge_id_t> edges;
+	edges.reserve(numberOfEdges());
+	for (EdgeIterator it = this->edges().first; it != this->edges().second; ++it)
+		edges.push_back(it.id());
+	afterEdgesAdd(edges);
+}
+
+void Graph::afterGraphCompact(const std::vector<node_id_t>& nodeIds,
+		const std::vector<edge_id_t>& edgeIds)
+{
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterGraphCompact(*this, nodeIds, edgeIds);
+	if (bound_)
+		bound_->afterGraphCompact(*this, nodeIds, edgeIds);
+}
+
 void Graph::afterNodeStateChange(const node_id_t n,
 		const node_state_t oldState, const node_state_t newState)
 {
@@ -222,4 +780,14 @@ void Graph::afterEdgeStateChange(const edge_id_t e,
 		(*i)->afterEdgeStateChange(*this, *edge(e), oldState, newState);
 }
 
+void Graph::afterEdgeStatesChange(const std::vector<edge_id_t>& edges,
+		const std::vector<edge_state_t>& oldStates)
+{
+	for (ListenerContainer::iterator i = listeners_.begin(); i
+			!= listeners_.end(); ++i)
+		(*i)->afterEdgeStatesChange(*this, edges, oldStates);
+	if (bound_)
+		bound_->afterEdgeStatesChange(*this, edges, oldStates);
+}
+
 }
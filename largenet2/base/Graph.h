@@ -4,9 +4,15 @@
 #include <largenet2/base/types.h>
 #include <largenet2/base/Node.h>
 #include <largenet2/base/Edge.h>
+#include <largenet2/base/ElementFactory.h>
 #include <largenet2/base/repo/CPtrRepository.h>
 #include <boost/noncopyable.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <iterator>
 #include <list>
+#include <vector>
 #include <utility>
 #include <memory>
 #include <stdexcept>
@@ -14,9 +20,64 @@
 namespace largenet
 {
 
-class ElementFactory;
 class GraphListener;
 
+/**
+ * Memory used by a graph, in bytes
+ *
+ * Heap memory of node adjacency containers is estimated from their sizes and
+ * does not include the overhead of the heap allocator.
+ * @see Graph::memoryUsage()
+ */
+struct MemoryUsage
+{
+	MemoryUsage() :
+		nodes(0), edges(0), adjacency(0), repositories(0), pool(0),
+				listeners(0), unused(0)
+	{
+	}
+	/**
+	 * Total memory, which includes the unused part
+	 */
+	size_t total() const
+	{
+		return nodes + edges + adjacency + repositories + pool + listeners;
+	}
+	size_t nodes; ///< node objects
+	size_t edges; ///< edge objects
+	size_t adjacency; ///< adjacency containers of the nodes
+	size_t repositories; ///< node and edge bookkeeping arrays
+	size_t pool; ///< memory pool of the element factory, apart from the live nodes and edges
+	size_t listeners; ///< data owned by the registered graph listeners
+	size_t unused; ///< allocated but unused part of the above, including the pool
+};
+
+/// @cond IGNORE
+namespace detail
+{
+/// Entry of the undo log of a graph transaction (@see Graph::beginTransaction)
+struct UndoRecord
+{
+	enum Kind
+	{
+		NODE_ADD, NODE_REMOVE, EDGE_ADD, EDGE_REMOVE, NODE_STATE, EDGE_STATE,
+		EDGE_REWIRE
+	};
+	UndoRecord(const Kind k, const edge_id_t i, const node_state_t s = 0,
+			const node_id_t src = 0, const node_id_t tgt = 0, const bool d =
+					false) :
+		kind(k), directed(d), state(s), id(i), source(src), target(tgt)
+	{
+	}
+	Kind kind;
+	bool directed; ///< of a removed edge
+	node_state_t state; ///< previous state, or state of a removed element
+	edge_id_t id; ///< node or edge ID
+	node_id_t source, target; ///< previous end nodes of a removed or rewired edge
+};
+}
+/// @endcond
+
 /**
  * The Graph class
  *
@@ -26,11 +87,16 @@ class GraphListener;
 class Graph: public boost::noncopyable
 {
 private:
-	typedef repo::CPtrRepository<Node> NodeContainer;
-	typedef repo::CPtrRepository<Edge> EdgeContainer;
+	typedef repo::CPtrRepository<Node, ElementFactoryCloneAllocator> NodeContainer;
+	typedef repo::CPtrRepository<Edge, ElementFactoryCloneAllocator> EdgeContainer;
 	typedef std::list<GraphListener*> ListenerContainer; // use boost::ptr_list if taking ownership seems better
 
 public:
+	/// node element type (generic code uses this to select node_traits)
+	typedef Node node_type;
+	/// edge element type
+	typedef Edge edge_type;
+
 	/// iterator for all nodes
 	typedef NodeContainer::iterator NodeIterator;
 	/// iterator for all nodes in given state
@@ -47,6 +113,14 @@ public:
 	typedef EdgeContainer::const_iterator ConstEdgeIterator;
 	/// const edge iterator for all edges in given state
 	typedef EdgeContainer::ConstCategoryIterator ConstEdgeStateIterator;
+	/// iterator for all nodes in storage order
+	typedef NodeContainer::DenseIterator DenseNodeIterator;
+	/// iterator for all edges in storage order
+	typedef EdgeContainer::DenseIterator DenseEdgeIterator;
+	/// const iterator for all nodes in storage order
+	typedef NodeContainer::ConstDenseIterator ConstDenseNodeIterator;
+	/// const iterator for all edges in storage order
+	typedef EdgeContainer::ConstDenseIterator ConstDenseEdgeIterator;
 
 	/// node iterator range
 	typedef std::pair<NodeIterator, NodeIterator> NodeIteratorRange;
@@ -64,16 +138,58 @@ public:
 	typedef std::pair<ConstEdgeIterator, ConstEdgeIterator> ConstEdgeIteratorRange;
 	/// const edge state iterator range
 	typedef std::pair<ConstEdgeStateIterator, ConstEdgeStateIterator> ConstEdgeStateIteratorRange;
+	/// dense node iterator range
+	typedef std::pair<DenseNodeIterator, DenseNodeIterator> DenseNodeIteratorRange;
+	/// dense edge iterator range
+	typedef std::pair<DenseEdgeIterator, DenseEdgeIterator> DenseEdgeIteratorRange;
+	/// const dense node iterator range
+	typedef std::pair<ConstDenseNodeIterator, ConstDenseNodeIterator> ConstDenseNodeIteratorRange;
+	/// const dense edge iterator range
+	typedef std::pair<ConstDenseEdgeIterator, ConstDenseEdgeIterator> ConstDenseEdgeIteratorRange;
 
 	/**
 	 * Create a graph with @p nodeStates possible node states and @p edgeStates
 	 * possible edge states.
+	 * @throw std::overflow_error if there are more states than node_state_t
+	 * or edge_state_t can represent
 	 */
-	Graph(node_state_t nodeStates, edge_state_t edgeStates);
+	Graph(node_state_size_t nodeStates, edge_state_size_t edgeStates);
 	/**
 	 * Destructor
 	 */
 	~Graph();
+	/**
+	 * Create a copy of this graph
+	 *
+	 * The copy has the same nodes and edges with the same IDs and states,
+	 * and the same storage settings. It is built in bulk, without adding
+	 * its elements one by one, and is therefore much cheaper than
+	 * regenerating the graph, e.g. to start each run of an ensemble from
+	 * the same initial condition. Only the order in which a node's edges
+	 * are iterated may differ from this graph.
+	 *
+	 * The copy creates its elements through a duplicate of this graph's
+	 * element factory (@see ElementFactory::clone). Graph listeners are
+	 * not copied.
+	 * @return the copy
+	 * @throw std::logic_error if the element factory cannot be duplicated
+	 */
+	std::auto_ptr<Graph> clone() const;
+	/**
+	 * Exchange nodes, edges, states, and element factories with @p g in
+	 * constant time
+	 *
+	 * Together with clone(), this replaces move construction and
+	 * assignment, e.g. for keeping graphs in containers. Registered graph
+	 * listeners stay with their graph. They see the exchange as the graph
+	 * being cleared (@see GraphListener::beforeGraphClear) and the new
+	 * nodes and edges being added in one batch each (@see
+	 * GraphListener::afterNodesAdd, GraphListener::afterEdgesAdd). Open
+	 * transactions move with the nodes and edges.
+	 * @throw std::logic_error if either graph has a locked element factory
+	 * (@see lockElementFactory()) of a different type than the other one's
+	 */
+	void swap(Graph& g);
 	/**
 	 * Assign an element factory used to create nodes and edges.
 	 *
@@ -82,8 +198,12 @@ public:
 	 * parallel links
 	 * @see SingleEdgeElementFactory
 	 * @see MultiEdgeElementFactory
+	 * @see PooledElementFactory
 	 * @param elf std::auto_ptr to a new element factory (note that the Graph
 	 * instance takes ownership of the element factory)
+	 * @throw std::logic_error if the graph is not empty, as its elements must
+	 * be destroyed by the factory that created them, or if the element
+	 * factory is locked (@see lockElementFactory())
 	 */
 	void setElementFactory(std::auto_ptr<ElementFactory> elf);
 	/**
@@ -97,9 +217,129 @@ public:
 	/**
 	 * Clear the graph
 	 *
-	 * Removes all nodes and edges, leaving an empty graph.
+	 * Removes all nodes and edges, leaving an empty graph. The memory reserved
+	 * for nodes and edges is kept, such that the graph can be refilled
+	 * without further allocations (e.g. in repeated ensemble runs).
+	 * @throw std::logic_error if a transaction is open
 	 */
 	void clear();
+	/**
+	 * Reserve memory for @p nodes nodes and @p edges edges in total
+	 *
+	 * Reserving memory up front avoids enlarging the node and edge storage
+	 * repeatedly while building a large graph.
+	 * @throw repo::AllocException if more elements are requested than IDs
+	 * are available
+	 */
+	void reserve(node_size_t nodes, edge_size_t edges);
+	/**
+	 * Store the node and edge bookkeeping in segments of 2^@p bits elements,
+	 * or contiguously if @p bits is 0 (the default)
+	 *
+	 * In segmented mode, the graph grows one segment at a time without
+	 * copying its bookkeeping arrays, which avoids latency spikes when
+	 * adding elements to a large graph.
+	 * @see repo::CPtrRepository::setSegmentBits
+	 */
+	void setSegmentBits(unsigned int bits);
+	/**
+	 * Keep separate lists of the nodes and edges in each state
+	 *
+	 * Then adding and removing elements and changing their states take
+	 * constant time, independent of the number of states. Use this for
+	 * models with many node or edge states, e.g. when encoding degree classes
+	 * or opinion bins as states. numberOfNodes(s), nodes(s), and
+	 * randomNode(s, rnd) keep their complexity.
+	 * @see repo::CPtrRepository::setIndexedCategories
+	 */
+	void setIndexedStates(bool on);
+	/**
+	 * Renumber nodes and edges such that their IDs are 0, ..., numberOfNodes() - 1
+	 * and 0, ..., numberOfEdges() - 1, respectively.
+	 *
+	 * The relative order of IDs and all states are preserved. After many
+	 * removals, this lets nodes() and edges() run in time proportional to
+	 * the number of elements again. Graph listeners are informed about the
+	 * new IDs (@see GraphListener::afterGraphCompact).
+	 * @throw std::logic_error if a transaction is open
+	 */
+	void compact();
+	/**
+	 * Renumber nodes in the given order and store them in that order
+	 *
+	 * Node @p order[i] gets ID i. The nodes and edges are recreated, in
+	 * this order, through a duplicate of the element factory, which
+	 * replaces the old one, such that nodes with nearby IDs also lie close
+	 * to each other in memory if the factory allocates contiguously (@see
+	 * PooledElementFactory). Edges are numbered in the order of the new ID
+	 * of their first end in @p order. States and storage settings are
+	 * preserved, and both copies of the graph exist while relabeling.
+	 *
+	 * With an ordering that puts neighbors close together, e.g. from
+	 * orderings::reverseCuthillMcKee(), traversals such as
+	 * measures::triangles() or simulation steps touch fewer cache lines.
+	 * Graph listeners are informed about the new IDs as after compact(),
+	 * except that the relative order of IDs changes.
+	 * @param order IDs of all nodes, each exactly once
+	 * @return new ID of each node, indexed by its old ID; unused old IDs
+	 * map to the largest node_id_t
+	 * @throw std::invalid_argument if @p order is not a permutation of the
+	 * node IDs
+	 * @throw std::logic_error if a transaction is open or the element
+	 * factory cannot be duplicated
+	 */
+	std::vector<node_id_t> relabel(const std::vector<node_id_t>& order);
+	/**
+	 * Start a transaction
+	 *
+	 * All following changes to nodes, edges, and their states are recorded
+	 * in an undo log until the transaction is committed or rolled back.
+	 * Graph listeners are notified of these changes as usual. Transactions
+	 * can be nested; an inner transaction is committed into or rolled back
+	 * to the state of the enclosing one.
+	 *
+	 * This is meant for speculative moves in Monte Carlo samplers, e.g.
+	 * edge swaps that are rejected by an acceptance test.
+	 * @see commit(), rollback()
+	 */
+	void beginTransaction();
+	/**
+	 * Keep the changes made since the last call to beginTransaction()
+	 *
+	 * Committing the outermost transaction discards the undo log and is
+	 * reported to the graph listeners (@see
+	 * GraphListener::afterTransactionCommit).
+	 * @throw std::logic_error if no transaction is open
+	 */
+	void commit();
+	/**
+	 * Undo the changes made since the last call to beginTransaction()
+	 *
+	 * Replays the undo log backwards, such that removed nodes and edges are
+	 * restored with their previous IDs and states, added ones are removed,
+	 * and rewired edges are reconnected. Each undone change is reported to
+	 * the graph listeners once, as the corresponding inverse event, so that
+	 * derived data stays consistent; committed changes are not reported
+	 * again. Restored nodes and edges are reported as such (@see
+	 * GraphListener::afterNodeRestore), so that property maps and samplers
+	 * give them back the values they had before their removal.
+	 * @throw std::logic_error if no transaction is open
+	 */
+	void rollback();
+	/**
+	 * Check whether a transaction is open
+	 */
+	bool inTransaction() const;
+	/**
+	 * Memory used by this graph
+	 *
+	 * Visits all nodes and edges, so this takes time proportional to their
+	 * number. Elements drawn from a memory pool (@see PooledElementFactory)
+	 * are reported with their object sizes, and the rest of the pool
+	 * separately.
+	 * @return memory used by elements, bookkeeping, and graph listeners
+	 */
+	MemoryUsage memoryUsage() const;
 	/**
 	 * Get number of nodes
 	 */
@@ -141,9 +381,61 @@ public:
 	 * @param source source node
 	 * @param target target node
 	 * @param directed create directed edge?
-	 * @return edge ID of the added edge
+	 * @return edge ID of the added edge, or of the existing edge if the
+	 * nodes do not allow parallel edges
 	 */
 	edge_id_t addEdge(node_id_t source, node_id_t target, bool directed);
+	/**
+	 * Create a new edge between @p source and @p target node unless it would
+	 * be a parallel edge that the nodes do not allow
+	 *
+	 * Unlike adding an edge through the element factory, this never throws
+	 * for an existing edge, which makes it the method of choice where
+	 * duplicates are common, e.g. in rewiring loops and random graph
+	 * generators.
+	 * @param source source node
+	 * @param target target node
+	 * @param directed create directed edge?
+	 * @return edge ID of the added or the existing edge, and true if the edge
+	 * was added
+	 */
+	std::pair<edge_id_t, bool> tryAddEdge(node_id_t source, node_id_t target,
+			bool directed);
+	/**
+	 * Create @p n new nodes in state @p s
+	 *
+	 * Has the same effect as calling addNode(@p s) @p n times, but reserves
+	 * memory for all nodes at once and notifies the graph listeners only
+	 * once (@see GraphListener::afterNodesAdd).
+	 * @param n number of nodes to add
+	 * @param s state of the new nodes
+	 */
+	void addNodes(node_size_t n, node_state_t s = 0);
+	/**
+	 * Create edges between the node pairs in @p pairs
+	 *
+	 * Has the same effect as calling addEdge() for each pair, but reserves
+	 * memory for all edges at once and notifies the graph listeners only
+	 * once (@see GraphListener::afterEdgesAdd).
+	 *
+	 * If @p simple is true, the caller guarantees that the new edges are
+	 * neither parallel to each other nor to existing edges, which lets the
+	 * nodes skip their search for parallel edges. Passing parallel edges
+	 * with @p simple set is an error, and its outcome depends on the element
+	 * factory.
+	 *
+	 * If an edge cannot be created, e.g. because of an invalid node ID, the
+	 * edges created before it remain in the graph and are reported to the
+	 * graph listeners before the exception is passed on.
+	 * @param pairs range of pairs of source and target node IDs (e.g. a
+	 * std::vector<std::pair<node_id_t, node_id_t> >)
+	 * @param directed create directed edges?
+	 * @param simple are the new edges guaranteed not to be parallel edges?
+	 * @return number of edges created
+	 */
+	template<class PairRange>
+	edge_size_t addEdges(const PairRange& pairs, bool directed, bool simple =
+			false);
 	/**
 	 * Delete node @p n
 	 * @param n node ID of the node to delete
@@ -154,6 +446,34 @@ public:
 	 * @param e edge ID of the edge to delete
 	 */
 	void removeEdge(edge_id_t e);
+	/**
+	 * Connect edge @p e to other nodes
+	 *
+	 * The edge keeps its ID, state, and directionality and is moved between
+	 * the nodes' adjacency lists without being destroyed, so rewiring is
+	 * much cheaper than removing the edge and adding a new one. The graph
+	 * listeners are notified by GraphListener::beforeEdgeRewire and
+	 * GraphListener::afterEdgeRewire.
+	 * @param e edge ID of the edge to rewire
+	 * @param newSource new source node
+	 * @param newTarget new target node
+	 * @return true if the edge was rewired, false if it would have become a
+	 * parallel edge that the nodes do not allow, leaving the edge unchanged
+	 */
+	bool rewireEdge(edge_id_t e, node_id_t newSource, node_id_t newTarget);
+	/**
+	 * Move one end of edge @p e from node @p oldEnd to node @p newEnd
+	 *
+	 * If @p e is a loop, its target is moved.
+	 * @see rewireEdge()
+	 * @param e edge ID of the edge to rewire
+	 * @param oldEnd source or target node of @p e
+	 * @param newEnd node to connect to instead of @p oldEnd
+	 * @return true if the edge was rewired, false if it would have become a
+	 * parallel edge that the nodes do not allow, leaving the edge unchanged
+	 * @throw std::invalid_argument if @p oldEnd is not an end of @p e
+	 */
+	bool moveEdgeEndpoint(edge_id_t e, node_id_t oldEnd, node_id_t newEnd);
 	/**
 	 * Get node with ID @p n
 	 * @return pointer to node @p n
@@ -276,6 +596,29 @@ public:
 	 */
 	template<class RandomNumGen> const Edge* randomEdge(edge_state_t s,
 			RandomNumGen& rnd) const;
+	/**
+	 * Get random neighbor of node @p n in state @p s
+	 *
+	 * Neighbors along outgoing, incoming, and undirected edges are taken
+	 * into account. This takes constant time on average if a sizable
+	 * fraction of the neighbors of @p n is in state @p s, and time linear in
+	 * the degree of @p n otherwise (@see Node::randomNeighbor()).
+	 * @p rnd must provide an IntFromTo(int low, int high) method returning
+	 * a random integer in [low, high].
+	 * @param n node ID
+	 * @param s node state
+	 * @param rnd instance random number generator
+	 * @return pointer to random neighbor of @p n in state @p s
+	 * @throw std::invalid_argument if @p n has no neighbors in state @p s
+	 */
+	template<class RandomNumGen> Node* randomNeighbor(node_id_t n,
+			node_state_t s, RandomNumGen& rnd);
+	/**
+	 * Get random neighbor of node @p n in state @p s
+	 * @see randomNeighbor(node_id_t, node_state_t, RandomNumGen&)
+	 */
+	template<class RandomNumGen> const Node* randomNeighbor(node_id_t n,
+			node_state_t s, RandomNumGen& rnd) const;
 
 	/**
 	 * Set state of node @p n to @p s
@@ -289,6 +632,17 @@ public:
 	 * @param s new edge state
 	 */
 	void setEdgeState(edge_id_t e, edge_state_t s);
+	/**
+	 * Set states of several edges at once
+	 *
+	 * Sets the state of edge @p edges[i] to @p states[i]. Listeners are
+	 * notified once about all edges whose state has actually changed (@see
+	 * GraphListener::afterEdgeStatesChange), instead of once per edge.
+	 * @param edges edge IDs
+	 * @param states new edge states, one for each edge in @p edges
+	 */
+	void setEdgeStates(const std::vector<edge_id_t>& edges,
+			const std::vector<edge_state_t>& states);
 	/**
 	 * Get node state of node @p n
 	 * @param n node ID
@@ -340,33 +694,195 @@ public:
 	 * @return const iterator range for all edges in state @p s
 	 */
 	ConstEdgeStateIteratorRange edges(edge_state_t s) const;
+	/**
+	 * Get nodes in storage order
+	 *
+	 * Unlike nodes(), which visits nodes by ascending ID, this takes time
+	 * proportional to the number of nodes, however fragmented their IDs are.
+	 * The range is invalidated by adding or removing nodes and by changing
+	 * node states.
+	 * @return iterator range for all nodes
+	 */
+	DenseNodeIteratorRange denseNodes();
+	/**
+	 * Get nodes in storage order
+	 * @see denseNodes()
+	 */
+	ConstDenseNodeIteratorRange denseNodes() const;
+	/**
+	 * Get edges in storage order
+	 *
+	 * Unlike edges(), which visits edges by ascending ID, this takes time
+	 * proportional to the number of edges, however fragmented their IDs are.
+	 * The range is invalidated by adding or removing edges and by changing
+	 * edge states.
+	 * @return iterator range for all edges
+	 */
+	DenseEdgeIteratorRange denseEdges();
+	/**
+	 * Get edges in storage order
+	 * @see denseEdges()
+	 */
+	ConstDenseEdgeIteratorRange denseEdges() const;
 	/**
 	 * Check whether there exists a directed or undirected edge from @p source
 	 * to @p target
 	 */
 	bool isEdge(node_id_t source, node_id_t target) const;
+	/**
+	 * Find the edge from @p source to @p target
+	 * @param source source node
+	 * @param target target node
+	 * @param directed look for a directed edge from @p source to @p target,
+	 * or for an undirected edge between them?
+	 * @return pointer to the edge, or 0 if there is none
+	 */
+	Edge* findEdge(node_id_t source, node_id_t target, bool directed);
+	/**
+	 * Find the edge from @p source to @p target
+	 * @see findEdge()
+	 */
+	const Edge* findEdge(node_id_t source, node_id_t target, bool directed) const;
 	/**
 	 * Check whether two nodes are connected by an edge
 	 */
 	bool adjacent(node_id_t n1, node_id_t n2) const;
 
+protected:
+	/**
+	 * Copy the nodes and edges of @p g into this graph, which must be empty
+	 * and have the same numbers of states. The elements are created by this
+	 * graph's element factory, and no listeners are notified.
+	 * @see clone()
+	 */
+	void copyElements(const Graph& g);
+	/**
+	 * Bind a listener that is notified of all graph events in addition to
+	 * the registered graph listeners. It sees before-events first and
+	 * after-events last.
+	 *
+	 * BasicGraph uses this to forward events caused through the Graph
+	 * interface to its statically bound listener.
+	 * @param l listener to bind, or 0 to unbind
+	 * @return previously bound listener
+	 */
+	GraphListener* bindListener(GraphListener* l);
+	/**
+	 * Prevent the element factory from being replaced
+	 *
+	 * BasicGraph uses this, as it relies on the types of the elements its
+	 * factory creates.
+	 */
+	void lockElementFactory();
+	/**
+	 * Change the state of node @p n from @p oldState to @p newState and
+	 * notify the registered graph listeners, but not the bound listener.
+	 * @p oldState must be the current state and differ from @p newState.
+	 */
+	void changeNodeState(node_id_t n, node_state_t oldState,
+			node_state_t newState);
+	/**
+	 * Change the state of edge @p e from @p oldState to @p newState and
+	 * notify the registered graph listeners, but not the bound listener.
+	 * @see changeNodeState()
+	 */
+	void changeEdgeState(edge_id_t e, edge_state_t oldState,
+			edge_state_t newState);
+	/**
+	 * Check whether edge @p e can be rewired to connect @p newSource and
+	 * @p newTarget without becoming a parallel edge that the nodes do not
+	 * allow.
+	 */
+	bool canRewireEdge(edge_id_t e, node_id_t newSource, node_id_t newTarget) const;
+	/**
+	 * Rewire edge @p e, which must be allowed (@see canRewireEdge), and
+	 * notify the graph listeners.
+	 */
+	void rewireEdgeUnchecked(edge_id_t e, node_id_t newSource,
+			node_id_t newTarget);
+	/**
+	 * Source and target of edge @p e after moving its end @p oldEnd to
+	 * @p newEnd (@see moveEdgeEndpoint)
+	 * @throw std::invalid_argument if @p oldEnd is not an end of @p e
+	 */
+	std::pair<node_id_t, node_id_t> movedEnds(edge_id_t e, node_id_t oldEnd,
+			node_id_t newEnd) const;
+
 private:
+	/// true if events need to be reported to any listener
+	bool hasListeners() const;
+	/// exchange elements with @p g without notifying any listener
+	void swapElements(Graph& g);
+	/// report all nodes and edges as added, e.g. after swap()
+	void afterGraphReload();
 	void afterNodeAdd(node_id_t n);
 	void afterEdgeAdd(edge_id_t e);
+	void afterNodesAdd(const std::vector<node_id_t>& nodes);
+	void afterEdgesAdd(const std::vector<edge_id_t>& edges);
+	/**
+	 * Create a new edge and store it in the edge repository
+	 * @return the new edge, or 0 if @p checked and the edge exists already
+	 */
+	Edge* insertEdge(node_id_t source, node_id_t target, bool directed,
+			bool checked);
 	void beforeNodeRemove(node_id_t n);
 	void beforeEdgeRemove(edge_id_t e);
+	void beforeEdgeRewire(edge_id_t e, node_id_t newSource, node_id_t newTarget);
+	void afterEdgeRewire(edge_id_t e, node_id_t oldSource, node_id_t oldTarget);
+	void afterNodeRestore(node_id_t n);
+	void afterEdgeRestore(edge_id_t e);
+	void afterTransactionCommit();
 	void beforeGraphClear();
+	void afterGraphCompact(const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds);
 	void afterNodeStateChange(node_id_t n, node_state_t oldState,
 			node_state_t newState);
 	void afterEdgeStateChange(edge_id_t e, edge_state_t oldState,
 			edge_state_t newState);
+	void afterEdgeStatesChange(const std::vector<edge_id_t>& edges,
+			const std::vector<edge_state_t>& oldStates);
+	/// record a change in the undo log if a transaction is open
+	void logUndo(const detail::UndoRecord& r);
+	/// undo a recorded change
+	void undo(const detail::UndoRecord& r);
 
 	std::auto_ptr<ElementFactory> elf_;
+	bool elfLocked_; ///< element factory must not be replaced
 	NodeContainer nodes_;
 	EdgeContainer edges_;
 	ListenerContainer listeners_;
+	GraphListener* bound_;
+	std::vector<detail::UndoRecord> undo_;
+	/// start of each open transaction in the undo log
+	std::vector<size_t> transactions_;
+	/// buffers for the changed edges and their old states in
+	/// setEdgeStates(), reused across calls and taken out of here while in use
+	std::vector<edge_id_t> changedEdges_;
+	std::vector<edge_state_t> oldEdgeStates_;
 };
 
+/// @cond IGNORE
+namespace detail
+{
+/// Predicate checking whether a node is in a given state
+class NodeInState
+{
+public:
+	NodeInState(const Graph& g, const node_state_t s) :
+		g_(g), s_(s)
+	{
+	}
+	bool operator()(const Node& n) const
+	{
+		return g_.nodeState(n.id()) == s_;
+	}
+private:
+	const Graph& g_;
+	node_state_t s_;
+};
+}
+/// @endcond
+
 inline node_size_t Graph::numberOfNodes() const
 {
 	return nodes_.size();
@@ -439,10 +955,60 @@ inline edge_state_t Graph::edgeState(const edge_id_t e) const
 	return edges_.category(e);
 }
 
+inline void swap(Graph& a, Graph& b)
+{
+	a.swap(b);
+}
+
 inline void Graph::setElementFactory(std::auto_ptr<ElementFactory> elf)
 {
-	if (elf_.get() != elf.get())
-		elf_ = elf; // releases and destroys old factory (auto_ptr assignment is elf_.reset(elf.release()))
+	if (elf_.get() == elf.get())
+		return;
+	if (elfLocked_)
+		throw(std::logic_error("Cannot replace locked element factory."));
+	if ((numberOfNodes() > 0) || (numberOfEdges() > 0))
+		throw(std::logic_error("Cannot replace element factory of non-empty graph."));
+	elf_ = elf; // releases and destroys old factory (auto_ptr assignment is elf_.reset(elf.release()))
+	nodes_.setCloneAllocator(ElementFactoryCloneAllocator(elf_.get()));
+	edges_.setCloneAllocator(ElementFactoryCloneAllocator(elf_.get()));
+}
+
+inline void Graph::reserve(const node_size_t nodes, const edge_size_t edges)
+{
+	nodes_.reserve(nodes);
+	edges_.reserve(edges);
+}
+
+inline void Graph::setSegmentBits(const unsigned int bits)
+{
+	nodes_.setSegmentBits(bits);
+	edges_.setSegmentBits(bits);
+}
+
+inline void Graph::setIndexedStates(const bool on)
+{
+	nodes_.setIndexedCategories(on);
+	edges_.setIndexedCategories(on);
+}
+
+inline Graph::DenseNodeIteratorRange Graph::denseNodes()
+{
+	return nodes_.denseItems();
+}
+
+inline Graph::ConstDenseNodeIteratorRange Graph::denseNodes() const
+{
+	return nodes_.denseItems();
+}
+
+inline Graph::DenseEdgeIteratorRange Graph::denseEdges()
+{
+	return edges_.denseItems();
+}
+
+inline Graph::ConstDenseEdgeIteratorRange Graph::denseEdges() const
+{
+	return edges_.denseItems();
 }
 
 inline Graph& Graph::addGraphListener(GraphListener* l)
@@ -456,6 +1022,88 @@ inline void Graph::removeGraphListener(GraphListener* l)
 	listeners_.remove(l);
 }
 
+inline void Graph::lockElementFactory()
+{
+	elfLocked_ = true;
+}
+
+inline GraphListener* Graph::bindListener(GraphListener* l)
+{
+	GraphListener* old = bound_;
+	bound_ = l;
+	return old;
+}
+
+inline bool Graph::inTransaction() const
+{
+	return !transactions_.empty();
+}
+
+inline void Graph::logUndo(const detail::UndoRecord& r)
+{
+	if (!transactions_.empty())
+		undo_.push_back(r);
+}
+
+inline void Graph::changeNodeState(const node_id_t n,
+		const node_state_t oldState, const node_state_t newState)
+{
+	logUndo(detail::UndoRecord(detail::UndoRecord::NODE_STATE, n, oldState));
+	nodes_.setCategory(n, newState);
+	if (!listeners_.empty())
+		afterNodeStateChange(n, oldState, newState);
+}
+
+inline void Graph::changeEdgeState(const edge_id_t e,
+		const edge_state_t oldState, const edge_state_t newState)
+{
+	logUndo(detail::UndoRecord(detail::UndoRecord::EDGE_STATE, e, oldState));
+	edges_.setCategory(e, newState);
+	if (!listeners_.empty())
+		afterEdgeStateChange(e, oldState, newState);
+}
+
+inline bool Graph::hasListeners() const
+{
+	return (bound_ != 0) || !listeners_.empty();
+}
+
+template<class PairRange>
+edge_size_t Graph::addEdges(const PairRange& pairs, const bool directed,
+		const bool simple)
+{
+	typedef typename boost::range_iterator<const PairRange>::type iterator;
+	const iterator first = boost::begin(pairs), last = boost::end(pairs);
+	const edge_size_t n = std::distance(first, last);
+	edges_.reserve(edges_.size() + n);
+	std::vector<edge_id_t> added;
+	if (hasListeners())
+		added.reserve(n);
+	edge_size_t count = 0;
+	try
+	{
+		for (iterator it = first; it != last; ++it)
+		{
+			Edge* e = insertEdge(it->first, it->second, directed, !simple);
+			if (e == 0)
+				continue;
+			++count;
+			if (hasListeners())
+				added.push_back(e->id());
+		}
+	}
+	catch (...)
+	{
+		// the edges created so far stay, so the listeners must learn of them
+		if (!added.empty())
+			afterEdgesAdd(added);
+		throw;
+	}
+	if (!added.empty())
+		afterEdgesAdd(added);
+	return count;
+}
+
 template<class RandomNumGen>
 const Node* Graph::randomNode(RandomNumGen& rnd) const
 {
@@ -548,6 +1196,20 @@ Edge* Graph::randomEdge(const edge_state_t s, RandomNumGen& rnd)
 							edges_.count(s) - 1))));
 }
 
+template<class RandomNumGen>
+const Node* Graph::randomNeighbor(const node_id_t n, const node_state_t s,
+		RandomNumGen& rnd) const
+{
+	return node(n)->randomNeighbor(rnd, detail::NodeInState(*this, s));
+}
+
+template<class RandomNumGen>
+Node* Graph::randomNeighbor(const node_id_t n, const node_state_t s,
+		RandomNumGen& rnd)
+{
+	return node(n)->randomNeighbor(rnd, detail::NodeInState(*this, s));
+}
+
 }
 
 #endif /* GRAPH_H_ */
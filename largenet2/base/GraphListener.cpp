@@ -0,0 +1,35 @@
+/**
+ * @file GraphListener.cpp
+ * @date 18.10.2026
+ */
+
+#include "GraphListener.h"
+#include <largenet2/base/Graph.h>
+
+namespace largenet
+{
+
+void GraphListener::afterNodesAddEvent(Graph& g, const std::vector<node_id_t>& nodes)
+{
+	for (std::vector<node_id_t>::const_iterator it = nodes.begin(); it
+			!= nodes.end(); ++it)
+		afterNodeAddEvent(g, *g.node(*it));
+}
+
+void GraphListener::afterEdgesAddEvent(Graph& g, const std::vector<edge_id_t>& edges)
+{
+	for (std::vector<edge_id_t>::const_iterator it = edges.begin(); it
+			!= edges.end(); ++it)
+		afterEdgeAddEvent(g, *g.edge(*it));
+}
+
+void GraphListener::afterEdgeStatesChangeEvent(Graph& g,
+		const std::vector<edge_id_t>& edges,
+		const std::vector<edge_state_t>& oldStates)
+{
+	for (size_t i = 0; i < edges.size(); ++i)
+		afterEdgeStateChangeEvent(g, *g.edge(edges[i]), oldStates[i],
+				g.edgeState(edges[i]));
+}
+
+}
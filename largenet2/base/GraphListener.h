@@ -2,6 +2,7 @@
 #define GRAPHLISTENER_H_
 
 #include <largenet2/base/types.h>
+#include <vector>
 
 namespace largenet
 {
@@ -19,11 +20,80 @@ public:
 	GraphListener() {}
 	virtual ~GraphListener() {}
 
+	/**
+	 * Heap memory owned by this listener, in bytes, e.g. for per-node data.
+	 * Reported by Graph::memoryUsage().
+	 */
+	virtual size_t memoryUsage() const { return 0; }
+
 	void afterNodeAdd(Graph& g, Node& n) { afterNodeAddEvent(g, n); }
 	void afterEdgeAdd(Graph& g, Edge& e) { afterEdgeAddEvent(g, e); }
+	/**
+	 * Called once after a batch of nodes has been added with Graph::addNodes().
+	 * By default, this calls afterNodeAdd() for each node in turn.
+	 * @param nodes IDs of the new nodes
+	 */
+	void afterNodesAdd(Graph& g, const std::vector<node_id_t>& nodes) { afterNodesAddEvent(g, nodes); }
+	/**
+	 * Called once after a batch of edges has been added with Graph::addEdges().
+	 * By default, this calls afterEdgeAdd() for each edge in turn.
+	 * @param edges IDs of the new edges
+	 */
+	void afterEdgesAdd(Graph& g, const std::vector<edge_id_t>& edges) { afterEdgesAddEvent(g, edges); }
 	void beforeNodeRemove(Graph& g, Node& n) { beforeNodeRemoveEvent(g, n); }
 	void beforeEdgeRemove(Graph& g, Edge& e) { beforeEdgeRemoveEvent(g, e); }
+	/**
+	 * Called before Graph::rewireEdge() connects @p e to other nodes.
+	 * By default, this calls beforeEdgeRemove(), so that listeners which
+	 * only handle edge removal and addition see a rewiring as the removal of
+	 * the edge followed by its addition.
+	 * @param newSource node that will be the source of @p e
+	 * @param newTarget node that will be the target of @p e
+	 */
+	void beforeEdgeRewire(Graph& g, Edge& e, Node& newSource, Node& newTarget)
+	{
+		beforeEdgeRewireEvent(g, e, newSource, newTarget);
+	}
+	/**
+	 * Called after Graph::rewireEdge() has connected @p e to other nodes. The
+	 * edge keeps its ID and state. By default, this calls afterEdgeAdd().
+	 * @param oldSource previous source of @p e
+	 * @param oldTarget previous target of @p e
+	 */
+	void afterEdgeRewire(Graph& g, Edge& e, Node& oldSource, Node& oldTarget)
+	{
+		afterEdgeRewireEvent(g, e, oldSource, oldTarget);
+	}
+	/**
+	 * Called after Graph::rollback() has restored the removed node @p n with
+	 * its previous ID and state. Its edges are restored afterwards. By
+	 * default, this calls afterNodeAdd().
+	 */
+	void afterNodeRestore(Graph& g, Node& n) { afterNodeRestoreEvent(g, n); }
+	/**
+	 * Called after Graph::rollback() has restored the removed edge @p e with
+	 * its previous ID and state. By default, this calls afterEdgeAdd().
+	 */
+	void afterEdgeRestore(Graph& g, Edge& e) { afterEdgeRestoreEvent(g, e); }
+	/**
+	 * Called after Graph::commit() has committed the outermost transaction.
+	 * Nodes and edges removed during the transaction cannot be restored any
+	 * more, so data kept for restoring them can be discarded.
+	 */
+	void afterTransactionCommit(Graph& g) { afterTransactionCommitEvent(g); }
 	void beforeGraphClear(Graph& g) { beforeGraphClearEvent(g); }
+	/**
+	 * Called after Graph::compact() or Graph::relabel() has renumbered nodes
+	 * and edges. After relabel(), the new IDs need not keep the order of the
+	 * old ones.
+	 * @param nodeIds new ID of each node, indexed by its old ID
+	 * @param edgeIds new ID of each edge, indexed by its old ID
+	 */
+	void afterGraphCompact(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds)
+	{
+		afterGraphCompactEvent(g, nodeIds, edgeIds);
+	}
 	void afterNodeStateChange(Graph& g, Node& n, node_state_t oldState, node_state_t newState)
 	{
 		afterNodeStateChangeEvent(g, n, oldState, newState);
@@ -32,16 +102,51 @@ public:
 	{
 		afterEdgeStateChangeEvent(g, e, oldState, newState);
 	}
+	/**
+	 * Called once after the states of several edges have been changed with
+	 * Graph::setEdgeStates(). By default, this calls afterEdgeStateChange()
+	 * for each edge in turn.
+	 * @param edges IDs of the edges whose states have changed
+	 * @param oldStates previous state of each of these edges
+	 */
+	void afterEdgeStatesChange(Graph& g, const std::vector<edge_id_t>& edges,
+			const std::vector<edge_state_t>& oldStates)
+	{
+		afterEdgeStatesChangeEvent(g, edges, oldStates);
+	}
 
 private:
 	// these are not pure virtual, to ease implementing only a few methods
 	virtual void afterNodeAddEvent(Graph& g, Node& n) {}
 	virtual void afterEdgeAddEvent(Graph& g, Edge& e) {}
+	virtual void afterNodesAddEvent(Graph& g, const std::vector<node_id_t>& nodes);
+	virtual void afterEdgesAddEvent(Graph& g, const std::vector<edge_id_t>& edges);
 	virtual void beforeNodeRemoveEvent(Graph& g, Node& n) {}
 	virtual void beforeEdgeRemoveEvent(Graph& g, Edge& e) {}
+	virtual void beforeEdgeRewireEvent(Graph& g, Edge& e, Node& newSource, Node& newTarget)
+	{
+		beforeEdgeRemoveEvent(g, e);
+	}
+	virtual void afterEdgeRewireEvent(Graph& g, Edge& e, Node& oldSource, Node& oldTarget)
+	{
+		afterEdgeAddEvent(g, e);
+	}
+	virtual void afterNodeRestoreEvent(Graph& g, Node& n)
+	{
+		afterNodeAddEvent(g, n);
+	}
+	virtual void afterEdgeRestoreEvent(Graph& g, Edge& e)
+	{
+		afterEdgeAddEvent(g, e);
+	}
+	virtual void afterTransactionCommitEvent(Graph& g) {}
 	virtual void beforeGraphClearEvent(Graph& g) {}
+	virtual void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds) {}
 	virtual void afterNodeStateChangeEvent(Graph& g, Node& n, node_state_t oldState, node_state_t newState) {}
 	virtual void afterEdgeStateChangeEvent(Graph& g, Edge& e, edge_state_t oldState, edge_state_t newState) {}
+	virtual void afterEdgeStatesChangeEvent(Graph& g, const std::vector<edge_id_t>& edges,
+			const std::vector<edge_state_t>& oldStates);
 };
 
 }
@@ -0,0 +1,227 @@
+/**
+ * @file IndexedNode.cpp
+ * @date 17.10.2026
+ */
+
+#include <largenet2/base/IndexedNode.h>
+#include <largenet2/base/Edge.h>
+#include <largenet2/base/exceptions.h>
+#include <boost/foreach.hpp>
+#include <algorithm>
+
+namespace largenet
+{
+
+const IndexedNode::Adjacency* IndexedNode::find(const Node* n) const
+{
+	neighbor_map::const_iterator i = index_->find(n);
+	return (i == index_->end()) ? 0 : &i->second;
+}
+
+bool IndexedNode::hasInEdge(const Edge* e) const
+{
+	if (!index_)
+		return CompactNode::hasInEdge(e);
+	const Adjacency* a = find(e->source());
+	return (a != 0) && (a->in == e);
+}
+
+bool IndexedNode::hasOutEdge(const Edge* e) const
+{
+	if (!index_)
+		return CompactNode::hasOutEdge(e);
+	const Adjacency* a = find(e->target());
+	return (a != 0) && (a->out == e);
+}
+
+bool IndexedNode::hasUndirectedEdge(const Edge* e) const
+{
+	if (!index_)
+		return CompactNode::hasUndirectedEdge(e);
+	const Node* n = (e->source() == this) ? e->target() : e->source();
+	const Adjacency* a = find(n);
+	return (a != 0) && (a->un == e);
+}
+
+bool IndexedNode::hasEdgeTo(const Node* n) const
+{
+	return findEdgeTo(n) != 0;
+}
+
+bool IndexedNode::hasEdgeFrom(const Node* n) const
+{
+	return findEdgeFrom(n) != 0;
+}
+
+bool IndexedNode::hasUndirectedEdgeTo(const Node* n) const
+{
+	return findUndirectedEdgeTo(n) != 0;
+}
+
+Edge* IndexedNode::findEdgeTo(const Node* n) const
+{
+	if (!index_)
+		return CompactNode::findEdgeTo(n);
+	const Adjacency* a = find(n);
+	return (a != 0) ? a->out : 0;
+}
+
+Edge* IndexedNode::findEdgeFrom(const Node* n) const
+{
+	if (!index_)
+		return CompactNode::findEdgeFrom(n);
+	const Adjacency* a = find(n);
+	return (a != 0) ? a->in : 0;
+}
+
+Edge* IndexedNode::findUndirectedEdgeTo(const Node* n) const
+{
+	if (!index_)
+		return CompactNode::findUndirectedEdgeTo(n);
+	const Adjacency* a = find(n);
+	return (a != 0) ? a->un : 0;
+}
+
+Edge* IndexedNode::edgeTo(const Node* n) const
+{
+	Edge* e = findEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge to given node."));
+	return e;
+}
+
+Edge* IndexedNode::edgeFrom(const Node* n) const
+{
+	Edge* e = findEdgeFrom(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge from given node."));
+	return e;
+}
+
+Edge* IndexedNode::undirectedEdgeTo(const Node* n) const
+{
+	Edge* e = findUndirectedEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no undirected edge to given node."));
+	return e;
+}
+
+void IndexedNode::registerEdge(const Edge* e)
+{
+	// only loops are registered twice with the same node
+	if (e->isLoop() && hasEdge(e))
+		return;
+
+	CompactNode::registerEdge(e); // throws on parallel edges
+	added(e);
+}
+
+void IndexedNode::registerEdgeUnchecked(const Edge* e)
+{
+	if (e->isLoop() && hasEdge(e))
+		return;
+
+	CompactNode::registerEdgeUnchecked(e);
+	added(e);
+}
+
+void IndexedNode::added(const Edge* e)
+{
+	if (e->isDirected())
+	{
+		// we can have at most one mutual edge pair per neighbor
+		if (e->isLoop())
+			++mutual_;
+		else if ((e->source() == this) ? hasEdgeFrom(e->target())
+				: hasEdgeTo(e->source()))
+			++mutual_;
+	}
+
+	if (index_)
+		index(const_cast<Edge*>(e)); // here be dragons
+	else if (degree() >= index_threshold)
+		buildIndex();
+}
+
+void IndexedNode::unregisterEdge(const Edge* e)
+{
+	// loops are unregistered twice, and edges rejected as parallel edges
+	// by the other node are unregistered without ever having been registered
+	if (!hasEdge(e))
+		return;
+
+	if (e->isDirected())
+	{
+		if (e->isLoop())
+			--mutual_;
+		else if ((e->source() == this) ? hasEdgeFrom(e->target())
+				: hasEdgeTo(e->source()))
+			--mutual_;
+	}
+
+	if (index_)
+		unindex(e);
+	CompactNode::unregisterEdge(e);
+
+	if (index_ && (degree() < index_threshold / 2))
+		index_.reset();
+}
+
+void IndexedNode::index(Edge* e)
+{
+	if (!e->isDirected())
+	{
+		(*index_)[e->opposite(*this)].un = e;
+		return;
+	}
+	if (e->source() == this)
+		(*index_)[e->target()].out = e;
+	if (e->target() == this)
+		(*index_)[e->source()].in = e;
+}
+
+void IndexedNode::unindex(const Edge* e)
+{
+	const Node* n = (e->source() == this) ? e->target() : e->source();
+	neighbor_map::iterator i = index_->find(n);
+	if (i == index_->end())
+		return;
+	Adjacency& a = i->second;
+	if (a.out == e)
+		a.out = 0;
+	if (a.in == e)
+		a.in = 0;
+	if (a.un == e)
+		a.un = 0;
+	if ((a.out == 0) && (a.in == 0) && (a.un == 0))
+		index_->erase(i);
+}
+
+void IndexedNode::buildIndex()
+{
+	index_.reset(new neighbor_map);
+	index_->reserve(degree());
+	BOOST_FOREACH(Edge* e, outEdges())
+		index(e);
+	BOOST_FOREACH(Edge* e, inEdges())
+		index(e);
+	BOOST_FOREACH(Edge* e, undirectedEdges())
+		index(e);
+}
+
+size_t IndexedNode::memoryUsage(size_t& adjacency, size_t& unused) const
+{
+	CompactNode::memoryUsage(adjacency, unused);
+	if (index_)
+	{
+		// bucket array, and per entry the value, a link and a cached hash
+		adjacency += sizeof(neighbor_map) + index_->bucket_count()
+				* sizeof(void*) + index_->size() * (sizeof(neighbor_map::value_type)
+				+ 2 * sizeof(void*));
+		unused += (index_->bucket_count() - std::min(index_->bucket_count(),
+				index_->size())) * sizeof(void*);
+	}
+	return sizeof(IndexedNode);
+}
+
+}
@@ -0,0 +1,106 @@
+/**
+ * @file IndexedNode.h
+ * @date 17.10.2026
+ */
+
+#ifndef INDEXEDNODE_H_
+#define INDEXEDNODE_H_
+
+#include <largenet2/base/CompactNode.h>
+#include <boost/unordered_map.hpp>
+#include <boost/scoped_ptr.hpp>
+
+namespace largenet
+{
+
+/**
+ * Does not allow for parallel edges, and answers adjacency queries in
+ * constant time.
+ *
+ * An IndexedNode is a CompactNode that additionally keeps a hash index of its
+ * edges, keyed by the neighbor node. Queries such as hasEdgeTo() or edgeTo()
+ * (and thus Graph::isEdge(), Graph::adjacent(), and the detection of parallel
+ * edges in Graph::addEdge()) take constant time on average, independent of
+ * the node's degree. The mutual degree is maintained incrementally.
+ *
+ * The index is only built once the degree of the node reaches
+ * @ref index_threshold, as scanning a few contiguous edges is faster and
+ * much cheaper in memory than a hash table. It is dropped again when the
+ * degree falls well below this value.
+ */
+class IndexedNode: public CompactNode
+{
+public:
+	enum
+	{
+		index_threshold = 8 ///< Degree from which on the neighbor index is used
+	};
+
+	/**
+	 * Create a new node with ID @p id
+	 */
+	IndexedNode(node_id_t id) :
+		CompactNode(id), mutual_(0)
+	{
+	}
+	virtual ~IndexedNode()
+	{
+	}
+	degree_t mutualDegree() const
+	{
+		return mutual_;
+	}
+	bool hasInEdge(const Edge* e) const;
+	bool hasOutEdge(const Edge* e) const;
+	bool hasUndirectedEdge(const Edge* e) const;
+	bool hasEdgeTo(const Node* n) const;
+	bool hasEdgeFrom(const Node* n) const;
+	bool hasUndirectedEdgeTo(const Node* n) const;
+	Edge* edgeTo(const Node* n) const;
+	Edge* edgeFrom(const Node* n) const;
+	Edge* undirectedEdgeTo(const Node* n) const;
+	Edge* findEdgeTo(const Node* n) const;
+	Edge* findEdgeFrom(const Node* n) const;
+	Edge* findUndirectedEdgeTo(const Node* n) const;
+	/**
+	 * Check whether the neighbor index is currently in use
+	 */
+	bool isIndexed() const
+	{
+		return index_.get() != 0;
+	}
+	size_t memoryUsage(size_t& adjacency, size_t& unused) const;
+
+protected:
+	void registerEdge(const Edge* e);
+	void registerEdgeUnchecked(const Edge* e);
+	void unregisterEdge(const Edge* e);
+
+private:
+	/// The edges connecting to one neighbor
+	struct Adjacency
+	{
+		Adjacency() :
+			out(0), in(0), un(0)
+		{
+		}
+		Edge* out;
+		Edge* in;
+		Edge* un;
+	};
+	typedef boost::unordered_map<const Node*, Adjacency> neighbor_map;
+
+	const Adjacency* find(const Node* n) const;
+	/// update mutual edge count and index after registering @p e
+	void added(const Edge* e);
+	void index(Edge* e);
+	void unindex(const Edge* e);
+	void buildIndex();
+
+	boost::scoped_ptr<neighbor_map> index_;
+	degree_t mutual_;
+};
+
+}
+
+#endif /* INDEXEDNODE_H_ */
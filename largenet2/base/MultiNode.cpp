@@ -14,62 +14,71 @@ degree_t MultiNode::mutualDegree() const
 }
 bool MultiNode::hasEdgeTo(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, outEdges_)
-				{
-					if (e->to(*n))
-						return true;
-				}
-	return false;
+	return findEdgeTo(n) != 0;
 }
 
-Edge* MultiNode::edgeTo(const Node* n) const
+bool MultiNode::hasEdgeFrom(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, outEdges_)
-				{
-					if (e->to(*n))
-						return e;
-				}
-	throw(NotAdjacentException("Node has no edge to given node."));
+	return findEdgeFrom(n) != 0;
 }
 
-bool MultiNode::hasEdgeFrom(const Node* n) const
+bool MultiNode::hasUndirectedEdgeTo(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, inEdges_)
-				{
-					if (e->from(*n))
-						return true;
-				}
-	return false;
+	return findUndirectedEdgeTo(n) != 0;
 }
 
-Edge* MultiNode::edgeFrom(const Node* n) const
+Edge* MultiNode::edgeTo(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, inEdges_)
-				{
-					if (e->from(*n))
-						return e;
-				}
-	throw(NotAdjacentException("Node has no edge from given node."));
+	Edge* e = findEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge to given node."));
+	return e;
 }
 
-bool MultiNode::hasUndirectedEdgeTo(const Node* n) const
+Edge* MultiNode::edgeFrom(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, unEdges_)
-				{
-					if (e->from(*n) || e->to(*n))
-						return true;
-				}
-	return false;
+	Edge* e = findEdgeFrom(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge from given node."));
+	return e;
 }
 
 Edge* MultiNode::undirectedEdgeTo(const Node* n) const
+{
+	Edge* e = findUndirectedEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no undirected edge to given node."));
+	return e;
+}
+
+Edge* MultiNode::findEdgeTo(const Node* n) const
+{
+	BOOST_FOREACH(Edge* e, outEdges_)
+	{
+		if (e->to(*n))
+			return e;
+	}
+	return 0;
+}
+
+Edge* MultiNode::findEdgeFrom(const Node* n) const
+{
+	BOOST_FOREACH(Edge* e, inEdges_)
+	{
+		if (e->from(*n))
+			return e;
+	}
+	return 0;
+}
+
+Edge* MultiNode::findUndirectedEdgeTo(const Node* n) const
 {
 	BOOST_FOREACH(Edge* e, unEdges_)
-				{
-					if (e->from(*n) || e->to(*n))
-						return e;
-				}
-	throw(NotAdjacentException("Node has no undirected edge to given node."));
+	{
+		if (e->opposite(*this) == n)
+			return e;
+	}
+	return 0;
 }
 
 void MultiNode::registerEdge(const Edge* e)
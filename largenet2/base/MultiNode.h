@@ -35,6 +35,10 @@ public:
 	{
 		return unEdges_.size();
 	}
+	degree_t degree() const
+	{
+		return outEdges_.size() + inEdges_.size() + unEdges_.size();
+	}
 	bool hasInEdge(const Edge* e) const
 	{ /* here be dragons */
 		return inEdges_.find(const_cast<Edge*> (e)) != inEdges_.end();
@@ -53,6 +57,13 @@ public:
 	Edge* edgeTo(const Node* n) const;
 	Edge* edgeFrom(const Node* n) const;
 	Edge* undirectedEdgeTo(const Node* n) const;
+	Edge* findEdgeTo(const Node* n) const;
+	Edge* findEdgeFrom(const Node* n) const;
+	Edge* findUndirectedEdgeTo(const Node* n) const;
+	bool allowsParallelEdges() const
+	{
+		return true;
+	}
 	edge_iterator_range outEdges() const
 	{
 		return edge_iterator_range(outEdges_.begin(), outEdges_.end());
@@ -99,6 +110,13 @@ public:
 				unEdges_.begin(), id()), UndirectedNeighborIterator(
 				unEdges_.end(), id()));
 	}
+	size_t memoryUsage(size_t& adjacency, size_t& unused) const
+	{
+		adjacency = setMemoryUsage(outEdges_) + setMemoryUsage(inEdges_)
+				+ setMemoryUsage(unEdges_);
+		unused = 0;
+		return sizeof(MultiNode);
+	}
 
 protected:
 	void registerEdge(const Edge* e);
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <set>
 #include <utility>
+#include <iterator>
 #include <boost/noncopyable.hpp>
 #include <stdexcept>
 
@@ -24,10 +25,11 @@ class Edge;
 class Node: public boost::noncopyable
 {
 	friend class Edge;
+	friend class Graph; // renumbers nodes in Graph::compact()
 public:
 	typedef std::set<Edge*> edge_set;	///< Used to store pointers to adjacent edges
-	typedef edge_set::iterator edge_iterator;
-	typedef edge_set::const_iterator const_edge_iterator;
+	typedef iterators::NodeEdgeIterator edge_iterator;
+	typedef iterators::NodeEdgeIterator const_edge_iterator;
 	typedef std::pair<edge_iterator, edge_iterator> edge_iterator_range;
 
 	typedef iterators::NodeOutNeighborIterator<edge_iterator>
@@ -176,6 +178,56 @@ public:
 	 * @throw NotAdjacentException if @p n is not connected by an undirected edge
 	 */
 	virtual Edge* undirectedEdgeTo(const Node* n) const = 0;
+	/**
+	 * Find edge to @p n
+	 *
+	 * Like edgeTo(), but does not throw, which is faster where a missing edge
+	 * is a common outcome, e.g. when rewiring.
+	 * @param n pointer to Node
+	 * @return pointer to the outgoing edge connecting to @p n, or 0 if there
+	 * is none
+	 */
+	virtual Edge* findEdgeTo(const Node* n) const
+	{
+		return hasEdgeTo(n) ? edgeTo(n) : 0;
+	}
+	/**
+	 * Find edge from @p n
+	 * @see findEdgeTo()
+	 * @return pointer to the incoming edge coming from @p n, or 0 if there
+	 * is none
+	 */
+	virtual Edge* findEdgeFrom(const Node* n) const
+	{
+		return hasEdgeFrom(n) ? edgeFrom(n) : 0;
+	}
+	/**
+	 * Find undirected edge to @p n
+	 * @see findEdgeTo()
+	 * @return pointer to the undirected edge connecting to @p n, or 0 if
+	 * there is none
+	 */
+	virtual Edge* findUndirectedEdgeTo(const Node* n) const
+	{
+		return hasUndirectedEdgeTo(n) ? undirectedEdgeTo(n) : 0;
+	}
+	/**
+	 * Find (any) edge to @p n
+	 *
+	 * Returns a directed edge to/from or an undirected edge to @p n.
+	 * @param n pointer to Node
+	 * @return pointer to the edge connecting to @p n, or 0 if @p n is not
+	 * adjacent
+	 */
+	Edge* findEdge(const Node* n) const
+	{
+		Edge* e = findEdgeTo(n);
+		if (e == 0)
+			e = findEdgeFrom(n);
+		if (e == 0)
+			e = findUndirectedEdgeTo(n);
+		return e;
+	}
 	/**
 	 * Get (any) edge to @p n
 	 *
@@ -186,21 +238,22 @@ public:
 	 */
 	Edge* edgeToAdjacentNode(const Node* n) const
 	{
-		Edge* e = 0;
-		try
-		{
-			e = edgeTo(n);
-		} catch (NotAdjacentException&)
-		{
-			try {
-				e = edgeFrom(n);
-			} catch (NotAdjacentException&)
-			{
-				e = undirectedEdgeTo(n);
-			}
-		}
+		Edge* e = findEdge(n);
+		if (e == 0)
+			throw(NotAdjacentException("Node is not adjacent to given node."));
 		return e;
 	}
+	/**
+	 * Check whether this node accepts several edges of the same
+	 * directionality to the same neighbor
+	 *
+	 * Nodes that allow parallel edges do not reject them when they are
+	 * registered.
+	 */
+	virtual bool allowsParallelEdges() const
+	{
+		return false;
+	}
 
 	/**
 	 * Check whether @p n is adjacent to this node
@@ -259,72 +312,191 @@ public:
 	 */
 	virtual UndirectedNeighborIteratorRange undirectedNeighbors() = 0;
 
-/*	template<class RandomNumGen>
-	Node* randomOutNeighbor(RandomNumGen& rnd)
+	/**
+	 * Get the @p i'th outgoing edge
+	 *
+	 * This takes constant time for node types storing their edges
+	 * contiguously (CompactNode, IndexedNode), and time linear in @p i for
+	 * node types storing them in sets (SingleNode, MultiNode).
+	 * @param i edge number, 0 <= @p i < outDegree()
+	 * @return pointer to the @p i'th outgoing edge
+	 */
+	virtual Edge* outEdgeAt(degree_t i) const
 	{
-		const degree_size_t deg = outDegree();
-		if (deg == 0)
-			throw(std::invalid_argument(
-					"Cannot pick random neighbor from empty set."));
-		const int num = rnd.IntFromTo(0, deg - 1);
-		OutNeighborIteratorRange iters = outNeighbors();
-		OutNeighborIterator it = iters.first;
-		std::advance(it, num);
-		assert(it != iters.second);
-		return it.operator->();
+		return edgeAt(outEdges(), i);
+	}
+	/**
+	 * Get the @p i'th incoming edge
+	 * @see outEdgeAt()
+	 */
+	virtual Edge* inEdgeAt(degree_t i) const
+	{
+		return edgeAt(inEdges(), i);
+	}
+	/**
+	 * Get the @p i'th undirected edge
+	 * @see outEdgeAt()
+	 */
+	virtual Edge* undirectedEdgeAt(degree_t i) const
+	{
+		return edgeAt(undirectedEdges(), i);
 	}
 
+	/**
+	 * Get random outgoing edge
+	 *
+	 * The edge is selected using the supplied instance of a random number
+	 * generator, which must provide an IntFromTo(int low, int high) method
+	 * returning a random integer in [low, high]. This takes as long as
+	 * outEdgeAt(), i.e. constant time for CompactNode and IndexedNode.
+	 * @param rnd instance of random number generator
+	 * @return pointer to random outgoing edge
+	 * @throw std::invalid_argument if there are no outgoing edges
+	 */
 	template<class RandomNumGen>
-	const Node* randomOutNeighbor(RandomNumGen& rnd) const
+	Edge* randomOutEdge(RandomNumGen& rnd) const
 	{
-		const degree_t deg = outDegree();
-		if (deg == 0)
-			throw(std::invalid_argument(
-					"Cannot pick random neighbor from empty set."));
-		const int num = rnd.IntFromTo(0, deg - 1);
-		ConstOutNeighborIteratorRange iters = outNeighbors();
-		ConstOutNeighborIterator it = iters.first;
-		std::advance(it, num);
-		assert(it != iters.second); // should always give true
-		return it.operator->();
+		return outEdgeAt(randomIndex(outDegree(), rnd));
 	}
-
+	/**
+	 * Get random incoming edge
+	 * @see randomOutEdge()
+	 */
 	template<class RandomNumGen>
-	Node* randomInNeighbor(RandomNumGen& rnd)
+	Edge* randomInEdge(RandomNumGen& rnd) const
 	{
-		const degree_t deg = inDegree();
-		if (deg == 0)
-			throw(std::invalid_argument(
-					"Cannot pick random neighbor from empty set."));
-		const int num = rnd.IntFromTo(0, deg - 1);
-		InNeighborIteratorRange iters = inNeighbors();
-		InNeighborIterator it = iters.first;
-		std::advance(it, num);
-		assert(it != iters.second); // should always give true
-		return it.operator->();
+		return inEdgeAt(randomIndex(inDegree(), rnd));
 	}
-
+	/**
+	 * Get random undirected edge
+	 * @see randomOutEdge()
+	 */
 	template<class RandomNumGen>
-	const Node* randomInNeighbor(RandomNumGen& rnd) const
+	Edge* randomUndirectedEdge(RandomNumGen& rnd) const
 	{
-		const degree_t deg = inDegree();
-		if (deg == 0)
-			throw(std::invalid_argument(
-					"Cannot pick random neighbor from empty set."));
-		const int num = rnd.IntFromTo(0, deg - 1);
-		ConstInNeighborIteratorRange iters = inNeighbors();
-		ConstInNeighborIterator it = iters.first;
-		std::advance(it, num);
-		assert(it != iters.second); // should always give true
-		return it.operator->();
-	}
-*/
+		return undirectedEdgeAt(randomIndex(undirectedDegree(), rnd));
+	}
+	/**
+	 * Get random edge out of all outgoing, incoming, and undirected edges
+	 * @see randomOutEdge()
+	 */
+	template<class RandomNumGen>
+	Edge* randomEdge(RandomNumGen& rnd) const
+	{
+		return edgeAt(randomIndex(degree(), rnd));
+	}
+	/**
+	 * Get random neighbor along an outgoing edge
+	 *
+	 * Neighbors are selected by edge, i.e. a neighbor connected by two edges
+	 * is selected twice as often.
+	 * @see randomOutEdge()
+	 */
+	template<class RandomNumGen>
+	Node* randomOutNeighbor(RandomNumGen& rnd) const
+	{
+		return randomOutEdge(rnd)->target();
+	}
+	/**
+	 * Get random neighbor along an incoming edge
+	 * @see randomOutNeighbor()
+	 */
+	template<class RandomNumGen>
+	Node* randomInNeighbor(RandomNumGen& rnd) const
+	{
+		return randomInEdge(rnd)->source();
+	}
+	/**
+	 * Get random neighbor along an undirected edge
+	 * @see randomOutNeighbor()
+	 */
+	template<class RandomNumGen>
+	Node* randomUndirectedNeighbor(RandomNumGen& rnd) const
+	{
+		return neighborAlong(randomUndirectedEdge(rnd));
+	}
+	/**
+	 * Get random neighbor along any edge
+	 * @see randomOutNeighbor()
+	 */
+	template<class RandomNumGen>
+	Node* randomNeighbor(RandomNumGen& rnd) const
+	{
+		return neighborAlong(randomEdge(rnd));
+	}
+	/**
+	 * Get random neighbor along any edge, among those accepted by @p accept
+	 *
+	 * A few neighbors are drawn at random until one is accepted. Only if all
+	 * of them are rejected, the accepted neighbors are counted and one of
+	 * them is selected, in two passes over the adjacent edges. Thus, this
+	 * takes constant time on average if a sizable fraction of the neighbors
+	 * is accepted, and time linear in the degree otherwise. Either way, all accepted neighbors are equally likely
+	 * to be selected, per edge.
+	 *
+	 * @param rnd instance of random number generator
+	 * @param accept predicate taking a const Node&, e.g. to check its state
+	 * @return pointer to random accepted neighbor
+	 * @throw std::invalid_argument if no neighbor is accepted
+	 * @see Graph::randomNeighbor()
+	 */
+	template<class RandomNumGen, class Predicate>
+	Node* randomNeighbor(RandomNumGen& rnd, Predicate accept) const
+	{
+		const degree_t deg = degree();
+		for (int tries = 0; (tries < 8) && (deg > 0); ++tries)
+		{
+			Node* n = neighborAlong(edgeAt(randomIndex(deg, rnd)));
+			if (accept(static_cast<const Node&> (*n)))
+				return n;
+		}
+		// count down from the degree, which no count of accepted neighbors
+		// can exceed, so that no neighbor is returned
+		degree_t k = deg;
+		acceptedNeighbor(accept, k);
+		k = randomIndex(deg - k, rnd);
+		return acceptedNeighbor(accept, k);
+	}
+	/**
+	 * Memory used by this node, in bytes
+	 *
+	 * Heap memory is estimated from the sizes of the containers and does not
+	 * include the overhead of the heap allocator.
+	 * @param[out] adjacency heap memory held by the adjacency containers
+	 * @param[out] unused part of @p adjacency that holds no edges
+	 * @return size of the node object itself
+	 */
+	virtual size_t memoryUsage(size_t& adjacency, size_t& unused) const
+	{
+		adjacency = unused = 0;
+		return sizeof(Node);
+	}
 protected:
+	/**
+	 * Estimated heap memory held by the tree nodes of edge set @p s
+	 */
+	static size_t setMemoryUsage(const edge_set& s)
+	{
+		// color, parent, left, and right child, plus the stored pointer
+		return s.size() * (4 * sizeof(void*) + sizeof(edge_set::value_type));
+	}
 	/**
 	 * Register an adjacent edge instance with this node
 	 * @param e pointer to Edge
 	 */
 	virtual void registerEdge(const Edge* e) = 0;
+	/**
+	 * Register an adjacent edge instance that is known not to be parallel to
+	 * any edge already registered with this node.
+	 *
+	 * Node types that search their edges to reject parallel edges can skip
+	 * that search here. The default implementation calls registerEdge().
+	 * @param e pointer to Edge
+	 */
+	virtual void registerEdgeUnchecked(const Edge* e)
+	{
+		registerEdge(e);
+	}
 	/**
 	 * Unregister an adjacent edge instance from this node (e.g., before
 	 * removing the edge)
@@ -340,6 +512,76 @@ protected:
 	}
 
 private:
+	/// draw a random number in [0, @p n)
+	template<class RandomNumGen>
+	static degree_t randomIndex(const degree_t n, RandomNumGen& rnd)
+	{
+		if (n == 0)
+			throw(std::invalid_argument(
+					"Cannot pick random edge from empty set."));
+		return rnd.IntFromTo(static_cast<degree_t> (0), n - 1);
+	}
+	static Edge* edgeAt(const edge_iterator_range& r, const degree_t i)
+	{
+		edge_iterator it = r.first;
+		std::advance(it, i);
+		assert(it != r.second);
+		return *it;
+	}
+	/// @p i'th edge, counting outgoing, incoming, and undirected edges
+	Edge* edgeAt(degree_t i) const
+	{
+		const degree_t out = outDegree();
+		if (i < out)
+			return outEdgeAt(i);
+		i -= out;
+		const degree_t in = inDegree();
+		if (i < in)
+			return inEdgeAt(i);
+		return undirectedEdgeAt(i - in);
+	}
+	/**
+	 * The @p k'th neighbor accepted by @p accept, walking the outgoing,
+	 * incoming, and undirected edges once, or 0 if there are fewer. @p k is
+	 * decreased by the number of accepted neighbors passed.
+	 */
+	template<class Predicate>
+	Node* acceptedNeighbor(Predicate& accept, degree_t& k) const
+	{
+		const edge_iterator_range r[3] = { outEdges(), inEdges(),
+				undirectedEdges() };
+		for (int d = 0; d < 3; ++d)
+		{
+			// choose the kind of storage once per range, not per edge
+			Node* n = r[d].first.contiguous() ? acceptedNeighbor(
+					r[d].first.arrayIterator(), r[d].second.arrayIterator(),
+					accept, k) : acceptedNeighbor(r[d].first.setIterator(),
+					r[d].second.setIterator(), accept, k);
+			if (n != 0)
+				return n;
+		}
+		return 0;
+	}
+	/// acceptedNeighbor() along the edges in [@p first, @p last)
+	template<class Iterator, class Predicate>
+	Node* acceptedNeighbor(Iterator first, const Iterator last,
+			Predicate& accept, degree_t& k) const
+	{
+		for (; first != last; ++first)
+		{
+			Node* n = neighborAlong(*first);
+			if (accept(static_cast<const Node&> (*n)) && (k-- == 0))
+				return n;
+		}
+		return 0;
+	}
+	/// node at the other end of @p e (a template, as Edge is incomplete here)
+	template<class EdgeType>
+	Node* neighborAlong(const EdgeType* e) const
+	{
+		return (e->source() == this) ? e->target() : e->source();
+	}
+
 	node_id_t id_;
 };
 
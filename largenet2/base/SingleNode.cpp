@@ -25,62 +25,71 @@ degree_t SingleNode::mutualDegree() const
 
 bool SingleNode::hasEdgeTo(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, outEdges_)
-	{
-		if (e->to(*n))
-			return true;
-	}
-	return false;
+	return findEdgeTo(n) != 0;
 }
 
-Edge* SingleNode::edgeTo(const Node* n) const
+bool SingleNode::hasEdgeFrom(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, outEdges_)
-	{
-		if (e->to(*n))
-			return e;
-	}
-	throw(NotAdjacentException("Node has no edge to given node."));
+	return findEdgeFrom(n) != 0;
 }
 
-bool SingleNode::hasEdgeFrom(const Node* n) const
+bool SingleNode::hasUndirectedEdgeTo(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, inEdges_)
-				{
-					if (e->from(*n))
-						return true;
-				}
-	return false;
+	return findUndirectedEdgeTo(n) != 0;
 }
 
-Edge* SingleNode::edgeFrom(const Node* n) const
+Edge* SingleNode::edgeTo(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, inEdges_)
-				{
-					if (e->from(*n))
-						return e;
-				}
-	throw(NotAdjacentException("Node has no edge from given node."));
+	Edge* e = findEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge to given node."));
+	return e;
 }
 
-bool SingleNode::hasUndirectedEdgeTo(const Node* n) const
+Edge* SingleNode::edgeFrom(const Node* n) const
 {
-	BOOST_FOREACH(Edge* e, unEdges_)
-				{
-					if (e->from(*n) || e->to(*n))
-						return true;
-				}
-	return false;
+	Edge* e = findEdgeFrom(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no edge from given node."));
+	return e;
 }
 
 Edge* SingleNode::undirectedEdgeTo(const Node* n) const
+{
+	Edge* e = findUndirectedEdgeTo(n);
+	if (e == 0)
+		throw(NotAdjacentException("Node has no undirected edge to given node."));
+	return e;
+}
+
+Edge* SingleNode::findEdgeTo(const Node* n) const
+{
+	BOOST_FOREACH(Edge* e, outEdges_)
+	{
+		if (e->to(*n))
+			return e;
+	}
+	return 0;
+}
+
+Edge* SingleNode::findEdgeFrom(const Node* n) const
+{
+	BOOST_FOREACH(Edge* e, inEdges_)
+	{
+		if (e->from(*n))
+			return e;
+	}
+	return 0;
+}
+
+Edge* SingleNode::findUndirectedEdgeTo(const Node* n) const
 {
 	BOOST_FOREACH(Edge* e, unEdges_)
-				{
-					if (e->from(*n) || e->to(*n))
-						return e;
-				}
-	throw(NotAdjacentException("Node has no undirected edge to given node."));
+	{
+		if (e->opposite(*this) == n)
+			return e;
+	}
+	return 0;
 }
 
 void SingleNode::registerEdge(const Edge* e)
@@ -133,6 +142,26 @@ void SingleNode::registerEdge(const Edge* e)
 	}
 }
 
+void SingleNode::registerEdgeUnchecked(const Edge* e)
+{
+	if ((e->source() != this) && (e->target() != this)) // neither target nor source point to this node
+		throw(NotAdjacentException(
+				"Cannot register edge that does not connect to this node."));
+
+	// edges created in bulk (e.g. by Graph::clone) tend to have ascending
+	// addresses, so try inserting them at the end first
+	Edge* edge = const_cast<Edge*> (e); // here be dragons
+	if (!e->isDirected())
+	{
+		unEdges_.insert(unEdges_.end(), edge);
+		return;
+	}
+	if (e->source() == this)
+		outEdges_.insert(outEdges_.end(), edge);
+	if (e->target() == this)
+		inEdges_.insert(inEdges_.end(), edge);
+}
+
 void SingleNode::unregisterEdge(const Edge* e)
 {
 	edge_set::iterator i = inEdges_.find(const_cast<Edge*> (e)); // here be dragons
@@ -40,6 +40,10 @@ public:
 	{
 		return unEdges_.size();
 	}
+	degree_t degree() const
+	{
+		return outEdges_.size() + inEdges_.size() + unEdges_.size();
+	}
 	bool hasInEdge(const Edge* e) const
 	{ /* here be dragons */
 		return inEdges_.find(const_cast<Edge*> (e)) != inEdges_.end();
@@ -58,6 +62,9 @@ public:
 	Edge* edgeTo(const Node* n) const;
 	Edge* edgeFrom(const Node* n) const;
 	Edge* undirectedEdgeTo(const Node* n) const;
+	Edge* findEdgeTo(const Node* n) const;
+	Edge* findEdgeFrom(const Node* n) const;
+	Edge* findUndirectedEdgeTo(const Node* n) const;
 	edge_iterator_range outEdges() const
 	{
 		return edge_iterator_range(outEdges_.begin(), outEdges_.end());
@@ -104,9 +111,17 @@ public:
 				unEdges_.begin(), id()), UndirectedNeighborIterator(
 				unEdges_.end(), id()));
 	}
+	size_t memoryUsage(size_t& adjacency, size_t& unused) const
+	{
+		adjacency = setMemoryUsage(outEdges_) + setMemoryUsage(inEdges_)
+				+ setMemoryUsage(unEdges_);
+		unused = 0;
+		return sizeof(SingleNode);
+	}
 
 protected:
 	void registerEdge(const Edge* e);
+	void registerEdgeUnchecked(const Edge* e);
 	void unregisterEdge(const Edge* e);
 
 private:
@@ -0,0 +1,140 @@
+/**
+ * @file StaticGraphListener.h
+ * @date 18.10.2026
+ */
+
+#ifndef STATICGRAPHLISTENER_H_
+#define STATICGRAPHLISTENER_H_
+
+#include <largenet2/base/types.h>
+#include <vector>
+
+namespace largenet
+{
+
+/**
+ * Base class for statically bound graph listeners
+ *
+ * A static listener is bound to a BasicGraph through its @p Listener template
+ * parameter instead of being registered with Graph::addGraphListener(). The
+ * graph calls the listener's event members directly, so they can be inlined,
+ * and events the listener does not handle compile away entirely.
+ *
+ * Static listeners provide the same events as GraphListener, but as member
+ * templates taking the concrete graph, node, and edge types. Derive from this
+ * class and hide the members for the events you are interested in. Batch
+ * events (GraphListener::afterNodesAdd, GraphListener::afterEdgesAdd) are
+ * reported element by element. Unlike for GraphListener, the rewiring events
+ * do not fall back to edge removal and addition, so static listeners that
+ * track adjacency must handle them.
+ *
+ * Used on its own, this is the listener that ignores all events.
+ */
+class StaticGraphListener
+{
+public:
+	template<class G, class N> void afterNodeAdd(G& g, N& n) {}
+	template<class G, class E> void afterEdgeAdd(G& g, E& e) {}
+	template<class G, class N> void beforeNodeRemove(G& g, N& n) {}
+	template<class G, class E> void beforeEdgeRemove(G& g, E& e) {}
+	template<class G, class E, class N> void beforeEdgeRewire(G& g, E& e,
+			N& newSource, N& newTarget) {}
+	template<class G, class E, class N> void afterEdgeRewire(G& g, E& e,
+			N& oldSource, N& oldTarget) {}
+	template<class G> void beforeGraphClear(G& g) {}
+	template<class G> void afterGraphCompact(G& g,
+			const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds) {}
+	template<class G, class N> void afterNodeStateChange(G& g, N& n,
+			node_state_t oldState, node_state_t newState) {}
+	template<class G, class E> void afterEdgeStateChange(G& g, E& e,
+			edge_state_t oldState, edge_state_t newState) {}
+};
+
+/**
+ * Compile-time sequence of two static listeners
+ *
+ * Each event is passed to @p First, then to @p Second. Longer chains are
+ * built by nesting, e.g. ListenerChain<A, ListenerChain<B, C> >.
+ *
+ * @tparam First first static listener
+ * @tparam Second second static listener
+ */
+template<class First, class Second = StaticGraphListener>
+class ListenerChain
+{
+public:
+	ListenerChain(const First& first = First(), const Second& second = Second()) :
+		first_(first), second_(second)
+	{
+	}
+	First& first() { return first_; }
+	const First& first() const { return first_; }
+	Second& second() { return second_; }
+	const Second& second() const { return second_; }
+
+	template<class G, class N> void afterNodeAdd(G& g, N& n)
+	{
+		first_.afterNodeAdd(g, n);
+		second_.afterNodeAdd(g, n);
+	}
+	template<class G, class E> void afterEdgeAdd(G& g, E& e)
+	{
+		first_.afterEdgeAdd(g, e);
+		second_.afterEdgeAdd(g, e);
+	}
+	template<class G, class N> void beforeNodeRemove(G& g, N& n)
+	{
+		first_.beforeNodeRemove(g, n);
+		second_.beforeNodeRemove(g, n);
+	}
+	template<class G, class E> void beforeEdgeRemove(G& g, E& e)
+	{
+		first_.beforeEdgeRemove(g, e);
+		second_.beforeEdgeRemove(g, e);
+	}
+	template<class G, class E, class N> void beforeEdgeRewire(G& g, E& e,
+			N& newSource, N& newTarget)
+	{
+		first_.beforeEdgeRewire(g, e, newSource, newTarget);
+		second_.beforeEdgeRewire(g, e, newSource, newTarget);
+	}
+	template<class G, class E, class N> void afterEdgeRewire(G& g, E& e,
+			N& oldSource, N& oldTarget)
+	{
+		first_.afterEdgeRewire(g, e, oldSource, oldTarget);
+		second_.afterEdgeRewire(g, e, oldSource, oldTarget);
+	}
+	template<class G> void beforeGraphClear(G& g)
+	{
+		first_.beforeGraphClear(g);
+		second_.beforeGraphClear(g);
+	}
+	template<class G> void afterGraphCompact(G& g,
+			const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds)
+	{
+		first_.afterGraphCompact(g, nodeIds, edgeIds);
+		second_.afterGraphCompact(g, nodeIds, edgeIds);
+	}
+	template<class G, class N> void afterNodeStateChange(G& g, N& n,
+			node_state_t oldState, node_state_t newState)
+	{
+		first_.afterNodeStateChange(g, n, oldState, newState);
+		second_.afterNodeStateChange(g, n, oldState, newState);
+	}
+	template<class G, class E> void afterEdgeStateChange(G& g, E& e,
+			edge_state_t oldState, edge_state_t newState)
+	{
+		first_.afterEdgeStateChange(g, e, oldState, newState);
+		second_.afterEdgeStateChange(g, e, oldState, newState);
+	}
+
+private:
+	First first_;
+	Second second_;
+};
+
+}
+
+#endif /* STATICGRAPHLISTENER_H_ */
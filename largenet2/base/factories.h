@@ -2,9 +2,12 @@
 #define FACTORIES_H_
 
 #include <largenet2/base/ElementFactory.h>
+#include <largenet2/base/ElementPool.h>
 #include <largenet2/base/Edge.h>
 #include <largenet2/base/SingleNode.h>
 #include <largenet2/base/MultiNode.h>
+#include <largenet2/base/CompactNode.h>
+#include <largenet2/base/IndexedNode.h>
 
 namespace largenet
 {
@@ -27,6 +30,120 @@ private:
 	{
 		return EdgeType::create(id, source, target, directed);
 	}
+
+	virtual EdgeType* doCreateEdgeUnchecked(edge_id_t id, Node& source, Node& target, bool directed)
+	{
+		return EdgeType::createUnchecked(id, source, target, directed);
+	}
+
+	virtual GraphElementFactory* doClone() const
+	{
+		return new GraphElementFactory;
+	}
+};
+
+/**
+ * Graph element factory template drawing nodes and edges from an ElementPool
+ *
+ * Use this factory for graphs that are modified very frequently, e.g. in
+ * adaptive network simulations, to avoid a heap allocation for every new node
+ * or edge. The memory of removed elements is recycled, and Graph::clear()
+ * releases all elements in bulk while keeping the memory for reuse.
+ *
+ * @tparam NodeType type of node elements
+ * @tparam EdgeType type of edge elements
+ */
+template<class NodeType = SingleNode, class EdgeType = Edge>
+class PooledElementFactory: public ElementFactory
+{
+public:
+	/**
+	 * Get the memory pool elements are created from
+	 */
+	const ElementPool& pool() const
+	{
+		return pool_;
+	}
+	/**
+	 * Return the pool's memory to the heap.
+	 *
+	 * Must only be called when no elements created by this factory exist.
+	 */
+	void release()
+	{
+		pool_.release();
+	}
+
+private:
+	virtual NodeType* doCreateNode(node_id_t id)
+	{
+		void* p = pool_.allocate(sizeof(NodeType));
+		try
+		{
+			return new (p) NodeType(id);
+		} catch (...)
+		{
+			pool_.deallocate(p, sizeof(NodeType));
+			throw;
+		}
+	}
+
+	virtual EdgeType* doCreateEdge(edge_id_t id, Node& source, Node& target, bool directed)
+	{
+		void* p = pool_.allocate(sizeof(EdgeType));
+		try
+		{
+			return EdgeType::create(p, id, source, target, directed);
+		} catch (...)
+		{
+			pool_.deallocate(p, sizeof(EdgeType));
+			throw;
+		}
+	}
+
+	virtual EdgeType* doCreateEdgeUnchecked(edge_id_t id, Node& source, Node& target, bool directed)
+	{
+		void* p = pool_.allocate(sizeof(EdgeType));
+		try
+		{
+			return EdgeType::createUnchecked(p, id, source, target, directed);
+		} catch (...)
+		{
+			pool_.deallocate(p, sizeof(EdgeType));
+			throw;
+		}
+	}
+
+	virtual void doDestroyNode(Node* n)
+	{
+		NodeType* p = static_cast<NodeType*>(n);
+		p->~NodeType();
+		pool_.deallocate(p, sizeof(NodeType));
+	}
+
+	virtual void doDestroyEdge(Edge* e)
+	{
+		EdgeType* p = static_cast<EdgeType*>(e);
+		p->~EdgeType();
+		pool_.deallocate(p, sizeof(EdgeType));
+	}
+
+	virtual void doReset()
+	{
+		pool_.reset();
+	}
+
+	virtual PooledElementFactory* doClone() const
+	{
+		return new PooledElementFactory; // with a pool of its own
+	}
+
+	virtual size_t doMemoryUsage() const
+	{
+		return pool_.capacity();
+	}
+
+	ElementPool pool_;
 };
 
 /**
@@ -37,6 +154,18 @@ typedef GraphElementFactory<SingleNode, Edge> SingleEdgeElementFactory;
  * Element factory for non-simple graphs, in which parallel edges are allowed
  */
 typedef GraphElementFactory<MultiNode, Edge> MultiEdgeElementFactory;
+/**
+ * Element factory for simple graphs in which no parallel edges are allowed,
+ * storing adjacent edges in contiguous arrays
+ * @see CompactNode
+ */
+typedef GraphElementFactory<CompactNode, Edge> CompactElementFactory;
+/**
+ * Element factory for simple graphs in which no parallel edges are allowed,
+ * with constant-time adjacency queries
+ * @see IndexedNode
+ */
+typedef GraphElementFactory<IndexedNode, Edge> IndexedElementFactory;
 
 }
 
@@ -3,16 +3,119 @@
 
 #include <largenet2/base/types.h>
 #include <largenet2/util/choosetype.h>
+#include <boost/iterator/iterator_facade.hpp>
 #include <iterator>
+#include <set>
 
 namespace largenet
 {
 
 class Node;
+class Edge;
 
 namespace iterators
 {
 
+/**
+ * Iterator over the edges attached to a node.
+ *
+ * Node types keep their adjacent edges either in node-based containers
+ * (std::set) or in contiguous arrays. This iterator traverses both kinds of
+ * storage, so that all node types can share the same Node interface.
+ */
+class NodeEdgeIterator: public boost::iterator_facade<NodeEdgeIterator,
+		Edge* const, boost::bidirectional_traversal_tag>
+{
+public:
+	typedef std::set<Edge*>::const_iterator set_iterator;
+	typedef Edge* const* array_iterator;
+
+	/**
+	 * Default constructor. Creates a singular iterator.
+	 */
+	NodeEdgeIterator() :
+		set_(), ptr_(0), contiguous_(true)
+	{
+	}
+	/**
+	 * Create iterator from an iterator into a std::set of edges.
+	 *
+	 * This is implicit on purpose, such that set-based node types can
+	 * return their set iterators directly.
+	 */
+	NodeEdgeIterator(const set_iterator& it) :
+		set_(it), ptr_(0), contiguous_(false)
+	{
+	}
+	/**
+	 * Create iterator from a pointer into a contiguous array of edges.
+	 */
+	explicit NodeEdgeIterator(array_iterator p) :
+		set_(), ptr_(p), contiguous_(true)
+	{
+	}
+	/**
+	 * Check whether this iterator traverses a contiguous array.
+	 *
+	 * Loops over a whole edge range can check this once and then walk
+	 * arrayIterator() or setIterator() directly, which saves the check on
+	 * each step.
+	 */
+	bool contiguous() const
+	{
+		return contiguous_;
+	}
+	/**
+	 * Underlying array position, only valid if contiguous()
+	 */
+	array_iterator arrayIterator() const
+	{
+		return ptr_;
+	}
+	/**
+	 * Underlying set iterator, only valid if not contiguous()
+	 */
+	const set_iterator& setIterator() const
+	{
+		return set_;
+	}
+
+private:
+	friend class boost::iterator_core_access;
+
+	void increment()
+	{
+		if (contiguous_)
+			++ptr_;
+		else
+			++set_;
+	}
+
+	void decrement()
+	{
+		if (contiguous_)
+			--ptr_;
+		else
+			--set_;
+	}
+
+	Edge* const& dereference() const
+	{
+		return contiguous_ ? *ptr_ : *set_;
+	}
+
+	bool equal(const NodeEdgeIterator& other) const
+	{
+		// comparable iterators traverse the same range, and thus the same
+		// kind of storage
+		return contiguous_ ? (ptr_ == other.ptr_) : (set_ == other.set_);
+	}
+
+	set_iterator set_;
+	array_iterator ptr_;
+	bool contiguous_;
+};
+
 template<class Iterator, bool is_const = false>
 class NodeOutNeighborIterator
 {
@@ -0,0 +1,139 @@
+/**
+ * @file node_traits.h
+ * @date 18.10.2026
+ */
+
+#ifndef NODE_TRAITS_H_
+#define NODE_TRAITS_H_
+
+#include <largenet2/base/types.h>
+#include <largenet2/base/Node.h>
+
+namespace largenet
+{
+
+/**
+ * Statically dispatched node queries
+ *
+ * All members call the implementation in @p NodeType directly instead of going
+ * through the virtual Node interface, such that they can be inlined. They
+ * must only be used on nodes whose dynamic type is exactly @p NodeType, which
+ * is guaranteed for the nodes of a BasicGraph<NodeType>.
+ *
+ * The specialization for Node uses the virtual interface, so generic code
+ * written against node_traits works for every graph.
+ *
+ * @tparam NodeType concrete node type
+ */
+template<class NodeType>
+struct node_traits
+{
+	static degree_t outDegree(const NodeType& n)
+	{
+		return n.NodeType::outDegree();
+	}
+	static degree_t inDegree(const NodeType& n)
+	{
+		return n.NodeType::inDegree();
+	}
+	static degree_t undirectedDegree(const NodeType& n)
+	{
+		return n.NodeType::undirectedDegree();
+	}
+	static degree_t mutualDegree(const NodeType& n)
+	{
+		return n.NodeType::mutualDegree();
+	}
+	static degree_t degree(const NodeType& n)
+	{
+		return n.NodeType::degree();
+	}
+	static bool hasEdgeTo(const NodeType& n, const Node* m)
+	{
+		return n.NodeType::hasEdgeTo(m);
+	}
+	static bool hasEdgeFrom(const NodeType& n, const Node* m)
+	{
+		return n.NodeType::hasEdgeFrom(m);
+	}
+	static bool hasUndirectedEdgeTo(const NodeType& n, const Node* m)
+	{
+		return n.NodeType::hasUndirectedEdgeTo(m);
+	}
+	static bool isAdjacentTo(const NodeType& n, const Node* m)
+	{
+		return hasEdgeTo(n, m) || hasEdgeFrom(n, m) || hasUndirectedEdgeTo(n, m);
+	}
+	static Node::edge_iterator_range outEdges(const NodeType& n)
+	{
+		return n.NodeType::outEdges();
+	}
+	static Node::edge_iterator_range inEdges(const NodeType& n)
+	{
+		return n.NodeType::inEdges();
+	}
+	static Node::edge_iterator_range undirectedEdges(const NodeType& n)
+	{
+		return n.NodeType::undirectedEdges();
+	}
+};
+
+/**
+ * Node queries through the virtual Node interface
+ */
+template<>
+struct node_traits<Node>
+{
+	static degree_t outDegree(const Node& n)
+	{
+		return n.outDegree();
+	}
+	static degree_t inDegree(const Node& n)
+	{
+		return n.inDegree();
+	}
+	static degree_t undirectedDegree(const Node& n)
+	{
+		return n.undirectedDegree();
+	}
+	static degree_t mutualDegree(const Node& n)
+	{
+		return n.mutualDegree();
+	}
+	static degree_t degree(const Node& n)
+	{
+		return n.degree();
+	}
+	static bool hasEdgeTo(const Node& n, const Node* m)
+	{
+		return n.hasEdgeTo(m);
+	}
+	static bool hasEdgeFrom(const Node& n, const Node* m)
+	{
+		return n.hasEdgeFrom(m);
+	}
+	static bool hasUndirectedEdgeTo(const Node& n, const Node* m)
+	{
+		return n.hasUndirectedEdgeTo(m);
+	}
+	static bool isAdjacentTo(const Node& n, const Node* m)
+	{
+		return n.isAdjacentTo(m);
+	}
+	static Node::edge_iterator_range outEdges(const Node& n)
+	{
+		return n.outEdges();
+	}
+	static Node::edge_iterator_range inEdges(const Node& n)
+	{
+		return n.inEdges();
+	}
+	static Node::edge_iterator_range undirectedEdges(const Node& n)
+	{
+		return n.undirectedEdges();
+	}
+};
+
+}
+
+#endif /* NODE_TRAITS_H_ */
@@ -0,0 +1,268 @@
+/**
+ * @file orderings.cpp
+ * @date 18.10.2026
+ */
+
+#include <largenet2/base/orderings.h>
+#include <largenet2/base/CSRGraph.h>
+#include <largenet2/base/Graph.h>
+#include <algorithm>
+#include <utility>
+
+namespace largenet
+{
+namespace orderings
+{
+
+namespace
+{
+
+const node_size_t none = static_cast<node_size_t> (-1);
+
+/// sorts node indices by ascending degree
+class ByDegree
+{
+public:
+	explicit ByDegree(const CSRGraph& c) :
+		c_(c)
+	{
+	}
+	bool operator()(const node_size_t a, const node_size_t b) const
+	{
+		return c_.degree(a) < c_.degree(b);
+	}
+private:
+	const CSRGraph& c_;
+};
+
+/**
+ * Breadth-first search over the component of @p start that has not been
+ * visited yet, marking nodes with @p mark and appending them to @p order.
+ */
+void search(const CSRGraph& c, const node_size_t start, const bool byDegree,
+		const node_size_t mark, std::vector<node_size_t>& marks,
+		std::vector<node_size_t>& order)
+{
+	size_t head = order.size();
+	order.push_back(start);
+	marks[start] = mark;
+	for (; head < order.size(); ++head)
+	{
+		const size_t level = order.size();
+		for (int d = CSRGraph::OUT; d <= CSRGraph::UNDIRECTED; ++d)
+		{
+			const CSRGraph::index_range r = c.neighbors(order[head],
+					static_cast<CSRGraph::Direction> (d));
+			for (CSRGraph::index_iterator it = r.first; it != r.second; ++it)
+			{
+				if (marks[*it] == mark)
+					continue;
+				marks[*it] = mark;
+				order.push_back(*it);
+			}
+		}
+		if (byDegree)
+			std::stable_sort(order.begin() + level, order.end(), ByDegree(c));
+	}
+}
+
+/**
+ * Node of large eccentricity in the component of @p start (George and Liu),
+ * using marks after @p mark and leaving @p mark at the last one used
+ */
+node_size_t peripheral(const CSRGraph& c, node_size_t start,
+		node_size_t& mark, std::vector<node_size_t>& marks)
+{
+	std::vector<node_size_t> order, depth(c.numberOfNodes());
+	node_size_t eccentricity = 0;
+	for (bool first = true;; first = false)
+	{
+		// breadth-first search recording levels
+		order.assign(1, start);
+		marks[start] = ++mark;
+		depth[start] = 0;
+		for (size_t head = 0; head < order.size(); ++head)
+		{
+			for (int d = CSRGraph::OUT; d <= CSRGraph::UNDIRECTED; ++d)
+			{
+				const CSRGraph::index_range r = c.neighbors(order[head],
+						static_cast<CSRGraph::Direction> (d));
+				for (CSRGraph::index_iterator it = r.first; it != r.second; ++it)
+				{
+					if (marks[*it] == mark)
+						continue;
+					marks[*it] = mark;
+					depth[*it] = depth[order[head]] + 1;
+					order.push_back(*it);
+				}
+			}
+		}
+		const node_size_t e = depth[order.back()];
+		if (!first && (e <= eccentricity))
+			return start;
+		eccentricity = e;
+		// continue from a node of minimum degree in the last level
+		node_size_t next = order.back();
+		for (size_t i = order.size(); (i > 0) && (depth[order[i - 1]] == e); --i)
+		{
+			if (c.degree(order[i - 1]) < c.degree(next))
+				next = order[i - 1];
+		}
+		if (next == start)
+			return start;
+		start = next;
+	}
+}
+
+std::vector<node_id_t> ids(const CSRGraph& c,
+		const std::vector<node_size_t>& order)
+{
+	std::vector<node_id_t> v(order.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		v[i] = c.nodeId(order[i]);
+	return v;
+}
+
+}
+
+std::vector<node_id_t> breadthFirst(const Graph& g)
+{
+	const CSRGraph c(g);
+	std::vector<node_size_t> marks(c.numberOfNodes(), none), order;
+	order.reserve(c.numberOfNodes());
+	for (node_size_t i = 0; i < c.numberOfNodes(); ++i)
+	{
+		if (marks[i] == none)
+			search(c, i, false, 0, marks, order);
+	}
+	return ids(c, order);
+}
+
+std::vector<node_id_t> reverseCuthillMcKee(const Graph& g)
+{
+	const CSRGraph c(g);
+	std::vector<node_size_t> byDegree(c.numberOfNodes());
+	for (node_size_t i = 0; i < c.numberOfNodes(); ++i)
+		byDegree[i] = i;
+	std::stable_sort(byDegree.begin(), byDegree.end(), ByDegree(c));
+	// the final search uses mark 0, the pseudo-peripheral searches the
+	// marks after it
+	std::vector<node_size_t> marks(c.numberOfNodes(), none), order;
+	order.reserve(c.numberOfNodes());
+	node_size_t mark = 0;
+	for (node_size_t i = 0; i < byDegree.size(); ++i)
+	{
+		if (marks[byDegree[i]] == 0)
+			continue;
+		const node_size_t start = peripheral(c, byDegree[i], mark, marks);
+		search(c, start, true, 0, marks, order);
+	}
+	std::reverse(order.begin(), order.end());
+	return ids(c, order);
+}
+
+std::vector<node_id_t> degreeDescending(const Graph& g)
+{
+	const CSRGraph c(g);
+	std::vector<node_size_t> order(c.numberOfNodes());
+	for (node_size_t i = 0; i < c.numberOfNodes(); ++i)
+		order[i] = i;
+	// ascending from the back is descending from the front, with ties in
+	// their original order
+	std::stable_sort(order.rbegin(), order.rend(), ByDegree(c));
+	return ids(c, order);
+}
+
+std::vector<node_id_t> communities(const Graph& g)
+{
+	typedef std::vector<std::pair<node_size_t, double> > Adjacency;
+	const CSRGraph c(g);
+	const node_size_t N = c.numberOfNodes();
+	std::vector<Adjacency> adj(N);
+	std::vector<double> volume(N);
+	double total = 0;
+	for (node_size_t i = 0; i < N; ++i)
+	{
+		for (int d = CSRGraph::OUT; d <= CSRGraph::UNDIRECTED; ++d)
+		{
+			const CSRGraph::index_range r = c.neighbors(i,
+					static_cast<CSRGraph::Direction> (d));
+			for (CSRGraph::index_iterator it = r.first; it != r.second; ++it)
+				adj[i].push_back(std::make_pair(*it, 1.0));
+		}
+		volume[i] = adj[i].size();
+		total += volume[i];
+	}
+
+	// merge nodes into communities by ascending degree
+	std::vector<node_size_t> byDegree(N), parent(N);
+	for (node_size_t i = 0; i < N; ++i)
+		byDegree[i] = parent[i] = i;
+	std::stable_sort(byDegree.begin(), byDegree.end(), ByDegree(c));
+	std::vector<std::vector<node_size_t> > children(N);
+	std::vector<double> weight(N, 0);
+	std::vector<node_size_t> touched;
+	for (node_size_t k = 0; k < N; ++k)
+	{
+		const node_size_t u = byDegree[k];
+		// aggregate the edges of u's community by neighboring community
+		touched.clear();
+		for (Adjacency::const_iterator it = adj[u].begin(); it != adj[u].end(); ++it)
+		{
+			node_size_t r = it->first;
+			while (parent[r] != r)
+				r = parent[r] = parent[parent[r]];
+			if (r == u)
+				continue;
+			if (weight[r] == 0)
+				touched.push_back(r);
+			weight[r] += it->second;
+		}
+		Adjacency merged;
+		merged.reserve(touched.size());
+		node_size_t best = none;
+		double gain = 0;
+		for (size_t i = 0; i < touched.size(); ++i)
+		{
+			const node_size_t r = touched[i];
+			// modularity gain of merging u into r, times total / 2
+			const double dq = weight[r] - volume[u] * volume[r] / total;
+			if (dq > gain)
+			{
+				gain = dq;
+				best = r;
+			}
+			merged.push_back(std::make_pair(r, weight[r]));
+			weight[r] = 0;
+		}
+		adj[u].swap(merged);
+		if (best == none)
+			continue;
+		parent[u] = best;
+		volume[best] += volume[u];
+		children[best].push_back(u);
+		adj[best].insert(adj[best].end(), adj[u].begin(), adj[u].end());
+		Adjacency().swap(adj[u]);
+	}
+
+	// depth-first traversal of the merge hierarchy
+	std::vector<node_size_t> order, stack;
+	order.reserve(N);
+	for (node_size_t i = 0; i < N; ++i)
+	{
+		if (parent[i] != i)
+			continue;
+		stack.push_back(i);
+		while (!stack.empty())
+		{
+			const node_size_t v = stack.back();
+			stack.pop_back();
+			order.push_back(v);
+			stack.insert(stack.end(), children[v].rbegin(), children[v].rend());
+		}
+	}
+	return ids(c, order);
+}
+
+}
+}
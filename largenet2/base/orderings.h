@@ -0,0 +1,70 @@
+/**
+ * @file orderings.h
+ * @date 18.10.2026
+ */
+
+#ifndef ORDERINGS_H_
+#define ORDERINGS_H_
+
+#include <largenet2/base/types.h>
+#include <vector>
+
+namespace largenet
+{
+
+class Graph;
+
+/**
+ * Node orderings for Graph::relabel()
+ *
+ * Each function returns the IDs of all nodes of a graph in a new order,
+ * which is meant to be passed to Graph::relabel(). Orderings that place
+ * adjacent nodes close to each other improve the cache locality of
+ * algorithms walking along edges. Edge directions are ignored.
+ *
+ * @code
+ * g.relabel(orderings::reverseCuthillMcKee(g));
+ * @endcode
+ */
+namespace orderings
+{
+
+/**
+ * Breadth-first order, starting each connected component at its node that
+ * comes first in Graph::nodes().
+ */
+std::vector<node_id_t> breadthFirst(const Graph& g);
+/**
+ * Reverse Cuthill-McKee order
+ *
+ * Breadth-first search from a pseudo-peripheral node of each connected
+ * component, visiting neighbors by ascending degree, in reverse. This keeps
+ * the IDs of adjacent nodes close together, i.e. it reduces the bandwidth of
+ * the adjacency matrix, and works best on meshes and other graphs of
+ * large diameter.
+ */
+std::vector<node_id_t> reverseCuthillMcKee(const Graph& g);
+/**
+ * Nodes by descending degree, ties in the order of Graph::nodes()
+ *
+ * Places the hubs of a heavy-tailed network next to each other, where
+ * they share the cache lines visited most often.
+ */
+std::vector<node_id_t> degreeDescending(const Graph& g);
+/**
+ * Community order in the spirit of Rabbit Order
+ *
+ * Nodes are merged into the neighboring community giving the largest
+ * modularity gain, in order of ascending degree, and the edges of merged
+ * communities are aggregated. The resulting hierarchy of merges is
+ * traversed depth-first, such that each community, and each community
+ * within it, gets a contiguous range of IDs. This suits networks with
+ * community structure but small diameter, where breadth-first orderings
+ * soon spread over the whole graph.
+ */
+std::vector<node_id_t> communities(const Graph& g);
+
+}
+}
+
+#endif /* ORDERINGS_H_ */
@@ -0,0 +1,168 @@
+/**
+ * @file parallel.h
+ * @date 18.10.2026
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <largenet2/base/types.h>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace largenet
+{
+
+/**
+ * @defgroup parallel Parallel traversal
+ *
+ * The ranges returned by Graph::denseNodes(), Graph::denseEdges(),
+ * Graph::nodes(node_state_t), and Graph::edges(edge_state_t) are random
+ * access ranges, which are partitioned here by storage address into parts
+ * of nearly equal size that are processed in parallel using OpenMP. Without
+ * OpenMP (configure --disable-openmp, or client code compiled without it),
+ * everything runs in the calling thread.
+ *
+ * While no thread modifies the graph, the following may be called
+ * concurrently: all const members of Graph, Node, and Edge, as well as all
+ * node and edge ranges and their iterators. Not thread-safe are all
+ * modifications, including state changes.
+ * @{
+ */
+
+/**
+ * Number of threads parallel loops run on
+ */
+inline unsigned int numberOfThreads()
+{
+#ifdef _OPENMP
+	return omp_get_max_threads();
+#else
+	return 1;
+#endif
+}
+
+/**
+ * Get part @p i of @p r split into @p parts contiguous parts of nearly
+ * equal size
+ *
+ * @param r random access iterator range (a std::pair of iterators)
+ * @param parts number of parts
+ * @param i part number, 0 <= @p i < @p parts
+ * @return the @p i'th part, which is empty if @p r has less than @p parts
+ * elements and @p i is large
+ */
+template<class Range>
+Range splitRange(const Range& r, const unsigned int parts, const unsigned int i)
+{
+	assert(parts > 0);
+	assert(i < parts);
+	typedef typename Range::first_type iterator;
+	typedef typename std::iterator_traits<iterator>::difference_type
+			difference_type;
+	const difference_type n = r.second - r.first;
+	const iterator first = r.first + n / parts * i + std::min<difference_type>(
+			i, n % parts);
+	return Range(first, first + n / parts
+			+ (static_cast<difference_type> (i) < n % parts ? 1 : 0));
+}
+
+/**
+ * Call @p f for each element of @p r in parallel
+ *
+ * @p f is shared by all threads and must be safe to call concurrently.
+ * @param r random access iterator range (a std::pair of iterators)
+ * @param f function object taking a reference to an element
+ */
+template<class Range, class Function>
+void parallel_for_each(const Range& r, Function f)
+{
+	const long n = r.second - r.first;
+#pragma omp parallel for schedule(static)
+	for (long i = 0; i < n; ++i)
+		f(*(r.first + i));
+}
+
+/**
+ * Accumulate over the elements of @p r in parallel
+ *
+ * Each part of @p r is processed by a copy of @p body, and the copies are
+ * then joined into @p body in the order of their parts, so that the result
+ * does not depend on scheduling. @p body must thus be in a neutral state,
+ * e.g. with all sums set to zero.
+ *
+ * @p Body must be copy-constructible and assignable and provide
+ * - <tt>void operator()(element&)</tt> to process an element of @p r, and
+ * - <tt>void join(const Body& other)</tt> to add the results of @p other.
+ *
+ * @param r random access iterator range (a std::pair of iterators)
+ * @param body accumulator, receives the result
+ */
+template<class Range, class Body>
+void parallel_reduce(const Range& r, Body& body)
+{
+	const unsigned int parts = numberOfThreads();
+	std::vector<Body> bodies(parts, body);
+#pragma omp parallel for schedule(static, 1)
+	for (long p = 0; p < static_cast<long> (parts); ++p)
+	{
+		const Range part = splitRange(r, parts, p);
+		for (typename Range::first_type it = part.first; it != part.second; ++it)
+			bodies[p](*it);
+	}
+	body = bodies[0];
+	for (unsigned int p = 1; p < parts; ++p)
+		body.join(bodies[p]);
+}
+
+/**
+ * Call @p f for each node of @p g in parallel
+ * @see parallel_for_each
+ */
+template<class GraphType, class Function>
+void parallel_for_each_node(GraphType& g, Function f)
+{
+	parallel_for_each(g.denseNodes(), f);
+}
+
+/**
+ * Call @p f for each node of @p g in state @p s in parallel
+ * @see parallel_for_each
+ */
+template<class GraphType, class Function>
+void parallel_for_each_node(GraphType& g, node_state_t s, Function f)
+{
+	parallel_for_each(g.nodes(s), f);
+}
+
+/**
+ * Call @p f for each edge of @p g in parallel
+ * @see parallel_for_each
+ */
+template<class GraphType, class Function>
+void parallel_for_each_edge(GraphType& g, Function f)
+{
+	parallel_for_each(g.denseEdges(), f);
+}
+
+/**
+ * Call @p f for each edge of @p g in state @p s in parallel
+ * @see parallel_for_each
+ */
+template<class GraphType, class Function>
+void parallel_for_each_edge(GraphType& g, edge_state_t s, Function f)
+{
+	parallel_for_each(g.edges(s), f);
+}
+
+/** @} */
+
+}
+
+#endif /* PARALLEL_H_ */
@@ -0,0 +1,297 @@
+/**
+ * @file properties.h
+ * @date 18.10.2026
+ */
+
+#ifndef PROPERTIES_H_
+#define PROPERTIES_H_
+
+#include <largenet2/base/types.h>
+#include <largenet2/base/Graph.h>
+#include <largenet2/base/GraphListener.h>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+namespace largenet
+{
+
+/// @cond IGNORE
+namespace detail
+{
+/**
+ * Values of type @p T stored in a dense array indexed by element ID
+ */
+template<class T, class Id>
+class PropertyArray
+{
+public:
+	typedef T value_type;
+	typedef typename std::vector<T>::reference reference;
+	typedef typename std::vector<T>::const_reference const_reference;
+	typedef typename std::vector<T>::iterator iterator;
+	typedef typename std::vector<T>::const_iterator const_iterator;
+
+	const_reference operator[](const Id i) const
+	{
+		assert(i < values_.size());
+		return values_[i];
+	}
+	reference operator[](const Id i)
+	{
+		assert(i < values_.size());
+		return values_[i];
+	}
+	/**
+	 * Value of the element with ID @p i, e.g. for use as edge weight provider
+	 */
+	const_reference operator()(const Id i) const
+	{
+		return (*this)[i];
+	}
+	/**
+	 * Value of new elements and of elements that have been removed
+	 */
+	const T& defaultValue() const
+	{
+		return default_;
+	}
+	/**
+	 * Set all values to @p value
+	 */
+	void fill(const T& value)
+	{
+		std::fill(values_.begin(), values_.end(), value);
+	}
+	/**
+	 * Number of stored values, which is larger than the largest element ID
+	 */
+	size_t size() const
+	{
+		return values_.size();
+	}
+	/**
+	 * Memory held by the values, in bytes
+	 */
+	size_t memoryUsage() const
+	{
+		return values_.capacity() * sizeof(T) + removed_.capacity()
+				* sizeof(std::pair<Id, T>);
+	}
+	/**
+	 * Iterators over all values in ID order. Values at unused IDs equal
+	 * defaultValue().
+	 */
+	iterator begin()
+	{
+		return values_.begin();
+	}
+	iterator end()
+	{
+		return values_.end();
+	}
+	const_iterator begin() const
+	{
+		return values_.begin();
+	}
+	const_iterator end() const
+	{
+		return values_.end();
+	}
+
+protected:
+	explicit PropertyArray(const T& def) :
+		default_(def)
+	{
+	}
+	/// make room for the value of new element @p i and set it to the default
+	void add(const Id i)
+	{
+		if (i >= values_.size())
+			values_.resize(std::max<size_t>(i + 1, 2 * values_.size()), default_);
+		else
+			values_[i] = default_;
+	}
+	/// reset the value of removed element @p i, keeping it for restore() if
+	/// @p keep
+	void remove(const Id i, const bool keep)
+	{
+		assert(i < values_.size());
+		if (keep)
+			removed_.push_back(std::make_pair(i, values_[i]));
+		values_[i] = default_;
+	}
+	/// make room for the removed element @p i again, with its kept value
+	void restore(const Id i)
+	{
+		add(i);
+		// elements are restored in reverse order of their removal
+		if (!removed_.empty() && (removed_.back().first == i))
+		{
+			values_[i] = removed_.back().second;
+			removed_.pop_back();
+		}
+	}
+	/// discard the values kept for restore()
+	void forget()
+	{
+		removed_.clear();
+	}
+	void clear()
+	{
+		values_.clear();
+		removed_.clear();
+	}
+	/// move values to new IDs, which are never larger than the old ones
+	void compact(const std::vector<Id>& newIds, const size_t n)
+	{
+		// the new IDs may be in any order (@see Graph::relabel)
+		std::vector<T> values(n, default_);
+		for (size_t i = 0; i < newIds.size(); ++i)
+		{
+			if (newIds[i] != std::numeric_limits<Id>::max())
+				values[newIds[i]] = values_[i];
+		}
+		values_.swap(values);
+	}
+
+private:
+	T default_;
+	std::vector<T> values_;
+	/// values of elements removed during a transaction, by ID
+	std::vector<std::pair<Id, T> > removed_;
+};
+}
+/// @endcond
+
+/**
+ * Node property map.
+ *
+ * Stores a value of type @p T for every node, such as a susceptibility, in a
+ * dense array indexed by node ID. Access thus takes constant time without any
+ * lookups, and loops over all values can be vectorized. The property is a
+ * graph listener: It makes room for new nodes, resets the values of removed
+ * nodes to the default value, and follows Graph::compact() and
+ * Graph::relabel(). Values of nodes removed during a transaction are kept
+ * until it is committed, and restored if it is rolled back.
+ *
+ * The property takes the nodes from the graph it is constructed with and must
+ * then be registered with that graph (@see Graph::addGraphListener).
+ */
+template<class T>
+class NodeProperty: public detail::PropertyArray<T, node_id_t>,
+		public GraphListener
+{
+public:
+	/**
+	 * Create property with value @p def for all nodes of @p g.
+	 */
+	explicit NodeProperty(const Graph& g, const T& def = T()) :
+		detail::PropertyArray<T, node_id_t>(def)
+	{
+		for (Graph::ConstNodeIterator it = g.nodes().first; it
+				!= g.nodes().second; ++it)
+			this->add(it.id());
+	}
+	size_t memoryUsage() const
+	{
+		return detail::PropertyArray<T, node_id_t>::memoryUsage();
+	}
+
+private:
+	void afterNodeAddEvent(Graph& g, Node& n)
+	{
+		this->add(n.id());
+	}
+	void beforeNodeRemoveEvent(Graph& g, Node& n)
+	{
+		// keep the value in case the removal is rolled back
+		this->remove(n.id(), g.inTransaction());
+	}
+	void afterNodeRestoreEvent(Graph& g, Node& n)
+	{
+		this->restore(n.id());
+	}
+	void afterTransactionCommitEvent(Graph& g)
+	{
+		this->forget();
+	}
+	void beforeGraphClearEvent(Graph& g)
+	{
+		this->clear();
+	}
+	void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds)
+	{
+		this->compact(nodeIds, g.numberOfNodes());
+	}
+};
+
+/**
+ * Edge property map.
+ *
+ * Stores a value of type @p T for every edge, such as a link weight, in a
+ * dense array indexed by edge ID. It can be used directly as edge weight
+ * provider for the weighted measures.
+ * @see NodeProperty
+ */
+template<class T>
+class EdgeProperty: public detail::PropertyArray<T, edge_id_t>,
+		public GraphListener
+{
+public:
+	/**
+	 * Create property with value @p def for all edges of @p g.
+	 */
+	explicit EdgeProperty(const Graph& g, const T& def = T()) :
+		detail::PropertyArray<T, edge_id_t>(def)
+	{
+		for (Graph::ConstEdgeIterator it = g.edges().first; it
+				!= g.edges().second; ++it)
+			this->add(it.id());
+	}
+	size_t memoryUsage() const
+	{
+		return detail::PropertyArray<T, edge_id_t>::memoryUsage();
+	}
+
+private:
+	void afterEdgeAddEvent(Graph& g, Edge& e)
+	{
+		this->add(e.id());
+	}
+	void beforeEdgeRemoveEvent(Graph& g, Edge& e)
+	{
+		this->remove(e.id(), g.inTransaction());
+	}
+	void afterEdgeRestoreEvent(Graph& g, Edge& e)
+	{
+		this->restore(e.id());
+	}
+	void afterTransactionCommitEvent(Graph& g)
+	{
+		this->forget();
+	}
+	// rewired edges keep their values
+	void beforeEdgeRewireEvent(Graph& g, Edge& e, Node& newSource, Node& newTarget)
+	{
+	}
+	void afterEdgeRewireEvent(Graph& g, Edge& e, Node& oldSource, Node& oldTarget)
+	{
+	}
+	void beforeGraphClearEvent(Graph& g)
+	{
+		this->clear();
+	}
+	void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds)
+	{
+		this->compact(edgeIds, g.numberOfEdges());
+	}
+};
+
+}
+
+#endif /* PROPERTIES_H_ */
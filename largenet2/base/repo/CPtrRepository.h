@@ -10,12 +10,15 @@
 #include "repo_types.h"
 #include "repo_iterators.h"
 #include "repo_exceptions.h"
+#include "SegmentedArray.h"
 #include <vector>
 #include <memory>
-#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/ptr_container/clone_allocator.hpp>
 #include <boost/noncopyable.hpp>
 #include <cassert>
 #include <utility>
+#include <limits>
+#include <algorithm>
 
 namespace repo
 {
@@ -25,6 +28,21 @@ namespace repo
  * number of classes. Repository features efficient access to objects and can handle
  * some additional tasks.
  *
+ * The repository owns its items and disposes of them through @p CloneAllocator
+ * (@see boost::ptr_container). Its bookkeeping arrays can be stored in
+ * segments (@see setSegmentBits()), in which case growing the repository
+ * never copies them.
+ *
+ * By default, items are kept in a single array ordered by category, such
+ * that changing the category of an item from @c a to @c b takes
+ * O(|a - b|) steps, and inserting an item takes O(C) steps for C
+ * categories. For many categories, use indexed categories instead
+ * (@see setIndexedCategories()).
+ *
+ * @tparam T item type
+ * @tparam CloneAllocator disposes of items
+ * @tparam Allocator unused, kept for source compatibility
+ *
  * @author Gerd Zschaler <zschaler@pks.mpg.de>
  * @author Thilo Gross (original idea)
  */
@@ -51,10 +69,15 @@ public:
 	typedef iterators::CategoryIterator<T, this_type> CategoryIterator;
 	typedef iterators::CategoryIterator<T const, this_type const> ConstCategoryIterator;
 
+	typedef iterators::DenseIterator<T, this_type> DenseIterator;
+	typedef iterators::DenseIterator<T const, this_type const> ConstDenseIterator;
+
 	typedef iterator_range IndexIteratorRange;
 	typedef std::pair<ConstIndexIterator, ConstIndexIterator> ConstIndexIteratorRange;
 	typedef std::pair<CategoryIterator, CategoryIterator> CategoryIteratorRange;
 	typedef std::pair<ConstCategoryIterator, ConstCategoryIterator> ConstCategoryIteratorRange;
+	typedef std::pair<DenseIterator, DenseIterator> DenseIteratorRange;
+	typedef std::pair<ConstDenseIterator, ConstDenseIterator> ConstDenseIteratorRange;
 
 public:
 	CPtrRepository();
@@ -98,11 +121,32 @@ public:
 	{
 		return N_;
 	}
+	/**
+	 * Memory held by the bookkeeping arrays, in bytes, not counting the items
+	 * themselves.
+	 * @see unusedMemory()
+	 */
+	boost::uint64_t memoryUsage() const
+	{
+		return nums_.memoryUsage() + ids_.memoryUsage() + items_.memoryUsage()
+				+ (count_.capacity() + offset_.capacity()) * sizeof(address_t);
+	}
+	/**
+	 * Part of memoryUsage() that is reserved for items not currently stored
+	 */
+	boost::uint64_t unusedMemory() const
+	{
+		return (nums_.capacity() - nStored_) * sizeof(address_t)
+				+ (ids_.capacity() - nStored_) * sizeof(id_t)
+				+ (items_.capacity() - nStored_) * sizeof(T*);
+	}
 
 	id_size_t maxSize() const
 	{
-		// taken from std::allocator
-		return id_size_t(-1) / sizeof(T);
+		// both item IDs and addresses must be representable
+		const id_size_t max_id = std::numeric_limits<id_size_t>::max();
+		const id_size_t max_address = std::numeric_limits<address_t>::max();
+		return std::min(max_id, max_address);
 	}
 
 	unsigned int enlargeFactor() const
@@ -116,6 +160,74 @@ public:
 			enlargeFactor_ = val;
 	}
 
+	/**
+	 * Reserve memory for at least @p n items, such that up to @p n items
+	 * can be stored without enlarging the repository again.
+	 * @param n Number of items to reserve memory for.
+	 * @throw AllocException if @p n exceeds maxSize()
+	 */
+	void reserve(id_size_t n);
+
+	/**
+	 * Get the clone allocator used to dispose of items.
+	 */
+	const CloneAllocator& cloneAllocator() const
+	{
+		return alloc_;
+	}
+
+	/**
+	 * Set the clone allocator used to dispose of items.
+	 *
+	 * This allows for stateful clone allocators, e.g. ones that return items
+	 * to the memory pool they were created from. It should only be changed
+	 * while the repository is empty.
+	 */
+	void setCloneAllocator(const CloneAllocator& a)
+	{
+		alloc_ = a;
+	}
+
+	/**
+	 * Store the bookkeeping arrays in segments of 2^@p bits items, or
+	 * contiguously if @p bits is 0 (the default).
+	 *
+	 * In segmented mode, the repository grows by one segment at a time and
+	 * never copies existing entries, which bounds the cost of a single
+	 * insertion. Contiguous storage grows by enlargeFactor() and has slightly
+	 * cheaper access. Switching modes copies the arrays once.
+	 * @param bits Base-2 logarithm of the segment size.
+	 * @throw std::invalid_argument if @p bits is larger than 30
+	 */
+	void setSegmentBits(unsigned int bits);
+	/**
+	 * Get the base-2 logarithm of the segment size, or 0 if the
+	 * bookkeeping arrays are stored contiguously.
+	 */
+	unsigned int segmentBits() const
+	{
+		return items_.segmentBits();
+	}
+
+	/**
+	 * Keep a separate list of items for each category (@p on is true), or
+	 * order a single list of all items by category (the default).
+	 *
+	 * With indexed categories, inserting and erasing items and changing
+	 * their categories take constant time, independent of the number of
+	 * categories, at the expense of two more words of memory per item. The
+	 * items in each category are still stored contiguously. Switching modes
+	 * takes time linear in the number of items and categories.
+	 */
+	void setIndexedCategories(bool on);
+	/**
+	 * Check whether categories are indexed (@see setIndexedCategories()).
+	 */
+	bool indexedCategories() const
+	{
+		return indexed_;
+	}
+
 	/**
 	 * Get the number of categories in the repository.
 	 * @return Number of categories.
@@ -134,10 +246,22 @@ public:
 	{
 		return ((nStored_ > 0) && (i < N_) && (nums_[i] < nStored_));
 	}
+	/**
+	 * Largest ID of an item in the repository, or 0 if it is empty.
+	 *
+	 * The smallest and largest IDs are kept up to date by the modifying
+	 * operations, so that reading them takes constant time. Erasing the item
+	 * with the smallest or largest ID looks up the new one, which takes time
+	 * linear in the number of unused IDs skipped (@see erase()).
+	 */
 	id_t maxID() const
 	{
 		return maxID_;
 	}
+	/**
+	 * Smallest ID of an item in the repository, or 0 if it is empty.
+	 * @see maxID()
+	 */
 	id_t minID() const
 	{
 		return minID_;
@@ -156,7 +280,7 @@ public:
 	 * @param n Number of item.
 	 * @return	Category ID of item.
 	 */
-	category_t category(address_t n) const;
+	category_t categoryAt(address_t n) const;
 	/**
 	 * Return category of item with unique ID @p id.
 	 * @param id Unique ID of item.
@@ -257,6 +381,10 @@ public:
 
 	/**
 	 * Erase item from repository. The item's destructor is called.
+	 *
+	 * This takes constant time, except if the item has the smallest or
+	 * largest ID: then the IDs up to the next item are scanned, which takes
+	 * time linear in the number of unused IDs between them.
 	 * @param id Unique ID of item to erase
 	 */
 	void erase(id_t id);
@@ -321,6 +449,45 @@ public:
 	CategoryIterator end(category_t cat);
 	ConstCategoryIterator end(category_t cat) const;
 
+	/**
+	 * Return iterator range of all items stored in the repository, in the
+	 * order of their addresses (@see iterators::DenseIterator).
+	 *
+	 * Traversing this range takes time proportional to the number of items,
+	 * independent of gaps in the item IDs.
+	 */
+	DenseIteratorRange denseItems();
+	ConstDenseIteratorRange denseItems() const;
+
+	/**
+	 * Renumber the items such that their IDs are 0, ..., size() - 1.
+	 *
+	 * The relative order of IDs and the categories of all items are
+	 * preserved. Afterwards, traversal by ID does not need to skip unused IDs.
+	 * @param newIds receives the new ID of each item, indexed by its old ID;
+	 * entries for old IDs not in use are set to the largest value of id_t
+	 */
+	void compact(std::vector<id_t>& newIds);
+
+	/**
+	 * Replace the contents by copies of the items in @p r, with the same
+	 * IDs, categories, and storage order.
+	 *
+	 * The bookkeeping arrays are copied in bulk. The storage mode
+	 * (@see setSegmentBits(), setIndexedCategories()) is taken over from
+	 * @p r, the clone allocator is kept.
+	 * @param r repository to copy
+	 * @param clone function object returning a pointer to a new copy of
+	 * the item passed to it, which must be disposable by the clone allocator
+	 */
+	template<class Cloner>
+	void assign(const CPtrRepository& r, Cloner clone);
+	/**
+	 * Exchange the contents, including the clone allocators, with @p r
+	 * in constant time.
+	 */
+	void swap(CPtrRepository& r);
+
 	void clear(); ///< clear repository
 
 private:
@@ -331,7 +498,7 @@ private:
 	 * @param n Number of item.
 	 * @param cat Category to put item into.
 	 */
-	void setCategory(address_t n, category_t cat);
+	void setCategoryAt(address_t n, category_t cat);
 	/**
 	 * Set category of @p n 'th item in category @p oldCat to @p newCat
 	 * @param oldCat Category the item is in.
@@ -345,30 +512,44 @@ private:
 	 * @param n Number of item
 	 * @return Reference to item
 	 */
-	reference item(address_t n);
-	const_reference item(address_t n) const;
+	reference itemAt(address_t n);
+	const_reference itemAt(address_t n) const;
 
 	/**
 	 * Remove @p n 'th item from repository.
 	 * The item's destructor is called.
 	 * @param n Number of item to remove
+	 * @see erase(id_t) for the time taken
 	 */
-	void erase(address_t n);
+	void eraseAt(address_t n);
 
 	void enlarge(); ///< enlarge the storage space
+	void destroyItems(); ///< dispose of all stored items
+	void grow(id_size_t new_size); ///< enlarge the storage space to exactly @p new_size items
 	void increaseCat(address_t n, category_t cat); ///< increase category of entry
 	void decreaseCat(address_t n, category_t cat); ///< decrease category of entry
 
 	void reorderToMaxCategory(const category_t n);
 
+	/// @name Indexed categories
+	///@{
+	void addToCategory(id_t id, category_t cat); ///< append item to the list of category @p cat
+	void removeFromCategory(id_t id); ///< remove item from the list of its category
+	void eraseIndexed(address_t n); ///< remove @p n 'th item from the list of stored items
+	///@}
+
+	/**
+	 * Look up the minimum valid ID after erasing the item with the minimum
+	 * ID, starting from the previous one, which is a lower bound
+	 */
 	void updateMinID();
-	void updateMaxID();
 	/**
-	 * Recalculate the minimum and maximum valid ID
+	 * Look up the maximum valid ID after erasing the item with the maximum
+	 * ID, starting from the previous one, which is an upper bound
 	 */
-	void updateMinMaxID();
+	void updateMaxID();
 	/**
-	 * Recalculate the minimum and maximum valid ID, where @p id is guaranteed to be valid
+	 * Update the minimum and maximum valid ID, where @p id is guaranteed to be valid
 	 * (e. g. after insertion).
 	 * @param id Valid ID
 	 */
@@ -379,12 +560,17 @@ private:
 	address_t nStored_; ///< total number of items stored
 	std::vector<address_t> count_; ///< number of items per category;
 	std::vector<address_t> offset_; ///< start index of a class
-	std::vector<address_t> nums_; ///< number of an item according to id
-	std::vector<id_t> ids_; ///< id of an item according to number
-	boost::ptr_vector<boost::nullable<T>, CloneAllocator, Allocator> items_; ///< array of items
+	SegmentedArray<address_t> nums_; ///< number of an item according to id
+	SegmentedArray<id_t> ids_; ///< id of an item according to number
+	SegmentedArray<T*> items_; ///< array of items, null if unused
+	CloneAllocator alloc_; ///< disposes of items
 	id_t minID_; ///< smallest valid ID
 	id_t maxID_; ///< largest valid ID
 	unsigned int enlargeFactor_;
+	bool indexed_; ///< categories are indexed
+	std::vector<std::vector<id_t> > members_; ///< IDs of items per category, if indexed
+	SegmentedArray<category_t> cats_; ///< category of an item according to id, if indexed
+	SegmentedArray<address_t> pos_; ///< position of an item in members_ according to id, if indexed
 };
 
 template<class T, class CloneAllocator, class Allocator>
@@ -392,8 +578,7 @@ inline void CPtrRepository<T, CloneAllocator, Allocator>::updateMinID()
 {
 	if (nStored_ > 0)
 	{
-		minID_ = 0;
-		while (!valid(minID_) && (minID_ < N_))
+		while (!valid(minID_))
 			++minID_;
 	}
 	else
@@ -405,43 +590,34 @@ inline void CPtrRepository<T, CloneAllocator, Allocator>::updateMaxID()
 {
 	if (nStored_ > 0)
 	{
-		maxID_ = N_ - 1;
-		while (!valid(maxID_) && (maxID_ > 0))
+		while (!valid(maxID_))
 			--maxID_;
 	}
 	else
 		maxID_ = 0;
 }
 
-template<class T, class CloneAllocator, class Allocator>
-inline void CPtrRepository<T, CloneAllocator, Allocator>::updateMinMaxID()
-{
-	updateMinID();
-	updateMaxID();
-}
-
 template<class T, class CloneAllocator, class Allocator>
 inline void CPtrRepository<T, CloneAllocator, Allocator>::updateMinMaxID(
 		const id_t id)
 {
-	if (nStored_ > 0)
-	{
-		assert(id < N_);
-		if (id < minID_)
-			minID_ = id;
-		if (id > maxID_)
-			maxID_ = id;
-	}
-	else
+	assert(valid(id));
+	if (nStored_ == 1)
 	{
-		minID_ = 0;
-		maxID_ = 0;
+		minID_ = id;
+		maxID_ = id;
+		return;
 	}
+	if (id < minID_)
+		minID_ = id;
+	if (id > maxID_)
+		maxID_ = id;
 }
 
 template<class T, class CloneAllocator, class Allocator>
 CPtrRepository<T, CloneAllocator, Allocator>::CPtrRepository() :
-		C_(1), N_(0), nStored_(0), minID_(0), maxID_(0), enlargeFactor_(2)
+		C_(1), N_(0), nStored_(0), minID_(0), maxID_(0), enlargeFactor_(2),
+				indexed_(false)
 {
 	init();
 }
@@ -449,9 +625,8 @@ CPtrRepository<T, CloneAllocator, Allocator>::CPtrRepository() :
 template<class T, class CloneAllocator, class Allocator>
 CPtrRepository<T, CloneAllocator, Allocator>::CPtrRepository(
 		const category_t cat) :
-		C_(cat), N_(100), nStored_(0), count_(cat + 1, 0), offset_(cat + 1, 0), nums_(
-				N_, 0), ids_(N_, 0), items_(N_), minID_(0), maxID_(0), enlargeFactor_(
-				2)
+		C_(cat), N_(100), nStored_(0), count_(cat + 1, 0), offset_(cat + 1, 0),
+				minID_(0), maxID_(0), enlargeFactor_(2), indexed_(false)
 {
 	assert(C_ > 0);
 	init();
@@ -460,9 +635,8 @@ CPtrRepository<T, CloneAllocator, Allocator>::CPtrRepository(
 template<class T, class CloneAllocator, class Allocator>
 CPtrRepository<T, CloneAllocator, Allocator>::CPtrRepository(
 		const category_t cat, const id_size_t n) :
-		C_(cat), N_(n), nStored_(0), count_(cat + 1, 0), offset_(cat + 1, 0), nums_(
-				N_, 0), ids_(N_, 0), items_(N_), minID_(0), maxID_(0), enlargeFactor_(
-				2)
+		C_(cat), N_(n), nStored_(0), count_(cat + 1, 0), offset_(cat + 1, 0),
+				minID_(0), maxID_(0), enlargeFactor_(2), indexed_(false)
 {
 	init();
 }
@@ -482,15 +656,82 @@ CPtrRepository<T, CloneAllocator, Allocator>::CPtrRepository(
 template<class T, class CloneAllocator, class Allocator>
 CPtrRepository<T, CloneAllocator, Allocator>::~CPtrRepository()
 {
+	destroyItems();
+}
+
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::destroyItems()
+{
+	for (address_t n = 0; n < nStored_; ++n)
+	{
+		T* itm = items_[ids_[n]];
+		items_[ids_[n]] = 0;
+		alloc_.deallocate_clone(itm);
+	}
+	nStored_ = 0;
+}
+
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::setSegmentBits(
+		const unsigned int bits)
+{
+	nums_.setSegmentBits(bits);
+	ids_.setSegmentBits(bits);
+	items_.setSegmentBits(bits);
+	cats_.setSegmentBits(bits);
+	pos_.setSegmentBits(bits);
+}
+
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::setIndexedCategories(
+		const bool on)
+{
+	if (on == indexed_)
+		return;
+	if (on)
+	{
+		cats_.resize(N_, C_);
+		pos_.resize(N_, 0);
+		members_.assign(C_, std::vector<id_t>());
+		for (category_t c = 0; c < C_; ++c)
+		{
+			members_[c].reserve(count_[c]);
+			for (address_t n = offset_[c]; n < offset_[c] + count_[c]; ++n)
+			{
+				const id_t id = ids_[n];
+				cats_[id] = c;
+				pos_[id] = members_[c].size();
+				members_[c].push_back(id);
+			}
+		}
+	}
+	else
+	{
+		// order the stored items by category again
+		address_t n = 0;
+		for (category_t c = 0; c < C_; ++c)
+		{
+			offset_[c] = n;
+			for (typename std::vector<id_t>::const_iterator it =
+					members_[c].begin(); it != members_[c].end(); ++it, ++n)
+			{
+				ids_[n] = *it;
+				nums_[*it] = n;
+			}
+		}
+		assert(n == nStored_);
+		std::vector<std::vector<id_t> >().swap(members_);
+		cats_.resize(0);
+		pos_.resize(0);
+	}
+	indexed_ = on;
 }
 
 template<class T, class CloneAllocator, class Allocator>
 void CPtrRepository<T, CloneAllocator, Allocator>::init()
 {
 	nStored_ = 0;
-	nums_.reserve(N_);
 	nums_.resize(N_, 0);
-	ids_.reserve(N_);
 	ids_.resize(N_, 0);
 	count_.reserve(C_ + 1);
 	count_.resize(C_ + 1, 0);
@@ -510,9 +751,16 @@ void CPtrRepository<T, CloneAllocator, Allocator>::init()
 	count_[C_] = N_;
 	minID_ = 0;
 	maxID_ = 0;
-	items_.reserve(N_);
-	for (address_t i = 0; i < N_; ++i)
-		items_.push_back(0);
+	items_.resize(0);
+	items_.resize(N_, 0);
+	if (indexed_)
+	{
+		cats_.resize(0);
+		cats_.resize(N_, C_);
+		pos_.resize(0);
+		pos_.resize(N_, 0);
+		members_.assign(C_, std::vector<id_t>());
+	}
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -529,9 +777,12 @@ void CPtrRepository<T, CloneAllocator, Allocator>::setNumberOfCategories(
 	C_ = n;
 	count_.resize(C_ + 1, 0);
 	offset_.resize(C_ + 1, oldCOffset);
-	count_[oldC] = 0;
+	if (oldC < C_)
+		count_[oldC] = 0;
 	count_[C_] = oldCCount;
 	offset_[C_] = oldCOffset;
+	if (indexed_)
+		members_.resize(C_);
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -541,13 +792,28 @@ void CPtrRepository<T, CloneAllocator, Allocator>::reorderToMaxCategory(
 	if (n >= C_ - 1)
 		return;
 
+	if (indexed_)
+	{
+		for (category_t c = n + 1; c < C_; ++c)
+		{
+			const std::vector<id_t> ids(members_[c]);
+			for (typename std::vector<id_t>::const_iterator it = ids.begin(); it
+					!= ids.end(); ++it)
+			{
+				removeFromCategory(*it);
+				addToCategory(*it, n);
+			}
+		}
+		return;
+	}
+
 	// first id to move should be ids_[offset_[n+1]], last ids_[offset_[C_]-1]
 	// number of ids to move should be offset_[C_] - offset_[n+1]
 
 	id_size_t num = offset_[C_] - offset_[n + 1];
 	std::vector<id_t> temp(num, 0);
-	std::copy(ids_.begin() + offset_[n + 1], ids_.begin() + offset_[C_],
-			temp.begin());
+	for (id_size_t i = 0; i < num; ++i)
+		temp[i] = ids_[offset_[n + 1] + i];
 
 	for (std::vector<id_t>::const_iterator it = temp.begin(); it != temp.end();
 			++it)
@@ -556,39 +822,194 @@ void CPtrRepository<T, CloneAllocator, Allocator>::reorderToMaxCategory(
 	}
 }
 
+template<class T, class CloneAllocator, class Allocator>
+typename CPtrRepository<T, CloneAllocator, Allocator>::DenseIteratorRange CPtrRepository<
+		T, CloneAllocator, Allocator>::denseItems()
+{
+	return std::make_pair(DenseIterator(*this, 0), DenseIterator(*this,
+			nStored_));
+}
+
+template<class T, class CloneAllocator, class Allocator>
+typename CPtrRepository<T, CloneAllocator, Allocator>::ConstDenseIteratorRange CPtrRepository<
+		T, CloneAllocator, Allocator>::denseItems() const
+{
+	return std::make_pair(ConstDenseIterator(*this, 0), ConstDenseIterator(
+			*this, nStored_));
+}
+
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::compact(
+		std::vector<id_t>& newIds)
+{
+	newIds.assign(nStored_ > 0 ? maxID() + 1 : 0,
+			std::numeric_limits<id_t>::max());
+	// move items down to their new IDs in ascending order, such that no
+	// item is overwritten before it has been moved
+	id_t next = 0;
+	for (id_t i = minID(); next < nStored_; ++i)
+	{
+		if (!valid(i))
+			continue;
+		newIds[i] = next;
+		T* itm = items_[i];
+		items_[i] = 0;
+		items_[next] = itm;
+		if (indexed_)
+		{
+			cats_[next] = cats_[i];
+			pos_[next] = pos_[i];
+		}
+		++next;
+	}
+	if (indexed_)
+	{
+		for (category_t c = 0; c < C_; ++c)
+			for (typename std::vector<id_t>::iterator it = members_[c].begin(); it
+					!= members_[c].end(); ++it)
+				*it = newIds[*it];
+	}
+	// addresses, and thus categories, stay the same
+	for (address_t n = 0; n < nStored_; ++n)
+	{
+		const id_t id = newIds[ids_[n]];
+		ids_[n] = id;
+		nums_[id] = n;
+	}
+	for (address_t n = nStored_; n < N_; ++n)
+	{
+		ids_[n] = n;
+		nums_[n] = n;
+	}
+	minID_ = 0;
+	maxID_ = (nStored_ > 0) ? nStored_ - 1 : 0;
+}
+
+template<class T, class CloneAllocator, class Allocator>
+template<class Cloner>
+void CPtrRepository<T, CloneAllocator, Allocator>::assign(
+		const CPtrRepository& r, Cloner clone)
+{
+	if (&r == this)
+		return;
+	destroyItems();
+	C_ = r.C_;
+	N_ = r.N_;
+	count_ = r.count_;
+	offset_ = r.offset_;
+	nums_.assign(r.nums_);
+	ids_.assign(r.ids_);
+	items_.setSegmentBits(r.segmentBits());
+	items_.resize(0);
+	items_.resize(N_, 0);
+	minID_ = r.minID_;
+	maxID_ = r.maxID_;
+	enlargeFactor_ = r.enlargeFactor_;
+	indexed_ = r.indexed_;
+	members_ = r.members_;
+	cats_.assign(r.cats_);
+	pos_.assign(r.pos_);
+	// count the copies as they are made, such that they are disposed of
+	// if cloning fails
+	for (address_t n = 0; n < r.nStored_; ++n)
+	{
+		const id_t id = ids_[n];
+		items_[id] = clone(*r.items_[id]);
+		++nStored_;
+	}
+}
+
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::swap(CPtrRepository& r)
+{
+	std::swap(C_, r.C_);
+	std::swap(N_, r.N_);
+	std::swap(nStored_, r.nStored_);
+	count_.swap(r.count_);
+	offset_.swap(r.offset_);
+	nums_.swap(r.nums_);
+	ids_.swap(r.ids_);
+	items_.swap(r.items_);
+	std::swap(alloc_, r.alloc_);
+	std::swap(minID_, r.minID_);
+	std::swap(maxID_, r.maxID_);
+	std::swap(enlargeFactor_, r.enlargeFactor_);
+	std::swap(indexed_, r.indexed_);
+	members_.swap(r.members_);
+	cats_.swap(r.cats_);
+	pos_.swap(r.pos_);
+}
+
 template<class T, class CloneAllocator, class Allocator>
 void CPtrRepository<T, CloneAllocator, Allocator>::clear()
 {
 	assert(C_ > 0);
-	items_.clear(); // ensure that items' destructors are called
+	destroyItems(); // ensure that items' destructors are called
 	init();
 }
 
 template<class T, class CloneAllocator, class Allocator>
 void CPtrRepository<T, CloneAllocator, Allocator>::enlarge()
 {
-	id_size_t new_size = (N_ > 0) ? N_ * enlargeFactor_ : enlargeFactor_;
-	id_size_t max_size = maxSize();
+	const id_size_t max_size = maxSize();
+	id_size_t new_size = enlargeFactor_;
+	if (segmentBits() > 0)
+	{
+		// add one segment, such that no entries need to be copied
+		const id_size_t segment = static_cast<id_size_t> (1) << segmentBits();
+		new_size = (N_ > max_size - segment) ? max_size : N_ + segment;
+	}
+	else if (N_ > 0)
+	{
+		// avoid overflow of the new size
+		new_size = (N_ > max_size / enlargeFactor_) ? max_size
+				: static_cast<id_size_t> (N_) * enlargeFactor_;
+	}
 	if (new_size > max_size)
 		new_size = max_size;
 	if (new_size <= N_)
 		throw AllocException();
-	else
-	{
-		items_.reserve(new_size);
-		for (address_t i = N_; i < new_size; ++i)
-			items_.push_back(0);
-		ids_.reserve(new_size);
-		for (address_t i = N_; i < new_size; ++i)
-			ids_.push_back(i);
+	grow(new_size);
+}
 
-		nums_.reserve(new_size);
-		for (id_t i = N_; i < new_size; ++i)
-			nums_.push_back(i);
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::reserve(const id_size_t n)
+{
+	if (n <= N_)
+		return;
+	const id_size_t max_size = maxSize();
+	if (n > max_size)
+		throw AllocException();
+	id_size_t new_size = n;
+	if (segmentBits() > 0)
+	{
+		// use up the last segment
+		const id_size_t mask = (static_cast<id_size_t> (1) << segmentBits()) - 1;
+		new_size = (n > max_size - mask) ? max_size : ((n + mask) & ~mask);
+	}
+	grow(new_size);
+}
 
-		count_[C_] += new_size - N_;
-		N_ = new_size;
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::grow(const id_size_t new_size)
+{
+	assert(new_size > N_);
+	items_.resize(new_size, 0);
+	ids_.resize(new_size);
+	nums_.resize(new_size);
+	if (indexed_)
+	{
+		cats_.resize(new_size, C_);
+		pos_.resize(new_size, 0);
+	}
+	for (address_t i = N_; i < new_size; ++i)
+	{
+		ids_[i] = i;
+		nums_[i] = i;
 	}
+
+	count_[C_] += new_size - N_;
+	N_ = new_size;
 }
 
 /// we cannot copy objects, must rely on cloneability @see boost::ptr_container
@@ -610,7 +1031,7 @@ void CPtrRepository<T, CloneAllocator, Allocator>::increaseCat(
 {
 	assert(n < N_);
 	assert(cat <= C_);
-	category_t cls = category(n);
+	category_t cls = categoryAt(n);
 	address_t mynum = n;
 	id_t myid = ids_[mynum];
 	assert(cls <= cat);
@@ -640,7 +1061,7 @@ void CPtrRepository<T, CloneAllocator, Allocator>::decreaseCat(
 {
 	assert(n < N_);
 	assert(cat <= C_);
-	category_t cls = category(n);
+	category_t cls = categoryAt(n);
 	address_t mynum = n;
 	id_t myid = ids_[mynum];
 	assert(cls >= cat);
@@ -669,14 +1090,16 @@ inline category_t CPtrRepository<T, CloneAllocator, Allocator>::category(
 		const id_t id) const
 {
 	assert(valid(id));
-	return category(nums_[id]);
+	return categoryAt(nums_[id]);
 }
 
 template<class T, class CloneAllocator, class Allocator>
-inline category_t CPtrRepository<T, CloneAllocator, Allocator>::category(
+inline category_t CPtrRepository<T, CloneAllocator, Allocator>::categoryAt(
 		const address_t n) const
 {
 	assert(n < N_);
+	if (indexed_)
+		return (n < nStored_) ? cats_[ids_[n]] : C_;
 	address_t na = n;
 	category_t c = 0;
 	while (na >= count_[c])
@@ -692,16 +1115,26 @@ inline void CPtrRepository<T, CloneAllocator, Allocator>::setCategory(
 		const id_t id, const category_t cat)
 {
 	assert(valid(id));
-	setCategory(nums_[id], cat);
+	setCategoryAt(nums_[id], cat);
 }
 
 template<class T, class CloneAllocator, class Allocator>
-inline void CPtrRepository<T, CloneAllocator, Allocator>::setCategory(
+inline void CPtrRepository<T, CloneAllocator, Allocator>::setCategoryAt(
 		const address_t n, const category_t cat)
 {
 	assert(cat < C_);
 	assert(n <= nStored_);
-	category_t cls = category(n);
+	if (indexed_)
+	{
+		const id_t id = ids_[n];
+		if (cats_[id] != cat)
+		{
+			removeFromCategory(id);
+			addToCategory(id, cat);
+		}
+		return;
+	}
+	category_t cls = categoryAt(n);
 	if (cls < cat)
 		increaseCat(n, cat);
 	else
@@ -715,8 +1148,7 @@ inline void CPtrRepository<T, CloneAllocator, Allocator>::setCategory(
 	assert(oldCat < C_);
 	assert(n < count_[oldCat]);
 	assert(newCat < C_);
-	address_t num = offset_[oldCat] + n;
-	setCategory(num, newCat);
+	setCategoryAt(nums_[id(oldCat, n)], newCat);
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -724,7 +1156,7 @@ inline typename CPtrRepository<T, CloneAllocator, Allocator>::reference CPtrRepo
 		T, CloneAllocator, Allocator>::item(const id_t id)
 {
 	assert(valid(id));
-	return items_[id];
+	return *items_[id];
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -739,7 +1171,7 @@ inline typename CPtrRepository<T, CloneAllocator, Allocator>::const_reference CP
 		T, CloneAllocator, Allocator>::item(const id_t id) const
 {
 	assert(valid(id));
-	return items_[id];
+	return *items_[id];
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -751,20 +1183,20 @@ inline typename CPtrRepository<T, CloneAllocator, Allocator>::const_reference CP
 
 template<class T, class CloneAllocator, class Allocator>
 inline typename CPtrRepository<T, CloneAllocator, Allocator>::reference CPtrRepository<
-		T, CloneAllocator, Allocator>::item(const address_t n)
+		T, CloneAllocator, Allocator>::itemAt(const address_t n)
 {
 	assert(n < N_);
 	assert(valid(ids_[n]));
-	return items_[ids_[n]];
+	return *items_[ids_[n]];
 }
 
 template<class T, class CloneAllocator, class Allocator>
 inline typename CPtrRepository<T, CloneAllocator, Allocator>::const_reference CPtrRepository<
-		T, CloneAllocator, Allocator>::item(const address_t n) const
+		T, CloneAllocator, Allocator>::itemAt(const address_t n) const
 {
 	assert(n < N_);
 	assert(valid(ids_[n]));
-	return items_[ids_[n]];
+	return *items_[ids_[n]];
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -774,8 +1206,7 @@ inline typename CPtrRepository<T, CloneAllocator, Allocator>::reference CPtrRepo
 {
 	assert(cat < C_);
 	assert(n < count_[cat]);
-	assert(valid(ids_[offset_[cat] + n]));
-	return items_[ids_[offset_[cat] + n]];
+	return *items_[id(cat, n)];
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -785,8 +1216,7 @@ inline typename CPtrRepository<T, CloneAllocator, Allocator>::const_reference CP
 {
 	assert(cat < C_);
 	assert(n < count_[cat]);
-	assert(valid(ids_[offset_[cat] + n]));
-	return items_[ids_[offset_[cat] + n]];
+	return *items_[id(cat, n)];
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -802,8 +1232,10 @@ inline id_t CPtrRepository<T, CloneAllocator, Allocator>::id(
 		const category_t cat, const address_t n) const
 {
 	assert(cat < C_);
-	assert(offset_[cat] + n < N_);
 	assert(n < count_[cat]);
+	if (indexed_)
+		return members_[cat][n];
+	assert(offset_[cat] + n < N_);
 	return ids_[offset_[cat] + n];
 }
 
@@ -828,8 +1260,17 @@ id_t CPtrRepository<T, CloneAllocator, Allocator>::insert(T* itm,
 	//	if (curnum >= N_)
 	//		enlarge();
 	//	id_t uid = ids_[curnum];
-	items_.replace(uid, itm); // this returns auto_type pointer to the old item, released and destroyed when out of scope
-	decreaseCat(curnum, cat); // Move into right class
+	assert(items_[uid] == 0);
+	items_[uid] = itm;
+	if (indexed_)
+	{
+		// take the first free address
+		--count_[C_];
+		++offset_[C_];
+		addToCategory(uid, cat);
+	}
+	else
+		decreaseCat(curnum, cat); // Move into right class
 	++nStored_;
 	updateMinMaxID(uid);
 	return uid;
@@ -877,7 +1318,9 @@ template<class T, class CloneAllocator, class Allocator>
 void CPtrRepository<T, CloneAllocator, Allocator>::replace(id_t id, T* itm)
 {
 	assert(valid(id));
-	items_.replace(id, itm);
+	T* old = items_[id];
+	items_[id] = itm;
+	alloc_.deallocate_clone(old);
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -885,18 +1328,22 @@ template<class U>
 void CPtrRepository<T, CloneAllocator, Allocator>::replace(id_t id,
 		std::auto_ptr<U> itm)
 {
-	assert(valid(id));
-	items_.replace(id, itm.release());
+	replace(id, itm.release());
 }
 
 template<class T, class CloneAllocator, class Allocator>
-void CPtrRepository<T, CloneAllocator, Allocator>::erase(const address_t n)
+void CPtrRepository<T, CloneAllocator, Allocator>::eraseAt(const address_t n)
 {
 	assert(n < N_);
 	assert(n < nStored_);
 	id_t uid = ids_[n];
-	items_.replace(uid, 0); // replace by null pointer, returns released auto_ptr, destroyed and freed when out of scope
-	increaseCat(n, C_); // move to hidden category
+	T* itm = items_[uid];
+	items_[uid] = 0;
+	alloc_.deallocate_clone(itm);
+	if (indexed_)
+		eraseIndexed(n);
+	else
+		increaseCat(n, C_); // move to hidden category
 	--nStored_;
 	if (uid == minID_)
 		updateMinID();
@@ -904,25 +1351,70 @@ void CPtrRepository<T, CloneAllocator, Allocator>::erase(const address_t n)
 		updateMaxID();
 }
 
+template<class T, class CloneAllocator, class Allocator>
+inline void CPtrRepository<T, CloneAllocator, Allocator>::addToCategory(
+		const id_t id, const category_t cat)
+{
+	assert(indexed_);
+	assert(cat < C_);
+	cats_[id] = cat;
+	pos_[id] = members_[cat].size();
+	members_[cat].push_back(id);
+	++count_[cat];
+}
+
+template<class T, class CloneAllocator, class Allocator>
+inline void CPtrRepository<T, CloneAllocator, Allocator>::removeFromCategory(
+		const id_t id)
+{
+	assert(indexed_);
+	const category_t cat = cats_[id];
+	assert(cat < C_);
+	std::vector<id_t>& m = members_[cat];
+	// fill the gap with the last item of the category
+	const id_t last = m.back();
+	m[pos_[id]] = last;
+	pos_[last] = pos_[id];
+	m.pop_back();
+	--count_[cat];
+}
+
+template<class T, class CloneAllocator, class Allocator>
+void CPtrRepository<T, CloneAllocator, Allocator>::eraseIndexed(
+		const address_t n)
+{
+	const id_t uid = ids_[n];
+	removeFromCategory(uid);
+	// fill the gap with the last stored item
+	const address_t last = nStored_ - 1;
+	const id_t lastId = ids_[last];
+	ids_[n] = lastId;
+	nums_[lastId] = n;
+	ids_[last] = uid;
+	nums_[uid] = last;
+	++count_[C_];
+	--offset_[C_];
+}
+
 template<class T, class CloneAllocator, class Allocator>
 void CPtrRepository<T, CloneAllocator, Allocator>::erase(const id_t id)
 {
 	assert(valid(id));
-	erase(nums_[id]);
+	eraseAt(nums_[id]);
 }
 
 template<class T, class CloneAllocator, class Allocator>
 typename CPtrRepository<T, CloneAllocator, Allocator>::iterator CPtrRepository<
 		T, CloneAllocator, Allocator>::begin()
 {
-	return iterator(*this, minID_);
+	return iterator(*this, minID());
 }
 
 template<class T, class CloneAllocator, class Allocator>
 typename CPtrRepository<T, CloneAllocator, Allocator>::const_iterator CPtrRepository<
 		T, CloneAllocator, Allocator>::begin() const
 {
-	return const_iterator(*this, minID_);
+	return const_iterator(*this, minID());
 }
 
 template<class T, class CloneAllocator, class Allocator>
@@ -930,9 +1422,9 @@ typename CPtrRepository<T, CloneAllocator, Allocator>::iterator CPtrRepository<
 		T, CloneAllocator, Allocator>::end()
 {
 	if (nStored_ > 0)
-		return iterator(*this, maxID_ + 1);
+		return iterator(*this, maxID() + 1);
 	else
-		return iterator(*this, maxID_);
+		return iterator(*this, maxID());
 
 }
 
@@ -941,9 +1433,9 @@ typename CPtrRepository<T, CloneAllocator, Allocator>::const_iterator CPtrReposi
 		T, CloneAllocator, Allocator>::end() const
 {
 	if (nStored_ > 0)
-		return const_iterator(*this, maxID_ + 1);
+		return const_iterator(*this, maxID() + 1);
 	else
-		return const_iterator(*this, maxID_);
+		return const_iterator(*this, maxID());
 
 }
 
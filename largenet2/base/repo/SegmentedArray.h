@@ -0,0 +1,210 @@
+/**
+ * @file SegmentedArray.h
+ * @date 18.10.2026
+ */
+
+#ifndef SEGMENTEDARRAY_H_
+#define SEGMENTEDARRAY_H_
+
+#include "repo_types.h"
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+
+namespace repo
+{
+
+/**
+ * Array used for the per-item bookkeeping of CPtrRepository.
+ *
+ * By default, entries are stored contiguously, and growing the array
+ * reallocates and copies them, like a std::vector. In segmented mode, entries
+ * are stored in segments of 2^bits entries, entry @c i being element
+ * <tt>i & (2^bits - 1)</tt> of segment <tt>i >> bits</tt>. Growing the array
+ * then only allocates new segments, such that existing entries are never
+ * copied and their addresses stay valid.
+ *
+ * Contiguous storage is a single plain array, which is accessed directly
+ * rather than through the segment table.
+ *
+ * @tparam V entry type
+ */
+template<class V>
+class SegmentedArray: boost::noncopyable
+{
+public:
+	/// Largest supported number of bits per segment
+	static const unsigned int max_segment_bits = 30;
+
+	SegmentedArray() :
+		data_(0), size_(0), capacity_(0), bits_(0), mask_(0)
+	{
+	}
+	~SegmentedArray()
+	{
+		deallocate();
+	}
+	/**
+	 * Number of entries
+	 */
+	address_t size() const
+	{
+		return size_;
+	}
+	/**
+	 * Number of entries that can be stored without allocating memory
+	 */
+	boost::uint64_t capacity() const
+	{
+		return capacity_;
+	}
+	/**
+	 * Memory held by the entries and the segment table, in bytes
+	 */
+	boost::uint64_t memoryUsage() const
+	{
+		return capacity_ * sizeof(V) + segments_.capacity() * sizeof(V*);
+	}
+	/**
+	 * Number of bits per segment, or 0 for contiguous storage
+	 */
+	unsigned int segmentBits() const
+	{
+		return bits_;
+	}
+	V& operator[](const id_size_t i)
+	{
+		assert(i < size_);
+		return entry(i);
+	}
+	const V& operator[](const id_size_t i) const
+	{
+		assert(i < size_);
+		return entry(i);
+	}
+	/**
+	 * Reserve memory for @p n entries
+	 */
+	void reserve(const address_t n)
+	{
+		if (n <= capacity_)
+			return;
+		if (bits_ == 0)
+		{
+			V* data = new V[n];
+			std::copy(data_, data_ + size_, data);
+			delete[] data_;
+			data_ = data;
+			capacity_ = n;
+			return;
+		}
+		const boost::uint64_t segment_size = mask_ + static_cast<boost::uint64_t> (1);
+		segments_.reserve((n + segment_size - 1) >> bits_);
+		while (capacity_ < n)
+		{
+			segments_.push_back(new V[segment_size]);
+			capacity_ += segment_size;
+		}
+	}
+	/**
+	 * Change the number of entries to @p n, setting new entries to @p v.
+	 *
+	 * Shrinking the array keeps its memory.
+	 */
+	void resize(const address_t n, const V& v = V())
+	{
+		reserve(n);
+		for (address_t i = size_; i < n; ++i)
+			entry(i) = v;
+		size_ = n;
+	}
+	/**
+	 * Switch to segments of 2^@p bits entries, or to contiguous storage
+	 * if @p bits is 0. Existing entries are copied once.
+	 * @throw std::invalid_argument if @p bits exceeds max_segment_bits
+	 */
+	void setSegmentBits(const unsigned int bits)
+	{
+		if (bits > max_segment_bits)
+			throw(std::invalid_argument("Segment size too large."));
+		if (bits == bits_)
+			return;
+		SegmentedArray a;
+		a.bits_ = bits;
+		if (bits > 0)
+			a.mask_ = (static_cast<address_t> (1) << bits) - 1;
+		a.reserve(size_);
+		for (address_t i = 0; i < size_; ++i)
+			a.entry(i) = (*this)[i];
+		a.size_ = size_;
+		swap(a);
+	}
+	/**
+	 * Replace the entries by copies of those in @p a, taking over its
+	 * segment size. Existing memory is reused where possible.
+	 */
+	void assign(const SegmentedArray& a)
+	{
+		if (&a == this)
+			return;
+		size_ = 0;
+		setSegmentBits(a.bits_);
+		reserve(a.size_);
+		if (bits_ == 0)
+			std::copy(a.data_, a.data_ + a.size_, data_);
+		else
+		{
+			// copy whole segments
+			const boost::uint64_t segment_size = mask_
+					+ static_cast<boost::uint64_t> (1);
+			for (boost::uint64_t i = 0; i < a.size_; i += segment_size)
+			{
+				const V* first = a.segments_[i >> bits_];
+				std::copy(first, first + std::min<boost::uint64_t>(
+						segment_size, a.size_ - i), segments_[i >> bits_]);
+			}
+		}
+		size_ = a.size_;
+	}
+	void swap(SegmentedArray& a)
+	{
+		std::swap(data_, a.data_);
+		segments_.swap(a.segments_);
+		std::swap(size_, a.size_);
+		std::swap(capacity_, a.capacity_);
+		std::swap(bits_, a.bits_);
+		std::swap(mask_, a.mask_);
+	}
+
+private:
+	/// entry @p i, which need not be below size()
+	V& entry(const boost::uint64_t i) const
+	{
+		if (bits_ == 0)
+			return data_[i];
+		return segments_[i >> bits_][i & mask_];
+	}
+	void deallocate()
+	{
+		delete[] data_;
+		data_ = 0;
+		for (typename std::vector<V*>::iterator it = segments_.begin(); it
+				!= segments_.end(); ++it)
+			delete[] *it;
+		segments_.clear();
+	}
+
+	V* data_; ///< contiguous storage, unused in segmented mode
+	std::vector<V*> segments_; ///< segment table, empty in contiguous mode
+	address_t size_;
+	boost::uint64_t capacity_;
+	unsigned int bits_;
+	address_t mask_;
+};
+
+}
+
+#endif /* SEGMENTEDARRAY_H_ */
@@ -18,10 +18,13 @@ namespace iterators
  * This should be used for the traversal of the repository. If valid, it will
  * always dereference to an item actually stored in the repository.
  * Note that inserting into the repository invalidates all iterators.
+ *
+ * It is a bidirectional iterator, as unused IDs have to be skipped one by
+ * one. For constant time positional access, use DenseIterator.
  */
 template<class T, class Repo>
 class IndexIterator: public boost::iterator_facade<IndexIterator<T, Repo> , T,
-boost::forward_traversal_tag>
+boost::bidirectional_traversal_tag>
 {
 public:
 	typedef Repo* repo_ptr;
@@ -105,6 +108,15 @@ private:
 				break;
 		}
 	}
+	void decrement()
+	{
+		assert(rep_ != 0);
+		do
+		{
+			assert(cur_ > rep_->minID());
+			--cur_;
+		} while (!rep_->valid(cur_));
+	}
 
 	T& dereference() const
 	{
@@ -127,16 +139,20 @@ private:
 /**
  * Category iterator.
  *
- * Iterates over all items in a given category.
+ * Iterates over all items in a given category. It is a random access
+ * iterator, such that the items of a category can be split into parts,
+ * e.g. for processing them in parallel.
  */
 template<class T, class Repo>
 class CategoryIterator: public boost::iterator_facade<CategoryIterator<T, Repo>
 		, T,
-		boost::forward_traversal_tag>
+		boost::random_access_traversal_tag>
 {
 public:
 	typedef Repo* repo_ptr;
 	typedef Repo& repo_ref;
+	typedef typename boost::iterator_facade<CategoryIterator<T, Repo>, T,
+			boost::random_access_traversal_tag>::difference_type difference_type;
 
 	/**
 	 * Default constructor needed for STL compliance. This creates a singular
@@ -209,6 +225,24 @@ private:
 			++cur_;
 		}
 	}
+	void decrement()
+	{
+		assert(rep_ != 0);
+		assert(cur_ > 0);
+		--cur_;
+	}
+	void advance(const difference_type n)
+	{
+		assert(rep_ != 0);
+		cur_ += n;
+	}
+	template<class U, class R>
+	difference_type distance_to(const CategoryIterator<U, R>& other) const
+	{
+		assert(other.category_ == category_);
+		return static_cast<difference_type> (other.cur_)
+				- static_cast<difference_type> (cur_);
+	}
 
 	T& dereference() const
 	{
@@ -230,6 +264,108 @@ private:
 	address_t cur_; ///< Current iterator position, relative to rep_->offset_[category_] (index in ids_ array).
 };
 
+/**
+ * Dense iterator.
+ *
+ * Iterates over all items in the order of their storage addresses, i.e.,
+ * grouped by category. Unlike IndexIterator, it never visits unused IDs, so a
+ * full traversal takes time proportional to the number of items, however
+ * fragmented the IDs are.
+ *
+ * Changing the category of an item moves it to another address, so
+ * besides insertion and removal, setCategory() invalidates all dense
+ * iterators, too.
+ */
+template<class T, class Repo>
+class DenseIterator: public boost::iterator_facade<DenseIterator<T, Repo>, T,
+		boost::random_access_traversal_tag>
+{
+public:
+	typedef Repo* repo_ptr;
+	typedef Repo& repo_ref;
+	typedef typename boost::iterator_facade<DenseIterator<T, Repo>, T,
+			boost::random_access_traversal_tag>::difference_type difference_type;
+
+	/**
+	 * Default constructor needed for STL compliance. This creates a singular
+	 * (invalid) iterator which does not belong to any repository.
+	 */
+	DenseIterator() :
+			rep_(0), cur_(0)
+	{
+	}
+	/**
+	 * Position constructor. This creates an iterator pointing to the item
+	 * stored at address @p n in the repository @p repo.
+	 * @param repo Repository the iterator belongs to.
+	 * @param n Address of item.
+	 */
+	DenseIterator(repo_ref rep, address_t n) :
+			rep_(&rep), cur_(n)
+	{
+		assert(cur_ <= rep_->size());
+	}
+	/**
+	 * Copy constructor.
+	 * @param it Iterator to copy from.
+	 */
+	template<class U, class R>
+	DenseIterator(const DenseIterator<U, R>& it,
+			typename boost::enable_if_convertible<U*, T*>::type* = 0) :
+			rep_(it.rep_), cur_(it.cur_)
+	{
+	}
+	id_t id() const
+	{
+		assert(rep_ != 0);
+		assert(cur_ < rep_->size());
+		return rep_->id(cur_);
+	}
+	category_t category() const
+	{
+		assert(rep_ != 0);
+		assert(cur_ < rep_->size());
+		return rep_->categoryAt(cur_);
+	}
+
+private:
+	friend class boost::iterator_core_access;
+	template<class, class > friend class DenseIterator;
+
+	void increment()
+	{
+		++cur_;
+	}
+	void decrement()
+	{
+		--cur_;
+	}
+	void advance(const difference_type n)
+	{
+		cur_ += n;
+	}
+	template<class U, class R>
+	difference_type distance_to(const DenseIterator<U, R>& other) const
+	{
+		return static_cast<difference_type> (other.cur_)
+				- static_cast<difference_type> (cur_);
+	}
+	T& dereference() const
+	{
+		assert(rep_ != 0);
+		assert(cur_ < rep_->size());
+		return rep_->item(rep_->id(cur_));
+	}
+	template<class U, class R>
+	bool equal(const DenseIterator<U, R>& other) const
+	{
+		return ((other.rep_ == rep_) && (other.cur_ == cur_));
+	}
+
+	repo_ptr rep_; ///< Repository the iterator belongs to.
+	address_t cur_; ///< Current iterator position (address in ids_ array).
+};
+
 }
 }
 #endif /* REPO_ITERATORS_H_ */
@@ -7,6 +7,8 @@
 #ifndef REPO_TYPES_H_
 #define REPO_TYPES_H_
 
+#include <largenet2/base/types.h>
+
 /**
  * @namespace repo
  * The %CategorizedRepository namespace.
@@ -18,7 +20,11 @@ namespace repo
 {
 typedef unsigned int category_t; ///< Category number type.
 typedef unsigned int address_t; ///< Item number (array index) type.
+#if LARGENET_ID_BITS == 32
+typedef boost::uint32_t id_t; ///< Item unique ID type.
+#else
 typedef unsigned long int id_t; ///< Item unique ID type.
+#endif
 typedef id_t id_size_t; ///< Item count type.
 }
 
@@ -7,23 +7,61 @@
 #ifndef LARGENET_TYPES_H_
 #define LARGENET_TYPES_H_
 
+/**
+ * @def LARGENET_ID_BITS
+ * Width of node and edge IDs, counts, and degrees in bits (32 or 64).
+ *
+ * Graphs with less than 2^32 nodes and edges can use 32-bit IDs to save
+ * memory. This must be set identically when building the library and
+ * the code using it, e.g. via configure --with-id-bits.
+ */
+#ifndef LARGENET_ID_BITS
+#define LARGENET_ID_BITS 64
+#endif
+
+/**
+ * @def LARGENET_STATE_BITS
+ * Width of node and edge states in bits (8, 16, or 32).
+ *
+ * This must be set identically when building the library and the code
+ * using it, e.g. via configure --with-state-bits.
+ */
+#ifndef LARGENET_STATE_BITS
+#define LARGENET_STATE_BITS 32
+#endif
+
+#if (LARGENET_ID_BITS != 32) && (LARGENET_ID_BITS != 64)
+#error "LARGENET_ID_BITS must be 32 or 64"
+#endif
+#if (LARGENET_STATE_BITS != 8) && (LARGENET_STATE_BITS != 16) && (LARGENET_STATE_BITS != 32)
+#error "LARGENET_STATE_BITS must be 8, 16, or 32"
+#endif
+
+#include <boost/cstdint.hpp>
+
 /**
  * The largenet namespace
  */
 namespace largenet {
 
+#if LARGENET_ID_BITS == 32
+/// Node ID type
+typedef boost::uint32_t node_id_t;
+#else
 /// Node ID type
 typedef unsigned long int node_id_t;
+#endif
 /// Node count type
 typedef node_id_t node_size_t;
 /// Edge id type
-typedef unsigned long int edge_id_t;
+typedef node_id_t edge_id_t;
 /// Edge count type
 typedef edge_id_t edge_size_t;
 /// Degree type (is a node count type)
-typedef unsigned long int degree_t;
+typedef node_id_t degree_t;
 /// Degree size type (is degree type)
 typedef degree_t degree_size_t;
+
 /**
  * Node state type
  *
@@ -32,9 +70,20 @@ typedef degree_t degree_size_t;
  * interface, one can efficiently traverse all nodes in a given
  * state, or randomly select a node in a given state, for instance.
  */
+#if LARGENET_STATE_BITS == 8
+typedef boost::uint8_t node_state_t;
+#elif LARGENET_STATE_BITS == 16
+typedef boost::uint16_t node_state_t;
+#else
 typedef unsigned int node_state_t;
-/// Node state count type
-typedef node_state_t node_state_size_t;
+#endif
+/**
+ * Node state count type
+ *
+ * This is an unsigned int regardless of LARGENET_STATE_BITS, such that
+ * all values of an 8- or 16-bit node_state_t can be used as states.
+ */
+typedef unsigned int node_state_size_t;
 /**
  * Edge state type
  *
@@ -43,9 +92,9 @@ typedef node_state_t node_state_size_t;
  * interface, one can efficiently traverse all edges in a given
  * state, or randomly select an edge in a given state, for instance.
  */
-typedef unsigned int edge_state_t;
-/// Edge state count type
-typedef edge_state_t edge_state_size_t;
+typedef node_state_t edge_state_t;
+/// Edge state count type (see node_state_size_t)
+typedef unsigned int edge_state_size_t;
 
 }
 
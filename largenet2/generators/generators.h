@@ -54,6 +54,11 @@ U& random_from(V& container, RandomGen& rnd)
  * @param end iterator pointing to (past the) end of range
  * @param rnd random number generator
  * @return random iterator within range or @p end if empty range
+ *
+ * This takes constant time for random access iterators, such as the
+ * per-state node and edge iterators of a Graph and those of its denseNodes()
+ * and denseEdges(). The iterators of nodes() and edges() are bidirectional,
+ * for which this takes time linear in the length of the range.
  */
 template<class _Iter, class RandomGen>
 _Iter random_from(_Iter begin, _Iter end, RandomGen& rnd)
@@ -89,8 +94,8 @@ _Iter random_from(std::pair<_Iter, _Iter> range, RandomGen& rnd)
  * @param rnd
  * @param directed
  */
-template<class RandomGen>
-void randomGnmSlow(Graph& g, node_size_t numNodes, edge_size_t numEdges,
+template<class GraphType, class RandomGen>
+void randomGnmSlow(GraphType& g, node_size_t numNodes, edge_size_t numEdges,
 		RandomGen& rnd, bool directed = false)
 {
 	node_size_t max_edges =
@@ -100,12 +105,11 @@ void randomGnmSlow(Graph& g, node_size_t numNodes, edge_size_t numEdges,
 		throw std::out_of_range(
 				"Cannot create graph with more than O(N^2) edges");
 	g.clear();
-	while (g.numberOfNodes() < numNodes)
-		g.addNode();
+	g.addNodes(numNodes);
 	while (g.numberOfEdges() < numEdges)
 	{
-		Graph::NodeIterator n1 = util::random_from(g.nodes(), rnd), n2 =
-				util::random_from(g.nodes(), rnd);
+		typename GraphType::DenseNodeIterator n1 = util::random_from(
+				g.denseNodes(), rnd), n2 = util::random_from(g.denseNodes(), rnd);
 		if (n1.id() == n2.id())
 			continue;
 		if (g.isEdge(n1.id(), n2.id()))
@@ -124,8 +128,8 @@ void randomGnmSlow(Graph& g, node_size_t numNodes, edge_size_t numEdges,
  * @param directed
  * @see Phys. Rev. E 71, 036113 (2005)
  */
-template<class RandomGen>
-void randomGnm(Graph& g, node_size_t numNodes, edge_size_t numEdges,
+template<class GraphType, class RandomGen>
+void randomGnm(GraphType& g, node_size_t numNodes, edge_size_t numEdges,
 		RandomGen& rnd, bool directed = false)
 {
 	if (directed)
@@ -138,8 +142,7 @@ void randomGnm(Graph& g, node_size_t numNodes, edge_size_t numEdges,
 	// hash table for edges
 	typedef boost::unordered_set<edge_t> edge_set;
 
-	while (g.numberOfNodes() < numNodes)
-		g.addNode();
+	g.addNodes(numNodes);
 
 	if (numNodes < 1)
 		return;
@@ -151,6 +154,8 @@ void randomGnm(Graph& g, node_size_t numNodes, edge_size_t numEdges,
 	 * efficient G(n,m) from Phys. Rev. E 71, 036113 (2005)
 	 */
 	edge_set edges;
+	std::vector<edge_t> new_edges;
+	new_edges.reserve(numEdges);
 	edge_t current_edge;
 	for (edge_size_t i = 0; i < numEdges; ++i)
 	{
@@ -168,11 +173,12 @@ void randomGnm(Graph& g, node_size_t numNodes, edge_size_t numEdges,
 			if (edges.find(current_edge) == edges.end())
 			{
 				edges.insert(current_edge);
-				g.addEdge(current_edge.first, current_edge.second, directed);
+				new_edges.push_back(current_edge);
 				break;
 			}
 		}
 	}
+	g.addEdges(new_edges, directed, true); // edges are unique
 }
 
 /**
@@ -186,8 +192,8 @@ void randomGnm(Graph& g, node_size_t numNodes, edge_size_t numEdges,
  * @param[in] rnd random number generator
  * @todo implement
  */
-template<class RandomGen>
-void randomGnp(Graph& g, node_size_t numNodes, double edgeProb, RandomGen& rnd)
+template<class GraphType, class RandomGen>
+void randomGnp(GraphType& g, node_size_t numNodes, double edgeProb, RandomGen& rnd)
 {
 	// FIXME this seems broken
 	throw std::runtime_error("Not yet implented");
@@ -225,8 +231,8 @@ void randomGnp(Graph& g, node_size_t numNodes, double edgeProb, RandomGen& rnd)
  * @param m Number of edges attached to each new node
  * @param rnd Random number generator providing uniform IntFromTo(int low, int high)
  */
-template<class RandomGen>
-void randomBA(Graph& g, node_size_t numNodes, edge_size_t m, RandomGen& rnd)
+template<class GraphType, class RandomGen>
+void randomBA(GraphType& g, node_size_t numNodes, edge_size_t m, RandomGen& rnd)
 {
 	/*
 	 * efficient BA(n,m) from Phys. Rev. E 71, 036113 (2005)
@@ -249,8 +255,7 @@ void randomBA(Graph& g, node_size_t numNodes, edge_size_t m, RandomGen& rnd)
 		}
 	}
 
-	while (g.numberOfNodes() < numNodes) // this relies on an freshly initialized graph!
-		g.addNode();
+	g.addNodes(numNodes); // this relies on an freshly initialized graph!
 
 	for (size_t i = 0; i < numNodes * m; ++i)
 		g.addEdge(nodes[2 * i], nodes[2 * i + 1], false); // undirected
@@ -264,8 +269,8 @@ void randomBA(Graph& g, node_size_t numNodes, edge_size_t m, RandomGen& rnd)
  * @param exponent power law exponent in out-degree distribution @f$ p(k) = k^(-exponent) @f$
  * @param rnd Random number generator providing uniform IntFromTo(int low, int high)
  */
-template<class RandomGen>
-void randomOutDegreePowerlaw(Graph& g, node_size_t numNodes, double exponent,
+template<class GraphType, class RandomGen>
+void randomOutDegreePowerlaw(GraphType& g, node_size_t numNodes, double exponent,
 		RandomGen& rnd)
 {
 	if (g.numberOfNodes() != 0)
@@ -302,11 +307,10 @@ void randomOutDegreePowerlaw(Graph& g, node_size_t numNodes, double exponent,
 	std::cout << "Mean degree is " << mdeg / degsum << "\n";
 #endif
 
-	while (g.numberOfNodes() < numNodes)
-		g.addNode();
+	g.addNodes(numNodes);
 
 	std::vector<node_id_t> nodes(numNodes, 0);
-	Graph::NodeIteratorRange nd = g.nodes();
+	typename GraphType::NodeIteratorRange nd = g.nodes();
 	std::transform(nd.first, nd.second, nodes.begin(),
 			std::mem_fun_ref(&Node::id));
 
@@ -318,9 +322,10 @@ void randomOutDegreePowerlaw(Graph& g, node_size_t numNodes, double exponent,
 			nodes.pop_back();
 			for (node_size_t k = 0; k < i; ++k)
 			{
-				Graph::NodeIterator nit = util::random_from(g.nodes(), rnd);
+				typename GraphType::DenseNodeIterator nit = util::random_from(
+						g.denseNodes(), rnd);
 				while (g.isEdge(cur_id, nit.id()) || cur_id == nit.id()) // disallow double edges and self-loops
-					nit = util::random_from(g.nodes(), rnd);
+					nit = util::random_from(g.denseNodes(), rnd);
 				g.addEdge(cur_id, nit.id(), true);
 			}
 		}
@@ -335,8 +340,8 @@ void randomOutDegreePowerlaw(Graph& g, node_size_t numNodes, double exponent,
  * @param rewProb
  * @param rnd
  */
-template<class RandomGen>
-void wattsStrogatzGraph(Graph& g, node_size_t numNodes,
+template<class GraphType, class RandomGen>
+void wattsStrogatzGraph(GraphType& g, node_size_t numNodes,
 		node_size_t numNeighbors, double rewProb, RandomGen& rnd)
 {
 	/// @see implementation in Python Networkx (http://networkx.lanl.gov)
@@ -344,15 +349,16 @@ void wattsStrogatzGraph(Graph& g, node_size_t numNodes,
 		throw std::out_of_range("Number of neighbors must be less than N/2.");
 
 	g.clear();
-	while (g.numberOfNodes() < numNodes)
-		g.addNode();
+	g.addNodes(numNodes);
 
 	typedef std::vector<node_id_t> node_id_v;
 	node_id_v nodes(numNodes, 0);
-	Graph::NodeIteratorRange nd = g.nodes();
+	typename GraphType::NodeIteratorRange nd = g.nodes();
 	std::transform(nd.first, nd.second, nodes.begin(),
 			std::mem_fun_ref(&Node::id));
 	assert(nodes.size() == g.numberOfNodes());
+	std::vector<std::pair<node_id_t, node_id_t> > ring;
+	ring.reserve(numNodes * (numNeighbors / 2));
 	for (node_size_t i = 1; i < numNeighbors / 2 + 1; ++i)
 	{
 		node_id_v targets(numNodes, 0);
@@ -360,8 +366,9 @@ void wattsStrogatzGraph(Graph& g, node_size_t numNodes,
 		std::rotate_copy(nodes.begin(), nodes.begin() + i, nodes.end(),
 				targets.begin());
 		for (size_t k = 0; k < numNodes; ++k)
-			g.addEdge(nodes[k], targets[k], false);
+			ring.push_back(std::make_pair(nodes[k], targets[k]));
 	}
+	g.addEdges(ring, false, true); // all offsets are distinct and less than N/2
 
 	assert(g.numberOfEdges() == numNodes * numNeighbors / 2);
 
@@ -370,19 +377,20 @@ void wattsStrogatzGraph(Graph& g, node_size_t numNodes,
 	edge_id_v edges;
 	edges.reserve(
 			2 * static_cast<size_t>(std::ceil(rewProb * g.numberOfEdges())));
-	BOOST_FOREACH(Edge& e, g.edges())
+	BOOST_FOREACH(typename GraphType::edge_type& e, g.edges())
 	{
 		if (rnd.Chance(rewProb))
 			edges.push_back(e.id());
 	}
 	BOOST_FOREACH(edge_id_t eid, edges)
 	{
-		Edge* e = g.edge(eid);
-		Graph::NodeIterator nit = util::random_from(g.nodes(), rnd);
+		typename GraphType::edge_type* e = g.edge(eid);
+		typename GraphType::DenseNodeIterator nit = util::random_from(
+				g.denseNodes(), rnd);
 		// no self-loops or double edges
 		while ((nit.id() == e->source()->id())
 				|| g.adjacent(e->source()->id(), nit.id()))
-			nit = util::random_from(g.nodes(), rnd);
+			nit = util::random_from(g.denseNodes(), rnd);
 		g.addEdge(e->source()->id(), nit.id(), false);
 		g.removeEdge(eid);
 	}
@@ -5,9 +5,13 @@
  */
 
 #include "BinReader.h"
+#include "bin_format.h"
 #include <largenet2.h>
+#include <boost/cstdint.hpp>
 #include <map>
+#include <stdexcept>
 #include <utility>
+#include <cstring>
 
 using namespace std;
 
@@ -16,47 +20,81 @@ namespace largenet
 namespace io
 {
 
-Graph* largenet::io::BinReader::createFromStream(std::istream& strm)
+namespace
 {
-	streambuf* buf = strm.rdbuf();
-	node_size_t N = 0;
-	edge_size_t L = 0;
-	node_state_size_t node_states = 0;
-	edge_state_size_t edge_states = 0;
-	buf->sgetn((char*) (&N), sizeof(N));
+
+/**
+ * Read the rest of a binary graph after its number of nodes @p N, with IDs
+ * and counts of type @p Id and states of type @p State
+ */
+template<class Id, class State>
+Graph* readGraph(streambuf* buf, const Id N)
+{
+	Id L = 0;
+	boost::uint32_t node_states = 0, edge_states = 0;
 	buf->sgetn((char*) (&L), sizeof(L));
 	buf->sgetn((char*) (&node_states), sizeof(node_states));
 	buf->sgetn((char*) (&edge_states), sizeof(edge_states));
 
 	Graph* graph = new Graph(node_states, edge_states);
 
-	typedef pair<node_id_t, node_state_t> node_info_t;
-	typedef map<node_id_t, node_info_t> node_map_t;
+	typedef map<Id, node_id_t> node_map_t;
 	node_map_t node_map;
-	node_info_t item(0, 0);
-	node_id_t nid = 0;
-	for (node_size_t i = 0; i < N; ++i)
+	Id nid = 0;
+	State nst = 0;
+	for (Id i = 0; i < N; ++i)
 	{
-		item.second = 0;
 		buf->sgetn((char*)(&nid), sizeof(nid));
-		buf->sgetn((char*)(&item.second), sizeof(item.second));
-		item.first = graph->addNode(item.second);
-		node_map.insert(make_pair(nid, item));
+		buf->sgetn((char*)(&nst), sizeof(nst));
+		node_map.insert(make_pair(nid, graph->addNode(nst)));
 	}
-	node_id_t sid = 0, tid = 0;
-	edge_state_t est = 0;
+	Id sid = 0, tid = 0;
+	State est = 0;
 	edge_id_t eid = 0;
-	for (edge_size_t i = 0; i < L; ++i)
+	for (Id i = 0; i < L; ++i)
 	{
 		buf->sgetn((char*)(&sid), sizeof(sid));
 		buf->sgetn((char*)(&tid), sizeof(tid));
 		buf->sgetn((char*)(&est), sizeof(est));
-		eid = graph->addEdge(node_map[sid].first, node_map[tid].first, true);
+		eid = graph->addEdge(node_map[sid], node_map[tid], true);
 		graph->setEdgeState(eid, est);
 	}
 	return graph;
 }
 
+}
+
+Graph* largenet::io::BinReader::createFromStream(std::istream& strm)
+{
+	streambuf* buf = strm.rdbuf();
+	char magic[sizeof(bin::magic)];
+	if (buf->sgetn(magic, sizeof(magic)) != sizeof(magic))
+		throw(std::runtime_error("Not a largenet binary graph."));
+	if (std::memcmp(magic, bin::magic, sizeof(magic)) != 0)
+	{
+		// legacy data without header, starting with a 64 bit number of nodes
+		char N[sizeof(boost::uint64_t)];
+		std::memcpy(N, magic, sizeof(magic));
+		if (buf->sgetn(N + sizeof(magic), sizeof(N) - sizeof(magic))
+				!= static_cast<streamsize> (sizeof(N) - sizeof(magic)))
+			throw(std::runtime_error("Not a largenet binary graph."));
+		boost::uint64_t n = 0;
+		std::memcpy(&n, N, sizeof(n));
+		return readGraph<boost::uint64_t, boost::uint32_t> (buf, n);
+	}
+	unsigned char header[3] = { 0, 0, 0 };
+	if (buf->sgetn((char*) header, sizeof(header)) != sizeof(header))
+		throw(std::runtime_error("Not a largenet binary graph."));
+	if (header[0] != bin::version)
+		throw(std::runtime_error("Unsupported binary graph version."));
+	if ((header[1] != LARGENET_ID_BITS) || (header[2] != LARGENET_STATE_BITS))
+		throw(std::runtime_error(
+				"Binary graph was written with different ID or state widths."));
+	node_size_t N = 0;
+	buf->sgetn((char*) (&N), sizeof(N));
+	return readGraph<node_id_t, node_state_t> (buf, N);
+}
+
 Graph* largenet::io::BinReader::createFromStream(std::istream& strm,
 		Graph& graphToFill)
 {
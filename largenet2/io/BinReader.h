@@ -28,6 +28,11 @@ public:
 	 * Create a new Graph object from stream
 	 * @param strm Stream to read graph data from
 	 * @return pointer to new graph object
+	 *
+	 * Data without the header of the current format is read as written by
+	 * earlier versions of BinWriter, with 64 bit IDs and 32 bit states.
+	 * @throw std::runtime_error if the data was written by a BinWriter built
+	 * with different ID or state widths, or in an unknown format version
 	 */
 	Graph* createFromStream(std::istream& strm);
 	/**
@@ -5,6 +5,7 @@
  */
 
 #include "BinWriter.h"
+#include "bin_format.h"
 #include <largenet2/base/Graph.h>
 #include <boost/foreach.hpp>
 
@@ -18,6 +19,10 @@ namespace io
 void BinWriter::write(const Graph& g, ostream& strm)
 {
 	streambuf* buf = strm.rdbuf();
+	const unsigned char header[3] = { bin::version, LARGENET_ID_BITS,
+			LARGENET_STATE_BITS };
+	buf->sputn(bin::magic, sizeof(bin::magic));
+	buf->sputn((const char*)header, sizeof(header));
 	node_size_t N = g.numberOfNodes();
 	edge_size_t L = g.numberOfEdges();
 	node_state_size_t node_states = g.numberOfNodeStates();
@@ -16,6 +16,13 @@ namespace io
 
 /**
  * Write binary graph output
+ *
+ * The output starts with a magic number, a format version, and the
+ * LARGENET_ID_BITS and LARGENET_STATE_BITS of the build, followed by the
+ * numbers of nodes, edges, node states and edge states, the nodes with their
+ * states and the edges with their states. IDs, counts and states are written
+ * in the native byte order and width of the build, which BinReader checks
+ * against its own (@see bin_format.h).
  */
 class BinWriter: public largenet::io::GraphWriter
 {
@@ -11,7 +11,6 @@
 #include <utility>
 #include <sstream>
 #include <stdexcept>
-#include <boost/foreach.hpp>
 
 using namespace std;
 
@@ -50,13 +49,8 @@ Graph* EdgeListReader::createFromStream(std::istream& strm, Graph& graphToFill)
 	}
 
 	graphToFill.clear();
-	while (graphToFill.numberOfNodes() < maxNodeID + 1)
-		graphToFill.addNode();
-
-	BOOST_FOREACH(edge e, edges)
-	{
-		graphToFill.addEdge(e.first, e.second, true);
-	}
+	graphToFill.addNodes(maxNodeID + 1);
+	graphToFill.addEdges(edges, true);
 	return &graphToFill;
 }
 
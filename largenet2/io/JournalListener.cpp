@@ -0,0 +1,266 @@
+/**
+ * @file JournalListener.cpp
+ * @date 18.10.2026
+ */
+
+#include "JournalListener.h"
+#include "journal_format.h"
+#include <largenet2/base/Graph.h>
+#include <largenet2/base/Node.h>
+#include <largenet2/base/Edge.h>
+#include <stdexcept>
+
+namespace largenet
+{
+namespace io
+{
+
+using namespace journal;
+
+namespace
+{
+/// payload size at which a segment is written
+const size_t segmentBytes = 1 << 16;
+}
+
+JournalListener::JournalListener(const Graph& g, std::ostream& strm,
+		const double keyframeSpacing, const double t) :
+	g_(g), strm_(strm), keyframeSpacing_(keyframeSpacing), time_(t),
+			recordedTime_(t), segmentTime_(t), segmentFlags_(KEYFRAME_SEGMENT),
+			node_(0), edge_(0), changes_(0), sinceKeyframe_(0), written_(0)
+{
+	buf_.reserve(segmentBytes + 64);
+	buf_.insert(buf_.end(), magic, magic + sizeof(magic));
+	putVarint(buf_, g.numberOfNodeStates());
+	putVarint(buf_, g.numberOfEdgeStates());
+	written_ += buf_.size();
+	strm_.rdbuf()->sputn(&buf_[0], buf_.size());
+	buf_.clear();
+	writeKeyframe();
+}
+
+JournalListener::~JournalListener()
+{
+	flush();
+}
+
+void JournalListener::setTime(const double t)
+{
+	if (t < time_)
+		throw(std::invalid_argument("Journal time must not decrease."));
+	time_ = t;
+	if ((keyframeSpacing_ > 0) && (sinceKeyframe_ > keyframeSpacing_
+			* (g_.numberOfNodes() + g_.numberOfEdges())))
+		keyframe();
+}
+
+void JournalListener::keyframe()
+{
+	startSegment(KEYFRAME_SEGMENT);
+	writeKeyframe();
+}
+
+void JournalListener::flush()
+{
+	writeSegment();
+	strm_.flush();
+}
+
+size_t JournalListener::memoryUsage() const
+{
+	return buf_.capacity() + (nodeKnown_.capacity() + edgeKnown_.capacity()) / 8;
+}
+
+void JournalListener::afterNodeAddEvent(Graph& g, Node& n)
+{
+	setKnown(nodeKnown_, n.id(), true);
+	record(NODE_ADD);
+	putDelta(buf_, n.id(), node_);
+	putVarint(buf_, g.nodeState(n.id()));
+}
+
+void JournalListener::afterEdgeAddEvent(Graph& g, Edge& e)
+{
+	setKnown(edgeKnown_, e.id(), true);
+	record(EDGE_ADD);
+	putDelta(buf_, e.id(), edge_);
+	putDelta(buf_, e.source()->id(), node_);
+	putDelta(buf_, e.target()->id(), node_);
+	putVarint(buf_, (static_cast<boost::uint64_t> (g.edgeState(e.id())) << 1)
+			| (e.isDirected() ? 1 : 0));
+}
+
+void JournalListener::beforeNodeRemoveEvent(Graph& g, Node& n)
+{
+	setKnown(nodeKnown_, n.id(), false);
+	// the graph notifies the removal of the node's edges afterwards, but
+	// replaying the node removal removes them already
+	const Node::edge_iterator_range r[] = { n.outEdges(), n.inEdges(),
+			n.undirectedEdges() };
+	for (size_t i = 0; i < 3; ++i)
+	{
+		for (Node::edge_iterator e = r[i].first; e != r[i].second; ++e)
+			setKnown(edgeKnown_, (*e)->id(), false);
+	}
+	record(NODE_REMOVE);
+	putDelta(buf_, n.id(), node_);
+}
+
+void JournalListener::beforeEdgeRemoveEvent(Graph& g, Edge& e)
+{
+	if (!isKnown(edgeKnown_, e.id()))
+		return;
+	setKnown(edgeKnown_, e.id(), false);
+	record(EDGE_REMOVE);
+	putDelta(buf_, e.id(), edge_);
+}
+
+void JournalListener::afterEdgeRewireEvent(Graph& g, Edge& e, Node& oldSource,
+		Node& oldTarget)
+{
+	record(EDGE_REWIRE);
+	putDelta(buf_, e.id(), edge_);
+	putDelta(buf_, e.source()->id(), node_);
+	putDelta(buf_, e.target()->id(), node_);
+}
+
+void JournalListener::beforeGraphClearEvent(Graph& g)
+{
+	nodeKnown_.clear();
+	edgeKnown_.clear();
+	record(GRAPH_CLEAR);
+}
+
+void JournalListener::afterGraphCompactEvent(Graph& g,
+		const std::vector<node_id_t>& nodeIds,
+		const std::vector<edge_id_t>& edgeIds)
+{
+	// the replayer cannot renumber its own graph, so it reloads it
+	startSegment(KEYFRAME_SEGMENT | RELOAD_SEGMENT);
+	writeKeyframe();
+}
+
+void JournalListener::afterNodeStateChangeEvent(Graph& g, Node& n,
+		node_state_t oldState, node_state_t newState)
+{
+	// the state of a node whose addition is still to be recorded is
+	// recorded with it
+	if (!isKnown(nodeKnown_, n.id()))
+		return;
+	record(NODE_STATE);
+	putDelta(buf_, n.id(), node_);
+	putVarint(buf_, newState);
+}
+
+void JournalListener::afterEdgeStateChangeEvent(Graph& g, Edge& e,
+		edge_state_t oldState, edge_state_t newState)
+{
+	if (!isKnown(edgeKnown_, e.id()))
+		return;
+	record(EDGE_STATE);
+	putDelta(buf_, e.id(), edge_);
+	putVarint(buf_, newState);
+}
+
+void JournalListener::afterEdgeStatesChangeEvent(Graph& g,
+		const std::vector<edge_id_t>& edges,
+		const std::vector<edge_state_t>& oldStates)
+{
+	for (size_t i = 0; i < edges.size(); ++i)
+	{
+		if (!isKnown(edgeKnown_, edges[i]))
+			continue;
+		record(EDGE_STATE);
+		putDelta(buf_, edges[i], edge_);
+		putVarint(buf_, g.edgeState(edges[i]));
+	}
+}
+
+void JournalListener::record(const unsigned char opcode)
+{
+	if (buf_.size() >= segmentBytes)
+		startSegment(0);
+	if (time_ != recordedTime_)
+	{
+		buf_.push_back(TIME);
+		putDouble(buf_, time_);
+		recordedTime_ = time_;
+	}
+	buf_.push_back(opcode);
+	++changes_;
+	++sinceKeyframe_;
+}
+
+void JournalListener::startSegment(const unsigned char flags)
+{
+	writeSegment();
+	segmentFlags_ = flags;
+	segmentTime_ = recordedTime_ = time_;
+	node_ = edge_ = 0;
+}
+
+void JournalListener::writeSegment()
+{
+	if (buf_.empty())
+		return;
+	std::vector<char> header;
+	header.push_back(segmentFlags_);
+	putDouble(header, segmentTime_);
+	putVarint(header, buf_.size());
+	std::streambuf* sb = strm_.rdbuf();
+	sb->sputn(&header[0], header.size());
+	sb->sputn(&buf_[0], buf_.size());
+	written_ += header.size() + buf_.size();
+	buf_.clear();
+	// continue in a new segment without keyframe
+	segmentFlags_ = 0;
+	segmentTime_ = recordedTime_ = time_;
+	node_ = edge_ = 0;
+}
+
+void JournalListener::writeKeyframe()
+{
+	std::vector<char> body;
+	body.reserve(4 * (g_.numberOfNodes() + 2 * g_.numberOfEdges()) + 32);
+	boost::uint64_t node = 0, edge = 0;
+	nodeKnown_.clear();
+	edgeKnown_.clear();
+	putVarint(body, g_.numberOfNodes());
+	for (Graph::ConstNodeIterator n = g_.nodes().first; n != g_.nodes().second; ++n)
+	{
+		setKnown(nodeKnown_, n.id(), true);
+		putDelta(body, n.id(), node);
+		putVarint(body, g_.nodeState(n.id()));
+	}
+	putVarint(body, g_.numberOfEdges());
+	for (Graph::ConstEdgeIterator e = g_.edges().first; e != g_.edges().second; ++e)
+	{
+		setKnown(edgeKnown_, e.id(), true);
+		putDelta(body, e.id(), edge);
+		putDelta(body, e->source()->id(), node);
+		putDelta(body, e->target()->id(), node);
+		putVarint(body, (static_cast<boost::uint64_t> (g_.edgeState(e.id())) << 1)
+				| (e->isDirected() ? 1 : 0));
+	}
+	buf_.push_back(KEYFRAME);
+	putVarint(buf_, body.size());
+	buf_.insert(buf_.end(), body.begin(), body.end());
+	sinceKeyframe_ = 0;
+}
+
+void JournalListener::setKnown(std::vector<bool>& known,
+		const boost::uint64_t id, const bool k)
+{
+	if (id >= known.size())
+		known.resize(id + 1);
+	known[id] = k;
+}
+
+bool JournalListener::isKnown(const std::vector<bool>& known,
+		const boost::uint64_t id)
+{
+	return (id < known.size()) && known[id];
+}
+
+}
+}
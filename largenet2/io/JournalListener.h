@@ -0,0 +1,127 @@
+/**
+ * @file JournalListener.h
+ * @date 18.10.2026
+ */
+
+#ifndef JOURNALLISTENER_H_
+#define JOURNALLISTENER_H_
+
+#include <largenet2/base/GraphListener.h>
+#include <largenet2/base/types.h>
+#include <boost/cstdint.hpp>
+#include <iostream>
+#include <vector>
+
+namespace largenet
+{
+namespace io
+{
+
+/**
+ * Records all changes of a graph in a compact binary journal, from which
+ * JournalReplayer can reproduce the graph at any recorded time without
+ * re-running the simulation.
+ *
+ * Register the listener with the graph and call setTime() whenever
+ * simulation time advances; every change is recorded with the time last
+ * set. Records store ID differences and states as varints, usually taking
+ * two to four bytes each, and are written to the stream in segments of
+ * about 64 KiB. Keyframes holding the complete graph are written at the
+ * start, after Graph::compact(), and periodically at calls of setTime(), so
+ * that replay can start close to any time.
+ *
+ * The journal is complete only after flush() or destruction of the
+ * listener. Replaying requires a graph whose element factory accepts the
+ * same edges as the original, e.g. MultiEdgeElementFactory for parallel
+ * edges.
+ *
+ * @code
+ * std::ofstream out("sim.journal", std::ios::binary);
+ * io::JournalListener journal(g, out);
+ * g.addGraphListener(&journal);
+ * while (t < tmax)
+ * {
+ *     // ... change g, advance t ...
+ *     journal.setTime(t);
+ * }
+ * @endcode
+ */
+class JournalListener: public GraphListener
+{
+public:
+	/**
+	 * Constructor. Writes the journal header and a keyframe of the current
+	 * state of @p g.
+	 * @param g graph to record; register the listener with it afterwards
+	 * @param strm stream to write to, opened in binary mode
+	 * @param keyframeSpacing a keyframe is written at the next call of
+	 * setTime() once the number of changes recorded since the last one
+	 * exceeds @p keyframeSpacing times the number of nodes and edges; 0
+	 * disables periodic keyframes
+	 * @param t time of the initial state
+	 */
+	JournalListener(const Graph& g, std::ostream& strm,
+			double keyframeSpacing = 4, double t = 0);
+	/// Flushes the journal.
+	~JournalListener();
+	/**
+	 * Set the time recorded with subsequent changes. May write a keyframe.
+	 * @param t current time, not smaller than the previous one
+	 */
+	void setTime(double t);
+	/// Current time.
+	double time() const { return time_; }
+	/// Write a keyframe of the current graph, e.g. before expected seeks.
+	void keyframe();
+	/// Write all buffered changes to the stream and flush it.
+	void flush();
+	/// Number of changes recorded so far.
+	unsigned long numberOfChanges() const { return changes_; }
+	/// Number of bytes written to the stream so far.
+	boost::uint64_t bytesWritten() const { return written_; }
+	size_t memoryUsage() const;
+
+private:
+	void afterNodeAddEvent(Graph& g, Node& n);
+	void afterEdgeAddEvent(Graph& g, Edge& e);
+	void beforeNodeRemoveEvent(Graph& g, Node& n);
+	void beforeEdgeRemoveEvent(Graph& g, Edge& e);
+	// rewiring is recorded as such, not as removal and addition
+	void beforeEdgeRewireEvent(Graph& g, Edge& e, Node& newSource, Node& newTarget) {}
+	void afterEdgeRewireEvent(Graph& g, Edge& e, Node& oldSource, Node& oldTarget);
+	void beforeGraphClearEvent(Graph& g);
+	void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& nodeIds,
+			const std::vector<edge_id_t>& edgeIds);
+	void afterNodeStateChangeEvent(Graph& g, Node& n, node_state_t oldState, node_state_t newState);
+	void afterEdgeStateChangeEvent(Graph& g, Edge& e, edge_state_t oldState, edge_state_t newState);
+	void afterEdgeStatesChangeEvent(Graph& g, const std::vector<edge_id_t>& edges,
+			const std::vector<edge_state_t>& oldStates);
+
+	/// start a record, writing the time first if it has changed
+	void record(unsigned char opcode);
+	/// write the current segment and start a new one
+	void startSegment(unsigned char flags);
+	void writeSegment();
+	void writeKeyframe();
+	static void setKnown(std::vector<bool>& known, boost::uint64_t id, bool k);
+	static bool isKnown(const std::vector<bool>& known, boost::uint64_t id);
+
+	const Graph& g_;
+	std::ostream& strm_;
+	double keyframeSpacing_;
+	double time_, recordedTime_, segmentTime_;
+	unsigned char segmentFlags_;
+	std::vector<char> buf_;
+	/// previous IDs, for difference encoding
+	boost::uint64_t node_, edge_;
+	/// whether each node and edge exists in the recorded graph, which lags
+	/// behind the graph while events are dispatched to other listeners
+	std::vector<bool> nodeKnown_, edgeKnown_;
+	unsigned long changes_, sinceKeyframe_;
+	boost::uint64_t written_;
+};
+
+}
+}
+
+#endif /* JOURNALLISTENER_H_ */
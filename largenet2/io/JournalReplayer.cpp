@@ -0,0 +1,274 @@
+/**
+ * @file JournalReplayer.cpp
+ * @date 18.10.2026
+ */
+
+#include "JournalReplayer.h"
+#include <largenet2/base/Graph.h>
+#include <stdexcept>
+#include <limits>
+#include <cstring>
+
+namespace largenet
+{
+namespace io
+{
+
+using namespace journal;
+
+namespace
+{
+
+boost::uint64_t readVarint(std::istream& strm)
+{
+	boost::uint64_t v = 0;
+	for (unsigned int shift = 0; shift < 64; shift += 7)
+	{
+		const int b = strm.get();
+		if (!strm)
+			break;
+		v |= static_cast<boost::uint64_t> (b & 0x7f) << shift;
+		if (!(b & 0x80))
+			return v;
+	}
+	strm.setstate(std::ios::failbit);
+	return 0;
+}
+
+template<typename T> void setId(std::vector<T>& ids, const boost::uint64_t id,
+		const T local)
+{
+	if (id >= ids.size())
+		ids.resize(id + 1);
+	ids[id] = local;
+}
+
+}
+
+JournalReplayer::JournalReplayer(std::istream& strm, Graph& g) :
+	strm_(strm), g_(g), nodeStates_(0), edgeStates_(0), segment_(0), time_(0),
+			node_(0), edge_(0)
+{
+	char m[sizeof(magic)];
+	if (!strm_.read(m, sizeof(m)) || (std::memcmp(m, magic, sizeof(m)) != 0))
+		throw(std::runtime_error("Not a largenet journal."));
+	nodeStates_ = readVarint(strm_);
+	edgeStates_ = readVarint(strm_);
+	if (!strm_)
+		throw(std::runtime_error("Not a largenet journal."));
+	if ((g_.numberOfNodeStates() < nodeStates_) || (g_.numberOfEdgeStates()
+			< edgeStates_))
+		throw(std::invalid_argument(
+				"Graph has fewer states than the recorded graph."));
+
+	// locate the segments, ignoring an incomplete one at the end
+	const std::streampos start = strm_.tellg();
+	strm_.seekg(0, std::ios::end);
+	const std::streampos end = strm_.tellg();
+	strm_.seekg(start);
+	while (strm_ && (strm_.tellg() < end))
+	{
+		Segment s;
+		s.flags = static_cast<unsigned char> (strm_.get());
+		strm_.read(reinterpret_cast<char*> (&s.time), sizeof(s.time));
+		s.length = readVarint(strm_);
+		s.pos = strm_.tellg();
+		if (!strm_ || (end - s.pos < static_cast<std::streamoff> (s.length)))
+			break;
+		segments_.push_back(s);
+		strm_.seekg(s.pos + static_cast<std::streamoff> (s.length));
+	}
+	if (segments_.empty() || !(segments_[0].flags & KEYFRAME_SEGMENT))
+		throw(std::runtime_error("Journal has no initial keyframe."));
+	rewind();
+}
+
+bool JournalReplayer::atEnd()
+{
+	// skip segments holding only a keyframe
+	while (d_.atEnd() && (segment_ + 1 < segments_.size()))
+		load(segment_ + 1, false);
+	return d_.atEnd();
+}
+
+void JournalReplayer::rewind()
+{
+	load(0, true);
+}
+
+bool JournalReplayer::step()
+{
+	const double inf = std::numeric_limits<double>::infinity();
+	for (;;)
+	{
+		const int r = apply(inf);
+		if (r != 0)
+			return r > 0;
+	}
+}
+
+unsigned long JournalReplayer::advance(const double t)
+{
+	unsigned long n = 0;
+	int r;
+	while ((r = apply(t)) >= 0)
+		n += r;
+	return n;
+}
+
+void JournalReplayer::seek(const double t)
+{
+	size_t k = 0;
+	for (size_t i = 1; (i < segments_.size()) && (segments_[i].time <= t); ++i)
+	{
+		if (segments_[i].flags & KEYFRAME_SEGMENT)
+			k = i;
+	}
+	// replaying the changes between keyframes costs more than loading one
+	if ((t < time_) || (k > segment_))
+		load(k, true);
+	advance(t);
+}
+
+void JournalReplayer::load(const size_t i, const bool restart)
+{
+	const Segment& s = segments_[i];
+	buf_.resize(s.length);
+	strm_.clear();
+	strm_.seekg(s.pos);
+	if (!strm_.read(&buf_[0], s.length))
+		throw(std::runtime_error("Truncated journal."));
+	d_ = Decoder(&buf_[0], &buf_[0] + s.length);
+	node_ = edge_ = 0;
+	time_ = s.time;
+	if (s.flags & KEYFRAME_SEGMENT)
+	{
+		if (d_.byte() != KEYFRAME)
+			throw(std::runtime_error("Corrupt journal."));
+		const size_t length = d_.varint();
+		// a keyframe repeats the state reached by replaying the previous
+		// segments, unless the graph was renumbered
+		if (restart || (s.flags & RELOAD_SEGMENT))
+			loadKeyframe(Decoder(d_.position(), d_.position() + length));
+		d_.skip(length);
+	}
+	segment_ = i;
+}
+
+int JournalReplayer::apply(const double t)
+{
+	while (d_.atEnd())
+	{
+		if ((segment_ + 1 >= segments_.size()) || (segments_[segment_ + 1].time
+				> t))
+			return -1;
+		load(segment_ + 1, false);
+	}
+	const Decoder before = d_;
+	switch (d_.byte())
+	{
+	case TIME:
+	{
+		const double next = d_.real();
+		if (next > t)
+		{
+			d_ = before;
+			return -1;
+		}
+		time_ = next;
+		return 0;
+	}
+	case NODE_ADD:
+	{
+		const boost::uint64_t id = d_.delta(node_);
+		setId(nodes_, id, g_.addNode(d_.varint()));
+		return 1;
+	}
+	case NODE_REMOVE:
+		g_.removeNode(nodeId(d_.delta(node_)));
+		return 1;
+	case NODE_STATE:
+	{
+		const node_id_t n = nodeId(d_.delta(node_));
+		g_.setNodeState(n, d_.varint());
+		return 1;
+	}
+	case EDGE_ADD:
+	{
+		const boost::uint64_t id = d_.delta(edge_);
+		const node_id_t s = nodeId(d_.delta(node_));
+		const node_id_t tg = nodeId(d_.delta(node_));
+		const boost::uint64_t sd = d_.varint();
+		const edge_id_t e = g_.addEdge(s, tg, (sd & 1) != 0);
+		setId(edges_, id, e);
+		g_.setEdgeState(e, sd >> 1);
+		return 1;
+	}
+	case EDGE_REMOVE:
+		g_.removeEdge(edgeId(d_.delta(edge_)));
+		return 1;
+	case EDGE_STATE:
+	{
+		const edge_id_t e = edgeId(d_.delta(edge_));
+		g_.setEdgeState(e, d_.varint());
+		return 1;
+	}
+	case EDGE_REWIRE:
+	{
+		const edge_id_t e = edgeId(d_.delta(edge_));
+		const node_id_t s = nodeId(d_.delta(node_));
+		g_.rewireEdge(e, s, nodeId(d_.delta(node_)));
+		return 1;
+	}
+	case GRAPH_CLEAR:
+		g_.clear();
+		nodes_.clear();
+		edges_.clear();
+		return 1;
+	default:
+		throw(std::runtime_error("Corrupt journal."));
+	}
+}
+
+void JournalReplayer::loadKeyframe(Decoder d)
+{
+	g_.clear();
+	nodes_.clear();
+	edges_.clear();
+	boost::uint64_t node = 0, edge = 0;
+	const node_size_t n = d.varint();
+	for (node_size_t i = 0; i < n; ++i)
+	{
+		const boost::uint64_t id = d.delta(node);
+		setId(nodes_, id, g_.addNode(d.varint()));
+	}
+	const edge_size_t m = d.varint();
+	g_.reserve(n, m);
+	for (edge_size_t i = 0; i < m; ++i)
+	{
+		const boost::uint64_t id = d.delta(edge);
+		const node_id_t s = nodeId(d.delta(node));
+		const node_id_t t = nodeId(d.delta(node));
+		const boost::uint64_t sd = d.varint();
+		const edge_id_t e = g_.addEdge(s, t, (sd & 1) != 0);
+		setId(edges_, id, e);
+		g_.setEdgeState(e, sd >> 1);
+	}
+}
+
+node_id_t JournalReplayer::nodeId(const boost::uint64_t id) const
+{
+	if (id >= nodes_.size())
+		throw(std::runtime_error("Corrupt journal."));
+	return nodes_[id];
+}
+
+edge_id_t JournalReplayer::edgeId(const boost::uint64_t id) const
+{
+	if (id >= edges_.size())
+		throw(std::runtime_error("Corrupt journal."));
+	return edges_[id];
+}
+
+}
+}
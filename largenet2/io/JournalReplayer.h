@@ -0,0 +1,118 @@
+/**
+ * @file JournalReplayer.h
+ * @date 18.10.2026
+ */
+
+#ifndef JOURNALREPLAYER_H_
+#define JOURNALREPLAYER_H_
+
+#include <largenet2/base/types.h>
+#include <largenet2/io/journal_format.h>
+#include <iostream>
+#include <vector>
+
+namespace largenet
+{
+
+class Graph;
+
+namespace io
+{
+
+/**
+ * Reproduces a graph from a journal written by JournalListener.
+ *
+ * The replayer applies the recorded changes to a graph through the usual
+ * Graph methods, so that listeners registered with it, e.g. for computing
+ * measures, see the same sequence of events as during the simulation. Node
+ * and edge IDs in the replayed graph may differ from the recorded ones.
+ *
+ * @code
+ * std::ifstream in("sim.journal", std::ios::binary);
+ * Graph g(2, 3);
+ * io::JournalReplayer replay(in, g);
+ * g.addGraphListener(&measure);
+ * for (double t = 0; !replay.atEnd(); t += 1)
+ * {
+ *     replay.advance(t);
+ *     // ... evaluate measure ...
+ * }
+ * @endcode
+ */
+class JournalReplayer
+{
+public:
+	/**
+	 * Constructor. Reads the journal header, locates its segments, and
+	 * loads the initial state into @p g.
+	 * @param strm seekable stream to read the journal from, opened in binary
+	 * mode; must stay valid while the replayer is used
+	 * @param g graph to replay into; is cleared
+	 * @throw std::runtime_error if @p strm does not hold a journal
+	 * @throw std::invalid_argument if @p g has fewer node or edge states
+	 * than the recorded graph
+	 */
+	JournalReplayer(std::istream& strm, Graph& g);
+	/// Number of node states of the recorded graph.
+	node_state_size_t numberOfNodeStates() const { return nodeStates_; }
+	/// Number of edge states of the recorded graph.
+	edge_state_size_t numberOfEdgeStates() const { return edgeStates_; }
+	/// Time of the most recently applied change.
+	double time() const { return time_; }
+	/// Whether all changes have been applied.
+	bool atEnd();
+	/// Reload the initial state.
+	void rewind();
+	/**
+	 * Apply the next change.
+	 * @return false if there are no more changes
+	 */
+	bool step();
+	/**
+	 * Apply all changes recorded up to time @p t.
+	 * @return number of changes applied
+	 */
+	unsigned long advance(double t);
+	/**
+	 * Bring the graph to its state at time @p t, starting from the last
+	 * keyframe before @p t unless @p t lies ahead of the current time.
+	 */
+	void seek(double t);
+
+private:
+	struct Segment
+	{
+		std::streampos pos;
+		size_t length;
+		double time;
+		unsigned char flags;
+	};
+	/// load segment @p i, applying its keyframe if @p restart or if the graph
+	/// was renumbered
+	void load(size_t i, bool restart);
+	/// decode and apply the next record, with @p t the time not to exceed
+	/// @return 1 if a change was applied, 0 if not, -1 if it is beyond @p t
+	int apply(double t);
+	void loadKeyframe(journal::Decoder d);
+	node_id_t nodeId(boost::uint64_t id) const;
+	edge_id_t edgeId(boost::uint64_t id) const;
+
+	std::istream& strm_;
+	Graph& g_;
+	node_state_size_t nodeStates_;
+	edge_state_size_t edgeStates_;
+	std::vector<Segment> segments_;
+	size_t segment_;
+	std::vector<char> buf_;
+	journal::Decoder d_;
+	double time_;
+	boost::uint64_t node_, edge_;
+	/// IDs in the replayed graph, indexed by recorded ID
+	std::vector<node_id_t> nodes_;
+	std::vector<edge_id_t> edges_;
+};
+
+}
+}
+
+#endif /* JOURNALREPLAYER_H_ */
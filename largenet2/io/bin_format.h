@@ -0,0 +1,37 @@
+/**
+ * @file bin_format.h
+ * @date 18.10.2026
+ *
+ * Binary format shared by BinWriter and BinReader.
+ *
+ * A binary graph starts with the magic bytes "LNBG", a version byte, and
+ * two bytes holding the LARGENET_ID_BITS and LARGENET_STATE_BITS of the
+ * writing build. These are followed by the numbers of nodes and edges
+ * (node_size_t, edge_size_t), the numbers of node and edge states (32 bits
+ * each), the nodes as ID and state, and the edges as source ID, target ID,
+ * and state, all in native byte order.
+ *
+ * Files written before the header was introduced start with the number of
+ * nodes right away, and use 64 bit IDs and counts and 32 bit states.
+ */
+
+#ifndef BIN_FORMAT_H_
+#define BIN_FORMAT_H_
+
+namespace largenet
+{
+namespace io
+{
+/// @cond IGNORE
+namespace bin
+{
+
+const char magic[4] = { 'L', 'N', 'B', 'G' };
+const unsigned char version = 1;
+
+}
+/// @endcond
+}
+}
+
+#endif /* BIN_FORMAT_H_ */
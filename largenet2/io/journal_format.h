@@ -0,0 +1,156 @@
+/**
+ * @file journal_format.h
+ * @date 18.10.2026
+ *
+ * Binary format shared by JournalListener and JournalReplayer.
+ *
+ * A journal starts with the magic bytes "LNJ1" and the numbers of node and
+ * edge states as varints, followed by segments. Each segment consists of a
+ * flags byte, the time at its start (native double), the length of its
+ * payload as varint, and the payload. The payload is a sequence of records,
+ * each an opcode byte followed by its fields. IDs are stored as zigzag
+ * varint differences to the previous node or edge ID in the same segment,
+ * states as varints. A segment may start with a keyframe record holding the
+ * complete graph, so that segments can be located without decoding them and
+ * replay can start at any keyframe.
+ */
+
+#ifndef JOURNAL_FORMAT_H_
+#define JOURNAL_FORMAT_H_
+
+#include <largenet2/base/types.h>
+#include <boost/cstdint.hpp>
+#include <stdexcept>
+#include <vector>
+#include <cstring>
+
+namespace largenet
+{
+namespace io
+{
+/// @cond IGNORE
+namespace journal
+{
+
+const char magic[4] = { 'L', 'N', 'J', '1' };
+
+/// segment flags
+enum SegmentFlags
+{
+	KEYFRAME_SEGMENT = 1, ///< payload starts with a keyframe
+	RELOAD_SEGMENT = 2 ///< keyframe renumbers nodes and edges and must be loaded
+};
+
+/// record opcodes
+enum Opcode
+{
+	NODE_ADD = 1, ///< node, state
+	NODE_REMOVE, ///< node
+	NODE_STATE, ///< node, state
+	EDGE_ADD, ///< edge, source, target, state * 2 + directed
+	EDGE_REMOVE, ///< edge
+	EDGE_STATE, ///< edge, state
+	EDGE_REWIRE, ///< edge, source, target
+	GRAPH_CLEAR, ///< no fields
+	TIME, ///< time (native double)
+	KEYFRAME ///< length, node count, nodes, edge count, edges
+};
+
+inline void putVarint(std::vector<char>& buf, boost::uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		buf.push_back(static_cast<char> ((v & 0x7f) | 0x80));
+		v >>= 7;
+	}
+	buf.push_back(static_cast<char> (v));
+}
+
+/// zigzag-encoded difference @p v - @p last; sets @p last to @p v
+inline void putDelta(std::vector<char>& buf, const boost::uint64_t v,
+		boost::uint64_t& last)
+{
+	const boost::int64_t d = static_cast<boost::int64_t> (v - last);
+	putVarint(buf, (static_cast<boost::uint64_t> (d) << 1) ^ static_cast<
+			boost::uint64_t> (d >> 63));
+	last = v;
+}
+
+inline void putDouble(std::vector<char>& buf, const double v)
+{
+	const char* p = reinterpret_cast<const char*> (&v);
+	buf.insert(buf.end(), p, p + sizeof(v));
+}
+
+/// reads fields from a segment payload
+class Decoder
+{
+public:
+	Decoder() :
+		p_(0), end_(0)
+	{
+	}
+	Decoder(const char* begin, const char* end) :
+		p_(begin), end_(end)
+	{
+	}
+	bool atEnd() const
+	{
+		return p_ == end_;
+	}
+	const char* position() const
+	{
+		return p_;
+	}
+	void skip(const size_t n)
+	{
+		check(n);
+		p_ += n;
+	}
+	unsigned char byte()
+	{
+		check(1);
+		return static_cast<unsigned char> (*p_++);
+	}
+	boost::uint64_t varint()
+	{
+		boost::uint64_t v = 0;
+		for (unsigned int shift = 0; shift < 64; shift += 7)
+		{
+			const unsigned char b = byte();
+			v |= static_cast<boost::uint64_t> (b & 0x7f) << shift;
+			if (!(b & 0x80))
+				return v;
+		}
+		throw(std::runtime_error("Corrupt journal."));
+	}
+	boost::uint64_t delta(boost::uint64_t& last)
+	{
+		const boost::uint64_t z = varint();
+		last += (z >> 1) ^ (~(z & 1) + 1);
+		return last;
+	}
+	double real()
+	{
+		double v;
+		check(sizeof(v));
+		std::memcpy(&v, p_, sizeof(v));
+		p_ += sizeof(v);
+		return v;
+	}
+private:
+	void check(const size_t n) const
+	{
+		if (static_cast<size_t> (end_ - p_) < n)
+			throw(std::runtime_error("Truncated journal."));
+	}
+	const char* p_;
+	const char* end_;
+};
+
+}
+/// @endcond
+}
+}
+
+#endif /* JOURNAL_FORMAT_H_ */
@@ -8,6 +8,8 @@
 #define DEGREEDISTRIBUTION_H_
 
 #include <largenet2/base/Graph.h>
+#include <largenet2/base/CSRGraph.h>
+#include <largenet2/base/node_traits.h>
 #include <boost/noncopyable.hpp>
 #include <vector>
 #include <stdexcept>
@@ -48,20 +50,16 @@ class DegreeDistribution: public boost::noncopyable
 public:
 	typedef degree_dist_t::size_type size_type;
 
-	explicit DegreeDistribution(const Graph& g);
-	DegreeDistribution(const Graph& g, node_state_t s);
+	template<class GraphType>
+	explicit DegreeDistribution(const GraphType& g);
+	template<class GraphType>
+	DegreeDistribution(const GraphType& g, node_state_t s);
 	DegreeDistribution(const Graph& g, node_state_t s1, node_state_t s2);
+	explicit DegreeDistribution(const CSRGraph& g);
 
 	node_size_t operator[](degree_t k) const
 	{
-		try
-		{
-			return dist_.at(k);
-		} catch (std::out_of_range&)
-		{
-			return 0;
-		}
-		return 0;
+		return (k < dist_.size()) ? dist_[k] : 0;
 	}
 
 	degree_t maxDegree() const
@@ -86,7 +84,8 @@ public:
 	DegreeDistribution& operator>>(node_size_t& n);
 
 private:
-	template<class _NodeIterator> degree_t degree(_NodeIterator& it) const;
+	template<class NodeType> degree_t degree(const NodeType& n) const;
+	degree_t degree(const CSRGraph& g, node_size_t i) const;
 	template<class _NodeIterator> degree_t countNeighbors(_NodeIterator& it,
 			const Graph& g, node_state_t s) const;
 	degree_dist_t dist_;
@@ -99,31 +98,59 @@ typedef DegreeDistribution<undirectedS> UndirectedDegreeDistribution;
 typedef DegreeDistribution<allS> TotalDegreeDistribution;
 
 template<>
-template<class _NodeIterator>
-degree_t DegreeDistribution<inS>::degree(_NodeIterator& it) const
+template<class NodeType>
+degree_t DegreeDistribution<inS>::degree(const NodeType& n) const
 {
-	return it->inDegree();
+	return node_traits<NodeType>::inDegree(n);
 }
 
 template<>
-template<class _NodeIterator>
-degree_t DegreeDistribution<outS>::degree(_NodeIterator& it) const
+template<class NodeType>
+degree_t DegreeDistribution<outS>::degree(const NodeType& n) const
 {
-	return it->outDegree();
+	return node_traits<NodeType>::outDegree(n);
 }
 
 template<>
-template<class _NodeIterator>
-degree_t DegreeDistribution<undirectedS>::degree(_NodeIterator& it) const
+template<class NodeType>
+degree_t DegreeDistribution<undirectedS>::degree(const NodeType& n) const
 {
-	return it->undirectedDegree();
+	return node_traits<NodeType>::undirectedDegree(n);
 }
 
 template<>
-template<class _NodeIterator>
-degree_t DegreeDistribution<allS>::degree(_NodeIterator& it) const
+template<class NodeType>
+degree_t DegreeDistribution<allS>::degree(const NodeType& n) const
 {
-	return it->degree();
+	return node_traits<NodeType>::degree(n);
+}
+
+template<>
+inline degree_t DegreeDistribution<inS>::degree(const CSRGraph& g,
+		const node_size_t i) const
+{
+	return g.inDegree(i);
+}
+
+template<>
+inline degree_t DegreeDistribution<outS>::degree(const CSRGraph& g,
+		const node_size_t i) const
+{
+	return g.outDegree(i);
+}
+
+template<>
+inline degree_t DegreeDistribution<undirectedS>::degree(const CSRGraph& g,
+		const node_size_t i) const
+{
+	return g.undirectedDegree(i);
+}
+
+template<>
+inline degree_t DegreeDistribution<allS>::degree(const CSRGraph& g,
+		const node_size_t i) const
+{
+	return g.degree(i);
 }
 
 template<>
@@ -193,12 +220,13 @@ degree_t DegreeDistribution<allS>::countNeighbors(_NodeIterator& it,
 }
 
 template<typename directionS>
-DegreeDistribution<directionS>::DegreeDistribution(const Graph& g)
+template<class GraphType>
+DegreeDistribution<directionS>::DegreeDistribution(const GraphType& g)
 {
-	Graph::ConstNodeIteratorRange iters = g.nodes();
-	for (Graph::ConstNodeIterator& it = iters.first; it != iters.second; ++it)
+	typename GraphType::ConstNodeIteratorRange iters = g.nodes();
+	for (typename GraphType::ConstNodeIterator& it = iters.first; it != iters.second; ++it)
 	{
-		degree_t k = degree(it);
+		degree_t k = degree(*it);
 		while (k >= dist_.size())
 		{
 			dist_.push_back(0);
@@ -209,13 +237,14 @@ DegreeDistribution<directionS>::DegreeDistribution(const Graph& g)
 }
 
 template<typename directionS>
-DegreeDistribution<directionS>::DegreeDistribution(const Graph& g,
+template<class GraphType>
+DegreeDistribution<directionS>::DegreeDistribution(const GraphType& g,
 		const node_state_t s)
 {
-	Graph::ConstNodeStateIteratorRange iters = g.nodes(s);
-	for (Graph::ConstNodeStateIterator& it = iters.first; it != iters.second; ++it)
+	typename GraphType::ConstNodeStateIteratorRange iters = g.nodes(s);
+	for (typename GraphType::ConstNodeStateIterator& it = iters.first; it != iters.second; ++it)
 	{
-		degree_t k = degree(it);
+		degree_t k = degree(*it);
 		while (k >= dist_.size())
 		{
 			dist_.push_back(0);
@@ -242,6 +271,19 @@ DegreeDistribution<directionS>::DegreeDistribution(const Graph& g,
 	cur_ = dist_.begin();
 }
 
+template<typename directionS>
+DegreeDistribution<directionS>::DegreeDistribution(const CSRGraph& g)
+{
+	for (node_size_t i = 0; i < g.numberOfNodes(); ++i)
+	{
+		degree_t k = degree(g, i);
+		if (k >= dist_.size())
+			dist_.resize(k + 1, 0);
+		++dist_[k];
+	}
+	cur_ = dist_.begin();
+}
+
 template<typename directionS>
 DegreeDistribution<directionS>& DegreeDistribution<directionS>::operator>>(
 		node_size_t& n)
@@ -20,10 +20,14 @@ size_t edges(const Graph& net, const motifs::LinkMotif& l)
 	// to a LinkStateCalculator, so we have to resort to looping over
 	// all nodes
 	size_t count = 0;
+	const Graph::ConstNodeStateIteratorRange r = net.nodes(l.source());
+	const long N = r.second - r.first;
 	if (l.isDirected())
 	{
-		BOOST_FOREACH(const Node& n, net.nodes(l.source()))
+#pragma omp parallel for reduction(+: count) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& n1, n.outNeighbors())
 			{
 				if (net.nodeState(n1.id()) == l.target())
@@ -34,8 +38,10 @@ size_t edges(const Graph& net, const motifs::LinkMotif& l)
 	}
 	else
 	{
-		BOOST_FOREACH(const Node& n, net.nodes(l.source()))
+#pragma omp parallel for reduction(+: count) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& n1, n.undirectedNeighbors())
 			{
 				if (net.nodeState(n1.id()) == l.target())
@@ -48,61 +54,18 @@ size_t edges(const Graph& net, const motifs::LinkMotif& l)
 	}
 }
 
-size_t triples(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Node& n, net.nodes())
-	{
-		const degree_t d = n.degree();
-		if (d > 1)
-			t += d * (d - 1) - 2 * n.mutualDegree(); // do not count 2-loops as triples
-	}
-	return t / 2;
-}
-
-size_t outTriples(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Node& n, net.nodes())
-	{
-		const degree_t d = n.outDegree();
-		if (d > 1)
-			t += d * (d - 1); // FIXME will count multi-out-edges as triples for MultiNodes
-	}
-	return t / 2;
-}
-
-size_t inTriples(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Node& n, net.nodes())
-	{
-		const degree_t d = n.inDegree();
-		if (d > 1)
-			t += d * (d - 1); // FIXME will count multi-in-edges as triples for MultiNodes
-	}
-	return t / 2;
-}
-
-size_t inOutTriples(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Node& n, net.nodes())
-	{
-		const degree_t d_in = n.inDegree(), d_out = n.outDegree();
-		t += d_in * d_out - n.mutualDegree();
-	}
-	return t;
-}
-
 size_t triples_undirected(const Graph& net, const motifs::TripleMotif& t)
 {
 	assert(!t.isDirected());
 	size_t ret = 0;
 
 	// we cannot loop over links if we do not have access to the link state calculator
-	BOOST_FOREACH(const Node& n, net.nodes(t.center()))
+	const Graph::ConstNodeStateIteratorRange r = net.nodes(t.center());
+	const long N = r.second - r.first;
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+	for (long i = 0; i < N; ++i)
 	{
+		const Node& n = *(r.first + i);
 		BOOST_FOREACH(const Node& nb1, n.undirectedNeighbors())
 		{
 			if (net.nodeState(nb1.id()) != t.left())
@@ -129,8 +92,12 @@ size_t triples(const Graph& net, const motifs::TripleMotif& t)
 		return triples_undirected(net, t);
 
 	size_t ret = 0;
-	BOOST_FOREACH(const Node& n, net.nodes(t.center()))
+	const Graph::ConstNodeStateIteratorRange r = net.nodes(t.center());
+	const long N = r.second - r.first;
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+	for (long i = 0; i < N; ++i)
 	{
+		const Node& n = *(r.first + i);
 		switch (t.dir())
 		{
 		case motifs::TripleMotif::LCR: // one in-link to left, one out-link to right
@@ -208,11 +175,14 @@ size_t triples(const Graph& net, const motifs::TripleMotif& t)
 size_t triangles2(const Graph& net)
 {
 	size_t t = 0;
-	std::set<node_id_t> nbs;
 	// FIXME enumerating all nodes is slow in this case, can we do better?
-	BOOST_FOREACH(const Node& n, net.nodes())
+	const Graph::ConstDenseNodeIteratorRange r = net.denseNodes();
+	const long N = r.second - r.first;
+#pragma omp parallel for reduction(+: t) schedule(dynamic, 64)
+	for (long k = 0; k < N; ++k)
 	{
-		nbs.clear();
+		const Node& n = *(r.first + k);
+		std::set<node_id_t> nbs;
 		BOOST_FOREACH(const Node& onb, n.outNeighbors())
 		{
 			nbs.insert(onb.id());
@@ -240,75 +210,18 @@ size_t triangles2(const Graph& net)
 	return t / 3;
 }
 
-size_t triangles(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Edge& e, net.edges())
-	{
-		BOOST_FOREACH(const Node& nb, e.source()->outNeighbors())
-		{
-			if (nb.isAdjacentTo(e.target()))
-				++t;
-		}
-		BOOST_FOREACH(const Node& nb, e.source()->inNeighbors())
-		{
-			if (nb.isAdjacentTo(e.target()))
-				++t;
-		}
-		BOOST_FOREACH(const Node& nb, e.source()->undirectedNeighbors())
-		{
-			if (nb.isAdjacentTo(e.target()))
-				++t;
-		}
-	}
-	return t / 3;
-}
-
-size_t quadStars(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Node& n, net.nodes())
-	{
-		const degree_t d = n.degree(), m = n.mutualDegree();
-		if (d > 2)
-			t += 2 * d - 3 * d * d + d * d * d + 8 * m - 6 * d * m + 6 * m * m
-					- 2 * m * m * m;
-	}
-	return t / 6;
-}
-
-size_t outQuadStars(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Node& n, net.nodes())
-	{
-		const degree_t d = n.outDegree();
-		if (d > 2)
-			t += d * (d - 1) * (d - 2);
-	}
-	return t / 6;
-}
-
-size_t inQuadStars(const Graph& net)
-{
-	size_t t = 0;
-	BOOST_FOREACH(const Node& n, net.nodes())
-	{
-		const degree_t d = n.inDegree();
-		if (d > 2)
-			t += d * (d - 1) * (d - 2);
-	}
-	return t / 6;
-}
-
 size_t quad_stars_undirected(const Graph& net, const motifs::QuadStarMotif& q)
 {
 	assert(!q.isDirected());
 	size_t ret = 0;
 
 	// we cannot loop over links if we do not have access to the link state calculator
-	BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+	const Graph::ConstNodeStateIteratorRange r = net.nodes(q.center());
+	const long N = r.second - r.first;
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+	for (long i = 0; i < N; ++i)
 	{
+		const Node& n = *(r.first + i);
 		BOOST_FOREACH(const Node& nb1, n.undirectedNeighbors())
 		{
 			if (net.nodeState(nb1.id()) != q.a())
@@ -342,11 +255,15 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 	if (!q.isDirected())
 		return quad_stars_undirected(net, q);
 	size_t ret = 0;
+	const Graph::ConstNodeStateIteratorRange r = net.nodes(q.center());
+	const long N = r.second - r.first;
 	switch (q.dir())
 	{
 	case motifs::QuadStarMotif::ALL_OUT:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			size_t a_neighbors = 0, b_neighbors = 0, c_neighbors = 0;
 			BOOST_FOREACH(const Node& nb, n.outNeighbors())
 			{
@@ -376,8 +293,10 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		}
 		break;
 	case motifs::QuadStarMotif::ALL_IN:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			size_t a_neighbors = 0, b_neighbors = 0, c_neighbors = 0;
 			BOOST_FOREACH(const Node& nb, n.inNeighbors())
 			{
@@ -407,8 +326,10 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		}
 		break;
 	case motifs::QuadStarMotif::A_OUT:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& onb, n.outNeighbors())
 			{
 				if (net.nodeState(onb.id()) != q.a())
@@ -433,8 +354,10 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		}
 		break;
 	case motifs::QuadStarMotif::B_OUT:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& onb, n.outNeighbors())
 			{
 				if (net.nodeState(onb.id()) != q.b())
@@ -459,8 +382,10 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		}
 		break;
 	case motifs::QuadStarMotif::C_OUT:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& onb, n.outNeighbors())
 			{
 				if (net.nodeState(onb.id()) != q.c())
@@ -485,8 +410,10 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		}
 		break;
 	case motifs::QuadStarMotif::AB_OUT:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& onb1, n.outNeighbors())
 			{
 				if (net.nodeState(onb1.id()) != q.a())
@@ -511,8 +438,10 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		}
 		break;
 	case motifs::QuadStarMotif::AC_OUT:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& onb1, n.outNeighbors())
 			{
 				if (net.nodeState(onb1.id()) != q.a())
@@ -537,8 +466,10 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		}
 		break;
 	case motifs::QuadStarMotif::BC_OUT:
-		BOOST_FOREACH(const Node& n, net.nodes(q.center()))
+#pragma omp parallel for reduction(+: ret) schedule(dynamic, 64)
+		for (long i = 0; i < N; ++i)
 		{
+			const Node& n = *(r.first + i);
 			BOOST_FOREACH(const Node& onb1, n.outNeighbors())
 			{
 				if (net.nodeState(onb1.id()) != q.b())
@@ -573,5 +504,136 @@ size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q)
 		return ret;
 }
 
+size_t edges(const CSRGraph& net, const motifs::LinkMotif& l)
+{
+	const CSRGraph::Direction d = l.isDirected() ? CSRGraph::OUT
+			: CSRGraph::UNDIRECTED;
+	size_t count = 0;
+#pragma omp parallel for reduction(+: count) schedule(dynamic, 64)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+	{
+		if (net.nodeState(i) != l.source())
+			continue;
+		CSRGraph::index_range nbs = net.neighbors(i, d);
+		for (; nbs.first != nbs.second; ++nbs.first)
+		{
+			if (net.nodeState(*nbs.first) == l.target())
+				++count;
+		}
+	}
+	if (!l.isDirected() && l.isSymmetric())
+		count /= 2;
+	return count;
+}
+
+size_t triples(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+	{
+		const degree_t d = net.degree(i);
+		if (d > 1)
+			t += d * (d - 1) - 2 * net.mutualDegree(i); // do not count 2-loops as triples
+	}
+	return t / 2;
+}
+
+size_t outTriples(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+	{
+		const degree_t d = net.outDegree(i);
+		if (d > 1)
+			t += d * (d - 1);
+	}
+	return t / 2;
+}
+
+size_t inTriples(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+	{
+		const degree_t d = net.inDegree(i);
+		if (d > 1)
+			t += d * (d - 1);
+	}
+	return t / 2;
+}
+
+size_t inOutTriples(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+		t += net.inDegree(i) * net.outDegree(i) - net.mutualDegree(i);
+	return t;
+}
+
+size_t triangles(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t) schedule(dynamic, 64)
+	for (edge_size_t j = 0; j < net.numberOfEdges(); ++j)
+	{
+		const node_size_t s = net.source(j), tg = net.target(j);
+		for (int d = CSRGraph::OUT; d <= CSRGraph::UNDIRECTED; ++d)
+		{
+			CSRGraph::index_range nbs = net.neighbors(s,
+					static_cast<CSRGraph::Direction> (d));
+			for (; nbs.first != nbs.second; ++nbs.first)
+			{
+				if (net.adjacent(*nbs.first, tg))
+					++t;
+			}
+		}
+	}
+	return t / 3;
+}
+
+size_t quadStars(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+	{
+		const degree_t d = net.degree(i), m = net.mutualDegree(i);
+		if (d > 2)
+			t += 2 * d - 3 * d * d + d * d * d + 8 * m - 6 * d * m + 6 * m * m
+					- 2 * m * m * m;
+	}
+	return t / 6;
+}
+
+size_t outQuadStars(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+	{
+		const degree_t d = net.outDegree(i);
+		if (d > 2)
+			t += d * (d - 1) * (d - 2);
+	}
+	return t / 6;
+}
+
+size_t inQuadStars(const CSRGraph& net)
+{
+	size_t t = 0;
+#pragma omp parallel for reduction(+: t)
+	for (node_size_t i = 0; i < net.numberOfNodes(); ++i)
+	{
+		const degree_t d = net.inDegree(i);
+		if (d > 2)
+			t += d * (d - 1) * (d - 2);
+	}
+	return t / 6;
+}
+
 }
 }
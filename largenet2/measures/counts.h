@@ -8,10 +8,13 @@
 #define COUNTS_H_
 
 #include <largenet2/base/Graph.h>
+#include <largenet2/base/CSRGraph.h>
+#include <largenet2/base/node_traits.h>
 #include <largenet2/motifs/NodeMotif.h>
 #include <largenet2/motifs/LinkMotif.h>
 #include <largenet2/motifs/TripleMotif.h>
 #include <largenet2/motifs/QuadStarMotif.h>
+#include <boost/foreach.hpp>
 #include <cstddef>
 
 namespace largenet {
@@ -66,10 +69,14 @@ size_t edges(const Graph& net, const motifs::LinkMotif& l);
  * @param net Graph object
  * @return number of triples in @p net
  */
-size_t triples(const Graph& net);
-size_t inTriples(const Graph& net);
-size_t outTriples(const Graph& net);
-size_t inOutTriples(const Graph& net);
+template<class GraphType>
+size_t triples(const GraphType& net);
+template<class GraphType>
+size_t inTriples(const GraphType& net);
+template<class GraphType>
+size_t outTriples(const GraphType& net);
+template<class GraphType>
+size_t inOutTriples(const GraphType& net);
 size_t triples(const Graph& net, const motifs::TripleMotif& t);
 
 /**
@@ -77,13 +84,179 @@ size_t triples(const Graph& net, const motifs::TripleMotif& t);
  * @param net Graph object
  * @return number of triangles in @p net
  */
-size_t triangles(const Graph& net);
+template<class GraphType>
+size_t triangles(const GraphType& net);
 
-size_t quadStars(const Graph& net);
-size_t outQuadStars(const Graph& net);
-size_t inQuadStars(const Graph& net);
+template<class GraphType>
+size_t quadStars(const GraphType& net);
+template<class GraphType>
+size_t outQuadStars(const GraphType& net);
+template<class GraphType>
+size_t inQuadStars(const GraphType& net);
 size_t quadStars(const Graph& net, const motifs::QuadStarMotif& q);
 
+/**
+ * @name Counts on CSRGraph snapshots
+ *
+ * These overloads compute the same quantities as their Graph counterparts
+ * above, but operate on an immutable CSRGraph snapshot.
+ */
+///@{
+inline size_t nodes(const CSRGraph& net)
+{
+	return net.numberOfNodes();
+}
+inline size_t edges(const CSRGraph& net)
+{
+	return net.numberOfEdges();
+}
+size_t edges(const CSRGraph& net, const motifs::LinkMotif& l);
+size_t triples(const CSRGraph& net);
+size_t inTriples(const CSRGraph& net);
+size_t outTriples(const CSRGraph& net);
+size_t inOutTriples(const CSRGraph& net);
+size_t triangles(const CSRGraph& net);
+size_t quadStars(const CSRGraph& net);
+size_t outQuadStars(const CSRGraph& net);
+size_t inQuadStars(const CSRGraph& net);
+///@}
+
+/*
+ * The counts on Graph objects that only need node degrees and adjacency are
+ * templated on the graph type. For a BasicGraph, node queries are dispatched
+ * statically via node_traits.
+ */
+
+template<class GraphType>
+size_t triples(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	typedef node_traits<node_type> traits;
+	size_t t = 0;
+	BOOST_FOREACH(const node_type& n, net.nodes())
+	{
+		const degree_t d = traits::degree(n);
+		if (d > 1)
+			t += d * (d - 1) - 2 * traits::mutualDegree(n); // do not count 2-loops as triples
+	}
+	return t / 2;
+}
+
+template<class GraphType>
+size_t outTriples(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	size_t t = 0;
+	BOOST_FOREACH(const node_type& n, net.nodes())
+	{
+		const degree_t d = node_traits<node_type>::outDegree(n);
+		if (d > 1)
+			t += d * (d - 1); // FIXME will count multi-out-edges as triples for MultiNodes
+	}
+	return t / 2;
+}
+
+template<class GraphType>
+size_t inTriples(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	size_t t = 0;
+	BOOST_FOREACH(const node_type& n, net.nodes())
+	{
+		const degree_t d = node_traits<node_type>::inDegree(n);
+		if (d > 1)
+			t += d * (d - 1); // FIXME will count multi-in-edges as triples for MultiNodes
+	}
+	return t / 2;
+}
+
+template<class GraphType>
+size_t inOutTriples(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	typedef node_traits<node_type> traits;
+	size_t t = 0;
+	BOOST_FOREACH(const node_type& n, net.nodes())
+	{
+		const degree_t d_in = traits::inDegree(n), d_out = traits::outDegree(n);
+		t += d_in * d_out - traits::mutualDegree(n);
+	}
+	return t;
+}
+
+template<class GraphType>
+size_t triangles(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	typedef typename GraphType::edge_type edge_type;
+	typedef node_traits<node_type> traits;
+	size_t t = 0;
+	BOOST_FOREACH(const edge_type& e, net.edges())
+	{
+		const Node* target = e.target();
+		BOOST_FOREACH(const Node& nb, e.source()->outNeighbors())
+		{
+			if (traits::isAdjacentTo(static_cast<const node_type&> (nb), target))
+				++t;
+		}
+		BOOST_FOREACH(const Node& nb, e.source()->inNeighbors())
+		{
+			if (traits::isAdjacentTo(static_cast<const node_type&> (nb), target))
+				++t;
+		}
+		BOOST_FOREACH(const Node& nb, e.source()->undirectedNeighbors())
+		{
+			if (traits::isAdjacentTo(static_cast<const node_type&> (nb), target))
+				++t;
+		}
+	}
+	return t / 3;
+}
+
+template<class GraphType>
+size_t quadStars(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	typedef node_traits<node_type> traits;
+	size_t t = 0;
+	BOOST_FOREACH(const node_type& n, net.nodes())
+	{
+		const degree_t d = traits::degree(n), m = traits::mutualDegree(n);
+		if (d > 2)
+			t += 2 * d - 3 * d * d + d * d * d + 8 * m - 6 * d * m + 6 * m * m
+					- 2 * m * m * m;
+	}
+	return t / 6;
+}
+
+template<class GraphType>
+size_t outQuadStars(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	size_t t = 0;
+	BOOST_FOREACH(const node_type& n, net.nodes())
+	{
+		const degree_t d = node_traits<node_type>::outDegree(n);
+		if (d > 2)
+			t += d * (d - 1) * (d - 2);
+	}
+	return t / 6;
+}
+
+template<class GraphType>
+size_t inQuadStars(const GraphType& net)
+{
+	typedef typename GraphType::node_type node_type;
+	size_t t = 0;
+	BOOST_FOREACH(const node_type& n, net.nodes())
+	{
+		const degree_t d = node_traits<node_type>::inDegree(n);
+		if (d > 2)
+			t += d * (d - 1) * (d - 2);
+	}
+	return t / 6;
+}
+
 }
 }
 
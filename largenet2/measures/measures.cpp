@@ -13,34 +13,13 @@ namespace largenet
 namespace measures
 {
 
-degree_t maxInDegree(const Graph& g)
-{
-	degree_t max = 0;
-	BOOST_FOREACH(const Node& n, g.nodes())
-	{
-		if (max < n.inDegree())
-			max = n.inDegree();
-	}
-	return max;
-}
-
-degree_t minInDegree(const Graph& g)
-{
-	degree_t min = g.numberOfEdges();
-	BOOST_FOREACH(const Node& n, g.nodes())
-	{
-		if (min > n.inDegree())
-			min = n.inDegree();
-	}
-	return min;
-}
-
-degree_range_t inDegreeRange(const Graph& g)
+degree_range_t inDegreeRange(const CSRGraph& g)
 {
 	degree_t min = g.numberOfEdges(), max = 0;
-	BOOST_FOREACH(const Node& n, g.nodes())
+#pragma omp parallel for reduction(min: min) reduction(max: max)
+	for (node_size_t i = 0; i < g.numberOfNodes(); ++i)
 	{
-		degree_t k = n.inDegree();
+		degree_t k = g.inDegree(i);
 		if (min > k)
 			min = k;
 		if (max < k)
@@ -49,34 +28,23 @@ degree_range_t inDegreeRange(const Graph& g)
 	return std::make_pair(min, max);
 }
 
-degree_t maxOutDegree(const Graph& g)
+degree_t maxInDegree(const CSRGraph& g)
 {
-	degree_t max = 0;
-	BOOST_FOREACH(const Node& n, g.nodes())
-	{
-		if (max < n.outDegree())
-			max = n.outDegree();
-	}
-	return max;
+	return inDegreeRange(g).second;
 }
 
-degree_t minOutDegree(const Graph& g)
+degree_t minInDegree(const CSRGraph& g)
 {
-	degree_t min = g.numberOfEdges();
-	BOOST_FOREACH(const Node& n, g.nodes())
-	{
-		if (min > n.outDegree())
-			min = n.outDegree();
-	}
-	return min;
+	return inDegreeRange(g).first;
 }
 
-degree_range_t outDegreeRange(const Graph& g)
+degree_range_t outDegreeRange(const CSRGraph& g)
 {
 	degree_t min = g.numberOfEdges(), max = 0;
-	BOOST_FOREACH(const Node& n, g.nodes())
+#pragma omp parallel for reduction(min: min) reduction(max: max)
+	for (node_size_t i = 0; i < g.numberOfNodes(); ++i)
 	{
-		degree_t k = n.outDegree();
+		degree_t k = g.outDegree(i);
 		if (min > k)
 			min = k;
 		if (max < k)
@@ -85,65 +53,58 @@ degree_range_t outDegreeRange(const Graph& g)
 	return std::make_pair(min, max);
 }
 
-/// @cond IGNORE
-double std_dev_in(const Graph& g)
+degree_t maxOutDegree(const CSRGraph& g)
 {
-	double s = 0;
-	double mean = g.numberOfEdges() / g.numberOfNodes();
-	BOOST_FOREACH(const Node& n, g.nodes())
-	{
-		degree_t d = n.inDegree();
-		s += (d - mean) * (d - mean);
-	}
-	return sqrt(s);
+	return outDegreeRange(g).second;
 }
 
-double std_dev_out(const Graph& g)
+degree_t minOutDegree(const CSRGraph& g)
 {
-	double s = 0;
-	double mean = g.numberOfEdges() / g.numberOfNodes();
-	BOOST_FOREACH(const Node& n, g.nodes())
-	{
-		degree_t d = n.outDegree();
-		s += (d - mean) * (d - mean);
-	}
-	return sqrt(s);
+	return outDegreeRange(g).first;
 }
-/// @endcond
 
-double inOutDegreeCorrelation(const Graph& g)
+double inOutDegreeCorrelation(const CSRGraph& g)
 {
-	double cov = 0;
+	double cov = 0, s_in = 0, s_out = 0;
 	double mean = g.numberOfEdges() / g.numberOfNodes();
-	BOOST_FOREACH(const Node& n, g.nodes())
+#pragma omp parallel for reduction(+: cov, s_in, s_out)
+	for (node_size_t i = 0; i < g.numberOfNodes(); ++i)
 	{
-		degree_t din = n.inDegree(), dout = n.outDegree();
+		degree_t din = g.inDegree(i), dout = g.outDegree(i);
 		cov += (din - mean) * (dout - mean);
+		s_in += (din - mean) * (din - mean);
+		s_out += (dout - mean) * (dout - mean);
 	}
-	return cov / std_dev_out(g) / std_dev_in(g);
+	return cov / sqrt(s_out) / sqrt(s_in);
 }
 
-NeighborDegreeCorrelations neighborDegreeCorrelations(const Graph& g)
+NeighborDegreeCorrelations neighborDegreeCorrelations(const CSRGraph& g)
 {
+	const edge_size_t M = g.numberOfEdges();
 	double s_in_mean = 0, s_out_mean = 0, t_in_mean = 0, t_out_mean = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
+#pragma omp parallel for reduction(+: s_in_mean, s_out_mean, t_in_mean, t_out_mean)
+	for (edge_size_t j = 0; j < M; ++j)
 	{
-		s_in_mean += e.source()->inDegree();
-		s_out_mean += e.source()->outDegree();
-		t_in_mean += e.target()->inDegree();
-		t_out_mean += e.target()->outDegree();
+		const node_size_t s = g.source(j), t = g.target(j);
+		s_in_mean += g.inDegree(s);
+		s_out_mean += g.outDegree(s);
+		t_in_mean += g.inDegree(t);
+		t_out_mean += g.outDegree(t);
 	}
-	s_in_mean /= g.numberOfEdges();
-	s_out_mean /= g.numberOfEdges();
-	t_in_mean /= g.numberOfEdges();
-	t_out_mean /= g.numberOfEdges();
+	s_in_mean /= M;
+	s_out_mean /= M;
+	t_in_mean /= M;
+	t_out_mean /= M;
 
 	double cov_ii = 0, cov_io = 0, cov_oi = 0, cov_oo = 0;
 	double sd_s_in = 0, sd_s_out = 0, sd_t_in = 0, sd_t_out = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
+#pragma omp parallel for reduction(+: cov_ii, cov_io, cov_oi, cov_oo, \
+		sd_s_in, sd_s_out, sd_t_in, sd_t_out)
+	for (edge_size_t j = 0; j < M; ++j)
 	{
-		degree_t s_in = e.source()->inDegree(), s_out = e.source()->outDegree(),
-				 t_in = e.target()->inDegree(), t_out = e.target()->outDegree();
+		const node_size_t s = g.source(j), t = g.target(j);
+		degree_t s_in = g.inDegree(s), s_out = g.outDegree(s),
+				 t_in = g.inDegree(t), t_out = g.outDegree(t);
 		cov_ii += (s_in - s_in_mean) * (t_in - t_in_mean);
 		cov_io += (s_in - s_in_mean) * (t_out - t_out_mean);
 		cov_oi += (s_out - s_out_mean) * (t_in - t_in_mean);
@@ -165,96 +126,24 @@ NeighborDegreeCorrelations neighborDegreeCorrelations(const Graph& g)
 	return ret;
 }
 
-double neighborDegreeCorrelationInIn(const Graph& g)
+double neighborDegreeCorrelationInIn(const CSRGraph& g)
 {
-	double s_in_mean = 0, t_in_mean = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		s_in_mean += e.source()->inDegree();
-		t_in_mean += e.target()->inDegree();
-	}
-	s_in_mean /= g.numberOfEdges();
-	t_in_mean /= g.numberOfEdges();
-
-	double cov = 0;
-	double sd_s_in = 0, sd_t_in = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		degree_t s_in = e.source()->inDegree(), t_in = e.target()->inDegree();
-		cov += (s_in - s_in_mean) * (t_in - t_in_mean);
-		sd_s_in += (s_in - s_in_mean) * (s_in - s_in_mean);
-		sd_t_in += (t_in - t_in_mean) * (t_in - t_in_mean);
-	}
-	return cov / (sqrt(sd_s_in) * sqrt(sd_t_in));
+	return neighborDegreeCorrelations(g).r_ii;
 }
 
-double neighborDegreeCorrelationInOut(const Graph& g)
+double neighborDegreeCorrelationInOut(const CSRGraph& g)
 {
-	double s_in_mean = 0, t_out_mean = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		s_in_mean += e.source()->inDegree();
-		t_out_mean += e.target()->outDegree();
-	}
-	s_in_mean /= g.numberOfEdges();
-	t_out_mean /= g.numberOfEdges();
-
-	double cov = 0;
-	double sd_s_in = 0, sd_t_out = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		degree_t s_in = e.source()->inDegree(), t_out = e.target()->outDegree();
-		cov += (s_in - s_in_mean) * (t_out - t_out_mean);
-		sd_s_in += (s_in - s_in_mean) * (s_in - s_in_mean);
-		sd_t_out += (t_out - t_out_mean) * (t_out - t_out_mean);
-	}
-	return cov / (sqrt(sd_s_in) * sqrt(sd_t_out));
+	return neighborDegreeCorrelations(g).r_io;
 }
 
-double neighborDegreeCorrelationOutOut(const Graph& g)
+double neighborDegreeCorrelationOutOut(const CSRGraph& g)
 {
-	double s_out_mean = 0, t_out_mean = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		s_out_mean += e.source()->outDegree();
-		t_out_mean += e.target()->outDegree();
-	}
-	s_out_mean /= g.numberOfEdges();
-	t_out_mean /= g.numberOfEdges();
-
-	double cov = 0;
-	double sd_s_out = 0, sd_t_out = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		degree_t s_out = e.source()->outDegree(), t_out = e.target()->outDegree();
-		cov += (s_out - s_out_mean) * (t_out - t_out_mean);
-		sd_s_out += (s_out - s_out_mean) * (s_out - s_out_mean);
-		sd_t_out += (t_out - t_out_mean) * (t_out - t_out_mean);
-	}
-	return cov / (sqrt(sd_s_out) * sqrt(sd_t_out));
+	return neighborDegreeCorrelations(g).r_oo;
 }
 
-double neighborDegreeCorrelationOutIn(const Graph& g)
+double neighborDegreeCorrelationOutIn(const CSRGraph& g)
 {
-	double s_out_mean = 0, t_in_mean = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		s_out_mean += e.source()->outDegree();
-		t_in_mean += e.target()->inDegree();
-	}
-	s_out_mean /= g.numberOfEdges();
-	t_in_mean /= g.numberOfEdges();
-
-	double cov = 0;
-	double sd_s_out = 0, sd_t_in = 0;
-	BOOST_FOREACH(const Edge& e, g.edges())
-	{
-		degree_t s_out = e.source()->outDegree(), t_in = e.target()->inDegree();
-		cov += (s_out - s_out_mean) * (t_in - t_in_mean);
-		sd_s_out += (s_out - s_out_mean) * (s_out- s_out_mean);
-		sd_t_in += (t_in - t_in_mean) * (t_in - t_in_mean);
-	}
-	return cov / (sqrt(sd_s_out) * sqrt(sd_t_in));
+	return neighborDegreeCorrelations(g).r_oi;
 }
 
 }
@@ -8,6 +8,10 @@
 #define MEASURES_H_
 
 #include <largenet2/base/Graph.h>
+#include <largenet2/base/CSRGraph.h>
+#include <largenet2/base/node_traits.h>
+#include <boost/foreach.hpp>
+#include <cmath>
 #include <utility>
 
 namespace largenet
@@ -20,30 +24,43 @@ namespace measures
 /// degree range type (for (min, max) degree pair)
 typedef std::pair<degree_t, degree_t> degree_range_t;
 
+/*
+ * The measures on Graph objects are templated on the graph type. For a
+ * BasicGraph, node queries are dispatched statically via node_traits.
+ * They iterate over the dense node and edge ranges, which are split among
+ * threads if the library is built with OpenMP (see parallel.h).
+ */
+
 /**
  * Get maximum in-degree in graph @p g
  */
-degree_t maxInDegree(const Graph& g);
+template<class GraphType>
+degree_t maxInDegree(const GraphType& g);
 /**
  * Get minimum in-degree in graph @p g
  */
-degree_t minInDegree(const Graph& g);
+template<class GraphType>
+degree_t minInDegree(const GraphType& g);
 /**
  * Get in-degree range (min, max) in graph @p g
  */
-degree_range_t inDegreeRange(const Graph& g);
+template<class GraphType>
+degree_range_t inDegreeRange(const GraphType& g);
 /**
  * Get maximum out-degree in graph @p g
  */
-degree_t maxOutDegree(const Graph& g);
+template<class GraphType>
+degree_t maxOutDegree(const GraphType& g);
 /**
  * Get minimum out-degree in graph @p g
  */
-degree_t minOutDegree(const Graph& g);
+template<class GraphType>
+degree_t minOutDegree(const GraphType& g);
 /**
  * Get out-degree range (min, max) in graph @p g
  */
-degree_range_t outDegreeRange(const Graph& g);
+template<class GraphType>
+degree_range_t outDegreeRange(const GraphType& g);
 /**
  * Get mean degree in graph @p g
  */
@@ -57,7 +74,8 @@ inline double meanDegree(const Graph& g)
  * @param g Graph to compute correlation coefficient for.
  * @return Correlation coefficient \f$r\in[-1,1]\f$ of linear dependence between the nodes' in- and out-degrees.
  */
-double inOutDegreeCorrelation(const Graph& g);
+template<class GraphType>
+double inOutDegreeCorrelation(const GraphType& g);
 
 /**
  * Combined nearest-neighbor degree correlation coefficients.
@@ -75,32 +93,375 @@ struct NeighborDegreeCorrelations
  * @param g Graph object
  * @return correlation coefficients
  */
-NeighborDegreeCorrelations neighborDegreeCorrelations(const Graph& g);
+template<class GraphType>
+NeighborDegreeCorrelations neighborDegreeCorrelations(const GraphType& g);
 
 /**
  * Two-point correlation function: Pearson's correlation coefficient for in-degrees of adjacent nodes
  * @param g Graph
  * @return correlation coefficient between in-degrees of adjacent nodes
  */
-double neighborDegreeCorrelationInIn(const Graph& g);
+template<class GraphType>
+double neighborDegreeCorrelationInIn(const GraphType& g);
 /**
  * Two-point correlation function: Pearson's correlation coefficient for in- and out-degrees of adjacent nodes
  * @param g Graph
  * @return correlation coefficient between the nodes' in-degrees and out-degrees of outgoing neighbors.
  */
-double neighborDegreeCorrelationInOut(const Graph& g);
+template<class GraphType>
+double neighborDegreeCorrelationInOut(const GraphType& g);
 /**
  * Two-point correlation function: Pearson's correlation coefficient for out-degrees of adjacent nodes
  * @param g Graph
  * @return correlation coefficient between out-degrees of adjacent nodes
  */
-double neighborDegreeCorrelationOutOut(const Graph& g);
+template<class GraphType>
+double neighborDegreeCorrelationOutOut(const GraphType& g);
 /**
  * Two-point correlation function: Pearson's correlation coefficient for in- and out-degrees of adjacent nodes
  * @param g Graph
  * @return correlation coefficient between the nodes' out-degrees and in-degrees of outgoing neighbors.
  */
-double neighborDegreeCorrelationOutIn(const Graph& g);
+template<class GraphType>
+double neighborDegreeCorrelationOutIn(const GraphType& g);
+
+/**
+ * @name Measures on CSRGraph snapshots
+ *
+ * These overloads compute the same quantities as their Graph counterparts
+ * above, but operate on an immutable CSRGraph snapshot.
+ */
+///@{
+degree_t maxInDegree(const CSRGraph& g);
+degree_t minInDegree(const CSRGraph& g);
+degree_range_t inDegreeRange(const CSRGraph& g);
+degree_t maxOutDegree(const CSRGraph& g);
+degree_t minOutDegree(const CSRGraph& g);
+degree_range_t outDegreeRange(const CSRGraph& g);
+inline double meanDegree(const CSRGraph& g)
+{
+	return static_cast<double> (g.numberOfEdges()) / g.numberOfNodes();
+}
+double inOutDegreeCorrelation(const CSRGraph& g);
+NeighborDegreeCorrelations neighborDegreeCorrelations(const CSRGraph& g);
+double neighborDegreeCorrelationInIn(const CSRGraph& g);
+double neighborDegreeCorrelationInOut(const CSRGraph& g);
+double neighborDegreeCorrelationOutOut(const CSRGraph& g);
+double neighborDegreeCorrelationOutIn(const CSRGraph& g);
+///@}
+
+template<class GraphType>
+degree_t maxInDegree(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	degree_t max = 0;
+#pragma omp parallel for reduction(max: max)
+	for (long i = 0; i < N; ++i)
+	{
+		const degree_t k = node_traits<node_type>::inDegree(*(r.first + i));
+		if (max < k)
+			max = k;
+	}
+	return max;
+}
+
+template<class GraphType>
+degree_t minInDegree(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	degree_t min = g.numberOfEdges();
+#pragma omp parallel for reduction(min: min)
+	for (long i = 0; i < N; ++i)
+	{
+		const degree_t k = node_traits<node_type>::inDegree(*(r.first + i));
+		if (min > k)
+			min = k;
+	}
+	return min;
+}
+
+template<class GraphType>
+degree_range_t inDegreeRange(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	degree_t min = g.numberOfEdges(), max = 0;
+#pragma omp parallel for reduction(min: min) reduction(max: max)
+	for (long i = 0; i < N; ++i)
+	{
+		degree_t k = node_traits<node_type>::inDegree(*(r.first + i));
+		if (min > k)
+			min = k;
+		if (max < k)
+			max = k;
+	}
+	return std::make_pair(min, max);
+}
+
+template<class GraphType>
+degree_t maxOutDegree(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	degree_t max = 0;
+#pragma omp parallel for reduction(max: max)
+	for (long i = 0; i < N; ++i)
+	{
+		const degree_t k = node_traits<node_type>::outDegree(*(r.first + i));
+		if (max < k)
+			max = k;
+	}
+	return max;
+}
+
+template<class GraphType>
+degree_t minOutDegree(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	degree_t min = g.numberOfEdges();
+#pragma omp parallel for reduction(min: min)
+	for (long i = 0; i < N; ++i)
+	{
+		const degree_t k = node_traits<node_type>::outDegree(*(r.first + i));
+		if (min > k)
+			min = k;
+	}
+	return min;
+}
+
+template<class GraphType>
+degree_range_t outDegreeRange(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	degree_t min = g.numberOfEdges(), max = 0;
+#pragma omp parallel for reduction(min: min) reduction(max: max)
+	for (long i = 0; i < N; ++i)
+	{
+		degree_t k = node_traits<node_type>::outDegree(*(r.first + i));
+		if (min > k)
+			min = k;
+		if (max < k)
+			max = k;
+	}
+	return std::make_pair(min, max);
+}
+
+/// @cond IGNORE
+namespace detail
+{
+template<class GraphType>
+double std_dev_in(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	double s = 0;
+	double mean = g.numberOfEdges() / g.numberOfNodes();
+#pragma omp parallel for reduction(+: s)
+	for (long i = 0; i < N; ++i)
+	{
+		degree_t d = node_traits<node_type>::inDegree(*(r.first + i));
+		s += (d - mean) * (d - mean);
+	}
+	return std::sqrt(s);
+}
+
+template<class GraphType>
+double std_dev_out(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	double s = 0;
+	double mean = g.numberOfEdges() / g.numberOfNodes();
+#pragma omp parallel for reduction(+: s)
+	for (long i = 0; i < N; ++i)
+	{
+		degree_t d = node_traits<node_type>::outDegree(*(r.first + i));
+		s += (d - mean) * (d - mean);
+	}
+	return std::sqrt(s);
+}
+
+/// Degree lookups at both ends of an edge
+template<class GraphType>
+struct edge_degrees
+{
+	typedef typename GraphType::node_type node_type;
+	typedef typename GraphType::edge_type edge_type;
+	typedef node_traits<node_type> traits;
+
+	static degree_t sourceIn(const edge_type& e)
+	{
+		return traits::inDegree(static_cast<const node_type&> (*e.source()));
+	}
+	static degree_t sourceOut(const edge_type& e)
+	{
+		return traits::outDegree(static_cast<const node_type&> (*e.source()));
+	}
+	static degree_t targetIn(const edge_type& e)
+	{
+		return traits::inDegree(static_cast<const node_type&> (*e.target()));
+	}
+	static degree_t targetOut(const edge_type& e)
+	{
+		return traits::outDegree(static_cast<const node_type&> (*e.target()));
+	}
+};
+}
+/// @endcond
+
+template<class GraphType>
+double inOutDegreeCorrelation(const GraphType& g)
+{
+	typedef typename GraphType::node_type node_type;
+	const typename GraphType::ConstDenseNodeIteratorRange r = g.denseNodes();
+	const long N = r.second - r.first;
+	double cov = 0;
+	double mean = g.numberOfEdges() / g.numberOfNodes();
+#pragma omp parallel for reduction(+: cov)
+	for (long i = 0; i < N; ++i)
+	{
+		const node_type& n = *(r.first + i);
+		degree_t din = node_traits<node_type>::inDegree(n),
+				dout = node_traits<node_type>::outDegree(n);
+		cov += (din - mean) * (dout - mean);
+	}
+	return cov / detail::std_dev_out(g) / detail::std_dev_in(g);
+}
+
+template<class GraphType>
+NeighborDegreeCorrelations neighborDegreeCorrelations(const GraphType& g)
+{
+	typedef typename GraphType::edge_type edge_type;
+	typedef detail::edge_degrees<GraphType> deg;
+	const typename GraphType::ConstDenseEdgeIteratorRange r = g.denseEdges();
+	const long M = r.second - r.first;
+	double s_in_mean = 0, s_out_mean = 0, t_in_mean = 0, t_out_mean = 0;
+#pragma omp parallel for reduction(+: s_in_mean, s_out_mean, t_in_mean, t_out_mean)
+	for (long j = 0; j < M; ++j)
+	{
+		const edge_type& e = *(r.first + j);
+		s_in_mean += deg::sourceIn(e);
+		s_out_mean += deg::sourceOut(e);
+		t_in_mean += deg::targetIn(e);
+		t_out_mean += deg::targetOut(e);
+	}
+	s_in_mean /= g.numberOfEdges();
+	s_out_mean /= g.numberOfEdges();
+	t_in_mean /= g.numberOfEdges();
+	t_out_mean /= g.numberOfEdges();
+
+	double cov_ii = 0, cov_io = 0, cov_oi = 0, cov_oo = 0;
+	double sd_s_in = 0, sd_s_out = 0, sd_t_in = 0, sd_t_out = 0;
+#pragma omp parallel for reduction(+: cov_ii, cov_io, cov_oi, cov_oo, \
+		sd_s_in, sd_s_out, sd_t_in, sd_t_out)
+	for (long j = 0; j < M; ++j)
+	{
+		const edge_type& e = *(r.first + j);
+		degree_t s_in = deg::sourceIn(e), s_out = deg::sourceOut(e),
+				 t_in = deg::targetIn(e), t_out = deg::targetOut(e);
+		cov_ii += (s_in - s_in_mean) * (t_in - t_in_mean);
+		cov_io += (s_in - s_in_mean) * (t_out - t_out_mean);
+		cov_oi += (s_out - s_out_mean) * (t_in - t_in_mean);
+		cov_oo += (s_out - s_out_mean) * (t_out - t_out_mean);
+		sd_s_in += (s_in - s_in_mean) * (s_in - s_in_mean);
+		sd_s_out += (s_out - s_out_mean) * (s_out - s_out_mean);
+		sd_t_in += (t_in - t_in_mean) * (t_in - t_in_mean);
+		sd_t_out += (t_out - t_out_mean) * (t_out - t_out_mean);
+	}
+	double s_sd_s_in = std::sqrt(sd_s_in), s_sd_s_out = std::sqrt(sd_s_out),
+		   s_sd_t_in = std::sqrt(sd_t_in), s_sd_t_out = std::sqrt(sd_t_out);
+	NeighborDegreeCorrelations ret =
+	{
+			cov_ii / (s_sd_s_in * s_sd_t_in), // r_ii
+			cov_io / (s_sd_s_in * s_sd_t_out), // r_io
+			cov_oi / (s_sd_s_out * s_sd_t_in), // r_oi
+			cov_oo / (s_sd_s_out * s_sd_t_out) // r_oo
+	};
+	return ret;
+}
+
+/// @cond IGNORE
+namespace detail
+{
+/// Pearson's correlation coefficient of degrees at both ends of all edges
+template<class GraphType,
+		degree_t (*sourceDegree)(const typename GraphType::edge_type&),
+		degree_t (*targetDegree)(const typename GraphType::edge_type&)>
+double neighborDegreeCorrelation(const GraphType& g)
+{
+	typedef typename GraphType::edge_type edge_type;
+	const typename GraphType::ConstDenseEdgeIteratorRange r = g.denseEdges();
+	const long M = r.second - r.first;
+	double s_mean = 0, t_mean = 0;
+#pragma omp parallel for reduction(+: s_mean, t_mean)
+	for (long j = 0; j < M; ++j)
+	{
+		const edge_type& e = *(r.first + j);
+		s_mean += sourceDegree(e);
+		t_mean += targetDegree(e);
+	}
+	s_mean /= g.numberOfEdges();
+	t_mean /= g.numberOfEdges();
+
+	double cov = 0;
+	double sd_s = 0, sd_t = 0;
+#pragma omp parallel for reduction(+: cov, sd_s, sd_t)
+	for (long j = 0; j < M; ++j)
+	{
+		const edge_type& e = *(r.first + j);
+		degree_t s = sourceDegree(e), t = targetDegree(e);
+		cov += (s - s_mean) * (t - t_mean);
+		sd_s += (s - s_mean) * (s - s_mean);
+		sd_t += (t - t_mean) * (t - t_mean);
+	}
+	return cov / (std::sqrt(sd_s) * std::sqrt(sd_t));
+}
+}
+/// @endcond
+
+template<class GraphType>
+double neighborDegreeCorrelationInIn(const GraphType& g)
+{
+	typedef detail::edge_degrees<GraphType> deg;
+	return detail::neighborDegreeCorrelation<GraphType, &deg::sourceIn,
+			&deg::targetIn>(g);
+}
+
+template<class GraphType>
+double neighborDegreeCorrelationInOut(const GraphType& g)
+{
+	typedef detail::edge_degrees<GraphType> deg;
+	return detail::neighborDegreeCorrelation<GraphType, &deg::sourceIn,
+			&deg::targetOut>(g);
+}
+
+template<class GraphType>
+double neighborDegreeCorrelationOutOut(const GraphType& g)
+{
+	typedef detail::edge_degrees<GraphType> deg;
+	return detail::neighborDegreeCorrelation<GraphType, &deg::sourceOut,
+			&deg::targetOut>(g);
+}
+
+template<class GraphType>
+double neighborDegreeCorrelationOutIn(const GraphType& g)
+{
+	typedef detail::edge_degrees<GraphType> deg;
+	return detail::neighborDegreeCorrelation<GraphType, &deg::sourceOut,
+			&deg::targetIn>(g);
+}
 
 }
 }
@@ -49,6 +49,31 @@ sparse_dmatrix_t normalized_laplacian(const Graph& g)
 	throw std::runtime_error("Not yet implemented!");
 }
 
+sparse_dmatrix_t adjacency_matrix(const CSRGraph& g)
+{
+	sparse_dmatrix_t m(g.numberOfNodes(), g.numberOfNodes());
+	for (edge_size_t j = 0; j < g.numberOfEdges(); ++j)
+	{
+		m(g.source(j), g.target(j)) = 1;
+		if (!g.isDirected(j))
+			m(g.target(j), g.source(j)) = 1;
+	}
+	return m;
+}
+
+sparse_dmatrix_t degree_matrix(const CSRGraph& g)
+{
+	sparse_dmatrix_t m(g.numberOfNodes(), g.numberOfNodes());
+	for (node_size_t i = 0; i < g.numberOfNodes(); ++i)
+		m(i, i) = g.degree(i);
+	return m;
 }
+
+sparse_dmatrix_t laplacian(const CSRGraph& g)
+{
+	sparse_dmatrix_t d = degree_matrix(g), a = adjacency_matrix(g);
+	return d - a;
 }
 
+}
+}
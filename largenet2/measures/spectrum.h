@@ -7,6 +7,7 @@
 #define SPECTRUM_H_
 
 #include <largenet2/base/Graph.h>
+#include <largenet2/base/CSRGraph.h>
 #include <boost/numeric/ublas/matrix_sparse.hpp>
 #include <boost/foreach.hpp>
 
@@ -32,7 +33,8 @@ sparse_dmatrix_t adjacency_matrix(const Graph& g);
 /**
  * Weighted adjacency matrix of graph @p g, given an edge weight provider @p w
  * @param g graph object
- * @param w edge weight provider; function or functor of signature double (egdge_id_t)
+ * @param w edge weight provider; function or functor of signature double (egdge_id_t),
+ *        such as an EdgeProperty<double>
  * @return weighted adjacency matrix
  */
 template<class EdgeWeightProvider>
@@ -67,7 +69,8 @@ sparse_dmatrix_t degree_matrix(const Graph& g);
 /**
  * Diagonal matrix of node strengths (sum of edge weights attached to a node).
  * @param g graph object
- * @param w edge weight provider; function or functor of signature double (egdge_id_t)
+ * @param w edge weight provider; function or functor of signature double (egdge_id_t),
+ *        such as an EdgeProperty<double>
  * @return diagonal matrix containing node strengths (ascending node ID order)
  */
 template<class EdgeWeightProvider>
@@ -104,7 +107,8 @@ sparse_dmatrix_t laplacian(const Graph& g);
  * Compute the matrix \f$ L = S - W\f$, where \f$ S \f$ is the strength matrix of the
  * graph and \f$ W \f$ is its weighted adjacency matrix.
  * @param g graph object
- * @param w edge weight provider; function or functor of signature double (egdge_id_t)
+ * @param w edge weight provider; function or functor of signature double (egdge_id_t),
+ *        such as an EdgeProperty<double>
  * @return weighted Laplacian matrix of @p g
  */
 template<class EdgeWeightProvider>
@@ -124,6 +128,24 @@ sparse_dmatrix_t weighted_laplacian(const Graph& g, EdgeWeightProvider& w)
  */
 sparse_dmatrix_t normalized_laplacian(const Graph& g);
 
+/**
+ * Adjacency matrix of the snapshot @p g, indexed by node index.
+ * @see adjacency_matrix(const Graph&)
+ */
+sparse_dmatrix_t adjacency_matrix(const CSRGraph& g);
+
+/**
+ * Diagonal matrix of node degrees of the snapshot @p g, indexed by node index.
+ * @see degree_matrix(const Graph&)
+ */
+sparse_dmatrix_t degree_matrix(const CSRGraph& g);
+
+/**
+ * Unnormalized Laplacian of the snapshot @p g, indexed by node index.
+ * @see laplacian(const Graph&)
+ */
+sparse_dmatrix_t laplacian(const CSRGraph& g);
+
 }
 }
 
@@ -0,0 +1,159 @@
+/**
+ * @file SumTree.h
+ * @date 18.10.2026
+ */
+
+#ifndef SUMTREE_H_
+#define SUMTREE_H_
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cassert>
+
+namespace largenet
+{
+
+/**
+ * Non-negative weights with prefix sums, for weighted random selection.
+ *
+ * A Fenwick (binary indexed) tree over the weights of elements 0, 1, ...
+ * Setting a weight and finding the element at a given cumulative weight take
+ * O(log N) steps. The tree grows by doubling when weights are set beyond its
+ * size. It is rebuilt from the stored weights after every N updates, which
+ * takes amortized constant time and keeps rounding errors of the incremental
+ * updates from accumulating.
+ */
+class SumTree
+{
+public:
+	SumTree() :
+		total_(0), updates_(0)
+	{
+	}
+	/**
+	 * Number of weights, including zero weights
+	 */
+	size_t size() const
+	{
+		return weights_.size();
+	}
+	/**
+	 * Weight of element @p i
+	 */
+	double operator[](const size_t i) const
+	{
+		return i < weights_.size() ? weights_[i] : 0;
+	}
+	/**
+	 * Sum of all weights
+	 */
+	double total() const
+	{
+		return total_;
+	}
+	/**
+	 * Set weight of element @p i to @p w
+	 */
+	void set(const size_t i, const double w)
+	{
+		assert(w >= 0);
+		if (i >= weights_.size())
+		{
+			if (w == 0)
+				return;
+			weights_.resize(std::max(i + 1, 2 * weights_.size()), 0);
+			weights_[i] = w;
+			rebuild();
+			return;
+		}
+		const double delta = w - weights_[i];
+		if (delta == 0)
+			return;
+		weights_[i] = w;
+		if (++updates_ > weights_.size())
+		{
+			rebuild();
+			return;
+		}
+		total_ += delta;
+		for (size_t k = i + 1; k <= tree_.size(); k += k & (~k + 1))
+			tree_[k - 1] += delta;
+	}
+	/**
+	 * Element at cumulative weight @p u
+	 *
+	 * @return the element @c i whose weight interval [w_0 + ... + w_{i-1},
+	 * w_0 + ... + w_i) contains @p u, which is never an element of zero
+	 * weight, or size() if @p u is not smaller than total().
+	 */
+	size_t find(double u) const
+	{
+		size_t pos = 0;
+		for (size_t step = topBit(); step > 0; step >>= 1)
+		{
+			if ((pos + step <= tree_.size()) && (tree_[pos + step - 1] <= u))
+			{
+				pos += step;
+				u -= tree_[pos - 1];
+			}
+		}
+		return pos;
+	}
+	/**
+	 * Memory held by the weights and prefix sums, in bytes
+	 */
+	size_t memoryUsage() const
+	{
+		return (weights_.capacity() + tree_.capacity()) * sizeof(double);
+	}
+	/**
+	 * Remove all weights
+	 */
+	void clear()
+	{
+		weights_.clear();
+		tree_.clear();
+		total_ = 0;
+		updates_ = 0;
+	}
+	/**
+	 * Replace all weights by @p w
+	 */
+	void assign(const std::vector<double>& w)
+	{
+		weights_ = w;
+		rebuild();
+	}
+
+private:
+	/// recompute all prefix sums from the weights in O(N)
+	void rebuild()
+	{
+		tree_ = weights_;
+		total_ = 0;
+		for (size_t k = 1; k <= tree_.size(); ++k)
+		{
+			total_ += weights_[k - 1];
+			const size_t parent = k + (k & (~k + 1));
+			if (parent <= tree_.size())
+				tree_[parent - 1] += tree_[k - 1];
+		}
+		updates_ = 0;
+	}
+	size_t topBit() const
+	{
+		size_t b = 1;
+		while (2 * b <= tree_.size())
+			b *= 2;
+		return tree_.empty() ? 0 : b;
+	}
+
+	std::vector<double> weights_, tree_;
+	double total_;
+	size_t updates_;
+};
+
+}
+
+#endif /* SUMTREE_H_ */
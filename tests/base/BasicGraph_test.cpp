@@ -0,0 +1,276 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <largenet2/generators/generators.h>
+#include <largenet2/measures/measures.h>
+#include <largenet2/measures/counts.h>
+#include <largenet2/measures/DegreeDistribution.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/bernoulli_distribution.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/foreach.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <memory>
+
+using namespace largenet;
+
+namespace
+{
+
+/// random number generator providing the interface expected by the generators
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+	bool Chance(double p)
+	{
+		return boost::random::bernoulli_distribution<>(p)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// random graph with directed and undirected edges and gaps in the node IDs
+void randomGraph(Graph& g, node_size_t n, edge_size_t m)
+{
+	Rng rng(11);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(rng.IntFromTo<node_state_size_t>(0, 1));
+	for (edge_size_t j = 0; j < m; ++j)
+		g.addEdge(rng.IntFromTo<node_id_t>(0, n - 1),
+				rng.IntFromTo<node_id_t>(0, n - 1), j % 3 != 0);
+	for (node_id_t i = 0; i < n; i += 5)
+		g.removeNode(i);
+}
+
+template<class GraphType>
+void checkSameMeasures(const GraphType& g, const Graph& ref)
+{
+	BOOST_CHECK_EQUAL(measures::maxInDegree(g), measures::maxInDegree(ref));
+	BOOST_CHECK_EQUAL(measures::minOutDegree(g), measures::minOutDegree(ref));
+	BOOST_CHECK(measures::outDegreeRange(g) == measures::outDegreeRange(ref));
+	BOOST_CHECK_CLOSE(measures::inOutDegreeCorrelation(g),
+			measures::inOutDegreeCorrelation(ref), 1e-9);
+	BOOST_CHECK_CLOSE(measures::neighborDegreeCorrelations(g).r_io,
+			measures::neighborDegreeCorrelationInOut(ref), 1e-9);
+	BOOST_CHECK_CLOSE(measures::neighborDegreeCorrelationOutOut(g),
+			measures::neighborDegreeCorrelations(ref).r_oo, 1e-9);
+	BOOST_CHECK_EQUAL(measures::triples(g), measures::triples(ref));
+	BOOST_CHECK_EQUAL(measures::inOutTriples(g), measures::inOutTriples(ref));
+	BOOST_CHECK_EQUAL(measures::triangles(g), measures::triangles(ref));
+	BOOST_CHECK_EQUAL(measures::quadStars(g), measures::quadStars(ref));
+	BOOST_CHECK_EQUAL(measures::outQuadStars(g), measures::outQuadStars(ref));
+
+	measures::TotalDegreeDistribution dd(g), ddref(ref);
+	BOOST_CHECK_EQUAL_COLLECTIONS(dd.begin(), dd.end(), ddref.begin(), ddref.end());
+	measures::InDegreeDistribution ddin(g, 1), ddinref(ref, 1);
+	BOOST_CHECK_EQUAL_COLLECTIONS(ddin.begin(), ddin.end(), ddinref.begin(), ddinref.end());
+}
+
+/// counts events, checking that handlers receive the concrete types
+class StaticCounter: public StaticGraphListener
+{
+public:
+	StaticCounter() :
+		nodesAdded(0), edgesAdded(0), edgesRemoved(0), nodeChanges(0)
+	{
+	}
+	template<class G> void afterNodeAdd(G& g, CompactNode& n)
+	{
+		++nodesAdded;
+	}
+	template<class G> void afterEdgeAdd(G& g, Edge& e)
+	{
+		++edgesAdded;
+	}
+	template<class G> void beforeEdgeRemove(G& g, Edge& e)
+	{
+		BOOST_CHECK(g.isEdge(e.source()->id(), e.target()->id()));
+		++edgesRemoved;
+	}
+	template<class G> void afterNodeStateChange(G& g, CompactNode& n,
+			node_state_t oldState, node_state_t newState)
+	{
+		BOOST_CHECK_EQUAL(g.nodeState(n.id()), newState);
+		++nodeChanges;
+	}
+	int nodesAdded, edgesAdded, edgesRemoved, nodeChanges;
+};
+
+/// counts edge state changes at runtime
+class EdgeStateCounter: public GraphListener
+{
+public:
+	EdgeStateCounter() :
+		changes(0)
+	{
+	}
+	int changes;
+private:
+	void afterEdgeStateChangeEvent(Graph& g, Edge& e, edge_state_t oldState,
+			edge_state_t newState)
+	{
+		++changes;
+	}
+};
+
+/// edge state is 1 if both nodes are in state 1
+struct BothOne
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return (s == 1) && (t == 1) ? 1 : 0;
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( BasicGraph_tests )
+
+BOOST_AUTO_TEST_CASE( typed_access )
+{
+	typedef BasicGraph<CompactNode> graph_t;
+	BOOST_STATIC_ASSERT((boost::is_same<graph_t::node_type, CompactNode>::value));
+	BOOST_STATIC_ASSERT((boost::is_same<graph_t::NodeIterator::reference, CompactNode&>::value));
+	BOOST_STATIC_ASSERT((boost::is_same<graph_t::ConstEdgeIterator::reference, const Edge&>::value));
+
+	graph_t g(2, 1);
+	for (int i = 0; i < 4; ++i)
+		g.addNode(i % 2);
+	g.addEdge(0, 1, true);
+	g.addEdge(2, 1, false);
+	CompactNode* n = g.node(1);
+	BOOST_CHECK_EQUAL(n->id(), 1);
+	BOOST_CHECK_EQUAL(node_traits<CompactNode>::inDegree(*n), 1);
+	BOOST_CHECK_EQUAL(node_traits<CompactNode>::degree(*n), 2);
+	BOOST_CHECK(g.isEdge(0, 1));
+	BOOST_CHECK(!g.isEdge(1, 0));
+	BOOST_CHECK(g.isEdge(1, 2));
+	BOOST_CHECK(g.adjacent(1, 0));
+	BOOST_CHECK(!g.adjacent(0, 3));
+
+	const graph_t& cg = g;
+	node_size_t count = 0;
+	for (graph_t::ConstNodeStateIterator it = cg.nodes(1).first; it != cg.nodes(1).second; ++it)
+	{
+		BOOST_CHECK_EQUAL(it.id(), it->id());
+		BOOST_CHECK_EQUAL(g.nodeState(it.id()), 1);
+		++count;
+	}
+	BOOST_CHECK_EQUAL(count, 2);
+	graph_t::NodeIterator it = g.nodes().first;
+	graph_t::ConstNodeIterator cit(it);
+	BOOST_CHECK(cit == it);
+
+	// still usable through the type-erased interface
+	Graph& base = g;
+	BOOST_CHECK_EQUAL(base.node(1)->inDegree(), 1);
+	base.removeNode(1);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 0);
+
+	// the element factory cannot be replaced through it either
+	graph_t empty(1, 1);
+	Graph& e = empty;
+	BOOST_CHECK_THROW(e.setElementFactory(std::auto_ptr<ElementFactory>(
+			new MultiEdgeElementFactory)), std::logic_error);
+	empty.addNode();
+	BOOST_CHECK(dynamic_cast<CompactNode*> (e.node(0)) != 0);
+}
+
+BOOST_AUTO_TEST_CASE( measures_match_graph )
+{
+	Graph ref(2, 1);
+	BasicGraph<SingleNode> single(2, 1);
+	BasicGraph<CompactNode> compact(2, 1);
+	BasicGraph<IndexedNode> indexed(2, 1);
+	randomGraph(ref, 80, 400);
+	randomGraph(single, 80, 400);
+	randomGraph(compact, 80, 400);
+	randomGraph(indexed, 80, 400);
+	BOOST_REQUIRE_EQUAL(single.numberOfEdges(), ref.numberOfEdges());
+	BOOST_REQUIRE_EQUAL(compact.numberOfEdges(), ref.numberOfEdges());
+	BOOST_REQUIRE_EQUAL(indexed.numberOfEdges(), ref.numberOfEdges());
+	checkSameMeasures(single, ref);
+	checkSameMeasures(compact, ref);
+	checkSameMeasures(indexed, ref);
+}
+
+BOOST_AUTO_TEST_CASE( generator_fast_path )
+{
+	BasicGraph<CompactNode> g(1, 1);
+	Rng rng(3);
+	generators::randomGnm(g, 50, 120, rng);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), 50);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 120);
+	generators::wattsStrogatzGraph(g, 40, 4, 0.3, rng);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 80);
+	BOOST_FOREACH(const CompactNode& n, g.nodes())
+		BOOST_CHECK(!g.isEdge(n.id(), n.id()));
+}
+
+BOOST_AUTO_TEST_CASE( static_listener )
+{
+	typedef ListenerChain<StaticCounter, StaticStateConsistencyListener<BothOne> > chain_t;
+	typedef BasicGraph<CompactNode, Edge, GraphElementFactory<CompactNode>, chain_t> graph_t;
+	graph_t g(2, 2);
+	EdgeStateCounter dynamic;
+	g.addGraphListener(&dynamic);
+	const StaticCounter& count = g.listener().first();
+
+	for (int i = 0; i < 4; ++i)
+		g.addNode();
+	g.addEdge(0, 1, false);
+	g.addEdge(1, 2, true);
+	g.addEdge(2, 1, true);
+	g.addEdge(0, 1, false); // exists, not reported
+	BOOST_CHECK_EQUAL(count.nodesAdded, 4);
+	BOOST_CHECK_EQUAL(count.edgesAdded, 3);
+
+	g.setNodeState(1, 1);
+	g.setNodeState(1, 1); // no change
+	g.setNodeState(2, 1);
+	BOOST_CHECK_EQUAL(count.nodeChanges, 2);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 2);
+	BOOST_CHECK_EQUAL(dynamic.changes, 2);
+
+	// changes through the Graph interface reach the static listener once
+	Graph& base = g;
+	base.setNodeState(0, 1);
+	BOOST_CHECK_EQUAL(count.nodeChanges, 3);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 3);
+	BOOST_CHECK_EQUAL(dynamic.changes, 3);
+	base.addNode(1);
+	base.addEdge(3, 4, false);
+	BOOST_CHECK_EQUAL(count.nodesAdded, 5);
+	BOOST_CHECK_EQUAL(count.edgesAdded, 4);
+	BOOST_CHECK_EQUAL(g.edgeState(3), 0);
+	base.setNodeState(3, 1);
+	BOOST_CHECK_EQUAL(g.edgeState(3), 1);
+
+	// batch additions are reported per element
+	std::vector<std::pair<node_id_t, node_id_t> > pairs;
+	pairs.push_back(std::make_pair(0, 3));
+	pairs.push_back(std::make_pair(0, 2));
+	base.addEdges(pairs, true);
+	BOOST_CHECK_EQUAL(count.edgesAdded, 6);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 6);
+
+	g.removeEdge(0);
+	base.removeNode(3);
+	BOOST_CHECK_EQUAL(count.edgesRemoved, 3);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
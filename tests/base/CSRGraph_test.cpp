@@ -0,0 +1,124 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/base/CSRGraph.h>
+#include <largenet2/measures/measures.h>
+#include <largenet2/measures/counts.h>
+#include <largenet2/measures/DegreeDistribution.h>
+#include <largenet2/measures/spectrum.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <algorithm>
+
+using namespace largenet;
+
+namespace
+{
+
+/// random graph with directed and undirected edges, loops, and gaps in the node IDs
+void randomGraph(Graph& g, node_size_t n, edge_size_t m)
+{
+	boost::mt19937 rng(7);
+	boost::random::uniform_int_distribution<node_state_t> state(0, 1);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(state(rng));
+	boost::random::uniform_int_distribution<node_id_t> node(0, n - 1);
+	for (edge_size_t j = 0; j < m; ++j)
+		g.addEdge(node(rng), node(rng), j % 3 != 0);
+	for (node_id_t i = 0; i < n; i += 7)
+		g.removeNode(i);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( CSRGraph_tests )
+
+BOOST_AUTO_TEST_CASE( structure )
+{
+	Graph g(2, 1);
+	randomGraph(g, 60, 300);
+	CSRGraph csr(g);
+	BOOST_REQUIRE_EQUAL(csr.numberOfNodes(), g.numberOfNodes());
+	BOOST_REQUIRE_EQUAL(csr.numberOfEdges(), g.numberOfEdges());
+	BOOST_CHECK_THROW(csr.nodeIndex(0), std::invalid_argument);
+
+	for (node_size_t i = 0; i < csr.numberOfNodes(); ++i)
+	{
+		const node_id_t id = csr.nodeId(i);
+		const Node* n = g.node(id);
+		BOOST_CHECK_EQUAL(csr.nodeIndex(id), i);
+		BOOST_CHECK_EQUAL(csr.nodeState(i), g.nodeState(id));
+		BOOST_CHECK_EQUAL(csr.outDegree(i), n->outDegree());
+		BOOST_CHECK_EQUAL(csr.inDegree(i), n->inDegree());
+		BOOST_CHECK_EQUAL(csr.undirectedDegree(i), n->undirectedDegree());
+		BOOST_CHECK_EQUAL(csr.mutualDegree(i), n->mutualDegree());
+
+		CSRGraph::index_range nbs = csr.outNeighbors(i);
+		BOOST_CHECK(std::adjacent_find(nbs.first, nbs.second,
+				std::greater<node_size_t>()) == nbs.second); // sorted
+		CSRGraph::edge_index_range es = csr.edges(i, CSRGraph::OUT);
+		for (; nbs.first != nbs.second; ++nbs.first, ++es.first)
+		{
+			BOOST_CHECK_EQUAL(csr.source(*es.first), i);
+			BOOST_CHECK_EQUAL(csr.target(*es.first), *nbs.first);
+			BOOST_CHECK(n->hasOutEdge(g.edge(csr.edgeId(*es.first))));
+		}
+		for (node_size_t k = 0; k < csr.numberOfNodes(); ++k)
+		{
+			BOOST_CHECK_EQUAL(csr.isEdge(i, k), g.isEdge(id, csr.nodeId(k)));
+			BOOST_CHECK_EQUAL(csr.adjacent(i, k), g.adjacent(id, csr.nodeId(k)));
+		}
+	}
+	for (edge_size_t j = 0; j < csr.numberOfEdges(); ++j)
+	{
+		const Edge* e = g.edge(csr.edgeId(j));
+		BOOST_CHECK_EQUAL(csr.nodeId(csr.source(j)), e->source()->id());
+		BOOST_CHECK_EQUAL(csr.nodeId(csr.target(j)), e->target()->id());
+		BOOST_CHECK_EQUAL(csr.isDirected(j), e->isDirected());
+		BOOST_CHECK_EQUAL(csr.edgeState(j), g.edgeState(e->id()));
+	}
+
+	// the snapshot is independent of later changes
+	g.clear();
+	BOOST_CHECK(csr.numberOfEdges() > 0);
+}
+
+BOOST_AUTO_TEST_CASE( measures_match_graph )
+{
+	Graph g(2, 1);
+	randomGraph(g, 80, 400);
+	CSRGraph csr(g);
+
+	BOOST_CHECK(measures::inDegreeRange(csr) == measures::inDegreeRange(g));
+	BOOST_CHECK(measures::outDegreeRange(csr) == measures::outDegreeRange(g));
+	BOOST_CHECK_EQUAL(measures::meanDegree(csr), measures::meanDegree(g));
+	BOOST_CHECK_CLOSE(measures::inOutDegreeCorrelation(csr),
+			measures::inOutDegreeCorrelation(g), 1e-9);
+	BOOST_CHECK_CLOSE(measures::neighborDegreeCorrelationInOut(csr),
+			measures::neighborDegreeCorrelationInOut(g), 1e-9);
+	BOOST_CHECK_CLOSE(measures::neighborDegreeCorrelationOutOut(csr),
+			measures::neighborDegreeCorrelationOutOut(g), 1e-9);
+
+	motifs::LinkMotif l(0, 1), u(1, 1, false);
+	BOOST_CHECK_EQUAL(measures::edges(csr, l), measures::edges(g, l));
+	BOOST_CHECK_EQUAL(measures::edges(csr, u), measures::edges(g, u));
+	BOOST_CHECK_EQUAL(measures::triples(csr), measures::triples(g));
+	BOOST_CHECK_EQUAL(measures::inTriples(csr), measures::inTriples(g));
+	BOOST_CHECK_EQUAL(measures::outTriples(csr), measures::outTriples(g));
+	BOOST_CHECK_EQUAL(measures::inOutTriples(csr), measures::inOutTriples(g));
+	BOOST_CHECK_EQUAL(measures::triangles(csr), measures::triangles(g));
+	BOOST_CHECK_EQUAL(measures::quadStars(csr), measures::quadStars(g));
+	BOOST_CHECK_EQUAL(measures::inQuadStars(csr), measures::inQuadStars(g));
+	BOOST_CHECK_EQUAL(measures::outQuadStars(csr), measures::outQuadStars(g));
+
+	measures::TotalDegreeDistribution dg(g), dc(csr);
+	BOOST_CHECK_EQUAL_COLLECTIONS(dg.begin(), dg.end(), dc.begin(), dc.end());
+
+	measures::sparse_dmatrix_t lg = measures::laplacian(g), lc =
+			measures::laplacian(csr);
+	for (node_size_t i = 0; i < csr.numberOfNodes(); ++i)
+		for (node_size_t k = 0; k < csr.numberOfNodes(); ++k)
+			BOOST_CHECK_EQUAL(lg(i, k), lc(i, k));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/base/AdjacencyArray.h>
+#include <boost/foreach.hpp>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace largenet;
+
+namespace
+{
+
+void makeCompact(Graph& g)
+{
+	g.setElementFactory(std::auto_ptr<ElementFactory>(new CompactElementFactory));
+}
+
+std::set<node_id_t> outNeighborIds(const Node& n)
+{
+	std::set<node_id_t> ids;
+	BOOST_FOREACH(const Node& nb, n.outNeighbors())
+		ids.insert(nb.id());
+	return ids;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( CompactNode_tests )
+
+BOOST_AUTO_TEST_CASE( adjacency_array )
+{
+	AdjacencyArray a;
+	MultiNode s(0), t(1);
+	std::vector<Edge*> edges;
+	for (unsigned int i = 0; i < 3 * AdjacencyArray::inline_capacity; ++i)
+	{
+		edges.push_back(Edge::create(i, s, t, true));
+		a.insert(edges.back(), static_cast<AdjacencyArray::Segment>(i % 3));
+	}
+	BOOST_CHECK_EQUAL(a.size(), edges.size());
+	BOOST_CHECK(a.capacity() >= edges.size());
+	BOOST_CHECK_EQUAL(a.size(AdjacencyArray::OUT), AdjacencyArray::inline_capacity);
+	for (unsigned int i = 0; i < edges.size(); ++i)
+		BOOST_CHECK(a.contains(edges[i], static_cast<AdjacencyArray::Segment>(i % 3)));
+
+	BOOST_CHECK(a.erase(edges[0], AdjacencyArray::OUT));
+	BOOST_CHECK(!a.erase(edges[0], AdjacencyArray::OUT));
+	BOOST_CHECK(!a.erase(edges[1], AdjacencyArray::OUT));
+	BOOST_CHECK(a.erase(edges[1], AdjacencyArray::IN));
+	BOOST_CHECK_EQUAL(a.size(), edges.size() - 2);
+	for (unsigned int i = 2; i < edges.size(); ++i)
+		BOOST_CHECK(a.contains(edges[i], static_cast<AdjacencyArray::Segment>(i % 3)));
+
+	BOOST_FOREACH(Edge* e, edges)
+		delete e;
+}
+
+BOOST_AUTO_TEST_CASE( simple_graph )
+{
+	Graph g(1, 1);
+	makeCompact(g);
+	for (int i = 0; i < 4; ++i)
+		g.addNode();
+	edge_id_t e = g.addEdge(0, 1, true);
+	BOOST_CHECK_EQUAL(g.addEdge(0, 1, true), e); // no parallel edges
+	g.addEdge(1, 0, true);
+	g.addEdge(0, 2, false);
+	g.addEdge(3, 3, true);
+
+	const Node* n = g.node(0);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 4);
+	BOOST_CHECK_EQUAL(n->outDegree(), 1);
+	BOOST_CHECK_EQUAL(n->inDegree(), 1);
+	BOOST_CHECK_EQUAL(n->undirectedDegree(), 1);
+	BOOST_CHECK_EQUAL(n->mutualDegree(), 1);
+	BOOST_CHECK_EQUAL(n->degree(), 3);
+	BOOST_CHECK(g.isEdge(0, 1));
+	BOOST_CHECK(g.isEdge(2, 0));
+	BOOST_CHECK(!g.isEdge(1, 2));
+	BOOST_CHECK(g.adjacent(2, 0));
+	BOOST_CHECK_EQUAL(n->edgeTo(g.node(1))->id(), e);
+	BOOST_CHECK_THROW(n->edgeTo(g.node(3)), NotAdjacentException);
+	BOOST_CHECK_EQUAL(g.node(3)->outDegree(), 1);
+	BOOST_CHECK_EQUAL(g.node(3)->inDegree(), 1);
+
+	g.removeNode(0);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 1);
+	BOOST_CHECK_EQUAL(g.node(1)->degree(), 0);
+	BOOST_CHECK_EQUAL(g.node(2)->degree(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( hub_matches_single_node )
+{
+	Graph compact(1, 1), single(1, 1);
+	makeCompact(compact);
+	const node_size_t N = 50;
+	for (node_size_t i = 0; i < N; ++i)
+	{
+		compact.addNode();
+		single.addNode();
+	}
+	for (node_id_t i = 1; i < N; ++i)
+	{
+		compact.addEdge(0, i, true);
+		single.addEdge(0, i, true);
+		if (i % 3 == 0)
+		{
+			compact.addEdge(i, 0, false);
+			single.addEdge(i, 0, false);
+		}
+	}
+	// remove every other out-edge of the hub
+	for (node_id_t i = 1; i < N; i += 2)
+	{
+		compact.removeEdge(compact.node(0)->edgeTo(compact.node(i))->id());
+		single.removeEdge(single.node(0)->edgeTo(single.node(i))->id());
+	}
+	BOOST_CHECK_EQUAL(compact.numberOfEdges(), single.numberOfEdges());
+	BOOST_CHECK_EQUAL(compact.node(0)->outDegree(), single.node(0)->outDegree());
+	BOOST_CHECK_EQUAL(compact.node(0)->undirectedDegree(),
+			single.node(0)->undirectedDegree());
+	BOOST_CHECK(outNeighborIds(*compact.node(0)) == outNeighborIds(*single.node(0)));
+	for (node_id_t i = 1; i < N; ++i)
+	{
+		BOOST_CHECK_EQUAL(compact.isEdge(0, i), single.isEdge(0, i));
+		BOOST_CHECK_EQUAL(compact.adjacent(i, 0), single.adjacent(i, 0));
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
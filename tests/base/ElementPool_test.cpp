@@ -0,0 +1,86 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/base/ElementPool.h>
+#include <memory>
+
+using namespace largenet;
+
+namespace
+{
+
+typedef PooledElementFactory<SingleNode, Edge> PooledFactory;
+
+void fill(Graph& g, node_size_t n)
+{
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode();
+	for (node_id_t i = 0; i + 1 < n; ++i)
+		g.addEdge(i, i + 1, true);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( ElementPool_tests )
+
+BOOST_AUTO_TEST_CASE( lifo_reuse )
+{
+	ElementPool pool;
+	void* a = pool.allocate(40);
+	void* b = pool.allocate(40);
+	void* c = pool.allocate(100);
+	BOOST_CHECK(a != b);
+	BOOST_CHECK_EQUAL(pool.size(), 3);
+	pool.deallocate(a, 40);
+	pool.deallocate(b, 40);
+	BOOST_CHECK_EQUAL(pool.allocate(40), b);
+	BOOST_CHECK_EQUAL(pool.allocate(40), a);
+	pool.deallocate(c, 100);
+	BOOST_CHECK_EQUAL(pool.allocate(100), c);
+
+	const std::size_t cap = pool.capacity();
+	BOOST_CHECK(cap > 0);
+	pool.reset();
+	BOOST_CHECK_EQUAL(pool.size(), 0);
+	BOOST_CHECK_EQUAL(pool.capacity(), cap);
+	BOOST_CHECK_EQUAL(pool.allocate(40), a);
+	pool.release();
+	BOOST_CHECK_EQUAL(pool.capacity(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( pooled_graph )
+{
+	Graph g(1, 1);
+	PooledFactory* elf = new PooledFactory;
+	g.setElementFactory(std::auto_ptr<ElementFactory>(elf));
+	const node_size_t N = 1000;
+	fill(g, N);
+	BOOST_CHECK_EQUAL(elf->pool().size(), 2 * N - 1);
+	const edge_id_t e = g.addEdge(0, 1, true); // rejected as parallel edge
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), N - 1);
+	BOOST_CHECK_EQUAL(elf->pool().size(), 2 * N - 1);
+	BOOST_CHECK(g.isEdge(0, 1));
+
+	const Edge* old = g.edge(e);
+	g.removeEdge(e);
+	BOOST_CHECK_EQUAL(elf->pool().size(), 2 * N - 2);
+	BOOST_CHECK_EQUAL(g.edge(g.addEdge(5, 0, false)), old); // slot is recycled
+	g.removeNode(5);
+	BOOST_CHECK_EQUAL(elf->pool().size(), 2 * N - 5);
+
+	BOOST_CHECK_THROW(g.setElementFactory(std::auto_ptr<ElementFactory>(
+			new SingleEdgeElementFactory)), std::logic_error);
+
+	// refilling a cleared graph does not need any new memory
+	const std::size_t cap = elf->pool().capacity();
+	for (int run = 0; run < 3; ++run)
+	{
+		g.clear();
+		BOOST_CHECK_EQUAL(elf->pool().size(), 0);
+		fill(g, N);
+		BOOST_CHECK_EQUAL(g.numberOfEdges(), N - 1);
+		BOOST_CHECK_EQUAL(elf->pool().capacity(), cap);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
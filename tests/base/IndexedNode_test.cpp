@@ -0,0 +1,121 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <memory>
+
+using namespace largenet;
+
+namespace
+{
+
+void makeIndexed(Graph& g)
+{
+	g.setElementFactory(std::auto_ptr<ElementFactory>(new IndexedElementFactory));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( IndexedNode_tests )
+
+BOOST_AUTO_TEST_CASE( hub_queries )
+{
+	Graph g(1, 1);
+	makeIndexed(g);
+	const node_size_t N = 40;
+	for (node_size_t i = 0; i < N; ++i)
+		g.addNode();
+	const IndexedNode* hub = dynamic_cast<const IndexedNode*>(g.node(0));
+	BOOST_REQUIRE(hub != 0);
+	for (node_id_t i = 1; i < N; ++i)
+	{
+		edge_id_t e = g.addEdge(0, i, true);
+		BOOST_CHECK_EQUAL(g.addEdge(0, i, true), e); // no parallel edges
+		if (i % 2 == 0)
+			g.addEdge(i, 0, true);
+		if (i % 5 == 0)
+			g.addEdge(0, i, false);
+	}
+	g.addEdge(0, 0, true);
+	BOOST_CHECK(hub->isIndexed());
+	BOOST_CHECK_EQUAL(hub->mutualDegree(), (N - 1) / 2 + 1);
+	for (node_id_t i = 1; i < N; ++i)
+	{
+		BOOST_CHECK(g.isEdge(0, i));
+		BOOST_CHECK_EQUAL(g.isEdge(i, 0), (i % 2 == 0) || (i % 5 == 0));
+		BOOST_CHECK_EQUAL(hub->hasUndirectedEdgeTo(g.node(i)), i % 5 == 0);
+		BOOST_CHECK(hub->edgeTo(g.node(i))->to(*g.node(i)));
+		BOOST_CHECK(hub->hasOutEdge(hub->edgeTo(g.node(i))));
+	}
+	BOOST_CHECK(g.isEdge(0, 0));
+	BOOST_CHECK_THROW(hub->edgeFrom(g.node(1)), NotAdjacentException);
+
+	g.removeEdge(hub->edgeTo(hub)->id());
+	for (node_id_t i = 2; i < N; i += 2)
+		g.removeEdge(hub->edgeFrom(g.node(i))->id());
+	BOOST_CHECK_EQUAL(hub->mutualDegree(), 0);
+	BOOST_CHECK(!g.isEdge(0, 0));
+
+	for (node_id_t i = 1; i < N; ++i)
+		g.removeNode(i);
+	BOOST_CHECK(!hub->isIndexed());
+	BOOST_CHECK_EQUAL(hub->degree(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( random_matches_single_node )
+{
+	Graph indexed(1, 1), single(1, 1);
+	makeIndexed(indexed);
+	const node_size_t N = 30;
+	for (node_size_t i = 0; i < N; ++i)
+	{
+		indexed.addNode();
+		single.addNode();
+	}
+	boost::mt19937 rng(42);
+	boost::random::uniform_int_distribution<node_id_t> node(0, N - 1);
+	boost::random::uniform_int_distribution<int> action(0, 3);
+	for (int step = 0; step < 5000; ++step)
+	{
+		const node_id_t s = node(rng), t = node(rng);
+		const bool directed = action(rng) != 0;
+		if (action(rng) == 0)
+		{
+			Node* n = indexed.node(s);
+			Node* m = single.node(s);
+			if (directed && n->hasEdgeTo(indexed.node(t)))
+			{
+				indexed.removeEdge(n->edgeTo(indexed.node(t))->id());
+				single.removeEdge(m->edgeTo(single.node(t))->id());
+			}
+			else if (!directed && n->hasUndirectedEdgeTo(indexed.node(t)))
+			{
+				indexed.removeEdge(n->undirectedEdgeTo(indexed.node(t))->id());
+				single.removeEdge(m->undirectedEdgeTo(single.node(t))->id());
+			}
+		}
+		else
+		{
+			indexed.addEdge(s, t, directed);
+			single.addEdge(s, t, directed);
+		}
+	}
+	BOOST_CHECK_EQUAL(indexed.numberOfEdges(), single.numberOfEdges());
+	for (node_id_t i = 0; i < N; ++i)
+	{
+		const Node* n = indexed.node(i);
+		const Node* m = single.node(i);
+		BOOST_CHECK_EQUAL(n->outDegree(), m->outDegree());
+		BOOST_CHECK_EQUAL(n->inDegree(), m->inDegree());
+		BOOST_CHECK_EQUAL(n->undirectedDegree(), m->undirectedDegree());
+		BOOST_CHECK_EQUAL(n->mutualDegree(), m->mutualDegree());
+		for (node_id_t j = 0; j < N; ++j)
+		{
+			BOOST_CHECK_EQUAL(indexed.isEdge(i, j), single.isEdge(i, j));
+			BOOST_CHECK_EQUAL(indexed.adjacent(i, j), single.adjacent(i, j));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
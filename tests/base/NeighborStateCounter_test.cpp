@@ -0,0 +1,166 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/NeighborStateCounter.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <vector>
+#include <iterator>
+
+using namespace largenet;
+
+namespace
+{
+
+/// compare all counts with those obtained by iterating over the edges
+void checkCounts(const Graph& g, const NeighborStateCounter& c)
+{
+	const node_state_size_t S = g.numberOfNodeStates();
+	for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+	{
+		std::vector<degree_t> out(S, 0), in(S, 0), un(S, 0);
+		Node::edge_iterator_range r = n->outEdges();
+		for (Node::edge_iterator it = r.first; it != r.second; ++it)
+			++out[g.nodeState((*it)->target()->id())];
+		r = n->inEdges();
+		for (Node::edge_iterator it = r.first; it != r.second; ++it)
+			++in[g.nodeState((*it)->source()->id())];
+		r = n->undirectedEdges();
+		for (Node::edge_iterator it = r.first; it != r.second; ++it)
+			++un[g.nodeState((*it)->opposite(*n)->id())];
+		for (node_state_t s = 0; s < S; ++s)
+		{
+			BOOST_CHECK_EQUAL(c.outNeighbors(n.id(), s), out[s]);
+			BOOST_CHECK_EQUAL(c.inNeighbors(n.id(), s), in[s]);
+			BOOST_CHECK_EQUAL(c.undirectedNeighbors(n.id(), s), un[s]);
+			BOOST_CHECK_EQUAL(c.neighbors(n.id(), s), out[s] + in[s] + un[s]);
+		}
+	}
+}
+
+/// ID of a random node
+node_id_t pick(const Graph& g, boost::mt19937& rng)
+{
+	boost::random::uniform_int_distribution<node_size_t> n(0, g.numberOfNodes() - 1);
+	Graph::ConstNodeIterator it = g.nodes().first;
+	std::advance(it, n(rng));
+	return it.id();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( NeighborStateCounter_tests )
+
+BOOST_AUTO_TEST_CASE( counts )
+{
+	Graph g(3, 1);
+	g.addNode(0);
+	g.addNode(1);
+	g.addNode(1);
+	g.addNode(2);
+	g.addEdge(0, 1, true);
+	g.addEdge(2, 0, true);
+	g.addEdge(0, 3, false);
+	NeighborStateCounter c(g); // initial counts taken from the graph
+	g.addGraphListener(&c);
+	BOOST_CHECK_EQUAL(c.outNeighbors(0, 1), 1);
+	BOOST_CHECK_EQUAL(c.inNeighbors(0, 1), 1);
+	BOOST_CHECK_EQUAL(c.undirectedNeighbors(0, 2), 1);
+	BOOST_CHECK_EQUAL(c.neighbors(0, 1), 2);
+	BOOST_CHECK_EQUAL(c.neighbors(0, 0), 0);
+	BOOST_CHECK_EQUAL(c.neighbors(3, 0), 1);
+
+	g.setNodeState(0, 2);
+	BOOST_CHECK_EQUAL(c.inNeighbors(1, 2), 1);
+	BOOST_CHECK_EQUAL(c.outNeighbors(2, 2), 1);
+	BOOST_CHECK_EQUAL(c.undirectedNeighbors(3, 2), 1);
+	BOOST_CHECK_EQUAL(c.neighbors(3, 0), 0);
+
+	g.addEdge(3, 3, false); // loop
+	BOOST_CHECK_EQUAL(c.undirectedNeighbors(3, 2), 2);
+	g.setNodeState(3, 0);
+	BOOST_CHECK_EQUAL(c.undirectedNeighbors(3, 0), 1);
+	BOOST_CHECK_EQUAL(c.undirectedNeighbors(0, 0), 1);
+	checkCounts(g, c);
+
+	g.removeNode(0);
+	BOOST_CHECK_EQUAL(c.inNeighbors(1, 2), 0);
+	BOOST_CHECK_EQUAL(c.neighbors(3, 2), 0);
+	const node_id_t n = g.addNode(1); // reuses the ID of node 0
+	BOOST_CHECK_EQUAL(c.neighbors(n, 1), 0);
+	checkCounts(g, c);
+}
+
+BOOST_AUTO_TEST_CASE( random_changes )
+{
+	Graph g(4, 1);
+	g.setElementFactory(std::auto_ptr<ElementFactory>(new MultiEdgeElementFactory));
+	g.addNodes(60);
+	NeighborStateCounter c(g);
+	g.addGraphListener(&c);
+	boost::mt19937 rng(17);
+	boost::random::uniform_int_distribution<int> op(0, 9);
+	boost::random::uniform_int_distribution<node_state_t> state(0, 3);
+	for (int i = 0; i < 3000; ++i)
+	{
+		const int o = op(rng);
+		if (o < 4)
+		{
+			const node_id_t s = pick(g, rng), t = pick(g, rng);
+			g.addEdge(s, t, o % 2 == 0);
+		}
+		else if ((o < 6) && (g.numberOfEdges() > 0))
+			g.removeEdge(g.edges().first.id());
+		else if (o < 9)
+			g.setNodeState(pick(g, rng), state(rng));
+		else
+		{
+			g.removeNode(pick(g, rng));
+			g.addNode(state(rng));
+		}
+	}
+	checkCounts(g, c);
+
+	for (node_id_t i = 0; i < 60; i += 7)
+		g.removeNode(g.nodes().first.id());
+	g.compact();
+	checkCounts(g, c);
+
+	NeighborStateCounter fresh(g);
+	checkCounts(g, fresh);
+
+	g.clear();
+	g.addNodes(3, 1);
+	g.addEdge(0, 2, true);
+	BOOST_CHECK_EQUAL(c.outNeighbors(0, 1), 1);
+	checkCounts(g, c);
+}
+
+BOOST_AUTO_TEST_CASE( swapped_graphs )
+{
+	Graph a(3, 1), b(3, 1);
+	a.addNodes(4, 1);
+	a.addEdge(0, 1, true);
+	a.addEdge(2, 3, false);
+	b.addNodes(2, 2);
+	b.removeNode(0);
+	b.addNode(0);
+	b.addEdge(1, 0, true);
+	NeighborStateCounter ca(a), cb(b);
+	a.addGraphListener(&ca);
+	b.addGraphListener(&cb);
+
+	// the counters stay with their graph and recount its new edges
+	a.swap(b);
+	BOOST_CHECK_EQUAL(a.numberOfNodes(), 2);
+	checkCounts(a, ca);
+	checkCounts(b, cb);
+	BOOST_CHECK_EQUAL(ca.outNeighbors(1, 0), 1);
+	BOOST_CHECK_EQUAL(ca.outNeighbors(0, 1), 0);
+	a.setNodeState(0, 1);
+	b.addEdge(3, 0, false);
+	checkCounts(a, ca);
+	checkCounts(b, cb);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
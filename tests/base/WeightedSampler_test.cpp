@@ -0,0 +1,241 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/WeightedSampler.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <stdexcept>
+#include <vector>
+#include <map>
+#include <iterator>
+
+using namespace largenet;
+
+namespace
+{
+
+/// random number generator providing the interface expected by the samplers
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	double Uniform01()
+	{
+		return boost::random::uniform_real_distribution<double>(0, 1)(engine_);
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// compare all weights and totals with the node degrees
+void checkDegrees(const Graph& g, const NodeSampler& d, const NodeSampler& in,
+		const NodeSampler& out, const double offset)
+{
+	std::vector<double> totals(g.numberOfNodeStates(), 0);
+	for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+	{
+		BOOST_CHECK_EQUAL(d.weight(n.id()), n->degree() + offset);
+		BOOST_CHECK_EQUAL(in.weight(n.id()), n->inDegree() + offset);
+		BOOST_CHECK_EQUAL(out.weight(n.id()), n->outDegree() + offset);
+		totals[g.nodeState(n.id())] += n->degree() + offset;
+	}
+	double total = 0;
+	for (node_state_t s = 0; s < g.numberOfNodeStates(); ++s)
+	{
+		BOOST_CHECK_EQUAL(d.totalWeight(s), totals[s]);
+		total += totals[s];
+	}
+	BOOST_CHECK_EQUAL(d.totalWeight(), total);
+}
+
+/// ID of a random node
+node_id_t pick(const Graph& g, boost::mt19937& rng)
+{
+	boost::random::uniform_int_distribution<node_size_t> n(0, g.numberOfNodes() - 1);
+	Graph::ConstNodeIterator it = g.nodes().first;
+	std::advance(it, n(rng));
+	return it.id();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( WeightedSampler_tests )
+
+BOOST_AUTO_TEST_CASE( sum_tree )
+{
+	SumTree t;
+	BOOST_CHECK_EQUAL(t.total(), 0);
+	BOOST_CHECK_EQUAL(t.find(0), 0);
+	t.set(3, 0); // zero weights beyond the end need no room
+	BOOST_CHECK_EQUAL(t.size(), 0);
+
+	const double w[] = { 1, 0, 2, 0, 0, 3, 1 };
+	for (size_t i = 0; i < 7; ++i)
+		t.set(i, w[i]);
+	BOOST_CHECK(t.size() >= 7);
+	BOOST_CHECK_EQUAL(t.total(), 7);
+	BOOST_CHECK_EQUAL(t[5], 3);
+	BOOST_CHECK_EQUAL(t.find(0), 0);
+	BOOST_CHECK_EQUAL(t.find(0.5), 0);
+	BOOST_CHECK_EQUAL(t.find(1), 2); // zero weights are skipped
+	BOOST_CHECK_EQUAL(t.find(2.9), 2);
+	BOOST_CHECK_EQUAL(t.find(3), 5);
+	BOOST_CHECK_EQUAL(t.find(5.9), 5);
+	BOOST_CHECK_EQUAL(t.find(6), 6);
+	BOOST_CHECK_EQUAL(t.find(7), t.size());
+
+	t.set(2, 0);
+	t.set(4, 1);
+	BOOST_CHECK_EQUAL(t.total(), 6);
+	BOOST_CHECK_EQUAL(t.find(1), 4);
+	BOOST_CHECK_EQUAL(t.find(2), 5);
+	t.set(100, 4);
+	BOOST_CHECK_EQUAL(t.total(), 10);
+	BOOST_CHECK_EQUAL(t.find(9), 100);
+	t.clear();
+	BOOST_CHECK_EQUAL(t.total(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( degree_weights )
+{
+	Graph g(3, 1);
+	boost::mt19937 rng(13);
+	g.addNodes(50, 0);
+	for (edge_size_t i = 0; i < 150; ++i)
+		g.addEdge(pick(g, rng), pick(g, rng), i % 3 == 0);
+	NodeSampler d(g, NodeSampler::DEGREE, 0.5), in(g, NodeSampler::IN_DEGREE,
+			0.5), out(g, NodeSampler::OUT_DEGREE, 0.5);
+	g.addGraphListener(&d);
+	g.addGraphListener(&in);
+	g.addGraphListener(&out);
+	checkDegrees(g, d, in, out, 0.5);
+
+	Rng r(17);
+	boost::random::uniform_int_distribution<int> action(0, 5);
+	for (int i = 0; i < 400; ++i)
+	{
+		switch (action(rng))
+		{
+		case 0:
+			g.addNode(i % 3);
+			break;
+		case 1:
+			if (g.numberOfNodes() > 10)
+				g.removeNode(pick(g, rng));
+			break;
+		case 2:
+			if (g.numberOfEdges() > 0)
+				g.removeEdge(g.randomEdge(r)->id());
+			break;
+		case 3:
+			g.setNodeState(pick(g, rng), i % 3);
+			break;
+		default:
+			g.addEdge(pick(g, rng), pick(g, rng), i % 2 == 0);
+		}
+	}
+	checkDegrees(g, d, in, out, 0.5);
+	g.compact();
+	checkDegrees(g, d, in, out, 0.5);
+	BOOST_CHECK_THROW(d.setWeight(0, 1), std::invalid_argument);
+
+	g.clear();
+	BOOST_CHECK_EQUAL(d.totalWeight(), 0);
+	g.addNodes(2, 1);
+	g.addEdge(0, 1, false);
+	checkDegrees(g, d, in, out, 0.5);
+}
+
+BOOST_AUTO_TEST_CASE( node_draws )
+{
+	// star with hub 0 and ten leaves, leaves 1 to 4 in state 1
+	Graph g(2, 1);
+	g.addNodes(11, 0);
+	for (node_id_t i = 1; i <= 10; ++i)
+		g.addEdge(0, i, false);
+	for (node_id_t i = 1; i <= 4; ++i)
+		g.setNodeState(i, 1);
+	NodeSampler d(g);
+	g.addGraphListener(&d);
+	BOOST_CHECK_EQUAL(d.totalWeight(), 20);
+	BOOST_CHECK_EQUAL(d.totalWeight(1), 4);
+
+	Rng rnd(3);
+	std::map<node_id_t, int> all, state;
+	for (int i = 0; i < 4000; ++i)
+	{
+		++all[d.draw(rnd)];
+		++state[d.draw(1, rnd)];
+	}
+	BOOST_CHECK_EQUAL(all.size(), 11);
+	BOOST_CHECK(all[0] > 1800 && all[0] < 2200); // half of the weight
+	BOOST_CHECK_EQUAL(state.size(), 4);
+	for (node_id_t i = 1; i <= 4; ++i)
+		BOOST_CHECK(state[i] > 800 && state[i] < 1200);
+
+	// isolated nodes have zero weight without offset
+	g.addNode(1);
+	g.removeNode(0);
+	BOOST_CHECK_EQUAL(d.totalWeight(), 0);
+	BOOST_CHECK_THROW(d.draw(rnd), std::invalid_argument);
+	BOOST_CHECK_THROW(d.draw(1, rnd), std::invalid_argument);
+
+	NodeSampler c(g, NodeSampler::CUSTOM, 1);
+	g.addGraphListener(&c);
+	BOOST_CHECK_EQUAL(c.totalWeight(), 11);
+	c.setWeight(7, 0);
+	c.setWeight(11, 9);
+	BOOST_CHECK_EQUAL(c.totalWeight(1), 13);
+	BOOST_CHECK_THROW(c.setWeight(5, -1), std::invalid_argument);
+	for (int i = 0; i < 100; ++i)
+		BOOST_CHECK(c.draw(rnd) != 7);
+	g.setNodeState(11, 0);
+	BOOST_CHECK_EQUAL(c.totalWeight(0), 9 + 5);
+	BOOST_CHECK_EQUAL(c.weight(11), 9);
+}
+
+BOOST_AUTO_TEST_CASE( edge_draws )
+{
+	Graph g(1, 2);
+	g.addNodes(4);
+	g.addEdge(0, 1, false);
+	g.addEdge(1, 2, false);
+	EdgeSampler w(g);
+	g.addGraphListener(&w);
+	const edge_id_t e = g.addEdge(2, 3, false);
+	w.setWeight(e, 6);
+	BOOST_CHECK_EQUAL(w.totalWeight(), 8);
+	g.setEdgeState(e, 1);
+	BOOST_CHECK_EQUAL(w.totalWeight(0), 2);
+	BOOST_CHECK_EQUAL(w.totalWeight(1), 6);
+
+	Rng rnd(9);
+	int heavy = 0;
+	for (int i = 0; i < 4000; ++i)
+	{
+		if (w.draw(rnd) == e)
+			++heavy;
+		BOOST_CHECK_EQUAL(w.draw(1, rnd), e);
+	}
+	BOOST_CHECK(heavy > 2800 && heavy < 3200);
+
+	g.removeNode(0);
+	g.compact();
+	BOOST_CHECK_EQUAL(w.totalWeight(), 7);
+	BOOST_CHECK_EQUAL(w.weight(0), 1);
+	BOOST_CHECK_EQUAL(w.weight(1), 6);
+	BOOST_CHECK_EQUAL(w.draw(1, rnd), 1);
+	g.clear();
+	BOOST_CHECK_THROW(w.draw(rnd), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
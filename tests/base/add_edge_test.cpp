@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/measures/DegreeDistribution.h>
+#include <memory>
+
+using namespace largenet;
+
+namespace
+{
+
+/// counts edge additions
+class AddCounter: public GraphListener
+{
+public:
+	AddCounter() :
+		added(0)
+	{
+	}
+	int added;
+private:
+	void afterEdgeAddEvent(Graph& g, Edge& e)
+	{
+		++added;
+	}
+};
+
+/// add edges from node 0 to nodes 1 to 20 twice, checking the results
+void checkSimple(Graph& g)
+{
+	AddCounter c;
+	g.addGraphListener(&c);
+	g.addNodes(21);
+	for (node_id_t i = 1; i <= 20; ++i)
+	{
+		BOOST_CHECK(g.findEdge(0, i, i % 2 == 0) == 0);
+		const std::pair<edge_id_t, bool> e = g.tryAddEdge(0, i, i % 2 == 0);
+		BOOST_CHECK(e.second);
+		BOOST_CHECK_EQUAL(g.findEdge(0, i, i % 2 == 0), g.edge(e.first));
+	}
+	BOOST_CHECK_EQUAL(c.added, 20);
+	for (node_id_t i = 1; i <= 20; ++i)
+	{
+		const bool directed = i % 2 == 0;
+		const Edge* e = g.findEdge(0, i, directed);
+		BOOST_REQUIRE(e != 0);
+		std::pair<edge_id_t, bool> r = g.tryAddEdge(0, i, directed);
+		BOOST_CHECK(!r.second);
+		BOOST_CHECK_EQUAL(r.first, e->id());
+		BOOST_CHECK_EQUAL(g.addEdge(0, i, directed), e->id());
+		if (directed)
+		{
+			// reverse edges are distinct
+			BOOST_CHECK(g.findEdge(i, 0, true) == 0);
+			BOOST_CHECK_EQUAL(g.node(i)->findEdgeFrom(g.node(0)), e);
+		}
+		else
+		{
+			r = g.tryAddEdge(i, 0, false);
+			BOOST_CHECK(!r.second);
+			BOOST_CHECK_EQUAL(r.first, e->id());
+			BOOST_CHECK(g.findEdge(0, i, true) == 0);
+		}
+		BOOST_CHECK_EQUAL(g.node(i)->findEdge(g.node(0)), e);
+		BOOST_CHECK_EQUAL(g.node(i)->edgeToAdjacentNode(g.node(0)), e);
+	}
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 20);
+	BOOST_CHECK_EQUAL(c.added, 20);
+
+	// loops and simple edge batches
+	BOOST_CHECK(g.tryAddEdge(3, 3, true).second);
+	BOOST_CHECK(!g.tryAddEdge(3, 3, true).second);
+	BOOST_CHECK(g.tryAddEdge(3, 3, false).second);
+	BOOST_CHECK(!g.tryAddEdge(3, 3, false).second);
+	std::vector<std::pair<node_id_t, node_id_t> > pairs;
+	pairs.push_back(std::make_pair(1, 2));
+	pairs.push_back(std::make_pair(0, 1));
+	pairs.push_back(std::make_pair(2, 1));
+	BOOST_CHECK_EQUAL(g.addEdges(pairs, false), 1);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 23);
+	BOOST_CHECK(g.node(5)->findEdge(g.node(6)) == 0);
+	BOOST_CHECK_THROW(g.node(5)->edgeToAdjacentNode(g.node(6)), NotAdjacentException);
+	g.removeGraphListener(&c);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( add_edge_tests )
+
+BOOST_AUTO_TEST_CASE( simple_edges )
+{
+	Graph single(1, 1);
+	BOOST_CHECK(!single.node(single.addNode())->allowsParallelEdges());
+	single.clear();
+	checkSimple(single);
+
+	Graph compact(1, 1);
+	compact.setElementFactory(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ));
+	checkSimple(compact);
+
+	Graph indexed(1, 1);
+	indexed.setElementFactory(std::auto_ptr<ElementFactory>(
+			new IndexedElementFactory));
+	checkSimple(indexed);
+	BOOST_CHECK(dynamic_cast<const IndexedNode*> (indexed.node(0))->isIndexed());
+
+	Graph pooled(1, 1);
+	pooled.setElementFactory(std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<> ));
+	checkSimple(pooled);
+
+	BasicGraph<SingleNode> basic(1, 1);
+	checkSimple(basic);
+}
+
+BOOST_AUTO_TEST_CASE( parallel_edges )
+{
+	Graph g(1, 1);
+	g.setElementFactory(std::auto_ptr<ElementFactory>(
+			new MultiEdgeElementFactory));
+	g.addNodes(2);
+	BOOST_CHECK(g.node(0)->allowsParallelEdges());
+	const std::pair<edge_id_t, bool> e1 = g.tryAddEdge(0, 1, false), e2 =
+			g.tryAddEdge(1, 0, false);
+	BOOST_CHECK(e1.second && e2.second);
+	BOOST_CHECK(e1.first != e2.first);
+	BOOST_CHECK(g.addEdge(0, 1, false) != e2.first);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 3);
+	BOOST_CHECK(g.findEdge(0, 1, false) != 0);
+	BOOST_CHECK(g.findEdge(0, 1, true) == 0);
+}
+
+BOOST_AUTO_TEST_CASE( degree_distribution_lookup )
+{
+	Graph g(1, 1);
+	g.addNodes(3);
+	g.addEdge(0, 1, false);
+	measures::DegreeDistribution<> d(g);
+	BOOST_CHECK_EQUAL(d[0], 1);
+	BOOST_CHECK_EQUAL(d[1], 2);
+	BOOST_CHECK_EQUAL(d[100], 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,350 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <stdexcept>
+
+using namespace largenet;
+
+namespace
+{
+
+typedef std::vector<std::pair<node_id_t, node_id_t> > pair_v;
+
+/// counts per-element events only
+class ElementCounter: public GraphListener
+{
+public:
+	ElementCounter() :
+		nodes(0), edges(0), states(0)
+	{
+	}
+	node_size_t nodes;
+	edge_size_t edges;
+	edge_size_t states;
+private:
+	void afterNodeAddEvent(Graph& g, Node& n)
+	{
+		++nodes;
+	}
+	void afterEdgeAddEvent(Graph& g, Edge& e)
+	{
+		++edges;
+	}
+	void afterEdgeStateChangeEvent(Graph& g, Edge& e, edge_state_t oldState,
+			edge_state_t newState)
+	{
+		BOOST_CHECK(oldState != newState);
+		BOOST_CHECK_EQUAL(g.edgeState(e.id()), newState);
+		++states;
+	}
+};
+
+/// counts batch events
+class BatchCounter: public GraphListener
+{
+public:
+	BatchCounter() :
+		batches(0), edges(0), stateBatches(0), states(0)
+	{
+	}
+	unsigned int batches;
+	edge_size_t edges;
+	unsigned int stateBatches;
+	edge_size_t states;
+private:
+	void afterNodesAddEvent(Graph& g, const std::vector<node_id_t>& nodes)
+	{
+		++batches;
+	}
+	void afterEdgesAddEvent(Graph& g, const std::vector<edge_id_t>& e)
+	{
+		++batches;
+		edges += e.size();
+	}
+	void afterEdgeStatesChangeEvent(Graph& g, const std::vector<edge_id_t>& e,
+			const std::vector<edge_state_t>& oldStates)
+	{
+		BOOST_CHECK_EQUAL(e.size(), oldStates.size());
+		++stateBatches;
+		states += e.size();
+	}
+};
+
+/// edge state is 1 if both nodes are in state 1
+struct BothInfected
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return (s == 1) && (t == 1) ? 1 : 0;
+	}
+};
+
+/// edge state is the number of infected nodes
+struct InfectedEnds
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return s + t;
+	}
+};
+
+/// infects the susceptible end of each edge changing to state 1
+class Spreader: public GraphListener
+{
+private:
+	void afterEdgeStatesChangeEvent(Graph& g, const std::vector<edge_id_t>& e,
+			const std::vector<edge_state_t>& oldStates)
+	{
+		for (size_t i = 0; i < e.size(); ++i)
+		{
+			if (g.edgeState(e[i]) != 1)
+				continue;
+			const Edge* ed = g.edge(e[i]);
+			g.setNodeState(ed->source()->id(), 1);
+			g.setNodeState(ed->target()->id(), 1);
+		}
+	}
+};
+
+/// star around node 0 with @p n leaves, given once in each direction
+pair_v star(node_id_t n)
+{
+	pair_v pairs;
+	for (node_id_t i = 1; i <= n; ++i)
+		pairs.push_back(std::make_pair(0, i));
+	for (node_id_t i = 1; i <= n; ++i)
+		pairs.push_back(std::make_pair(i, 0));
+	return pairs;
+}
+
+template<class Factory>
+void checkBulkMatchesSingle()
+{
+	const pair_v pairs = star(20);
+	Graph bulk(1, 1), single(1, 1);
+	bulk.setElementFactory(std::auto_ptr<ElementFactory>(new Factory));
+	single.setElementFactory(std::auto_ptr<ElementFactory>(new Factory));
+	bulk.addNodes(21);
+	for (int i = 0; i < 21; ++i)
+		single.addNode();
+	BOOST_CHECK_EQUAL(bulk.addEdges(pairs, false), 20);
+	for (pair_v::const_iterator it = pairs.begin(); it != pairs.end(); ++it)
+		single.addEdge(it->first, it->second, false);
+	BOOST_CHECK_EQUAL(bulk.numberOfEdges(), single.numberOfEdges());
+	BOOST_CHECK_EQUAL(bulk.node(0)->undirectedDegree(), 20);
+	for (node_id_t i = 1; i <= 20; ++i)
+		BOOST_CHECK(bulk.isEdge(i, 0));
+}
+
+template<class Factory>
+void checkSimpleEdges(bool allowsParallelEdges = false)
+{
+	pair_v pairs = star(30);
+	pairs.resize(30); // only one direction
+	pairs.push_back(std::make_pair(1, 2));
+	Graph g(1, 1);
+	g.setElementFactory(std::auto_ptr<ElementFactory>(new Factory));
+	g.addNodes(31);
+	BOOST_CHECK_EQUAL(g.addEdges(pairs, true, true), 31);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 31);
+	BOOST_CHECK_EQUAL(g.node(0)->outDegree(), 30);
+	BOOST_CHECK_EQUAL(g.node(1)->inDegree(), 1);
+	BOOST_CHECK_EQUAL(g.node(1)->outDegree(), 1);
+	BOOST_CHECK(g.isEdge(0, 30));
+	BOOST_CHECK(!g.isEdge(30, 0));
+	BOOST_CHECK(g.node(2)->hasEdgeFrom(g.node(1)));
+	// later single additions still check for parallel edges
+	const edge_id_t e = g.addEdge(0, 17, true);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), allowsParallelEdges ? 32 : 31);
+	BOOST_CHECK_EQUAL(g.edge(e)->target()->id(), 17);
+	g.removeNode(0);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 1);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( bulk_tests )
+
+BOOST_AUTO_TEST_CASE( add_nodes )
+{
+	Graph g(3, 1);
+	g.addNode(1);
+	g.removeNode(0); // leave a free ID to be reused
+	ElementCounter elements;
+	BatchCounter batches;
+	g.addGraphListener(&elements).addGraphListener(&batches);
+	g.addNodes(50, 2);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), 50);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(2), 50);
+	BOOST_CHECK_EQUAL(elements.nodes, 50);
+	BOOST_CHECK_EQUAL(batches.batches, 1);
+	g.addNodes(0);
+	BOOST_CHECK_EQUAL(batches.batches, 1);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), 50);
+}
+
+BOOST_AUTO_TEST_CASE( add_edges_skips_parallel_edges )
+{
+	checkBulkMatchesSingle<SingleEdgeElementFactory>();
+	checkBulkMatchesSingle<CompactElementFactory>();
+	checkBulkMatchesSingle<IndexedElementFactory>();
+}
+
+BOOST_AUTO_TEST_CASE( add_simple_edges )
+{
+	checkSimpleEdges<SingleEdgeElementFactory>();
+	checkSimpleEdges<MultiEdgeElementFactory>(true);
+	checkSimpleEdges<CompactElementFactory>();
+	checkSimpleEdges<IndexedElementFactory>();
+	checkSimpleEdges<PooledElementFactory<IndexedNode> >();
+}
+
+BOOST_AUTO_TEST_CASE( batch_notification )
+{
+	Graph g(2, 2);
+	ElementCounter elements;
+	BatchCounter batches;
+	StateConsistencyListener<BothInfected> consistency(
+			std::auto_ptr<BothInfected>(new BothInfected));
+	g.addGraphListener(&elements).addGraphListener(&batches).addGraphListener(
+			&consistency);
+	g.addNodes(4, 1);
+	g.addNodes(2, 0);
+	pair_v pairs;
+	pairs.push_back(std::make_pair(0, 1));
+	pairs.push_back(std::make_pair(1, 2));
+	pairs.push_back(std::make_pair(2, 1)); // parallel, skipped
+	pairs.push_back(std::make_pair(3, 4));
+	pairs.push_back(std::make_pair(4, 5));
+	BOOST_CHECK_EQUAL(g.addEdges(pairs, false), 4);
+	BOOST_CHECK_EQUAL(elements.edges, 4);
+	BOOST_CHECK_EQUAL(batches.edges, 4);
+	BOOST_CHECK_EQUAL(batches.batches, 3);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 2);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(0), 2);
+}
+
+BOOST_AUTO_TEST_CASE( batch_failure )
+{
+	Graph g(2, 2);
+	BatchCounter batches;
+	StateConsistencyListener<BothInfected> consistency(
+			std::auto_ptr<BothInfected>(new BothInfected));
+	g.addGraphListener(&batches).addGraphListener(&consistency);
+	g.addNodes(3, 1);
+	pair_v pairs;
+	pairs.push_back(std::make_pair(0, 1));
+	pairs.push_back(std::make_pair(1, 2));
+	pairs.push_back(std::make_pair(7, 2)); // invalid source
+	pairs.push_back(std::make_pair(0, 2));
+	BOOST_CHECK_THROW(g.addEdges(pairs, false), std::invalid_argument);
+
+	// the edges created before the failure are kept and reported
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 2);
+	BOOST_CHECK_EQUAL(batches.edges, 2);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 2);
+}
+
+BOOST_AUTO_TEST_CASE( repository_reserve )
+{
+	repo::CPtrRepository<int> r(1);
+	r.reserve(1000);
+	BOOST_CHECK(r.capacity() >= 1000);
+	const repo::address_t cap = r.capacity();
+	for (int i = 0; i < 1000; ++i)
+		r.insert(new int(i));
+	BOOST_CHECK_EQUAL(r.capacity(), cap);
+	r.reserve(10);
+	BOOST_CHECK_EQUAL(r.capacity(), cap);
+	BOOST_CHECK_EQUAL(r[999], 999);
+}
+
+BOOST_AUTO_TEST_CASE( graph_reserve )
+{
+	Graph g(1, 1);
+	g.reserve(500, 2000);
+	g.setSegmentBits(6);
+	g.addNodes(1000);
+	const Node* first = g.node(0);
+	pair_v pairs;
+	for (node_id_t i = 1; i < 1000; ++i)
+		pairs.push_back(std::make_pair(i - 1, i));
+	BOOST_CHECK_EQUAL(g.addEdges(pairs, false, true), 999);
+	g.addNodes(1000);
+	BOOST_CHECK_EQUAL(g.node(0), first);
+	BOOST_CHECK_EQUAL(g.node(999)->degree(), 1);
+	BOOST_CHECK(g.adjacent(500, 501));
+	g.setSegmentBits(0);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), 2000);
+	BOOST_CHECK(g.adjacent(998, 999));
+}
+
+BOOST_AUTO_TEST_CASE( edge_state_batches )
+{
+	// star around node 0 with edges of all kinds, and a directed loop
+	Graph g(2, 2);
+	g.addNodes(6, 0);
+	g.addEdge(0, 1, true);
+	g.addEdge(2, 0, true);
+	g.addEdge(0, 3, false);
+	g.addEdge(4, 0, false);
+	g.addEdge(0, 0, true);
+	g.addEdge(4, 5, false);
+	ElementCounter elements;
+	BatchCounter batches;
+	StateConsistencyListener<BothInfected> consistency(
+			std::auto_ptr<BothInfected>(new BothInfected));
+	g.addGraphListener(&consistency).addGraphListener(&elements).addGraphListener(
+			&batches);
+	for (node_id_t i = 1; i < 6; ++i)
+		g.setNodeState(i, 1);
+	BOOST_CHECK_EQUAL(batches.stateBatches, 1); // only edge 4-5 changed
+	g.setNodeState(0, 1);
+	BOOST_CHECK_EQUAL(batches.stateBatches, 2);
+	BOOST_CHECK_EQUAL(batches.states, 6);
+	BOOST_CHECK_EQUAL(elements.states, 6);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 6);
+	g.setNodeState(3, 0);
+	g.setNodeState(0, 0);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 1);
+	for (Graph::ConstEdgeIterator it = g.edges().first; it != g.edges().second; ++it)
+		BOOST_CHECK_EQUAL(g.edgeState(it.id()), BothInfected()(g.nodeState(
+				it->source()->id()), g.nodeState(it->target()->id())));
+	BOOST_CHECK_EQUAL(batches.states, elements.states);
+
+	// direct use, with unchanged edges skipped
+	std::vector<edge_id_t> edges(2, 0);
+	edges[1] = 5;
+	std::vector<edge_state_t> states(2, 0);
+	const unsigned int before = batches.stateBatches;
+	g.setEdgeStates(edges, states);
+	BOOST_CHECK_EQUAL(batches.stateBatches, before + 1);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(1), 0);
+	g.setEdgeStates(edges, states);
+	BOOST_CHECK_EQUAL(batches.stateBatches, before + 1);
+}
+
+BOOST_AUTO_TEST_CASE( edge_state_cascade )
+{
+	// a binary tree, infected from the root by node state changes made
+	// while the consistency listener is still updating the edges of a node
+	Graph g(2, 3);
+	g.addNodes(63, 0);
+	for (node_id_t i = 1; i < 63; ++i)
+		g.addEdge((i - 1) / 2, i, i % 3 == 0);
+	StateConsistencyListener<InfectedEnds> consistency(
+			std::auto_ptr<InfectedEnds>(new InfectedEnds));
+	Spreader spreader;
+	g.addGraphListener(&consistency).addGraphListener(&spreader);
+	g.setNodeState(0, 1);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(1), 63);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(2), 62);
+	g.removeGraphListener(&spreader);
+	g.removeGraphListener(&consistency);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,218 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+using namespace largenet;
+
+namespace
+{
+
+/// sorted IDs of the edges of @p n
+std::vector<edge_id_t> edgeIds(const Node& n)
+{
+	std::vector<edge_id_t> ids;
+	Node::edge_iterator_range r = n.outEdges();
+	for (Node::edge_iterator it = r.first; it != r.second; ++it)
+		ids.push_back((*it)->id());
+	r = n.inEdges();
+	for (Node::edge_iterator it = r.first; it != r.second; ++it)
+		ids.push_back((*it)->id());
+	r = n.undirectedEdges();
+	for (Node::edge_iterator it = r.first; it != r.second; ++it)
+		ids.push_back((*it)->id());
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+/// check that @p b is an independent copy of @p a
+void checkCopy(const Graph& a, const Graph& b)
+{
+	BOOST_REQUIRE_EQUAL(a.numberOfNodes(), b.numberOfNodes());
+	BOOST_REQUIRE_EQUAL(a.numberOfEdges(), b.numberOfEdges());
+	BOOST_REQUIRE_EQUAL(a.numberOfNodeStates(), b.numberOfNodeStates());
+	BOOST_REQUIRE_EQUAL(a.numberOfEdgeStates(), b.numberOfEdgeStates());
+	for (node_state_t s = 0; s < a.numberOfNodeStates(); ++s)
+		BOOST_CHECK_EQUAL(a.numberOfNodes(s), b.numberOfNodes(s));
+	for (Graph::ConstNodeIterator it = a.nodes().first; it != a.nodes().second; ++it)
+	{
+		const Node* n = b.node(it.id());
+		BOOST_CHECK(n != &*it);
+		BOOST_CHECK_EQUAL(n->id(), it.id());
+		BOOST_CHECK_EQUAL(b.nodeState(it.id()), a.nodeState(it.id()));
+		BOOST_CHECK_EQUAL(n->outDegree(), it->outDegree());
+		BOOST_CHECK_EQUAL(n->inDegree(), it->inDegree());
+		BOOST_CHECK_EQUAL(n->undirectedDegree(), it->undirectedDegree());
+		const std::vector<edge_id_t> ea = edgeIds(*it), eb = edgeIds(*n);
+		BOOST_CHECK_EQUAL_COLLECTIONS(ea.begin(), ea.end(), eb.begin(), eb.end());
+	}
+	for (Graph::ConstEdgeIterator it = a.edges().first; it != a.edges().second; ++it)
+	{
+		const Edge* e = b.edge(it.id());
+		BOOST_CHECK(e != &*it);
+		BOOST_CHECK_EQUAL(e->id(), it.id());
+		BOOST_CHECK_EQUAL(b.edgeState(it.id()), a.edgeState(it.id()));
+		BOOST_CHECK_EQUAL(e->isDirected(), it->isDirected());
+		BOOST_CHECK_EQUAL(e->source()->id(), it->source()->id());
+		BOOST_CHECK_EQUAL(e->target()->id(), it->target()->id());
+		BOOST_CHECK(e->source() == b.node(e->source()->id()));
+		BOOST_CHECK(e->target() == b.node(e->target()->id()));
+	}
+}
+
+/// random graph with removed elements and mixed states
+void fill(Graph& g, const node_size_t n, const edge_size_t m)
+{
+	boost::mt19937 rng(3);
+	boost::random::uniform_int_distribution<node_state_t> state(0,
+			g.numberOfNodeStates() - 1);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(state(rng));
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	for (edge_size_t i = 0; i < m; ++i)
+		g.addEdge(pick(rng), pick(rng), i % 3 == 0);
+	for (node_id_t i = 0; i < n; i += 7)
+		g.removeNode(i);
+	for (edge_id_t i = 0; i < m / 2; i += 5)
+		if (g.edges().first != g.edges().second)
+			g.removeEdge(g.edges().first.id());
+	g.setEdgeState(g.edges().first.id(), 1);
+}
+
+/// counts node additions
+class NodeCounter: public GraphListener
+{
+public:
+	NodeCounter() :
+		nodes(0)
+	{
+	}
+	node_size_t nodes;
+private:
+	void afterNodeAddEvent(Graph& g, Node& n)
+	{
+		++nodes;
+	}
+	void beforeGraphClearEvent(Graph& g)
+	{
+		nodes = 0;
+	}
+};
+
+/// edge state is 1 if both nodes are in state 1
+struct BothInfected
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return (s == 1) && (t == 1) ? 1 : 0;
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( clone_tests )
+
+BOOST_AUTO_TEST_CASE( clone_graph )
+{
+	Graph g(3, 2);
+	g.setSegmentBits(4);
+	g.setIndexedStates(true);
+	NodeCounter l;
+	g.addGraphListener(&l);
+	fill(g, 100, 300);
+	const node_size_t added = l.nodes;
+
+	std::auto_ptr<Graph> c = g.clone();
+	BOOST_CHECK_EQUAL(l.nodes, added);
+	checkCopy(g, *c);
+
+	// the copy is independent and reuses IDs in the same order
+	BOOST_CHECK_EQUAL(c->addNode(2), g.addNode(2));
+	c->removeNode(c->nodes().first.id());
+	c->setNodeState(c->nodes().first.id(), 0);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), c->numberOfNodes() + 1);
+	BOOST_CHECK_EQUAL(l.nodes, added + 1);
+	c->clear();
+	BOOST_CHECK(g.numberOfEdges() > 0);
+}
+
+BOOST_AUTO_TEST_CASE( clone_factories )
+{
+	Graph multi(2, 2);
+	multi.setElementFactory(std::auto_ptr<ElementFactory>(new MultiEdgeElementFactory));
+	fill(multi, 20, 100); // many parallel edges and loops
+	checkCopy(multi, *multi.clone());
+
+	Graph pooled(2, 2);
+	pooled.setElementFactory(std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<CompactNode> ));
+	fill(pooled, 50, 150);
+	std::auto_ptr<Graph> c = pooled.clone();
+	checkCopy(pooled, *c);
+	pooled.clear(); // recycles the original's pool only
+	BOOST_CHECK_EQUAL(c->numberOfNodes(), 42);
+}
+
+BOOST_AUTO_TEST_CASE( clone_basic_graph )
+{
+	typedef BasicGraph<CompactNode, Edge, GraphElementFactory<CompactNode>,
+			StaticStateConsistencyListener<BothInfected> > graph_t;
+	graph_t g(2, 2);
+	fill(g, 30, 60);
+	std::auto_ptr<graph_t> c = g.clone();
+	checkCopy(g, *c);
+
+	// the static listener of the copy keeps its edge states consistent
+	const edge_id_t e = c->edges().first.id();
+	c->setNodeState(c->edge(e)->source()->id(), 1);
+	c->setNodeState(c->edge(e)->target()->id(), 1);
+	BOOST_CHECK_EQUAL(c->edgeState(e), 1);
+}
+
+BOOST_AUTO_TEST_CASE( swap_graphs )
+{
+	Graph a(2, 2), b(3, 1);
+	a.setElementFactory(std::auto_ptr<ElementFactory>(new MultiEdgeElementFactory));
+	fill(a, 30, 60);
+	b.addNode(2);
+	NodeCounter l;
+	a.addGraphListener(&l);
+	std::auto_ptr<Graph> copy = a.clone();
+
+	swap(a, b);
+	BOOST_CHECK_EQUAL(a.numberOfNodes(), 1);
+	BOOST_CHECK_EQUAL(a.numberOfNodeStates(), 3);
+	BOOST_CHECK_EQUAL(a.nodeState(0), 2);
+	checkCopy(*copy, b);
+	BOOST_CHECK_EQUAL(l.nodes, 1); // listeners see a clear and a reload
+
+	// the element factory moved along with the elements
+	const node_id_t n = b.nodes().first.id();
+	b.addEdge(n, n, false);
+	b.addEdge(n, n, false);
+	a.addNode();
+	BOOST_CHECK_EQUAL(l.nodes, 2); // listeners stay with their graph
+	BOOST_CHECK_EQUAL(b.numberOfEdges(), copy->numberOfEdges() + 2);
+
+	// typed graphs only accept elements from the same kind of factory
+	typedef BasicGraph<CompactNode> graph_t;
+	graph_t c(2, 2);
+	Graph& base = c;
+	BOOST_CHECK_THROW(base.swap(b), std::logic_error);
+	BOOST_CHECK_THROW(b.swap(c), std::logic_error);
+	Graph d(2, 2);
+	d.setElementFactory(std::auto_ptr<ElementFactory>(
+			new graph_t::factory_type));
+	d.addNode(1);
+	base.swap(d);
+	BOOST_CHECK_EQUAL(c.numberOfNodes(), 1);
+	BOOST_CHECK(dynamic_cast<CompactNode*> (base.node(0)) != 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
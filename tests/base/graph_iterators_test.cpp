@@ -3,17 +3,43 @@
 #include <boost/concept_check.hpp>
 
 #include <largenet2.h>
+#include <vector>
 
 using namespace largenet;
 
 BOOST_TEST_DONT_PRINT_LOG_VALUE( Graph::NodeIterator )
 BOOST_TEST_DONT_PRINT_LOG_VALUE( Graph::ConstNodeIterator )
 
+namespace
+{
+
+/// records the ID mapping of the last Graph::compact()
+class CompactRecorder: public GraphListener
+{
+public:
+	std::vector<node_id_t> nodeIds;
+	std::vector<edge_id_t> edgeIds;
+private:
+	void afterGraphCompactEvent(Graph& g, const std::vector<node_id_t>& n,
+			const std::vector<edge_id_t>& e)
+	{
+		nodeIds = n;
+		edgeIds = e;
+	}
+};
+
+}
+
 BOOST_AUTO_TEST_SUITE( graph_iterators )
 
 BOOST_AUTO_TEST_CASE( concepts )
 {
-	BOOST_CONCEPT_ASSERT((boost::ForwardIterator<Graph::NodeIterator>));
+	BOOST_CONCEPT_ASSERT((boost::BidirectionalIterator<Graph::NodeIterator>));
+	BOOST_CONCEPT_ASSERT((boost::BidirectionalIterator<Graph::ConstEdgeIterator>));
+	BOOST_CONCEPT_ASSERT((boost::RandomAccessIterator<Graph::DenseNodeIterator>));
+	BOOST_CONCEPT_ASSERT((boost::RandomAccessIterator<Graph::ConstDenseEdgeIterator>));
+	BOOST_CONCEPT_ASSERT((boost::RandomAccessIterator<Graph::NodeStateIterator>));
+	BOOST_CONCEPT_ASSERT((boost::RandomAccessIterator<Graph::ConstEdgeStateIterator>));
 }
 
 BOOST_AUTO_TEST_CASE( const_iterators )
@@ -37,4 +63,72 @@ BOOST_AUTO_TEST_CASE( const_iterators )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( dense_iteration_and_compact )
+{
+	Graph g(2, 1);
+	for (int i = 0; i < 10; ++i)
+		g.addNode(i % 2);
+	for (node_id_t i = 0; i < 9; ++i)
+		g.addEdge(i, i + 1, true);
+	g.removeNode(0);
+	g.removeNode(4);
+	g.removeNode(9);
+
+	node_size_t n = 0;
+	for (Graph::ConstDenseNodeIterator it = g.denseNodes().first; it
+			!= g.denseNodes().second; ++it, ++n)
+		BOOST_CHECK_EQUAL(it.id(), it->id());
+	BOOST_CHECK_EQUAL(n, 7);
+	BOOST_CHECK_EQUAL(g.denseEdges().second - g.denseEdges().first, 5);
+
+	CompactRecorder rec;
+	g.addGraphListener(&rec);
+	g.compact();
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), 7);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 5);
+	BOOST_CHECK_EQUAL(rec.nodeIds[1], 0);
+	BOOST_CHECK_EQUAL(rec.nodeIds[5], 3);
+	BOOST_CHECK_EQUAL(rec.nodeIds[8], 6);
+	BOOST_CHECK_EQUAL(rec.edgeIds.size(), 8);
+	BOOST_CHECK_EQUAL(rec.edgeIds[1], 0);
+	BOOST_CHECK_EQUAL(rec.edgeIds[5], 2);
+	for (Graph::NodeIterator it = g.nodes().first; it != g.nodes().second; ++it)
+		BOOST_CHECK_EQUAL(it.id(), it->id());
+	for (Graph::EdgeIterator it = g.edges().first; it != g.edges().second; ++it)
+		BOOST_CHECK_EQUAL(it.id(), it->id());
+	// old nodes 1, 2, 3 are now 0, 1, 2; old 5 is now 3
+	BOOST_CHECK(g.isEdge(0, 1));
+	BOOST_CHECK(g.isEdge(1, 2));
+	BOOST_CHECK(!g.isEdge(2, 3));
+	BOOST_CHECK(g.isEdge(3, 4));
+	BOOST_CHECK_EQUAL(g.nodeState(1), 0);
+	BOOST_CHECK_EQUAL(g.nodeState(3), 1);
+	BOOST_CHECK_EQUAL(g.addNode(), 7);
+	g.removeEdge(0);
+	BOOST_CHECK(!g.isEdge(0, 1));
+}
+
+BOOST_AUTO_TEST_CASE( indexed_states )
+{
+	Graph g(200, 1);
+	g.addNode(3);
+	g.setIndexedStates(true);
+	for (int i = 1; i < 400; ++i)
+		g.addNode(i % 200);
+	g.setNodeState(0, 199);
+	g.removeNode(5);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(199), 3);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(3), 2);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(5), 1);
+	node_size_t n = 0;
+	for (Graph::NodeStateIterator it = g.nodes(199).first; it
+			!= g.nodes(199).second; ++it, ++n)
+		BOOST_CHECK_EQUAL(g.nodeState(it->id()), 199);
+	BOOST_CHECK_EQUAL(n, 3);
+	g.setIndexedStates(false);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(199), 3);
+	BOOST_CHECK_EQUAL(g.nodeState(0), 199);
+	BOOST_CHECK_EQUAL(g.nodeState(399), 199);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,91 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/NeighborStateCounter.h>
+
+using namespace largenet;
+
+namespace
+{
+
+/// ring of @p n nodes with undirected edges
+void ring(Graph& g, const node_size_t n)
+{
+	g.addNodes(n);
+	for (node_id_t i = 0; i < n; ++i)
+		g.addEdge(i, (i + 1) % n, false);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( memory_tests )
+
+BOOST_AUTO_TEST_CASE( element_memory )
+{
+	Graph single(1, 1);
+	ring(single, 100);
+	MemoryUsage m = single.memoryUsage();
+	BOOST_CHECK_EQUAL(m.nodes, 100 * sizeof(SingleNode));
+	BOOST_CHECK_EQUAL(m.edges, 100 * sizeof(Edge));
+	// two set entries per edge
+	BOOST_CHECK_EQUAL(m.adjacency % 200, 0);
+	BOOST_CHECK(m.adjacency >= 200 * 4 * sizeof(Edge*));
+	BOOST_CHECK(m.repositories > 200 * (sizeof(Node*) + sizeof(node_id_t)));
+	BOOST_CHECK(m.unused < m.repositories);
+	BOOST_CHECK_EQUAL(m.pool, 0);
+	BOOST_CHECK_EQUAL(m.listeners, 0);
+	BOOST_CHECK_EQUAL(m.total(), m.nodes + m.edges + m.adjacency + m.repositories);
+
+	// edges fit into the inline storage of compact nodes
+	Graph compact(1, 1);
+	compact.setElementFactory(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ));
+	ring(compact, 100);
+	m = compact.memoryUsage();
+	BOOST_CHECK_EQUAL(m.nodes, 100 * sizeof(CompactNode));
+	BOOST_CHECK_EQUAL(m.adjacency, 0);
+	for (node_id_t i = 2; i < 10; ++i)
+		compact.addEdge(0, i, true);
+	BOOST_CHECK(compact.memoryUsage().adjacency >= 10 * sizeof(Edge*));
+	size_t adjacency = 0, unused = 0;
+	compact.node(0)->memoryUsage(adjacency, unused);
+	BOOST_CHECK_EQUAL(adjacency - unused, 10 * sizeof(Edge*));
+
+	Graph indexed(1, 1);
+	indexed.setElementFactory(std::auto_ptr<ElementFactory>(
+			new IndexedElementFactory));
+	ring(indexed, 20);
+	for (node_id_t i = 2; i < 19; ++i)
+		indexed.addEdge(0, i, false);
+	BOOST_REQUIRE(dynamic_cast<const IndexedNode*> (indexed.node(0))->isIndexed());
+	m = indexed.memoryUsage();
+	BOOST_CHECK(m.adjacency > 19 * sizeof(Edge*) + 19 * sizeof(IndexedNode*));
+}
+
+BOOST_AUTO_TEST_CASE( pool_and_listener_memory )
+{
+	Graph g(2, 1);
+	g.setElementFactory(std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<> ));
+	ring(g, 50);
+	MemoryUsage m = g.memoryUsage();
+	BOOST_CHECK_EQUAL(m.nodes, 50 * sizeof(SingleNode));
+	BOOST_CHECK(m.pool > 0);
+	BOOST_CHECK(m.unused >= m.pool);
+	g.clear(); // keeps the pool
+	m = g.memoryUsage();
+	BOOST_CHECK_EQUAL(m.nodes + m.edges + m.adjacency, 0);
+	BOOST_CHECK(m.pool >= 50 * (sizeof(SingleNode) + sizeof(Edge)));
+
+	ring(g, 50);
+	NeighborStateCounter c(g);
+	NodeProperty<double> p(g);
+	g.addGraphListener(&c);
+	g.addGraphListener(&p);
+	m = g.memoryUsage();
+	BOOST_CHECK_EQUAL(m.listeners, c.memoryUsage() + p.memoryUsage());
+	BOOST_CHECK(c.memoryUsage() >= 50 * 3 * 2 * sizeof(degree_t));
+	BOOST_CHECK(p.memoryUsage() >= 50 * sizeof(double));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
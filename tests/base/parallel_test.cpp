@@ -0,0 +1,233 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/measures/measures.h>
+#include <largenet2/measures/counts.h>
+#include <largenet2/motifs/LinkMotif.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace largenet;
+
+namespace
+{
+
+/// random graph with removed elements, so that IDs and addresses differ
+void fill(Graph& g, const node_size_t n, const edge_size_t m)
+{
+	boost::mt19937 rng(11);
+	boost::random::uniform_int_distribution<node_state_t> state(0,
+			g.numberOfNodeStates() - 1);
+	for (node_size_t i = 0; i < n; ++i)
+		g.addNode(state(rng));
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	for (edge_size_t i = 0; i < m; ++i)
+		g.addEdge(pick(rng), pick(rng), i % 4 == 0);
+	for (node_id_t i = 0; i < n; i += 9)
+		g.removeNode(i);
+}
+
+/// marks visited nodes
+struct Mark
+{
+	Mark(std::vector<int>& v) :
+		visited(v)
+	{
+	}
+	void operator()(const Node& n) const
+	{
+		++visited[n.id()]; // each node is visited by one thread only
+	}
+	std::vector<int>& visited;
+};
+
+/// sums up node IDs and degrees
+struct DegreeSum
+{
+	DegreeSum() :
+		ids(0), degrees(0)
+	{
+	}
+	void operator()(const Node& n)
+	{
+		ids += n.id();
+		degrees += n.degree();
+	}
+	void join(const DegreeSum& other)
+	{
+		ids += other.ids;
+		degrees += other.degrees;
+	}
+	node_id_t ids;
+	degree_t degrees;
+};
+
+/// counts edges
+struct EdgeCount
+{
+	EdgeCount() :
+		edges(0)
+	{
+	}
+	void operator()(const Edge&)
+	{
+		++edges;
+	}
+	void join(const EdgeCount& other)
+	{
+		edges += other.edges;
+	}
+	edge_size_t edges;
+};
+
+/// traverses all nodes of a graph by ID for each node it is called on
+struct Traversals
+{
+	Traversals(const Graph& g) :
+		g(&g), mismatches(0)
+	{
+	}
+	void operator()(const Node& n)
+	{
+		node_size_t count = 0;
+		for (Graph::ConstNodeIterator it = g->nodes().first; it
+				!= g->nodes().second; ++it)
+			++count;
+		if ((count != g->numberOfNodes()) || (g->nodes().first.id() != 1))
+			++mismatches;
+	}
+	void join(const Traversals& other)
+	{
+		mismatches += other.mismatches;
+	}
+	const Graph* g;
+	node_size_t mismatches;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( parallel_tests )
+
+BOOST_AUTO_TEST_CASE( split_range )
+{
+	std::vector<int> v(10);
+	typedef std::pair<std::vector<int>::iterator, std::vector<int>::iterator>
+			range;
+	const range r(v.begin(), v.end());
+	for (unsigned int parts = 1; parts < 14; ++parts)
+	{
+		std::vector<int>::iterator next = v.begin();
+		for (unsigned int i = 0; i < parts; ++i)
+		{
+			const range p = splitRange(r, parts, i);
+			BOOST_CHECK(p.first == next);
+			const long size = p.second - p.first;
+			BOOST_CHECK(size == 10 / parts || size == 10 / parts + 1);
+			next = p.second;
+		}
+		BOOST_CHECK(next == v.end());
+	}
+
+	Graph g(3, 2);
+	fill(g, 100, 300);
+	const Graph::NodeStateIteratorRange s = g.nodes(1);
+	node_size_t n = 0;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		const Graph::NodeStateIteratorRange p = splitRange(s, 4, i);
+		for (Graph::NodeStateIterator it = p.first; it != p.second; ++it)
+		{
+			BOOST_CHECK_EQUAL(g.nodeState(it->id()), 1);
+			++n;
+		}
+	}
+	BOOST_CHECK_EQUAL(n, g.numberOfNodes(1));
+}
+
+BOOST_AUTO_TEST_CASE( for_each )
+{
+	Graph g(3, 2);
+	fill(g, 200, 600);
+	std::vector<int> all(200, 0), state(200, 0);
+	for (Graph::ConstNodeIterator it = g.nodes().first; it != g.nodes().second; ++it)
+	{
+		all[it.id()] = 1;
+		state[it.id()] = g.nodeState(it.id()) == 2 ? 1 : 0;
+	}
+
+	std::vector<int> visited(200, 0);
+	parallel_for_each_node(g, Mark(visited));
+	BOOST_CHECK_EQUAL_COLLECTIONS(visited.begin(), visited.end(), all.begin(), all.end());
+	std::fill(visited.begin(), visited.end(), 0);
+	parallel_for_each_node(g, 2, Mark(visited));
+	BOOST_CHECK_EQUAL_COLLECTIONS(visited.begin(), visited.end(), state.begin(), state.end());
+}
+
+BOOST_AUTO_TEST_CASE( reduce )
+{
+	Graph g(3, 2);
+	fill(g, 500, 2000);
+	g.setEdgeState(g.edges().first.id(), 1);
+
+	DegreeSum serial;
+	for (Graph::ConstNodeIterator it = g.nodes().first; it != g.nodes().second; ++it)
+		serial(*it);
+	DegreeSum all;
+	parallel_reduce(g.denseNodes(), all);
+	BOOST_CHECK_EQUAL(all.ids, serial.ids);
+	BOOST_CHECK_EQUAL(all.degrees, serial.degrees);
+
+	DegreeSum states;
+	for (node_state_t s = 0; s < g.numberOfNodeStates(); ++s)
+	{
+		DegreeSum part;
+		parallel_reduce(g.nodes(s), part);
+		states.join(part);
+	}
+	BOOST_CHECK_EQUAL(states.ids, serial.ids);
+	BOOST_CHECK_EQUAL(states.degrees, serial.degrees);
+
+	EdgeCount edges;
+	parallel_reduce(g.denseEdges(), edges);
+	BOOST_CHECK_EQUAL(edges.edges, g.numberOfEdges());
+	EdgeCount state1;
+	parallel_reduce(g.edges(1), state1);
+	BOOST_CHECK_EQUAL(state1.edges, 1);
+}
+
+BOOST_AUTO_TEST_CASE( concurrent_id_traversal )
+{
+	// the nodes with the smallest and largest IDs have been removed
+	Graph g(2, 1);
+	fill(g, 200, 600);
+	g.removeNode(199);
+	Traversals t(g);
+	parallel_reduce(g.denseNodes(), t);
+	BOOST_CHECK_EQUAL(t.mismatches, 0);
+	BOOST_CHECK_EQUAL((--g.nodes().second).id(), 197);
+}
+
+BOOST_AUTO_TEST_CASE( parallel_measures )
+{
+	Graph g(2, 1);
+	fill(g, 300, 1200);
+	degree_t min = g.numberOfEdges(), max = 0;
+	for (Graph::ConstNodeIterator it = g.nodes().first; it != g.nodes().second; ++it)
+	{
+		min = std::min(min, it->outDegree());
+		max = std::max(max, it->outDegree());
+	}
+	BOOST_CHECK(measures::outDegreeRange(g) == std::make_pair(min, max));
+
+	// undirected links between a node in state 0 and one in state 1
+	size_t links = 0;
+	for (Graph::ConstEdgeIterator it = g.edges().first; it != g.edges().second; ++it)
+		if (!it->isDirected() && !it->isLoop() && g.nodeState(
+				it->source()->id()) != g.nodeState(it->target()->id()))
+			++links;
+	BOOST_CHECK_EQUAL(measures::edges(g, motifs::LinkMotif(0, 1, false)), links);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
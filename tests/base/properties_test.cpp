@@ -0,0 +1,79 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/measures/spectrum.h>
+#include <numeric>
+#include <vector>
+
+using namespace largenet;
+
+BOOST_AUTO_TEST_SUITE( properties_tests )
+
+BOOST_AUTO_TEST_CASE( node_property )
+{
+	Graph g(2, 1);
+	g.addNodes(3);
+	NodeProperty<double> p(g, 0.5); // existing nodes get the default value
+	g.addGraphListener(&p);
+	BOOST_CHECK_EQUAL(p.defaultValue(), 0.5);
+	BOOST_CHECK_EQUAL(p[2], 0.5);
+	BOOST_CHECK(p.size() >= 3);
+
+	p[1] = 2;
+	for (node_id_t i = 0; i < 20; ++i)
+		g.addNode();
+	BOOST_REQUIRE(p.size() >= 23);
+	BOOST_CHECK_EQUAL(p[1], 2);
+	BOOST_CHECK_EQUAL(p[22], 0.5);
+	p[22] = 3;
+
+	g.removeNode(1); // removed nodes are reset, so their IDs can be reused
+	BOOST_CHECK_EQUAL(p[1], 0.5);
+	const node_id_t n = g.addNode();
+	BOOST_CHECK_EQUAL(n, 1);
+	BOOST_CHECK_EQUAL(p[n], 0.5);
+
+	g.removeNode(0);
+	g.removeNode(5);
+	g.compact();
+	BOOST_CHECK_EQUAL(p.size(), g.numberOfNodes());
+	BOOST_CHECK_EQUAL(p[20], 3); // node 22 moved to 20
+	BOOST_CHECK_EQUAL(std::accumulate(p.begin(), p.end(), 0.0), 20 * 0.5 + 3);
+
+	p.fill(1);
+	BOOST_CHECK_EQUAL(std::accumulate(p.begin(), p.end(), 0.0), 21);
+	g.clear();
+	BOOST_CHECK_EQUAL(p.size(), 0);
+	g.addNode();
+	BOOST_CHECK_EQUAL(p[0], 0.5);
+}
+
+BOOST_AUTO_TEST_CASE( edge_property )
+{
+	Graph g(1, 1);
+	g.addNodes(4);
+	g.addEdge(0, 1, false);
+	g.addEdge(1, 2, false);
+	EdgeProperty<double> w(g, 1);
+	g.addGraphListener(&w);
+	const edge_id_t e = g.addEdge(2, 3, false);
+	w[e] = 4;
+	BOOST_CHECK_EQUAL(w[0], 1);
+	BOOST_CHECK_EQUAL(w(e), 4);
+
+	// edges of removed nodes are reset, too
+	g.removeNode(3);
+	BOOST_CHECK_EQUAL(w[e], 1);
+
+	// use as edge weight provider
+	w[1] = 3;
+	measures::sparse_dmatrix_t m = measures::weighted_adjacency_matrix(g, w);
+	BOOST_CHECK_EQUAL(m(0, 1), 1);
+	BOOST_CHECK_EQUAL(m(2, 1), 3);
+
+	EdgeProperty<int> flags(g);
+	BOOST_CHECK_EQUAL(flags[1], 0);
+	BOOST_CHECK_EQUAL(std::accumulate(flags.begin(), flags.end(), 0), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
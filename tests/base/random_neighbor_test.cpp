@@ -0,0 +1,143 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <stdexcept>
+#include <map>
+
+using namespace largenet;
+
+namespace
+{
+
+/// random number generator providing the interface expected by the graph
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// star around node 0 with out-, in-, and undirected edges
+void star(Graph& g)
+{
+	g.addNodes(7, 0);
+	g.addEdge(0, 1, true);
+	g.addEdge(0, 2, true);
+	g.addEdge(3, 0, true);
+	g.addEdge(0, 4, false);
+	g.addEdge(5, 0, false);
+	g.addEdge(0, 6, false);
+	g.setNodeState(2, 1);
+	g.setNodeState(5, 1);
+}
+
+/// check that all edges of the star are selected, and only those
+void checkSelection(Graph& g)
+{
+	Rng rng(5);
+	const Node* n = g.node(0);
+	std::map<node_id_t, int> out, in, un, all, state;
+	for (int i = 0; i < 3000; ++i)
+	{
+		++out[n->randomOutEdge(rng)->target()->id()];
+		++in[n->randomInEdge(rng)->source()->id()];
+		++un[n->randomUndirectedNeighbor(rng)->id()];
+		++all[n->randomNeighbor(rng)->id()];
+		++state[g.randomNeighbor(0, 1, rng)->id()];
+		BOOST_CHECK(n->hasOutEdge(n->randomOutEdge(rng)));
+		BOOST_CHECK(n->hasUndirectedEdge(n->randomUndirectedEdge(rng)));
+		BOOST_CHECK(n->hasEdge(n->randomEdge(rng)));
+	}
+	BOOST_CHECK_EQUAL(out.size(), 2);
+	BOOST_CHECK(out[1] > 1300 && out[2] > 1300);
+	BOOST_CHECK_EQUAL(in.size(), 1);
+	BOOST_CHECK_EQUAL(in[3], 3000);
+	BOOST_CHECK_EQUAL(un.size(), 3);
+	BOOST_CHECK(un[4] > 800 && un[5] > 800 && un[6] > 800);
+	BOOST_CHECK_EQUAL(all.size(), 6);
+	for (node_id_t i = 1; i < 7; ++i)
+		BOOST_CHECK(all[i] > 350);
+	BOOST_CHECK_EQUAL(state.size(), 2);
+	BOOST_CHECK(state[2] > 1300 && state[5] > 1300);
+	BOOST_CHECK(n->hasEdgeTo(n->randomOutNeighbor(rng)));
+	BOOST_CHECK_EQUAL(n->randomInNeighbor(rng)->id(), 3);
+}
+
+/// accepts only node 6
+struct IsSix
+{
+	bool operator()(const Node& n) const
+	{
+		return n.id() == 6;
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE( random_neighbor_tests )
+
+BOOST_AUTO_TEST_CASE( node_types )
+{
+	Graph single(2, 1);
+	star(single);
+	checkSelection(single);
+
+	Graph compact(2, 1);
+	compact.setElementFactory(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ));
+	star(compact);
+	checkSelection(compact);
+
+	Graph indexed(2, 1);
+	indexed.setElementFactory(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<IndexedNode> ));
+	star(indexed);
+	checkSelection(indexed);
+
+	Graph multi(2, 1);
+	multi.setElementFactory(std::auto_ptr<ElementFactory>(new MultiEdgeElementFactory));
+	star(multi);
+	checkSelection(multi);
+}
+
+BOOST_AUTO_TEST_CASE( rare_and_missing )
+{
+	// node types with and without positional access to their edges
+	Graph compact(3, 1), single(3, 1);
+	compact.setElementFactory(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ));
+	Graph* graphs[2] = { &compact, &single };
+	for (int k = 0; k < 2; ++k)
+	{
+		Graph& g = *graphs[k];
+		g.addNodes(101, 0);
+		for (node_id_t i = 1; i <= 100; ++i)
+			g.addEdge(0, i, false);
+		g.addEdge(0, 100, true);
+		g.setNodeState(6, 1);
+		Rng rng(7);
+		const Node* n = g.node(0);
+		for (int i = 0; i < 20; ++i)
+		{
+			BOOST_CHECK_EQUAL(g.randomNeighbor(0, 1, rng)->id(), 6);
+			BOOST_CHECK_EQUAL(n->randomNeighbor(rng, IsSix())->id(), 6);
+		}
+		BOOST_CHECK_THROW(g.randomNeighbor(0, 2, rng), std::invalid_argument);
+		BOOST_CHECK_THROW(n->randomInEdge(rng), std::invalid_argument);
+		BOOST_CHECK_THROW(g.node(1)->randomInNeighbor(rng), std::invalid_argument);
+		BOOST_CHECK_EQUAL(g.node(1)->randomNeighbor(rng)->id(), 0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,244 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/base/orderings.h>
+#include <largenet2/NeighborStateCounter.h>
+#include <largenet2/WeightedSampler.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <vector>
+#include <memory>
+
+using namespace largenet;
+
+namespace
+{
+
+typedef boost::tuple<node_id_t, node_id_t, bool, edge_state_t, int> EdgeData;
+
+/// edges of @p g with their data, with the nodes renamed by @p nodeIds
+std::vector<EdgeData> edgeData(const Graph& g, const EdgeProperty<int>& p,
+		const std::vector<node_id_t>& nodeIds)
+{
+	std::vector<EdgeData> v;
+	for (Graph::ConstEdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+		v.push_back(boost::make_tuple(nodeIds[e->source()->id()],
+				nodeIds[e->target()->id()], e->isDirected(), g.edgeState(e.id()),
+				p[e.id()]));
+	std::sort(v.begin(), v.end());
+	return v;
+}
+
+/// random graph with directed and undirected edges and some free IDs
+void fill(Graph& g, const int n, const int m)
+{
+	boost::mt19937 rng(5);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, n - 1);
+	for (int i = 0; i < n; ++i)
+		g.addNode(i % 3 == 0 ? 1 : 0);
+	for (int i = 0; i < m; ++i)
+	{
+		const edge_id_t e = g.addEdge(pick(rng), pick(rng), i % 4 == 0);
+		g.setEdgeState(e, i % 2);
+	}
+	g.removeNode(4);
+	g.removeNode(11);
+	g.removeEdge(g.edges().first.id());
+}
+
+/// largest difference between the IDs of adjacent nodes
+node_id_t bandwidth(const Graph& g)
+{
+	node_id_t b = 0;
+	for (Graph::ConstEdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+	{
+		const node_id_t s = e->source()->id(), t = e->target()->id();
+		b = std::max(b, s > t ? s - t : t - s);
+	}
+	return b;
+}
+
+/// check that @p order lists each node of @p g once
+void checkPermutation(const Graph& g, std::vector<node_id_t> order)
+{
+	std::vector<node_id_t> ids;
+	for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+		ids.push_back(n.id());
+	std::sort(order.begin(), order.end());
+	BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), ids.begin(), ids.end());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( relabel_tests )
+
+BOOST_AUTO_TEST_CASE( relabel_nodes )
+{
+	Graph g(2, 2);
+	g.setElementFactory(std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<> ));
+	fill(g, 40, 120);
+	NodeProperty<int> np(g);
+	EdgeProperty<int> ep(g);
+	g.addGraphListener(&np).addGraphListener(&ep);
+	for (Graph::NodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+		np[n.id()] = 1000 + n.id();
+	for (Graph::EdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+		ep[e.id()] = 2000 + e.id();
+	NeighborStateCounter c(g);
+	NodeSampler ns(g);
+	g.addGraphListener(&c).addGraphListener(&ns);
+
+	std::vector<node_id_t> order, states;
+	for (Graph::NodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+		order.push_back(n.id());
+	std::reverse(order.begin(), order.end());
+	std::vector<node_id_t> identity(40);
+	for (node_id_t i = 0; i < identity.size(); ++i)
+		identity[i] = i;
+	for (size_t i = 0; i < order.size(); ++i)
+		states.push_back(g.nodeState(order[i]));
+	const std::vector<EdgeData> before = edgeData(g, ep, identity);
+
+	const std::vector<node_id_t> ids = g.relabel(order);
+	BOOST_REQUIRE_EQUAL(ids.size(), 40);
+	BOOST_CHECK_EQUAL(ids[4], std::numeric_limits<node_id_t>::max());
+	BOOST_CHECK_EQUAL(ids[39], 0);
+	BOOST_CHECK_EQUAL(ids[0], 37);
+	BOOST_REQUIRE_EQUAL(g.numberOfNodes(), 38);
+	for (node_id_t i = 0; i < g.numberOfNodes(); ++i)
+	{
+		BOOST_REQUIRE(g.node(i) != 0);
+		BOOST_CHECK_EQUAL(g.node(i)->id(), i);
+		BOOST_CHECK_EQUAL(g.nodeState(i), states[i]);
+		BOOST_CHECK_EQUAL(np[i], 1000 + order[i]);
+		BOOST_CHECK_EQUAL(c.undirectedNeighbors(i, 1),
+				NeighborStateCounter(g).undirectedNeighbors(i, 1));
+		BOOST_CHECK_CLOSE(ns.weight(i), g.node(i)->degree(), 1e-9);
+		// the pool hands out memory in the order of the new IDs
+		if (i > 0)
+			BOOST_CHECK(g.node(i - 1) < g.node(i));
+	}
+	const std::vector<EdgeData> after = edgeData(g, ep, identity);
+	std::vector<EdgeData> expected;
+	for (size_t i = 0; i < before.size(); ++i)
+	{
+		EdgeData d = before[i];
+		d.get<0> () = ids[d.get<0> ()];
+		d.get<1> () = ids[d.get<1> ()];
+		expected.push_back(d);
+	}
+	std::sort(expected.begin(), expected.end());
+	BOOST_CHECK(after == expected);
+	// edges are numbered in the order of their first end
+	node_id_t last = 0;
+	for (edge_id_t e = 0; e < g.numberOfEdges(); ++e)
+	{
+		const Edge* ed = g.edge(e);
+		BOOST_REQUIRE(ed != 0);
+		const node_id_t first = ed->isDirected() ? ed->source()->id()
+				: std::min(ed->source()->id(), ed->target()->id());
+		BOOST_CHECK(first >= last);
+		last = first;
+	}
+	g.removeGraphListener(&ns);
+	g.removeGraphListener(&c);
+	g.removeGraphListener(&ep);
+	g.removeGraphListener(&np);
+}
+
+BOOST_AUTO_TEST_CASE( relabel_invalid_orders )
+{
+	Graph g(2, 2);
+	fill(g, 20, 40);
+	std::vector<node_id_t> order;
+	for (Graph::NodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+		order.push_back(n.id());
+	order.pop_back();
+	BOOST_CHECK_THROW(g.relabel(order), std::invalid_argument);
+	order.push_back(order.front());
+	BOOST_CHECK_THROW(g.relabel(order), std::invalid_argument);
+	order.back() = 4;
+	BOOST_CHECK_THROW(g.relabel(order), std::invalid_argument);
+	order.back() = 19;
+	g.beginTransaction();
+	BOOST_CHECK_THROW(g.relabel(order), std::logic_error);
+	g.rollback();
+	BOOST_CHECK_NO_THROW(g.relabel(order));
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), 18);
+}
+
+BOOST_AUTO_TEST_CASE( locality_orderings )
+{
+	// a 20 x 20 lattice with shuffled node IDs
+	const int L = 20;
+	Graph g(1, 1);
+	std::vector<node_id_t> cell(L * L);
+	for (int i = 0; i < L * L; ++i)
+		cell[i] = i;
+	boost::mt19937 rng(7);
+	for (int i = L * L - 1; i > 0; --i)
+		std::swap(cell[i], cell[boost::random::uniform_int_distribution<int>(0,
+				i)(rng)]);
+	g.addNodes(L * L);
+	for (int r = 0; r < L; ++r)
+		for (int col = 0; col < L; ++col)
+		{
+			if (col + 1 < L)
+				g.addEdge(cell[r * L + col], cell[r * L + col + 1], false);
+			if (r + 1 < L)
+				g.addEdge(cell[r * L + col], cell[(r + 1) * L + col], false);
+		}
+	BOOST_CHECK(bandwidth(g) > 10 * L);
+
+	checkPermutation(g, orderings::breadthFirst(g));
+	checkPermutation(g, orderings::degreeDescending(g));
+	checkPermutation(g, orderings::communities(g));
+	const std::vector<node_id_t> rcm = orderings::reverseCuthillMcKee(g);
+	checkPermutation(g, rcm);
+	g.relabel(rcm);
+	BOOST_CHECK(bandwidth(g) <= 2 * L);
+
+	g.relabel(orderings::degreeDescending(g));
+	for (node_id_t i = 1; i < g.numberOfNodes(); ++i)
+		BOOST_CHECK(g.node(i - 1)->degree() >= g.node(i)->degree());
+}
+
+BOOST_AUTO_TEST_CASE( community_ordering )
+{
+	// cliques joined in a ring, with interleaved node IDs
+	const int k = 8, cliques = 6;
+	Graph g(1, 1);
+	g.addNodes(k * cliques);
+	for (int c = 0; c < cliques; ++c)
+	{
+		for (int i = 0; i < k; ++i)
+			for (int j = i + 1; j < k; ++j)
+				g.addEdge(i * cliques + c, j * cliques + c, false);
+		g.addEdge(c, (k - 1) * cliques + (c + 1) % cliques, false);
+	}
+	g.relabel(orderings::communities(g));
+	// each clique gets a contiguous range of IDs
+	edge_size_t inside = 0;
+	for (Graph::EdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+	{
+		if (e->source()->id() / k == e->target()->id() / k)
+			++inside;
+	}
+	BOOST_CHECK_EQUAL(inside, cliques * k * (k - 1) / 2);
+
+	// isolated nodes and an empty graph
+	g.addNodes(3);
+	checkPermutation(g, orderings::reverseCuthillMcKee(g));
+	checkPermutation(g, orderings::communities(g));
+	Graph empty(1, 1);
+	BOOST_CHECK(orderings::breadthFirst(empty).empty());
+	BOOST_CHECK(empty.relabel(std::vector<node_id_t>()).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,12 @@
 #include <largenet2/base/repo/CPtrRepository.h>
 #include <memory>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
 
 #include "test_types.h"
 
@@ -109,6 +115,227 @@ BOOST_AUTO_TEST_CASE( ptr_repo_memory )
 	BOOST_CHECK_EQUAL(100, c.capacity());
 }
 
+BOOST_AUTO_TEST_CASE( ptr_repo_segmented )
+{
+	ptr_rep_type c(3, 10);
+	c.setSegmentBits(4); // segments of 16 items
+	BOOST_CHECK_EQUAL(c.segmentBits(), 4);
+	ptr_fillRepo(c, 10);
+	c << new val_type(11);
+	BOOST_CHECK_EQUAL(c.capacity(), 26); // grows by one segment
+	c.reserve(40);
+	BOOST_CHECK_EQUAL(c.capacity(), 48); // rounded up to full segments
+	ptr_fillRepo(c, 37);
+	BOOST_CHECK_EQUAL(c.size(), 48);
+	c.erase(20);
+	c.setCategory(21, 2);
+
+	// switching back to contiguous storage preserves all items
+	c.setSegmentBits(0);
+	BOOST_CHECK_EQUAL(c.size(), 47);
+	BOOST_CHECK(!c.valid(20));
+	BOOST_CHECK_EQUAL(c[21], 11);
+	BOOST_CHECK_EQUAL(c.category(21), 2);
+	BOOST_CHECK_EQUAL(c[47], 37);
+	BOOST_CHECK_THROW(c.setSegmentBits(31), std::invalid_argument);
+
+	c.clear();
+	BOOST_CHECK_EQUAL(c.size(), 0);
+	BOOST_CHECK_EQUAL(c.capacity(), 48);
+}
+
+BOOST_AUTO_TEST_CASE( ptr_repo_dense_compact )
+{
+	ptr_rep_type c(3, 20);
+	ptr_fillRepo(c, 20);
+	for (repo::id_t i = 0; i < 20; i += 3)
+		c.erase(i);
+	c.erase(19);
+	BOOST_CHECK_EQUAL(c.size(), 12);
+	BOOST_CHECK_EQUAL(c.minID(), 1);
+	BOOST_CHECK_EQUAL(c.maxID(), 17);
+
+	// dense iteration visits every item once
+	ptr_rep_type::DenseIteratorRange d = c.denseItems();
+	BOOST_CHECK_EQUAL(d.second - d.first, 12);
+	int sum = 0;
+	for (ptr_rep_type::DenseIterator it = d.first; it != d.second; ++it)
+	{
+		BOOST_CHECK(c.valid(it.id()));
+		BOOST_CHECK_EQUAL(c.category(it.id()), it.category());
+		BOOST_CHECK_EQUAL(*it, c[it.id()]);
+		sum += *it;
+	}
+	BOOST_CHECK_EQUAL(sum, 2 + 3 + 5 + 6 + 8 + 9 + 11 + 12 + 14 + 15 + 17 + 18);
+	BOOST_CHECK_EQUAL(d.first[11], *(d.second - 1));
+
+	std::vector<repo::id_t> newIds;
+	c.compact(newIds);
+	BOOST_CHECK_EQUAL(newIds.size(), 18);
+	BOOST_CHECK_EQUAL(newIds[1], 0);
+	BOOST_CHECK_EQUAL(newIds[2], 1);
+	BOOST_CHECK_EQUAL(newIds[17], 11);
+	BOOST_CHECK_EQUAL(newIds[3], std::numeric_limits<repo::id_t>::max());
+	BOOST_CHECK_EQUAL(c.size(), 12);
+	BOOST_CHECK_EQUAL(c.minID(), 0);
+	BOOST_CHECK_EQUAL(c.maxID(), 11);
+	BOOST_CHECK_EQUAL(c[0], 2);
+	BOOST_CHECK_EQUAL(c[11], 18);
+	BOOST_CHECK_EQUAL(c.category(11), 17 % 3);
+	BOOST_CHECK_EQUAL(c.count(2), 6);
+	BOOST_CHECK(!c.valid(12));
+
+	// freed IDs are reused after compaction
+	BOOST_CHECK_EQUAL(c.insert(new val_type(99)), 12);
+	BOOST_CHECK_EQUAL(c.maxID(), 12);
+}
+
+namespace
+{
+/// sorted IDs of all items in category @p cat
+std::vector<repo::id_t> members(const ptr_rep_type& c, repo::category_t cat)
+{
+	std::vector<repo::id_t> ids;
+	for (ptr_rep_type::ConstCategoryIterator it = c.begin(cat); it != c.end(cat); ++it)
+	{
+		BOOST_CHECK_EQUAL(c.category(it.id()), cat);
+		ids.push_back(it.id());
+	}
+	std::sort(ids.begin(), ids.end());
+	return ids;
+}
+
+void checkSameCategories(const ptr_rep_type& a, const ptr_rep_type& b)
+{
+	BOOST_REQUIRE_EQUAL(a.size(), b.size());
+	BOOST_REQUIRE_EQUAL(a.numberOfCategories(), b.numberOfCategories());
+	for (repo::category_t cat = 0; cat < a.numberOfCategories(); ++cat)
+	{
+		BOOST_REQUIRE_EQUAL(a.count(cat), b.count(cat));
+		const std::vector<repo::id_t> ma = members(a, cat), mb = members(b, cat);
+		BOOST_CHECK_EQUAL_COLLECTIONS(ma.begin(), ma.end(), mb.begin(), mb.end());
+	}
+	for (ptr_rep_type::ConstDenseIterator it = a.denseItems().first; it
+			!= a.denseItems().second; ++it)
+		BOOST_CHECK_EQUAL(it.category(), b.category(it.id()));
+}
+}
+
+BOOST_AUTO_TEST_CASE( ptr_repo_indexed_categories )
+{
+	const repo::category_t C = 50;
+	ptr_rep_type plain(C, 10), indexed(C, 10);
+	indexed.setIndexedCategories(true);
+	BOOST_CHECK(indexed.indexedCategories());
+	boost::mt19937 rng(5);
+	boost::random::uniform_int_distribution<repo::category_t> cat(0, C - 1);
+	boost::random::uniform_int_distribution<int> op(0, 3);
+	for (int i = 0; i < 3000; ++i)
+	{
+		const int o = op(rng);
+		if ((o == 0) || (plain.size() < 10))
+		{
+			const repo::category_t c = cat(rng);
+			BOOST_REQUIRE_EQUAL(plain.insert(new val_type(i), c),
+					indexed.insert(new val_type(i), c));
+		}
+		else
+		{
+			boost::random::uniform_int_distribution<repo::address_t> pick(0,
+					plain.size() - 1);
+			const repo::id_t id = plain.id(pick(rng));
+			if (o == 1)
+			{
+				plain.erase(id);
+				indexed.erase(id);
+			}
+			else
+			{
+				const repo::category_t c = cat(rng);
+				plain.setCategory(id, c);
+				indexed.setCategory(id, c);
+			}
+		}
+	}
+	checkSameCategories(plain, indexed);
+	BOOST_CHECK_EQUAL(indexed[indexed.id(7, 0)], plain[indexed.id(7, 0)]);
+
+	// switching modes preserves all categories
+	indexed.setIndexedCategories(false);
+	checkSameCategories(plain, indexed);
+	indexed.setIndexedCategories(true);
+	checkSameCategories(plain, indexed);
+
+	std::vector<repo::id_t> plainIds, indexedIds;
+	plain.compact(plainIds);
+	indexed.compact(indexedIds);
+	BOOST_CHECK(plainIds == indexedIds);
+	checkSameCategories(plain, indexed);
+
+	plain.setNumberOfCategories(10);
+	indexed.setNumberOfCategories(10);
+	checkSameCategories(plain, indexed);
+	BOOST_CHECK_EQUAL(indexed.count(9), plain.count(9));
+
+	indexed.clear();
+	BOOST_CHECK_EQUAL(indexed.size(), 0);
+	BOOST_CHECK_EQUAL(indexed.count(9), 0);
+	indexed.insert(new val_type(1), 9);
+	BOOST_CHECK_EQUAL(indexed.count(9), 1);
+}
+
+namespace
+{
+struct CopyInt
+{
+	val_type* operator()(const val_type& v) const
+	{
+		return new val_type(v);
+	}
+};
+}
+
+BOOST_AUTO_TEST_CASE( ptr_repo_assign_swap )
+{
+	for (int indexed = 0; indexed < 2; ++indexed)
+	{
+		ptr_rep_type c(4, 10);
+		c.setSegmentBits(2);
+		c.setIndexedCategories(indexed == 1);
+		ptr_fillRepo(c, 30);
+		for (repo::id_t i = 0; i < 30; i += 4)
+			c.erase(i);
+		c.setCategory(5, 3);
+
+		ptr_rep_type copy(1, 5);
+		ptr_fillRepo(copy, 3, 0); // replaced by the copy
+		copy.assign(c, CopyInt());
+		BOOST_CHECK_EQUAL(copy.segmentBits(), 2);
+		BOOST_CHECK_EQUAL(copy.indexedCategories(), indexed == 1);
+		BOOST_CHECK_EQUAL(copy.minID(), c.minID());
+		BOOST_CHECK_EQUAL(copy.maxID(), c.maxID());
+		checkSameCategories(c, copy);
+		for (ptr_rep_type::const_iterator it = c.begin(); it != c.end(); ++it)
+		{
+			BOOST_CHECK_EQUAL(copy[it.id()], *it);
+			BOOST_CHECK(&copy[it.id()] != &*it);
+		}
+		for (repo::address_t n = 0; n < c.size(); ++n)
+			BOOST_CHECK_EQUAL(copy.id(n), c.id(n));
+		// freed IDs are reused in the same order
+		BOOST_CHECK_EQUAL(copy.insert(new val_type(99), 1), c.insert(
+				new val_type(99), 1));
+
+		ptr_rep_type other(4, 10);
+		ptr_fillRepo(other, 2);
+		other.swap(copy);
+		BOOST_CHECK_EQUAL(copy.size(), 2);
+		checkSameCategories(c, other);
+		copy.clear();
+		BOOST_CHECK_EQUAL(other.size(), c.size());
+	}
+}
+
 BOOST_AUTO_TEST_CASE( ptr_repo_index_iterator )
 {
 	const int rep_size = 10;
@@ -174,6 +401,53 @@ BOOST_AUTO_TEST_CASE( ptr_repo_index_iterator_del )
 	BOOST_CHECK_EQUAL(95, i);
 }
 
+BOOST_AUTO_TEST_CASE( ptr_repo_random_access )
+{
+	ptr_rep_type c(3, 100);
+	ptr_fillRepo(c, 100);
+	c.erase(0);
+	c.erase(5);
+	c.erase(6);
+	c.erase(50);
+
+	// index iterators are bidirectional, skipping unused IDs
+	BOOST_CHECK_EQUAL(96, std::distance(c.begin(), c.end()));
+	ptr_rep_type::iterator it = c.begin();
+	std::advance(it, 4);
+	BOOST_CHECK_EQUAL(7, it.id());
+	std::advance(it, 46);
+	BOOST_CHECK_EQUAL(54, it.id());
+	--it;
+	--it;
+	BOOST_CHECK_EQUAL(51, (--it).id());
+	BOOST_CHECK_EQUAL(49, (--it).id());
+	ptr_rep_type::const_iterator last = c.end();
+	--last;
+	BOOST_CHECK_EQUAL(99, last.id());
+
+	// O(1) random access in storage order
+	ptr_rep_type::DenseIteratorRange d = c.denseItems();
+	BOOST_CHECK_EQUAL(96, d.second - d.first);
+	for (long i = 0; i < d.second - d.first; i += 7)
+	{
+		const ptr_rep_type::DenseIterator dit = d.first + i;
+		BOOST_CHECK(c.valid(dit.id()));
+		BOOST_CHECK_EQUAL(&*dit, &c[dit.id()]);
+		BOOST_CHECK_EQUAL(i, dit - d.first);
+	}
+
+	// O(1) random access into a category
+	ptr_rep_type::CategoryIterator cit = c.begin(1) + 3;
+	BOOST_CHECK_EQUAL(c.id(1, 3), cit.id());
+	BOOST_CHECK_EQUAL(static_cast<long> (c.count(1)), c.end(1) - c.begin(1));
+	BOOST_CHECK_EQUAL(c.id(1, 2), (--cit).id());
+
+	std::vector<val_type> vals(c.begin(), c.end());
+	std::reverse(vals.begin(), vals.end());
+	BOOST_CHECK(std::equal(vals.begin(), vals.end(),
+			std::reverse_iterator<ptr_rep_type::iterator>(c.end())));
+}
+
 BOOST_AUTO_TEST_CASE( ptr_repo_index_iterator_category )
 {
 	ptr_rep_type c(10, 100);
@@ -272,8 +546,11 @@ BOOST_AUTO_TEST_CASE( ptr_repo_stl_copy )
 
 BOOST_AUTO_TEST_CASE( ptr_repo_iterator_concepts )
 {
-	BOOST_CONCEPT_ASSERT((boost::ForwardIterator<ptr_rep_type::iterator>));
-	BOOST_CONCEPT_ASSERT((boost::ForwardIterator<ptr_rep_type::const_iterator>));
+	BOOST_CONCEPT_ASSERT((boost::BidirectionalIterator<ptr_rep_type::iterator>));
+	BOOST_CONCEPT_ASSERT((boost::BidirectionalIterator<ptr_rep_type::const_iterator>));
+	BOOST_CONCEPT_ASSERT((boost::RandomAccessIterator<ptr_rep_type::DenseIterator>));
+	BOOST_CONCEPT_ASSERT((boost::RandomAccessIterator<ptr_rep_type::CategoryIterator>));
+	BOOST_CONCEPT_ASSERT((boost::RandomAccessIterator<ptr_rep_type::ConstCategoryIterator>));
 	BOOST_CONCEPT_ASSERT((boost::Convertible<ptr_rep_type::iterator, ptr_rep_type::const_iterator>));
 }
 
@@ -0,0 +1,255 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <largenet2/NeighborStateCounter.h>
+#include <largenet2/WeightedSampler.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <stdexcept>
+#include <memory>
+
+using namespace largenet;
+
+namespace
+{
+
+/// edge state is 1 if both nodes are in state 1
+struct BothInfected
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return (s == 1) && (t == 1) ? 1 : 0;
+	}
+};
+
+/// counts edge events
+class RewireCounter: public GraphListener
+{
+public:
+	RewireCounter() :
+		before(0), after(0), added(0), removed(0)
+	{
+	}
+	int before, after, added, removed;
+private:
+	void afterEdgeAddEvent(Graph& g, Edge& e)
+	{
+		++added;
+	}
+	void beforeEdgeRemoveEvent(Graph& g, Edge& e)
+	{
+		++removed;
+	}
+	void beforeEdgeRewireEvent(Graph& g, Edge& e, Node& newSource, Node& newTarget)
+	{
+		BOOST_CHECK(g.edge(e.id()) == &e);
+		++before;
+	}
+	void afterEdgeRewireEvent(Graph& g, Edge& e, Node& oldSource, Node& oldTarget)
+	{
+		BOOST_CHECK(e.source()->hasEdge(&e));
+		BOOST_CHECK(e.target()->hasEdge(&e));
+		BOOST_CHECK(!oldSource.hasEdge(&e) || (&oldSource == e.source())
+				|| (&oldSource == e.target()));
+		++after;
+	}
+};
+
+/// random number generator providing the interface expected by the graph
+/// and the samplers
+class Rng
+{
+public:
+	explicit Rng(unsigned int seed) :
+		engine_(seed)
+	{
+	}
+	double Uniform01()
+	{
+		return boost::random::uniform_real_distribution<double>(0, 1)(engine_);
+	}
+	template<typename T> T IntFromTo(T low, T high)
+	{
+		return boost::random::uniform_int_distribution<T>(low, high)(engine_);
+	}
+
+private:
+	boost::mt19937 engine_;
+};
+
+/// check that the adjacency lists and all listeners agree with the edges
+void checkConsistency(const Graph& g, const NeighborStateCounter& c,
+		const NodeSampler& d)
+{
+	for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+		BOOST_CHECK_EQUAL(d.weight(n.id()), n->degree());
+	BothInfected f;
+	for (Graph::ConstEdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+	{
+		BOOST_CHECK_EQUAL(g.findEdge(e->source()->id(), e->target()->id(),
+				e->isDirected()), &*e);
+		BOOST_CHECK_EQUAL(g.edgeState(e.id()), f(g.nodeState(e->source()->id()),
+				g.nodeState(e->target()->id())));
+	}
+	NeighborStateCounter fresh(g);
+	for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+	{
+		for (node_state_t s = 0; s < g.numberOfNodeStates(); ++s)
+		{
+			BOOST_CHECK_EQUAL(c.outNeighbors(n.id(), s), fresh.outNeighbors(n.id(), s));
+			BOOST_CHECK_EQUAL(c.inNeighbors(n.id(), s), fresh.inNeighbors(n.id(), s));
+			BOOST_CHECK_EQUAL(c.undirectedNeighbors(n.id(), s),
+					fresh.undirectedNeighbors(n.id(), s));
+		}
+	}
+}
+
+/// rewire random edges of a random graph and check all derived data
+void randomRewiring(std::auto_ptr<ElementFactory> f)
+{
+	Graph g(2, 2);
+	g.setElementFactory(f);
+	StateConsistencyListener<BothInfected> scl(
+			std::auto_ptr<BothInfected>(new BothInfected));
+	g.addGraphListener(&scl);
+	boost::mt19937 rng(7);
+	Rng rnd(11);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, 29);
+	for (node_id_t i = 0; i < 30; ++i)
+		g.addNode(i % 2);
+	for (int i = 0; i < 150; ++i)
+		g.addEdge(pick(rng), pick(rng), i % 3 == 0);
+
+	NeighborStateCounter c(g);
+	NodeSampler d(g);
+	EdgeProperty<int> p(g, -1);
+	RewireCounter r;
+	g.addGraphListener(&c);
+	g.addGraphListener(&d);
+	g.addGraphListener(&p);
+	g.addGraphListener(&r);
+	for (Graph::EdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+		p[e.id()] = e.id();
+	const edge_size_t m = g.numberOfEdges();
+
+	int rewired = 0;
+	for (int i = 0; i < 500; ++i)
+	{
+		const edge_id_t e = g.randomEdge(rnd)->id();
+		bool ok;
+		if (i % 2 == 0)
+			ok = g.rewireEdge(e, pick(rng), pick(rng));
+		else
+			ok = g.moveEdgeEndpoint(e, (i % 4 == 1) ? g.edge(e)->source()->id()
+					: g.edge(e)->target()->id(), pick(rng));
+		if (ok)
+			++rewired;
+		if (i % 50 == 0)
+			g.setNodeState(pick(rng), 1 - g.nodeState(pick(rng)));
+	}
+	BOOST_CHECK(rewired > 100);
+	BOOST_CHECK_EQUAL(r.before, rewired);
+	BOOST_CHECK_EQUAL(r.after, rewired);
+	BOOST_CHECK_EQUAL(r.added + r.removed, 0);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), m);
+	for (Graph::EdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+		BOOST_CHECK_EQUAL(p[e.id()], static_cast<int> (e.id()));
+	checkConsistency(g, c, d);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( rewire_tests )
+
+BOOST_AUTO_TEST_CASE( rewire_in_place )
+{
+	Graph g(2, 2);
+	g.addNodes(5, 0);
+	const edge_id_t e = g.addEdge(0, 1, true);
+	const edge_id_t u = g.addEdge(2, 3, false);
+	g.setEdgeState(e, 1);
+	const Edge* ep = g.edge(e);
+
+	BOOST_CHECK(g.rewireEdge(e, 2, 4));
+	BOOST_CHECK_EQUAL(g.edge(e), ep);
+	BOOST_CHECK_EQUAL(ep->source()->id(), 2);
+	BOOST_CHECK_EQUAL(ep->target()->id(), 4);
+	BOOST_CHECK_EQUAL(g.edgeState(e), 1);
+	BOOST_CHECK(g.findEdge(0, 1, true) == 0);
+	BOOST_CHECK_EQUAL(g.findEdge(2, 4, true), ep);
+	BOOST_CHECK_EQUAL(g.node(0)->degree() + g.node(1)->degree(), 0);
+	BOOST_CHECK_EQUAL(g.node(2)->outDegree(), 1);
+
+	BOOST_CHECK(g.rewireEdge(u, 4, 2));
+	BOOST_CHECK(g.moveEdgeEndpoint(u, 4, 3));
+	// parallel edges are rejected without changing anything
+	const edge_id_t v = g.addEdge(0, 3, false);
+	BOOST_CHECK(!g.moveEdgeEndpoint(v, 0, 2));
+	BOOST_CHECK_EQUAL(g.edge(v)->source()->id(), 0);
+	BOOST_CHECK(g.node(2)->findUndirectedEdgeTo(g.node(0)) == 0);
+	BOOST_CHECK_THROW(g.moveEdgeEndpoint(v, 1, 2), std::invalid_argument);
+
+	// loops
+	BOOST_CHECK(g.rewireEdge(e, 4, 4));
+	BOOST_CHECK(ep->isLoop());
+	BOOST_CHECK_EQUAL(g.node(4)->degree(), 2);
+	BOOST_CHECK(g.moveEdgeEndpoint(e, 4, 1));
+	BOOST_CHECK_EQUAL(ep->source()->id(), 4);
+	BOOST_CHECK_EQUAL(ep->target()->id(), 1);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 3);
+}
+
+BOOST_AUTO_TEST_CASE( rewire_node_types )
+{
+	randomRewiring(std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory));
+	randomRewiring(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ));
+	randomRewiring(std::auto_ptr<ElementFactory>(new IndexedElementFactory));
+	randomRewiring(std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<IndexedNode> ));
+}
+
+BOOST_AUTO_TEST_CASE( rewire_parallel_edges )
+{
+	Graph g(1, 1);
+	g.setElementFactory(std::auto_ptr<ElementFactory>(
+			new MultiEdgeElementFactory));
+	g.addNodes(3);
+	g.addEdge(0, 1, false);
+	const edge_id_t e = g.addEdge(0, 2, false);
+	BOOST_CHECK(g.moveEdgeEndpoint(e, 2, 1));
+	BOOST_CHECK_EQUAL(g.node(1)->degree(), 2);
+	BOOST_CHECK_EQUAL(g.node(2)->degree(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( rewire_basic_graph )
+{
+	typedef BasicGraph<IndexedNode, Edge, GraphElementFactory<IndexedNode>,
+			StaticStateConsistencyListener<BothInfected> > graph_t;
+	graph_t g(2, 2);
+	g.addNodes(4, 1);
+	g.setNodeState(3, 0);
+	const edge_id_t e = g.addEdge(0, 1, false);
+	BOOST_CHECK_EQUAL(g.edgeState(e), 1);
+	BOOST_CHECK(g.moveEdgeEndpoint(e, 1, 3));
+	BOOST_CHECK_EQUAL(g.edgeState(e), 0);
+	// through the Graph interface
+	Graph& base = g;
+	BOOST_CHECK(base.rewireEdge(e, 2, 1));
+	BOOST_CHECK_EQUAL(g.edgeState(e), 1);
+	BOOST_CHECK_EQUAL(g.edge(e)->source()->id(), 2);
+	BOOST_CHECK(!g.rewireEdge(g.addEdge(0, 3, false), 1, 2));
+
+	Rng rnd(1);
+	EdgeSampler w(g);
+	g.addGraphListener(&w);
+	w.setWeight(e, 5);
+	BOOST_CHECK(g.rewireEdge(e, 0, 2));
+	BOOST_CHECK_EQUAL(w.weight(e), 5);
+	BOOST_CHECK_EQUAL(w.totalWeight(1), 5);
+	BOOST_CHECK_EQUAL(w.draw(1, rnd), e);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
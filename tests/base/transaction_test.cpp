@@ -0,0 +1,333 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <largenet2/NeighborStateCounter.h>
+#include <largenet2/WeightedSampler.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <stdexcept>
+#include <memory>
+#include <set>
+#include <utility>
+
+using namespace largenet;
+
+namespace
+{
+
+/// edge state is 1 if both nodes are in state 1
+struct BothInfected
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return (s == 1) && (t == 1) ? 1 : 0;
+	}
+};
+
+/// IDs, states and ends of all nodes and edges
+struct Snapshot
+{
+	explicit Snapshot(const Graph& g)
+	{
+		for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+			nodes.insert(std::make_pair(n.id(), g.nodeState(n.id())));
+		for (Graph::ConstEdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+			edges.insert(std::make_pair(std::make_pair(e.id(), g.edgeState(e.id())),
+					std::make_pair(e->source()->id(), e->target()->id())));
+	}
+	bool operator==(const Snapshot& s) const
+	{
+		return (nodes == s.nodes) && (edges == s.edges);
+	}
+	std::set<std::pair<node_id_t, node_state_t> > nodes;
+	std::set<std::pair<std::pair<edge_id_t, edge_state_t>, std::pair<node_id_t,
+			node_id_t> > > edges;
+};
+
+/// check that the adjacency lists and all listeners agree with the edges
+void checkConsistency(const Graph& g, const NeighborStateCounter& c,
+		const NodeSampler& d)
+{
+	BothInfected f;
+	for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+		BOOST_CHECK_EQUAL(d.weight(n.id()), n->degree());
+	for (Graph::ConstEdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+	{
+		BOOST_CHECK_EQUAL(g.findEdge(e->source()->id(), e->target()->id(),
+				e->isDirected()), &*e);
+		BOOST_CHECK_EQUAL(g.edgeState(e.id()), f(g.nodeState(e->source()->id()),
+				g.nodeState(e->target()->id())));
+	}
+	NeighborStateCounter fresh(g);
+	for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+	{
+		for (node_state_t s = 0; s < g.numberOfNodeStates(); ++s)
+		{
+			BOOST_CHECK_EQUAL(c.outNeighbors(n.id(), s), fresh.outNeighbors(n.id(), s));
+			BOOST_CHECK_EQUAL(c.inNeighbors(n.id(), s), fresh.inNeighbors(n.id(), s));
+			BOOST_CHECK_EQUAL(c.undirectedNeighbors(n.id(), s),
+					fresh.undirectedNeighbors(n.id(), s));
+		}
+	}
+}
+
+/// make random changes of all kinds in a transaction and roll them back
+void randomRollback(std::auto_ptr<ElementFactory> f)
+{
+	Graph g(2, 2);
+	g.setElementFactory(f);
+	StateConsistencyListener<BothInfected> scl(
+			std::auto_ptr<BothInfected>(new BothInfected));
+	g.addGraphListener(&scl);
+	boost::mt19937 rng(5);
+	boost::random::uniform_int_distribution<int> pick(0, 1000);
+	for (node_id_t i = 0; i < 30; ++i)
+		g.addNode(i % 2);
+	for (int i = 0; i < 100; ++i)
+		g.addEdge(pick(rng) % 30, pick(rng) % 30, i % 3 == 0);
+	// leave some free IDs
+	for (int i = 0; i < 10; ++i)
+		g.removeEdge(g.edges().first.id());
+	g.removeNode(7);
+
+	NeighborStateCounter c(g);
+	NodeSampler d(g);
+	g.addGraphListener(&c);
+	g.addGraphListener(&d);
+	const Snapshot before(g);
+
+	for (int round = 0; round < 20; ++round)
+	{
+		g.beginTransaction();
+		for (int i = 0; i < 30; ++i)
+		{
+			Graph::NodeIterator n = g.nodes().first;
+			for (int k = pick(rng) % g.numberOfNodes(); k > 0; --k)
+				++n;
+			const node_id_t a = n.id();
+			Graph::EdgeIterator e = g.edges().first;
+			for (int k = pick(rng) % g.numberOfEdges(); k > 0; --k)
+				++e;
+			switch (pick(rng) % 7)
+			{
+			case 0:
+				g.addEdge(a, g.addNode(pick(rng) % 2), true);
+				break;
+			case 1:
+				if (g.numberOfNodes() > 10)
+					g.removeNode(a);
+				break;
+			case 2:
+				g.removeEdge(e.id());
+				break;
+			case 3:
+				g.addEdge(a, e->target()->id(), false);
+				break;
+			case 4:
+				g.setNodeState(a, 1 - g.nodeState(a));
+				break;
+			case 5:
+				g.moveEdgeEndpoint(e.id(), e->source()->id(), a);
+				break;
+			default:
+				g.setEdgeState(e.id(), 1 - g.edgeState(e.id()));
+				break;
+			}
+		}
+		if (round % 4 == 3)
+		{
+			// nested transaction committed into the outer one
+			g.beginTransaction();
+			g.setNodeState(g.nodes().first.id(), 1);
+			g.removeNode(g.nodes().first.id());
+			g.commit();
+		}
+		g.rollback();
+		BOOST_CHECK(!g.inTransaction());
+		BOOST_CHECK(Snapshot(g) == before);
+		checkConsistency(g, c, d);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( transaction_tests )
+
+BOOST_AUTO_TEST_CASE( rollback_restores_ids )
+{
+	Graph g(2, 2);
+	g.addNodes(4, 0);
+	const edge_id_t e01 = g.addEdge(0, 1, false);
+	const edge_id_t e12 = g.addEdge(1, 2, true);
+	const edge_id_t e23 = g.addEdge(2, 3, false);
+	g.setEdgeState(e12, 1);
+	const Snapshot before(g);
+
+	BOOST_CHECK(!g.inTransaction());
+	g.beginTransaction();
+	BOOST_CHECK(g.inTransaction());
+	g.removeNode(1);
+	g.removeEdge(e23);
+	g.setNodeState(3, 1);
+	const node_id_t n = g.addNode();
+	g.addEdge(n, 0, false);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 1);
+	g.rollback();
+	BOOST_CHECK(!g.inTransaction());
+
+	BOOST_CHECK(Snapshot(g) == before);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(), 4);
+	BOOST_CHECK_EQUAL(g.edgeState(e12), 1);
+	BOOST_CHECK(g.edge(e12)->isDirected());
+	BOOST_CHECK_EQUAL(g.findEdge(0, 1, false)->id(), e01);
+	BOOST_CHECK_EQUAL(g.findEdge(1, 2, true)->id(), e12);
+	BOOST_CHECK_EQUAL(g.node(1)->degree(), 2);
+
+	// rewiring and committed changes
+	g.beginTransaction();
+	BOOST_CHECK(g.moveEdgeEndpoint(e01, 1, 3));
+	g.rollback();
+	BOOST_CHECK_EQUAL(g.edge(e01)->target()->id(), 1);
+	g.beginTransaction();
+	g.removeEdge(e01);
+	g.commit();
+	BOOST_CHECK(g.findEdge(0, 1, false) == 0);
+}
+
+BOOST_AUTO_TEST_CASE( nested_transactions )
+{
+	Graph g(2, 1);
+	g.addNodes(3, 0);
+	g.beginTransaction();
+	g.setNodeState(0, 1);
+	g.beginTransaction();
+	g.setNodeState(1, 1);
+	g.rollback();
+	BOOST_CHECK(g.inTransaction());
+	BOOST_CHECK_EQUAL(g.nodeState(0), 1);
+	BOOST_CHECK_EQUAL(g.nodeState(1), 0);
+	g.beginTransaction();
+	g.setNodeState(2, 1);
+	g.commit();
+	g.rollback();
+	BOOST_CHECK_EQUAL(g.numberOfNodes(0), 3);
+}
+
+BOOST_AUTO_TEST_CASE( rollback_listeners )
+{
+	randomRollback(std::auto_ptr<ElementFactory>(new SingleEdgeElementFactory));
+	randomRollback(std::auto_ptr<ElementFactory>(
+			new GraphElementFactory<CompactNode> ));
+	randomRollback(std::auto_ptr<ElementFactory>(new IndexedElementFactory));
+	randomRollback(std::auto_ptr<ElementFactory>(
+			new PooledElementFactory<IndexedNode> ));
+}
+
+BOOST_AUTO_TEST_CASE( rollback_restores_properties )
+{
+	Graph g(2, 1);
+	g.addNodes(4, 0);
+	const edge_id_t e = g.addEdge(0, 1, false);
+	g.addEdge(1, 2, false);
+	NodeProperty<int> np(g, -1);
+	EdgeProperty<double> ep(g, 1.0);
+	NodeSampler ns(g, NodeSampler::CUSTOM, 1);
+	EdgeSampler es(g, 1);
+	g.addGraphListener(&np).addGraphListener(&ep).addGraphListener(&ns).addGraphListener(
+			&es);
+	for (node_id_t i = 0; i < 4; ++i)
+	{
+		np[i] = 10 + i;
+		ns.setWeight(i, 2 + i);
+	}
+	ep[e] = 5.0;
+	es.setWeight(e, 5.0);
+
+	g.beginTransaction();
+	g.removeEdge(e);
+	g.rollback();
+	BOOST_CHECK_EQUAL(g.edge(e)->id(), e);
+	BOOST_CHECK_EQUAL(ep[e], 5.0);
+	BOOST_CHECK_EQUAL(es.weight(e), 5.0);
+
+	// the removed IDs are taken by new elements before the rollback, and
+	// a nested transaction is committed into the outer one
+	g.beginTransaction();
+	g.removeNode(1);
+	g.beginTransaction();
+	g.removeNode(3);
+	g.commit();
+	const node_id_t n = g.addNode();
+	BOOST_CHECK_EQUAL(np[n], -1);
+	BOOST_CHECK_EQUAL(ns.weight(n), 1);
+	g.addEdge(n, 0, false);
+	BOOST_CHECK_EQUAL(ep[e], 1.0);
+	g.rollback();
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 2);
+	for (node_id_t i = 0; i < 4; ++i)
+	{
+		BOOST_CHECK_EQUAL(np[i], 10 + i);
+		BOOST_CHECK_EQUAL(ns.weight(i), 2 + i);
+	}
+	BOOST_CHECK_EQUAL(ep[e], 5.0);
+	BOOST_CHECK_EQUAL(es.weight(e), 5.0);
+	BOOST_CHECK_CLOSE(es.totalWeight(), 6.0, 1e-9);
+
+	// committed removals are final
+	g.beginTransaction();
+	g.removeEdge(e);
+	g.commit();
+	const edge_id_t f = g.addEdge(0, 3, false);
+	BOOST_CHECK_EQUAL(f, e);
+	BOOST_CHECK_EQUAL(ep[f], 1.0);
+	BOOST_CHECK_EQUAL(es.weight(f), 1.0);
+	g.removeGraphListener(&es);
+	g.removeGraphListener(&ns);
+	g.removeGraphListener(&ep);
+	g.removeGraphListener(&np);
+}
+
+BOOST_AUTO_TEST_CASE( rollback_basic_graph )
+{
+	typedef BasicGraph<IndexedNode, Edge, GraphElementFactory<IndexedNode>,
+			StaticStateConsistencyListener<BothInfected> > graph_t;
+	graph_t g(2, 2);
+	g.addNodes(3, 1);
+	const edge_id_t e = g.addEdge(0, 1, false);
+	g.beginTransaction();
+	g.setNodeState(1, 0);
+	BOOST_CHECK_EQUAL(g.edgeState(e), 0);
+	g.addEdge(1, 2, false);
+	g.rollback();
+	BOOST_CHECK_EQUAL(g.edgeState(e), 1);
+	BOOST_CHECK_EQUAL(g.numberOfEdges(), 1);
+	g.beginTransaction();
+	g.moveEdgeEndpoint(e, 0, 2);
+	g.setNodeState(2, 0);
+	BOOST_CHECK_EQUAL(g.edgeState(e), 0);
+	g.rollback();
+	BOOST_CHECK_EQUAL(g.edge(e)->source()->id(), 0);
+	BOOST_CHECK_EQUAL(g.edgeState(e), 1);
+}
+
+BOOST_AUTO_TEST_CASE( transaction_misuse )
+{
+	Graph g(1, 1);
+	g.addNodes(2);
+	BOOST_CHECK_THROW(g.commit(), std::logic_error);
+	BOOST_CHECK_THROW(g.rollback(), std::logic_error);
+	g.beginTransaction();
+	BOOST_CHECK_THROW(g.clear(), std::logic_error);
+	BOOST_CHECK_THROW(g.compact(), std::logic_error);
+	Graph h(1, 1);
+	g.swap(h);
+	BOOST_CHECK(h.inTransaction());
+	BOOST_CHECK(!g.inTransaction());
+	h.addEdge(0, 1, false);
+	h.rollback();
+	BOOST_CHECK_EQUAL(h.numberOfEdges(), 0);
+	h.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
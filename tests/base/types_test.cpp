@@ -0,0 +1,117 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/io/BinWriter.h>
+#include <largenet2/io/BinReader.h>
+#include <boost/cstdint.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <limits>
+#include <stdexcept>
+
+using namespace largenet;
+
+BOOST_AUTO_TEST_SUITE( types_tests )
+
+BOOST_AUTO_TEST_CASE( type_widths )
+{
+	BOOST_CHECK_EQUAL(sizeof(node_id_t) * 8, LARGENET_ID_BITS == 32 ? 32 : sizeof(unsigned long) * 8);
+	BOOST_CHECK_EQUAL(sizeof(edge_id_t), sizeof(node_id_t));
+	BOOST_CHECK_EQUAL(sizeof(degree_t), sizeof(node_id_t));
+	BOOST_CHECK_EQUAL(sizeof(repo::id_t), sizeof(node_id_t));
+	BOOST_CHECK_EQUAL(sizeof(node_state_t) * 8, LARGENET_STATE_BITS);
+	BOOST_CHECK_EQUAL(sizeof(edge_state_t), sizeof(node_state_t));
+}
+
+BOOST_AUTO_TEST_CASE( state_range )
+{
+#if LARGENET_STATE_BITS < 32
+	// all values of node_state_t can be used as states, but no more
+	const node_state_size_t maxState = std::numeric_limits<node_state_t>::max();
+	Graph g(maxState + 1, 1);
+	g.addNode(maxState);
+	BOOST_CHECK_EQUAL(static_cast<node_state_size_t>(g.nodeState(0)), maxState);
+	BOOST_CHECK_EQUAL(g.numberOfNodes(maxState), 1);
+	BOOST_CHECK_THROW(Graph(maxState + 2, 1), std::overflow_error);
+	BOOST_CHECK_THROW(Graph(1, maxState + 2), std::overflow_error);
+#else
+	BOOST_CHECK_NO_THROW(Graph(16, 16));
+#endif
+}
+
+BOOST_AUTO_TEST_CASE( repository_max_size )
+{
+	repo::CPtrRepository<int> r(1);
+	BOOST_CHECK(r.maxSize() <= std::numeric_limits<repo::id_t>::max());
+	BOOST_CHECK(r.maxSize() <= std::numeric_limits<repo::address_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE( binary_widths )
+{
+	Graph g(2, 3);
+	g.addNodes(3, 1);
+	g.setEdgeState(g.addEdge(0, 2, true), 2);
+	std::ostringstream out;
+	io::BinWriter().write(g, out);
+	const std::string data = out.str();
+	BOOST_REQUIRE(data.size() > 7);
+	BOOST_CHECK_EQUAL(data.substr(0, 4), "LNBG");
+	BOOST_CHECK_EQUAL(data[4], 1);
+	BOOST_CHECK_EQUAL(data[5], LARGENET_ID_BITS);
+	BOOST_CHECK_EQUAL(data[6], LARGENET_STATE_BITS);
+
+	std::istringstream in(data);
+	const std::auto_ptr<Graph> h(io::BinReader().createFromStream(in));
+	BOOST_CHECK_EQUAL(h->numberOfNodes(1), 3);
+	BOOST_CHECK_EQUAL(h->numberOfEdges(2), 1);
+
+	// data written by a build with other widths, or in another version, is
+	// rejected
+	std::string other = data;
+	other[5] = LARGENET_ID_BITS == 32 ? 64 : 32;
+	std::istringstream in2(other);
+	BOOST_CHECK_THROW(io::BinReader().createFromStream(in2), std::runtime_error);
+	other = data;
+	other[6] = LARGENET_STATE_BITS == 8 ? 32 : 8;
+	std::istringstream in3(other);
+	BOOST_CHECK_THROW(io::BinReader().createFromStream(in3), std::runtime_error);
+	other = data;
+	other[4] = 2;
+	std::istringstream in4(other);
+	BOOST_CHECK_THROW(io::BinReader().createFromStream(in4), std::runtime_error);
+	std::istringstream empty;
+	BOOST_CHECK_THROW(io::BinReader().createFromStream(empty), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( binary_legacy )
+{
+	// written without header, with 64 bit IDs and 32 bit states: nodes 7 and
+	// 9 in states 1 and 0, an edge 9 -> 7 in state 2
+	std::ostringstream out;
+	const boost::uint64_t counts[2] = { 2, 1 };
+	const boost::uint32_t states[2] = { 2, 3 };
+	out.write((const char*) counts, sizeof(counts));
+	out.write((const char*) states, sizeof(states));
+	const boost::uint64_t ids[4] = { 7, 9, 9, 7 };
+	const boost::uint32_t nodeStates[2] = { 1, 0 }, edgeState = 2;
+	for (int i = 0; i < 2; ++i)
+	{
+		out.write((const char*) &ids[i], sizeof(ids[i]));
+		out.write((const char*) &nodeStates[i], sizeof(nodeStates[i]));
+	}
+	out.write((const char*) &ids[2], 2 * sizeof(ids[2]));
+	out.write((const char*) &edgeState, sizeof(edgeState));
+
+	std::istringstream in(out.str());
+	const std::auto_ptr<Graph> g(io::BinReader().createFromStream(in));
+	BOOST_CHECK_EQUAL(g->numberOfNodeStates(), 2);
+	BOOST_CHECK_EQUAL(g->numberOfEdgeStates(), 3);
+	BOOST_REQUIRE_EQUAL(g->numberOfNodes(), 2);
+	BOOST_CHECK_EQUAL(g->nodeState(0), 1);
+	BOOST_CHECK_EQUAL(g->nodeState(1), 0);
+	BOOST_REQUIRE_EQUAL(g->numberOfEdges(2), 1);
+	BOOST_CHECK(g->isEdge(1, 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,227 @@
+#include <boost/test/unit_test.hpp>
+
+#include <largenet2.h>
+#include <largenet2/io/JournalListener.h>
+#include <largenet2/io/JournalReplayer.h>
+#include <largenet2/StateConsistencyListener.h>
+#include <largenet2/NeighborStateCounter.h>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+#include <memory>
+
+using namespace largenet;
+
+namespace
+{
+
+/// SIS edge states: SS, SI, II
+struct SISEdges
+{
+	edge_state_t operator()(node_state_t s, node_state_t t) const
+	{
+		return s + t;
+	}
+};
+
+/// node and edge data that do not depend on IDs
+struct Signature
+{
+	explicit Signature(const Graph& g)
+	{
+		for (Graph::ConstNodeIterator n = g.nodes().first; n != g.nodes().second; ++n)
+			nodes.push_back(boost::make_tuple(g.nodeState(n.id()), n->outDegree(),
+					n->inDegree(), n->degree()));
+		for (Graph::ConstEdgeIterator e = g.edges().first; e != g.edges().second; ++e)
+			edges.push_back(boost::make_tuple(g.edgeState(e.id()), e->isDirected(),
+					g.nodeState(e->source()->id()) * 1000 + e->source()->degree(),
+					g.nodeState(e->target()->id()) * 1000 + e->target()->degree()));
+		std::sort(nodes.begin(), nodes.end());
+		std::sort(edges.begin(), edges.end());
+	}
+	bool operator==(const Signature& s) const
+	{
+		return (nodes == s.nodes) && (edges == s.edges);
+	}
+	std::vector<boost::tuple<node_state_t, degree_t, degree_t, degree_t> > nodes;
+	std::vector<boost::tuple<edge_state_t, bool, degree_t, degree_t> > edges;
+};
+
+/// random changes of all kinds, with the state after each time step
+void simulate(Graph& g, io::JournalListener& journal, const int steps,
+		std::vector<Signature>& states)
+{
+	boost::mt19937 rng(3);
+	boost::random::uniform_int_distribution<int> pick(0, 1000);
+	states.push_back(Signature(g));
+	for (int t = 1; t <= steps; ++t)
+	{
+		journal.setTime(t);
+		for (int i = 0; i < 20; ++i)
+		{
+			Graph::NodeIterator n = g.nodes().first;
+			for (int k = pick(rng) % g.numberOfNodes(); k > 0; --k)
+				++n;
+			const node_id_t a = n.id();
+			Graph::EdgeIterator e = g.edges().first;
+			for (int k = pick(rng) % g.numberOfEdges(); k > 0; --k)
+				++e;
+			switch (pick(rng) % 6)
+			{
+			case 0:
+				g.addEdge(a, g.addNode(pick(rng) % 2), pick(rng) % 2 == 0);
+				break;
+			case 1:
+				if (g.numberOfNodes() > 20)
+					g.removeNode(a);
+				break;
+			case 2:
+				if (g.numberOfEdges() > 20)
+					g.removeEdge(e.id());
+				break;
+			case 3:
+				g.setNodeState(a, 1 - g.nodeState(a));
+				break;
+			case 4:
+				g.moveEdgeEndpoint(e.id(), e->target()->id(), a);
+				break;
+			default:
+				g.addEdge(a, e->source()->id(), false);
+				break;
+			}
+		}
+		if (t % 17 == 0)
+			g.compact();
+		if (t % 23 == 0)
+		{
+			g.beginTransaction();
+			g.removeNode(g.nodes().first.id());
+			g.rollback();
+		}
+		states.push_back(Signature(g));
+	}
+}
+
+/// random graph with the SIS edge states
+void build(Graph& g, StateConsistencyListener<SISEdges>& scl)
+{
+	g.addGraphListener(&scl);
+	boost::mt19937 rng(1);
+	boost::random::uniform_int_distribution<node_id_t> pick(0, 49);
+	for (int i = 0; i < 50; ++i)
+		g.addNode(i % 2);
+	for (int i = 0; i < 120; ++i)
+		g.addEdge(pick(rng), pick(rng), false);
+	// leave some free IDs
+	g.removeNode(3);
+	g.removeNode(10);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( journal_tests )
+
+BOOST_AUTO_TEST_CASE( replay_and_seek )
+{
+	Graph g(2, 3);
+	StateConsistencyListener<SISEdges> scl(std::auto_ptr<SISEdges>(new SISEdges));
+	build(g, scl);
+	std::stringstream strm;
+	std::vector<Signature> states;
+	unsigned long changes;
+	{
+		io::JournalListener journal(g, strm, 0.5);
+		g.addGraphListener(&journal);
+		simulate(g, journal, 60, states);
+		g.removeGraphListener(&journal);
+		changes = journal.numberOfChanges();
+		journal.flush();
+		BOOST_CHECK_EQUAL(journal.bytesWritten(), strm.str().size());
+	}
+	BOOST_CHECK(changes > 1000);
+
+	// replay step by step, with listeners on the replayed graph
+	Graph h(2, 3);
+	StateConsistencyListener<SISEdges> hscl(std::auto_ptr<SISEdges>(
+			new SISEdges));
+	h.addGraphListener(&hscl);
+	NeighborStateCounter c(h);
+	h.addGraphListener(&c);
+	io::JournalReplayer replay(strm, h);
+	BOOST_CHECK_EQUAL(replay.numberOfNodeStates(), 2);
+	BOOST_CHECK(Signature(h) == states[0]);
+	unsigned long n = 0;
+	while (replay.step())
+		++n;
+	BOOST_CHECK_EQUAL(n, changes);
+	BOOST_CHECK(replay.atEnd());
+	BOOST_CHECK_EQUAL(replay.time(), 60);
+	BOOST_CHECK(Signature(h) == states.back());
+	NeighborStateCounter fresh(h);
+	for (Graph::NodeIterator i = h.nodes().first; i != h.nodes().second; ++i)
+		BOOST_CHECK_EQUAL(c.undirectedNeighbors(i.id(), 1), fresh.undirectedNeighbors(i.id(), 1));
+
+	// advance in time steps
+	replay.rewind();
+	for (int t = 1; t <= 60; ++t)
+	{
+		replay.advance(t);
+		BOOST_CHECK(Signature(h) == states[t]);
+	}
+	// seek backwards and forwards
+	const int times[] = { 30, 5, 0, 59, 16, 17, 18, 40, 41, 22 };
+	for (size_t i = 0; i < sizeof(times) / sizeof(times[0]); ++i)
+	{
+		replay.seek(times[i]);
+		BOOST_CHECK(Signature(h) == states[times[i]]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( journal_clear_and_truncation )
+{
+	Graph g(2, 1);
+	std::stringstream strm;
+	{
+		io::JournalListener journal(g, strm, 0, 1.5);
+		g.addGraphListener(&journal);
+		g.addNodes(3, 1);
+		g.addEdge(0, 1, true);
+		journal.flush();
+		journal.setTime(2);
+		g.clear();
+		g.addNode(0);
+		BOOST_CHECK_THROW(journal.setTime(1), std::invalid_argument);
+		g.removeGraphListener(&journal);
+	}
+	Graph h(2, 1);
+	io::JournalReplayer replay(strm, h);
+	BOOST_CHECK_EQUAL(h.numberOfNodes(), 0);
+	BOOST_CHECK_EQUAL(replay.time(), 1.5);
+	BOOST_CHECK_EQUAL(replay.advance(1.5), 4);
+	BOOST_CHECK_EQUAL(h.numberOfEdges(), 1);
+	BOOST_CHECK_EQUAL(replay.advance(2), 2);
+	BOOST_CHECK_EQUAL(h.numberOfNodes(), 1);
+	BOOST_CHECK(replay.atEnd());
+
+	// an incomplete segment at the end is ignored
+	std::string data = strm.str();
+	std::stringstream truncated(data.substr(0, data.size() - 3));
+	io::JournalReplayer partial(truncated, h);
+	BOOST_CHECK_EQUAL(partial.advance(10), 4);
+	BOOST_CHECK(partial.atEnd());
+	BOOST_CHECK_EQUAL(h.numberOfNodes(), 3);
+
+	Graph few(1, 1);
+	strm.clear();
+	strm.seekg(0);
+	BOOST_CHECK_THROW(io::JournalReplayer r(strm, few), std::invalid_argument);
+	std::stringstream garbage("not a journal");
+	BOOST_CHECK_THROW(io::JournalReplayer r(garbage, h), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()